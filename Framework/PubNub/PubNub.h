@@ -15,6 +15,7 @@ FOUNDATION_EXPORT const unsigned char PubNubVersionString[];
 
 // Protocols
 #import "PNObjectEventListener.h"
+#import "PNTransport.h"
 
 // Categories
 #import "NSURLSessionConfiguration+PNConfiguration.h"
@@ -4,7 +4,7 @@
 
 #pragma mark Class forward
 
-@class PNClientInformation, PNConfiguration;
+@class PNRequestMetricsHistogram, PNClientInformation, PNConfiguration, PNMetrics;
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -52,6 +52,52 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSString *)uuid;
 
+/**
+ @brief      Retrieve number of non-subscribe requests which wait for free connection in specified lane.
+ @discussion Each lane has own connections budget which can be configured with \b PNConfiguration. Growing 
+             queue depth may mean that budget for lane is too small.
+ 
+ @param lane One of \b PNRequestLane enum fields which specify for which lane queue depth should be returned.
+ 
+ @return Number of requests which wait in \c lane queue.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)pendingRequestsCountInLane:(PNRequestLane)lane;
+
+/**
+ @brief      Retrieve requests processing duration histogram for specified operation type.
+ @discussion Histogram collected only if \c requestMetricsHistogramEnabled has been set in client 
+             configuration.
+ 
+ @param operation One of \b PNOperationType enum fields which specify for which operation histogram should 
+                  be returned.
+ 
+ @return Snapshot of histogram state or \c nil in case if histogram collection not enabled.
+ 
+ @since 4.5.0
+ */
+- (nullable PNRequestMetricsHistogram *)requestMetricsHistogramForOperation:(PNOperationType)operation;
+
+/**
+ @brief  Remove all durations which has been collected by requests processing histograms.
+ 
+ @since 4.5.0
+ */
+- (void)resetRequestMetricsHistograms;
+
+/**
+ @brief      Retrieve snapshot of client-wide metrics.
+ @discussion Messages and presence events rates calculated for period since previous snapshot has been 
+             taken (or since client creation).
+ 
+ @return Metrics snapshot or \c nil in case if metrics collection has been removed from compiled code with
+         \c PN_METRICS_ENABLED=0 preprocessor definition.
+ 
+ @since 4.5.0
+ */
+- (nullable PNMetrics *)metrics;
+
 
 ///------------------------------------------------
 /// @name Initialization
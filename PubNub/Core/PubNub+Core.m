@@ -18,9 +18,14 @@
 #endif // __IPHONE_OS_VERSION_MIN_REQUIRED
 #import "PubNub+SubscribePrivate.h"
 #import "PNObjectEventListener.h"
+#import "PNURLSessionTransport.h"
+#import "PNRequestMetricsHistogram+Private.h"
 #import "PNClientInformation.h"
+#import "PNMetrics+Private.h"
+#import "PNRequestMetrics.h"
 #import "PNRequestParameters.h"
 #import "PNSubscribeStatus.h"
+#import "PNSocketTransport.h"
 #import "PNResult+Private.h"
 #import "PNStatus+Private.h"
 #import "PNConfiguration.h"
@@ -74,6 +79,42 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) PNClientState *clientStateManager;
 @property (nonatomic, strong) PNStateListener *listenersManager;
 @property (nonatomic, strong) PNHeartbeat *heartbeatManager;
+@property (nonatomic, strong) PNParsingExecutor *parsingExecutor;
+@property (nonatomic, strong) PNPublishQueue *publishQueue;
+@property (nonatomic, strong) PNPresenceIndex *presenceIndex;
+
+/**
+ @brief      Stores reference on list of requests processing histograms (one per \b PNOperationType).
+ @discussion List created only if histogram collection has been enabled in client configuration.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, strong) NSArray<PNRequestMetricsHistogram *> *metricsHistograms;
+
+#if PN_METRICS_ENABLED
+@property (nonatomic, assign) PNMetricsCounters *metricsCounters;
+
+/**
+ @brief  Stores date when client-wide metrics counters has been created.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSDate *metricsStartDate;
+
+/**
+ @brief  Stores reference on previous metrics snapshot which is used to calculate rates.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, strong) PNMetrics *previousMetrics;
+
+/**
+ @brief  Stores reference on spin-lock which is used to protect previous metrics snapshot.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) OSSpinLock metricsLock;
+#endif // PN_METRICS_ENABLED
 @property (nonatomic, assign) PNStatusCategory recentClientStatus;
 
 /**
@@ -84,6 +125,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) PNNetwork *subscriptionNetwork;
 
+/**
+ @brief      Stores reference on list of \b PubNub network managers which is used by additional subscribe 
+             shards.
+ @discussion Each shard use own long-poll connection, so slow response for one of them won't affect rest.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSArray<PNNetwork *> *subscriptionShardNetworks;
+
 /**
  @brief Stores reference on \b PubNub network manager configured to be used for 'non-subscription'
         API group.
@@ -200,6 +250,41 @@ NS_ASSUME_NONNULL_END
     return self.configuration.uuid;
 }
 
+- (NSUInteger)pendingRequestsCountInLane:(PNRequestLane)lane {
+    
+    return [self.serviceNetwork pendingRequestsCountInLane:lane];
+}
+
+- (PNRequestMetricsHistogram *)requestMetricsHistogramForOperation:(PNOperationType)operation {
+    
+    PNRequestMetricsHistogram *histogram = nil;
+    if (operation >= PNSubscribeOperation && (NSUInteger)operation < self.metricsHistograms.count) {
+        
+        histogram = [self.metricsHistograms[operation] copy];
+    }
+    
+    return histogram;
+}
+
+- (void)resetRequestMetricsHistograms {
+    
+    [self.metricsHistograms makeObjectsPerformSelector:@selector(reset)];
+}
+
+- (PNMetrics *)metrics {
+    
+    PNMetrics *metrics = nil;
+#if PN_METRICS_ENABLED
+    OSSpinLockLock(&_metricsLock);
+    metrics = [PNMetrics metricsWithCounters:self.metricsCounters previousMetrics:self.previousMetrics
+                                   startDate:self.metricsStartDate];
+    self.previousMetrics = metrics;
+    OSSpinLockUnlock(&_metricsLock);
+#endif // PN_METRICS_ENABLED
+    
+    return metrics;
+}
+
 
 #pragma mark - Initialization
 
@@ -226,12 +311,28 @@ NS_ASSUME_NONNULL_END
         
         _configuration = [configuration copy];
         _callbackQueue = callbackQueue;
+        if (_configuration.shouldCollectRequestMetricsHistogram) {
+            
+            NSMutableArray *histograms = [NSMutableArray new];
+            for (NSInteger operation = PNSubscribeOperation; operation <= PNTimeOperation; operation++) {
+                
+                [histograms addObject:[PNRequestMetricsHistogram histogramForOperation:operation]];
+            }
+            _metricsHistograms = [histograms copy];
+        }
+#if PN_METRICS_ENABLED
+        _metricsCounters = calloc(1, sizeof(PNMetricsCounters));
+        _metricsStartDate = [NSDate date];
+        _metricsLock = OS_SPINLOCK_INIT;
+#endif // PN_METRICS_ENABLED
         [self prepareNetworkManagers];
         
         _subscriberManager = [PNSubscriber subscriberForClient:self];
         _clientStateManager = [PNClientState stateForClient:self];
         _listenersManager = [PNStateListener stateListenerForClient:self];
         _heartbeatManager = [PNHeartbeat heartbeatForClient:self];
+        _publishQueue = [PNPublishQueue publishQueueForClient:self];
+        _presenceIndex = [PNPresenceIndex presenceIndexForClient:self];
         [self addListener:self];
         [self prepareReachability];
 #if TARGET_OS_WATCH
@@ -275,6 +376,7 @@ NS_ASSUME_NONNULL_END
     PubNub *client = [PubNub clientWithConfiguration:configuration callbackQueue:callbackQueue];
     [client.subscriberManager inheritStateFromSubscriber:self.subscriberManager];
     [client.clientStateManager inheritStateFromState:self.clientStateManager];
+    [client.presenceIndex inheritStateFromIndex:self.presenceIndex];
     [client.listenersManager inheritStateFromListener:self.listenersManager];
     [client removeListener:self];
     [self.listenersManager removeAllListeners];
@@ -392,12 +494,47 @@ NS_ASSUME_NONNULL_END
 
 - (void)prepareNetworkManagers {
     
+    Class<PNTransport> transportClass = _configuration.transportClass;
+    if (!transportClass) {
+        
+        transportClass = [PNURLSessionTransport class];
+        if (_configuration.transportType == PNSocketTransportType) {
+            
+            if (!_configuration.isTLSEnabled) { transportClass = [PNSocketTransport class]; }
+            else {
+                
+                DDLogClientInfo([[self class] ddLogLevel], @"<PubNub> Socket transport doesn't support TLS. "
+                                "NSURLSession transport will be used.");
+            }
+        }
+    }
+    
+    // Executor should be created before networks, because they will share it.
+    NSString *identifier = [NSString stringWithFormat:@"com.pubnub.client.%p", self];
+    _parsingExecutor = [PNParsingExecutor executorWithIdentifier:identifier
+                                                qualityOfService:_configuration.parsingQualityOfService
+                                              maximumConcurrency:_configuration.parsingMaximumConcurrency];
+    
     _subscriptionNetwork = [PNNetwork networkForClient:self
                                         requestTimeout:_configuration.subscribeMaximumIdleTime
-                                    maximumConnections:1 longPoll:YES];
+                                    maximumConnections:1 longPoll:YES transport:transportClass];
+    NSMutableArray *shardNetworks = [NSMutableArray new];
+    for (NSUInteger shardIdx = 1; shardIdx < _configuration.subscribeShardsMaximumCount; shardIdx++) {
+        
+        [shardNetworks addObject:[PNNetwork networkForClient:self
+                                              requestTimeout:_configuration.subscribeMaximumIdleTime
+                                          maximumConnections:1 longPoll:YES transport:transportClass]];
+    }
+    _subscriptionShardNetworks = [shardNetworks copy];
+    
+    // Service network manager schedule requests using lanes and should have enough connections for all of
+    // them.
+    NSInteger serviceConnections = (MAX(_configuration.publishRequestsMaximumConnections, 1) +
+                                    MAX(_configuration.controlRequestsMaximumConnections, 1) +
+                                    MAX(_configuration.bulkReadRequestsMaximumConnections, 1));
     _serviceNetwork = [PNNetwork networkForClient:self
                                    requestTimeout:_configuration.nonSubscribeRequestTimeout
-                               maximumConnections:3 longPoll:NO];
+                               maximumConnections:serviceConnections longPoll:NO transport:transportClass];
 }
 
 
@@ -412,21 +549,50 @@ NS_ASSUME_NONNULL_END
 - (void)processOperation:(PNOperationType)operationType withParameters:(PNRequestParameters *)parameters 
                     data:(nullable NSData *)data completionBlock:(nullable id)block {
     
+    [self processOperation:operationType withParameters:parameters data:data responseDataBlock:nil
+           completionBlock:block];
+}
+
+- (void)processOperation:(PNOperationType)operationType withParameters:(PNRequestParameters *)parameters 
+                    data:(nullable NSData *)data responseDataBlock:(nullable PNNetworkResponseDataBlock)dataBlock
+         completionBlock:(nullable id)block {
+    
     if (operationType == PNSubscribeOperation || operationType == PNUnsubscribeOperation) {
 
-        [self.subscriptionNetwork processOperation:operationType withParameters:parameters
-                                              data:data completionBlock:block];
+        [self.subscriptionNetwork processOperation:operationType withParameters:parameters data:data
+                                 responseDataBlock:dataBlock completionBlock:block];
     }
     else {
 
-        [self.serviceNetwork processOperation:operationType withParameters:parameters
-                                         data:data completionBlock:block];
+        [self.serviceNetwork processOperation:operationType withParameters:parameters data:data
+                            responseDataBlock:dataBlock completionBlock:block];
+    }
+}
+
+- (void)processSubscribeOperationInShard:(NSUInteger)shard withParameters:(PNRequestParameters *)parameters
+                         completionBlock:(PNStatusBlock)block {
+    
+    PNNetwork *network = self.subscriptionNetwork;
+    if (shard > 0 && shard <= self.subscriptionShardNetworks.count) {
+        
+        network = self.subscriptionShardNetworks[shard - 1];
+    }
+    [network processOperation:PNSubscribeOperation withParameters:parameters data:nil completionBlock:block];
+}
+
+- (void)cancelLongPollingOperationsInShard:(NSUInteger)shard {
+    
+    if (shard == 0) { [self.subscriptionNetwork cancelAllRequests]; }
+    else if (shard <= self.subscriptionShardNetworks.count) {
+        
+        [self.subscriptionShardNetworks[shard - 1] cancelAllRequests];
     }
 }
 
 - (void)cancelAllLongPollingOperations {
     
     [self.subscriptionNetwork cancelAllRequests];
+    [self.subscriptionShardNetworks makeObjectsPerformSelector:@selector(cancelAllRequests)];
 }
 
 
@@ -452,6 +618,14 @@ NS_ASSUME_NONNULL_END
     result.origin = self.configuration.origin;
 }
 
+- (void)storeRequestMetrics:(PNRequestMetrics *)metrics {
+    
+    if (metrics && (NSUInteger)metrics.operation < self.metricsHistograms.count) {
+        
+        [self.metricsHistograms[metrics.operation] recordMetrics:metrics];
+    }
+}
+
 
 #pragma mark - Events notification
 
@@ -550,8 +724,13 @@ NS_ASSUME_NONNULL_END
 #endif
     [_subscriptionNetwork invalidate];
     _subscriptionNetwork = nil;
+    [_subscriptionShardNetworks makeObjectsPerformSelector:@selector(invalidate)];
+    _subscriptionShardNetworks = nil;
     [_serviceNetwork invalidate];
     _serviceNetwork = nil;
+#if PN_METRICS_ENABLED
+    free(_metricsCounters);
+#endif // PN_METRICS_ENABLED
 }
 
 #pragma mark -
@@ -3,14 +3,19 @@
 #import "PNClientState.h"
 #import "PNSubscriber.h"
 #import "PNHeartbeat.h"
+#import "PNParsingExecutor.h"
+#import "PNPublishQueue.h"
+#import "PNPresenceIndex.h"
+#import "PNMetricsCounters.h"
 #import "PNLogMacro.h"
+#import "PNNetwork.h"
 #import "PNLog.h"
 
 
 #pragma mark Class forward
 
 @class PNRequestParameters, PNConfiguration, PNClientState, PNStateListener, PNSubscriber,
-       PNHeartbeat, PNResult, PNStatus;
+       PNHeartbeat, PNPublishQueue, PNPresenceIndex, PNRequestMetrics, PNResult, PNStatus;
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -68,6 +73,45 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly, strong) PNHeartbeat *heartbeatManager;
 
+/**
+ @brief      Stores reference on executor which is used by all client's networks to parse and decrypt service
+             responses.
+ @discussion Executor configured with \c parsingQualityOfService and \c parsingMaximumConcurrency values 
+             from client configuration.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, strong) PNParsingExecutor *parsingExecutor;
+
+/**
+ @brief      Stores reference on queue which is used to limit number of simultaneously processed publish 
+             calls and keep messages order for each channel.
+ @discussion Queue configured with \c publishMaximumInFlight value from client configuration.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, strong) PNPublishQueue *publishQueue;
+
+/**
+ @brief      Stores reference on local presence information storage.
+ @discussion Index kept up-to-date with presence events for channels to which client subscribed with
+             presence and used to provide here now information w/o network requests.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, strong) PNPresenceIndex *presenceIndex;
+
+#if PN_METRICS_ENABLED
+/**
+ @brief      Stores pointer on client-wide metrics counters.
+ @discussion Counters should be updated only with \c PNMetrics* macro, so they can be removed from compiled 
+             code.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) PNMetricsCounters *metricsCounters;
+#endif // PN_METRICS_ENABLED
+
 /**
  @brief  Stores reference about recent client state (whether it was connected or not).
  
@@ -140,6 +184,45 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)processOperation:(PNOperationType)operationType withParameters:(PNRequestParameters *)parameters 
                     data:(nullable NSData *)data completionBlock:(nullable id)block;
 
+/**
+ @brief      Compose request to \b PubNub network basing on operation type and passed \c parameters.
+ @discussion \c dataBlock allow to preview raw service response before it will be serialized and parsed.
+
+ @param operationType One of \b PNOperationType enum fields which represent type of operation which be issued 
+                      to \b PubNub network.
+ @param parameters    Resource and query path fields wrapped into object.
+ @param data          Reference on data which should be pushed to \b PubNub network.
+ @param dataBlock     Reference on block which will be called with raw service response data.
+ @param block         Reference on operation processing completion block.
+
+ @since 4.5.0
+ */
+- (void)processOperation:(PNOperationType)operationType withParameters:(PNRequestParameters *)parameters 
+                    data:(nullable NSData *)data responseDataBlock:(nullable PNNetworkResponseDataBlock)dataBlock
+         completionBlock:(nullable id)block;
+
+/**
+ @brief      Send subscribe request using long-poll connection dedicated to specified subscribe shard.
+ @discussion Shard with index \c 0 use same connection as any other subscribe/unsubscribe requests.
+ 
+ @param shard      Index of subscribe shard for which request should be sent.
+ @param parameters Resource and query path fields wrapped into object.
+ @param block      Reference on subscribe request processing completion block.
+ 
+ @since 4.5.0
+ */
+- (void)processSubscribeOperationInShard:(NSUInteger)shard withParameters:(PNRequestParameters *)parameters
+                         completionBlock:(PNStatusBlock)block;
+
+/**
+ @brief  Cancel long-polling operation which is active for specified subscribe shard.
+ 
+ @param shard Index of subscribe shard for which request should be cancelled.
+ 
+ @since 4.5.0
+ */
+- (void)cancelLongPollingOperationsInShard:(NSUInteger)shard;
+
 /**
  @brief  Cancel any active long-polling operations scheduled for processing.
  
@@ -176,6 +259,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)appendClientInformation:(PNResult *)result;
 
+/**
+ @brief      Add completed request metrics to corresponding operation histogram.
+ @discussion Metrics will be ignored in case if histogram collection not enabled.
+ 
+ @param metrics Reference on metrics of request which has been completed.
+ 
+ @since 4.5.0
+ */
+- (void)storeRequestMetrics:(nullable PNRequestMetrics *)metrics;
+
 
 ///------------------------------------------------
 /// @name Events notification
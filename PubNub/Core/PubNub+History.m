@@ -176,6 +176,7 @@ NS_ASSUME_NONNULL_END
 
     if (result && result.serviceData[@"decryptError"]) {
         
+        PNMetricsIncrement(self.metricsCounters, decryptionFailures);
         status = [PNErrorStatus statusForOperation:PNHistoryOperation category:PNDecryptionErrorCategory
                                withProcessingError:nil];
         NSMutableDictionary *updatedData = [result.serviceData mutableCopy];
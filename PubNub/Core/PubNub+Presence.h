@@ -4,7 +4,7 @@
 
 #pragma mark Class forward
 
-@class PNPresenceChannelGroupHereNowResult, PNPresenceChannelHereNowResult,
+@class PNPresenceChannelGroupHereNowResult, PNPresenceChannelHereNowResult, PNPresenceChannelHereNowData,
        PNPresenceGlobalHereNowResult, PNPresenceWhereNowResult, PNErrorStatus;
 
 
@@ -268,6 +268,48 @@ self.client = [PubNub clientWithConfiguration:configuration];
                completion:(PNHereNowCompletionBlock)block;
 
 
+///------------------------------------------------
+/// @name Local here now
+///------------------------------------------------
+
+/**
+ @brief      Retrieve locally stored information about subscribers on specific channel live feeds.
+ @note       Information available only if \b PNConfiguration's \c maintainPresenceIndex is set to \c YES and 
+             only for channels to which client subscribed with presence. It seeded with single 
+             \c -hereNowForChannel:withVerbosity:completion: request when subscription completed and kept 
+             up-to-date using \c join, \c leave, \c timeout, \c state-change and \c interval presence 
+             events, so method doesn't perform any network requests.
+ @discussion \b Example:
+ 
+ @code
+// Client configuration.
+PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo" 
+                                                                 subscribeKey:@"demo"];
+configuration.maintainPresenceIndex = YES;
+self.client = [PubNub clientWithConfiguration:configuration];
+[self.client subscribeToChannels:@[@"pubnub"] withPresence:YES];
+
+// Later, when client connected.
+PNPresenceChannelHereNowData *hereNow = [self.client localHereNowForChannel:@"pubnub"];
+if (hereNow) {
+
+    // Handle local presence information using:
+    //   hereNow.uuids - list of active subscribers. Each entry will have next fields: "uuid" - identifier 
+    //                   and "state" if it has been provided.
+    //   hereNow.occupancy - total number of active subscribers.
+}
+ @endcode
+ 
+ @param channel Reference on channel for which here now information should be retrieved.
+ 
+ @return Presence information in same format as for \c PNHereNowState verbosity level or \c nil in case if 
+         client not subscribed on \c channel presence or here now information not received yet.
+ 
+ @since 4.5.0
+ */
+- (nullable PNPresenceChannelHereNowData *)localHereNowForChannel:(NSString *)channel;
+
+
 ///------------------------------------------------
 /// @name Channel group here now
 ///------------------------------------------------
@@ -5,6 +5,8 @@
  */
 #import "PubNub+PresencePrivate.h"
 #import "PNPrivateStructures.h"
+#import "PNPresenceChannelHereNowResult.h"
+#import "PNServiceData+Private.h"
 #import "PNRequestParameters.h"
 #import "PubNub+CorePrivate.h"
 #import "PNStatus+Private.h"
@@ -84,6 +86,16 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Local here now
+
+- (PNPresenceChannelHereNowData *)localHereNowForChannel:(NSString *)channel {
+    
+    NSDictionary<NSString *, id> *hereNow = (channel ? [self.presenceIndex hereNowForChannel:channel] : nil);
+    
+    return (hereNow ? [PNPresenceChannelHereNowData dataWithServiceResponse:hereNow] : nil);
+}
+
+
 #pragma mark - Channel group here now
 
 - (void)hereNowForChannelGroup:(NSString *)group
@@ -211,15 +223,11 @@ NS_ASSUME_NONNULL_END
             }
             [parameters addQueryParameter:@(self.configuration.presenceHeartbeatValue).stringValue
                              forFieldName:@"heartbeat"];
-            NSDictionary *state = [self.clientStateManager state];
-            if (state.count) {
+            NSString *stateString = [self.clientStateManager JSONState];
+            if (stateString.length) {
                 
-                NSString *stateString = [PNJSON JSONStringFrom:state withError:nil];
-                if (stateString.length) {
-                    
-                    [parameters addQueryParameter:[PNString percentEscapedString:stateString]
-                                     forFieldName:@"state"];
-                }
+                [parameters addQueryParameter:[PNString percentEscapedString:stateString]
+                                 forFieldName:@"state"];
             }
             DDLogAPICall([[self class] ddLogLevel], @"<PubNub::API> Heartbeat for channels %@ and "
                          "groups %@.", [channels componentsJoinedByString:@", "],
@@ -29,6 +29,15 @@ typedef void(^PNPublishCompletionBlock)(PNPublishStatus *status);
  */
 typedef void(^PNMessageSizeCalculationCompletionBlock)(NSInteger size);
 
+/**
+ @brief  Publish queue flush completion block.
+ 
+ @param flushed \c YES in case if all scheduled messages has been processed before timeout.
+ 
+ @since 4.5.0
+ */
+typedef void(^PNPublishFlushCompletionBlock)(BOOL flushed);
+
 
 #pragma mark - API group interface
 
@@ -830,6 +839,34 @@ self.client = [PubNub clientWithConfiguration:configuration];
          completion:(nullable PNPublishCompletionBlock)block;
 
 
+///------------------------------------------------
+/// @name Publish queue
+///------------------------------------------------
+
+/**
+ @brief      Wait for processing completion of all messages which has been passed to publish API.
+ @discussion Can be used before client shutdown to make sure what all scheduled messages has been sent (or 
+             failed). Completion blocks for all published messages called before \c block.
+ @discussion \b Example:
+ 
+ @code
+[self.client flushPublishesWithTimeout:5.f completion:^(BOOL flushed) {
+
+    if (!flushed) {
+        
+        // Some of messages still in queue or wait for service response.
+    }
+}];
+ @endcode
+ 
+ @param timeout For how long client should wait for messages processing completion.
+ @param block   Reference on block which should be called when all messages processed or after timeout.
+ 
+ @since 4.5.0
+ */
+- (void)flushPublishesWithTimeout:(NSTimeInterval)timeout completion:(PNPublishFlushCompletionBlock)block;
+
+
 ///------------------------------------------------
 /// @name Message helper
 ///------------------------------------------------
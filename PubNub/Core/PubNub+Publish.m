@@ -208,10 +208,10 @@ NS_ASSUME_NONNULL_END
          compressed:(BOOL)compressed withMetadata:(nullable NSDictionary<NSString *, id> *)metadata
          completion:(nullable PNPublishCompletionBlock)block {
 
-    // Push further code execution on secondary queue to make service queue responsive during
-    // JSON serialization and encryption process.
+    // Publish queue call task on secondary queue to make service queue responsive during JSON
+    // serialization and encryption process. Messages for same channel sent one after another.
     __weak __typeof(self) weakSelf = self;
-    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    [self.publishQueue enqueueForChannel:(channel?: @"") usingBlock:^(dispatch_block_t completion) {
 
         BOOL encrypted = NO;
         NSError *publishError = nil;
@@ -246,7 +246,9 @@ NS_ASSUME_NONNULL_END
         if (compressed) {
 
             NSData *messageData = [messageForPublish dataUsingEncoding:NSUTF8StringEncoding];
-            NSData *compressedBody = [PNGZIP GZIPDeflatedData:messageData];
+            NSData *compressedBody = [PNGZIP GZIPDeflatedData:messageData
+                                                     withLevel:self.configuration.compressionLevel
+                                                      strategy:self.configuration.compressionStrategy];
             publishData = (compressedBody?: [@"" dataUsingEncoding:NSUTF8StringEncoding]);
         }
         
@@ -258,6 +260,7 @@ NS_ASSUME_NONNULL_END
                      (!compressed ? [NSString stringWithFormat:@": %@",
                                      (messageForPublish?: @"<error>")] : @"."));
 
+        PNMetricsIncrement(self.metricsCounters, publishesInFlight);
         [self processOperation:PNPublishOperation withParameters:parameters data:publishData
                completionBlock:^(PNStatus *status) {
                    
@@ -267,6 +270,7 @@ NS_ASSUME_NONNULL_END
            // it and probably whole client instance has been deallocated.
            #pragma clang diagnostic push
            #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+           PNMetricsDecrement(weakSelf.metricsCounters, publishesInFlight);
            if (status.isError) {
                 
                status.retryBlock = ^{
@@ -277,9 +281,25 @@ NS_ASSUME_NONNULL_END
                };
            }
            [weakSelf callBlock:block status:YES withResult:nil andStatus:status];
+           completion();
            #pragma clang diagnostic pop
        }];
-    });
+    }];
+}
+
+
+#pragma mark - Publish queue
+
+- (void)flushPublishesWithTimeout:(NSTimeInterval)timeout completion:(PNPublishFlushCompletionBlock)block {
+    
+    DDLogAPICall([[self class] ddLogLevel], @"<PubNub::API> Flush publish queue (timeout: %@ seconds).",
+                 @(timeout));
+    
+    dispatch_queue_t callbackQueue = self.callbackQueue;
+    [self.publishQueue flushWithTimeout:timeout completion:^(BOOL flushed) {
+        
+        pn_dispatch_async(callbackQueue, ^{ block(flushed); });
+    }];
 }
 
 
@@ -376,7 +396,9 @@ NS_ASSUME_NONNULL_END
             if (compressMessage) {
                 
                 NSData *messageData = [messageForPublish dataUsingEncoding:NSUTF8StringEncoding];
-                NSData *compressedBody = [PNGZIP GZIPDeflatedData:messageData];
+                NSData *compressedBody = [PNGZIP GZIPDeflatedData:messageData
+                                                         withLevel:self.configuration.compressionLevel
+                                                          strategy:self.configuration.compressionStrategy];
                 publishData = (compressedBody?: [@"" dataUsingEncoding:NSUTF8StringEncoding]);
             }
             NSInteger size = [weakSelf packetSizeForOperation:PNPublishOperation
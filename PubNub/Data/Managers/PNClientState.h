@@ -63,6 +63,45 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSDictionary *)state;
 
+/**
+ @brief      Retrieve current state cache version.
+ @discussion Version changes each time when cached information has been modified. It can be used to 
+             invalidate any data which has been derived from cached state. Version can be retrieved from
+             any thread w/o blocking (it doesn't wait for scheduled state modifications).
+ 
+ @return State cache version.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)version;
+
+/**
+ @brief      Retrieve JSON string with whole state information stored in cache.
+ @discussion Serialized state cached and re-composed only when cache content change. Each object's state 
+             serialized separately and re-encoded only when it has been changed. State of objects on which 
+             client not subscribed at this moment removed from cache before serialization.
+ 
+ @return JSON string or \c nil in case if state cache is empty.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)JSONState;
+
+/**
+ @brief      Merge \c state information into cache and serialize cached state for specified \c objects.
+ @discussion Only \c state entries for names from \c objects merged into cache. Cost depends from number of 
+             changed entries and number of \c objects, not from whole cache size.
+ 
+ @param state   State which should be merged into client state stored in cache.
+ @param objects List of object names for which serialized state should be composed.
+ 
+ @return JSON string or \c nil in case if there is no state for passed \c objects.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)JSONStateMergedWith:(nullable NSDictionary<NSString *, id> *)state
+                                forObjects:(NSArray<NSString *> *)objects;
+
 /**
  @brief  Provide merged client state using new \c state information which should be bound to remote data 
          \c object.
@@ -5,6 +5,7 @@
  */
 #import "PNClientState.h"
 #import "PubNub+CorePrivate.h"
+#import "PNJSON.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -31,6 +32,45 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) NSMutableDictionary<NSString *, id> *stateCache;
 
+/**
+ @brief      Stores current state cache version (changed with each cache modification).
+ @discussion Property modified only from barrier blocks on \c resourceAccessQueue, but it is atomic, so it 
+             can be read from any thread w/o hop on queue.
+ 
+ @since 4.5.0
+ */
+@property (atomic, assign) NSUInteger stateVersion;
+
+/**
+ @brief  Stores names of objects which state has been changed since last serialization.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *dirtyObjects;
+
+/**
+ @brief      Stores object name / serialized state map.
+ @discussion Each entry is JSON object member (\c "name":{...}), so serialized state for any list of objects 
+             can be composed w/o state encoding.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *encodedObjects;
+
+/**
+ @brief  Stores serialized whole state cache.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, copy) NSString *encodedState;
+
+/**
+ @brief  Stores state cache version for which \c encodedState has been composed.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger encodedStateVersion;
+
 /**
  @brief  Stores reference on queue which is used to serialize access to shared client state
          information.
@@ -53,6 +93,48 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)initForClient:(PubNub *)client;
 
+
+#pragma mark - Misc
+
+/**
+ @brief   Update cached state for object and mark it as changed (if new state differ from cached).
+ @warning Method should be called from barrier block on \c resourceAccessQueue.
+ 
+ @param state  State which should replace cached information or \c nil to remove it.
+ @param object Name of the object for which new data should be applied.
+ 
+ @since 4.5.0
+ */
+- (void)storeState:(nullable NSDictionary<NSString *, id> *)state forObject:(NSString *)object;
+
+/**
+ @brief   Serialize state of objects which has been changed since last serialization.
+ @warning Method should be called from barrier block on \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+- (void)encodeDirtyObjects;
+
+/**
+ @brief   Remove cached state of objects on which client not subscribed at this moment.
+ @warning Method should be called from barrier block on \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+- (void)removeStateForUnsubscribedObjects;
+
+/**
+ @brief   Compose JSON object from serialized state of specified objects.
+ @warning Method should be called on \c resourceAccessQueue after \c -encodeDirtyObjects call.
+ 
+ @param objects List of object names for which state should be added.
+ 
+ @return JSON string or \c nil in case if there is no state for passed \c objects.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)JSONStateForObjects:(id <NSFastEnumeration>)objects;
+
 #pragma mark -
 
 
@@ -80,6 +162,8 @@ NS_ASSUME_NONNULL_END
         
         _client = client;
         _stateCache = [NSMutableDictionary new];
+        _dirtyObjects = [NSMutableSet new];
+        _encodedObjects = [NSMutableDictionary new];
         _resourceAccessQueue = dispatch_queue_create("com.pubnub.client-state",
                                                      DISPATCH_QUEUE_CONCURRENT);
     }
@@ -90,6 +174,8 @@ NS_ASSUME_NONNULL_END
 - (void)inheritStateFromState:(PNClientState *)state {
     
     _stateCache = [state.stateCache mutableCopy];
+    [_dirtyObjects addObjectsFromArray:_stateCache.allKeys];
+    _stateVersion++;
 }
 
 
@@ -106,22 +192,79 @@ NS_ASSUME_NONNULL_END
     return state;
 }
 
+- (NSUInteger)version {
+    
+    return self.stateVersion;
+}
+
+- (NSString *)JSONState {
+    
+    __block NSString *encodedState = nil;
+    dispatch_barrier_sync(self.resourceAccessQueue, ^{
+        
+        if (self.encodedStateVersion != self.stateVersion || !self.encodedState) {
+            
+            // State can be set for objects on which client never subscribed, and it shouldn't be sent with
+            // heartbeat requests.
+            [self removeStateForUnsubscribedObjects];
+            [self encodeDirtyObjects];
+            self.encodedState = [self JSONStateForObjects:self.encodedObjects];
+            self.encodedStateVersion = self.stateVersion;
+        }
+        encodedState = self.encodedState;
+    });
+    
+    return encodedState;
+}
+
+- (NSString *)JSONStateMergedWith:(nullable NSDictionary<NSString *, id> *)state
+                       forObjects:(NSArray<NSString *> *)objects {
+    
+    __block NSString *encodedState = nil;
+    dispatch_barrier_sync(self.resourceAccessQueue, ^{
+        
+        if (state.count) {
+            
+            NSSet<NSString *> *objectsSet = [NSSet setWithArray:objects];
+            [state enumerateKeysAndObjectsUsingBlock:^(NSString *objectName, NSDictionary *stateForObject,
+                                                       __unused BOOL *stateEnumeratorStop) {
+                
+                if ([objectsSet containsObject:objectName]) {
+                    
+                    [self storeState:stateForObject forObject:objectName];
+                }
+            }];
+        }
+        [self encodeDirtyObjects];
+        encodedState = [self JSONStateForObjects:objects];
+    });
+    
+    return encodedState;
+}
+
 - (NSDictionary *)stateMergedWith:(nullable NSDictionary<NSString *, id> *)state 
                        forObjects:(NSArray<NSString *> *)objects {
     
-    NSMutableDictionary *mutableState = [([self state]?: @{}) mutableCopy];
-    [state enumerateKeysAndObjectsUsingBlock:^(NSString *objectName, NSDictionary *stateForObject,
-                                               __unused BOOL *stateEnumeratorStop) {
+    NSMutableDictionary *mutableState = [NSMutableDictionary new];
+    dispatch_sync(self.resourceAccessQueue, ^{
         
-        mutableState[objectName] = stateForObject;
-    }];
+        // Lookup only requested objects, so cost doesn't depend from whole cache size.
+        for (NSString *objectName in objects) {
+            
+            id stateForObject = self->_stateCache[objectName];
+            if (stateForObject) { mutableState[objectName] = stateForObject; }
+        }
+    });
     
-    [[mutableState allKeys] enumerateObjectsUsingBlock:^(NSString *objectName,
-                                                         __unused NSUInteger objectNameIdx,
-                                                         __unused BOOL *objectNamesEnumeratorStop) {
+    if (state.count) {
         
-        if (![objects containsObject:objectName]) { [mutableState removeObjectForKey:objectName]; }
-    }];
+        NSSet<NSString *> *objectsSet = [NSSet setWithArray:objects];
+        [state enumerateKeysAndObjectsUsingBlock:^(NSString *objectName, NSDictionary *stateForObject,
+                                                   __unused BOOL *stateEnumeratorStop) {
+            
+            if ([objectsSet containsObject:objectName]) { mutableState[objectName] = stateForObject; }
+        }];
+    }
     
     return [(mutableState.count ? mutableState : nil) copy];
 }
@@ -135,20 +278,11 @@ NS_ASSUME_NONNULL_END
             [state enumerateKeysAndObjectsUsingBlock:^(NSString *objectName, NSDictionary *stateForObject,
                                                        __unused BOOL *stateEnumeratorStop) {
                 
-                self.stateCache[objectName] = stateForObject;
+                [self storeState:stateForObject forObject:objectName];
             }];
             
             // Clean up state cache from objects on which client not subscribed at this moment.
-            NSMutableArray *objects = [NSMutableArray arrayWithArray:[self.stateCache allKeys]];
-            // Silence static analyzer warnings.
-            // Code is aware about this case and at the end will simply call on 'nil' object method.
-            // In most cases if referenced object become 'nil' it mean what there is no more need in
-            // it and probably whole client instance has been deallocated.
-            #pragma clang diagnostic push
-            #pragma clang diagnostic ignored "-Wreceiver-is-weak"
-            [objects removeObjectsInArray:[self.client.subscriberManager allObjects]];
-            #pragma clang diagnostic pop
-            [self removeStateForObjects:objects];
+            [self removeStateForUnsubscribedObjects];
         });
     }
 }
@@ -157,19 +291,90 @@ NS_ASSUME_NONNULL_END
 
     dispatch_barrier_async(self.resourceAccessQueue, ^{
         
-        if (state.count) { self.stateCache[object] = state; }
-        else { [self.stateCache removeObjectForKey:object]; }
+        [self storeState:(state.count ? state : nil) forObject:object];
     });
 }
 
 - (void)removeStateForObjects:(NSArray<NSString *> *)objects {
     
+    if (!objects.count) { return; }
+    
     dispatch_barrier_async(self.resourceAccessQueue, ^{
         
-        if (objects.count) { [self.stateCache removeObjectsForKeys:objects]; }
+        for (NSString *objectName in objects) { [self storeState:nil forObject:objectName]; }
     });
 }
 
+
+#pragma mark - Misc
+
+- (void)storeState:(nullable NSDictionary<NSString *, id> *)state forObject:(NSString *)object {
+    
+    id cachedState = self.stateCache[object];
+    if (cachedState == state || [cachedState isEqual:state]) { return; }
+    
+    if (state) { self.stateCache[object] = state; }
+    else { [self.stateCache removeObjectForKey:object]; }
+    [self.dirtyObjects addObject:object];
+    self.stateVersion++;
+}
+
+- (void)encodeDirtyObjects {
+    
+    for (NSString *objectName in self.dirtyObjects) {
+        
+        id stateForObject = self.stateCache[objectName];
+        NSString *encodedObject = nil;
+        if (stateForObject) {
+            
+            // Serialize single-member object and strip braces to get reusable "name":{...} member.
+            NSString *JSONString = [PNJSON JSONStringFrom:@{objectName: stateForObject} withError:nil];
+            if (JSONString.length > 2) {
+                
+                encodedObject = [JSONString substringWithRange:NSMakeRange(1, JSONString.length - 2)];
+            }
+        }
+        if (encodedObject) { self.encodedObjects[objectName] = encodedObject; }
+        else { [self.encodedObjects removeObjectForKey:objectName]; }
+    }
+    [self.dirtyObjects removeAllObjects];
+}
+
+- (void)removeStateForUnsubscribedObjects {
+    
+    if (!self.stateCache.count) { return; }
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    NSSet<NSString *> *subscribedObjects = [NSSet setWithArray:[self.client.subscriberManager allObjects]];
+    #pragma clang diagnostic pop
+    for (NSString *objectName in self.stateCache.allKeys) {
+        
+        if (![subscribedObjects containsObject:objectName]) { [self storeState:nil forObject:objectName]; }
+    }
+}
+
+- (NSString *)JSONStateForObjects:(id <NSFastEnumeration>)objects {
+    
+    NSMutableString *JSONString = nil;
+    for (NSString *objectName in objects) {
+        
+        NSString *encodedObject = self.encodedObjects[objectName];
+        if (!encodedObject) { continue; }
+        
+        if (!JSONString) { JSONString = [NSMutableString stringWithString:@"{"]; }
+        else { [JSONString appendString:@","]; }
+        [JSONString appendString:encodedObject];
+    }
+    [JSONString appendString:@"}"];
+    
+    return [JSONString copy];
+}
+
 #pragma mark -
 
 
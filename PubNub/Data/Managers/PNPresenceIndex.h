@@ -0,0 +1,121 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class PNPresenceEventResult, PubNub;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Local presence information storage.
+ @discussion Index store occupancy, list of active subscribers and their last known state for each channel
+             for which client receive presence events (subscribed to \c -pnpres channel). Information for
+             channel seeded with single here now request and after that kept up-to-date using presence
+             events from subscribe stream, so it can be provided synchronously and without network calls.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPresenceIndex : NSObject
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct and configure presence index.
+
+ @param client Reference on \b PubNub client for which presence index has been created.
+
+ @return Constructed and ready to use presence index.
+
+ @since 4.5.0
+ */
++ (instancetype)presenceIndexForClient:(PubNub *)client;
+
+/**
+ @brief  Copy presence information from another presence index.
+
+ @param index Reference on presence index from which information should be copied.
+
+ @since 4.5.0
+ */
+- (void)inheritStateFromIndex:(PNPresenceIndex *)index;
+
+
+///------------------------------------------------
+/// @name Channels management
+///------------------------------------------------
+
+/**
+ @brief      Start presence information tracking for specified presence channels.
+ @discussion Here now request will be sent for each channel which is not tracked yet (or which previous
+             here now request did fail). Presence events which arrive while request is in progress will
+             be applied on top of received here now information. Channels tracked only if enabled with 
+             \b PNConfiguration's \c maintainPresenceIndex property.
+
+ @param channels List of presence channels (with \c -pnpres suffix) which should be tracked.
+
+ @since 4.5.0
+ */
+- (void)seedChannels:(NSArray<NSString *> *)channels;
+
+/**
+ @brief      Stop presence information tracking for specified channels.
+ @discussion Only names with \c -pnpres suffix will be processed.
+
+ @param channels List of channels which has been removed from subscription.
+
+ @since 4.5.0
+ */
+- (void)removeChannels:(NSArray<NSString *> *)channels;
+
+/**
+ @brief  Remove presence information for all tracked channels.
+
+ @since 4.5.0
+ */
+- (void)removeAllChannels;
+
+
+///------------------------------------------------
+/// @name Events processing
+///------------------------------------------------
+
+/**
+ @brief  Update presence information of tracked channel using presence event from subscribe stream.
+
+ @param event Reference on presence event which has been received for one of presence channels.
+
+ @since 4.5.0
+ */
+- (void)handlePresenceEvent:(PNPresenceEventResult *)event;
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Retrieve presence information for specified channel.
+
+ @param channel Name of channel for which presence information should be retrieved.
+
+ @return Dictionary in format of here now response (\c occupancy and \c uuids which is list of
+         dictionaries with \c uuid and \c state keys) or \c nil in case if presence information for
+         \c channel not tracked or not seeded yet.
+
+ @since 4.5.0
+ */
+- (nullable NSDictionary<NSString *, id> *)hereNowForChannel:(NSString *)channel;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,452 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNPresenceIndex.h"
+#import "PNPresenceChannelHereNowResult.h"
+#import "PNSubscriberResults.h"
+#import "PubNub+CorePrivate.h"
+#import "PubNub+Presence.h"
+#import "PNConfiguration.h"
+#import "PNErrorStatus.h"
+#import "PNHelpers.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+/**
+ @brief  Presence information for single channel.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPresenceIndexEntry : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores number of active subscribers.
+ */
+@property (nonatomic, assign) NSUInteger occupancy;
+
+/**
+ @brief  Stores list of active subscribers unique identifiers.
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *uuids;
+
+/**
+ @brief  Stores reference on subscriber unique identifier / last known state map.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *states;
+
+/**
+ @brief  Stores time of last applied presence event (used to ignore events which arrived out of order).
+ */
+@property (nonatomic, assign) unsigned long long lastTimetoken;
+
+/**
+ @brief  Stores whether here now information has been received and applied or not.
+ */
+@property (nonatomic, assign, getter = isSeeded) BOOL seeded;
+
+/**
+ @brief  Stores list of presence events which arrived while here now request has been in progress.
+ */
+@property (nonatomic, strong) NSMutableArray<PNPresenceEventData *> *pendingEvents;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Protected interface declaration
+
+@interface PNPresenceIndex ()
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores weak reference on client for which presence index has been created.
+
+ @since 4.5.0
+ */
+@property (nonatomic, weak) PubNub *client;
+
+/**
+ @brief  Stores reference on channel name / presence information map.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, PNPresenceIndexEntry *> *entries;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to presence information.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize and configure presence index.
+
+ @param client Reference on \b PubNub client for which presence index has been created.
+
+ @return Initialized and ready to use presence index.
+
+ @since 4.5.0
+ */
+- (instancetype)initForClient:(PubNub *)client;
+
+
+#pragma mark - Seeding
+
+/**
+ @brief  Send here now request to seed presence information for specified channel.
+
+ @param channel Name of channel (w/o presence suffix) for which presence information should be seeded.
+ @param entry   Reference on entry which has been created for \c channel and should be seeded.
+
+ @since 4.5.0
+ */
+- (void)seedChannel:(NSString *)channel entry:(PNPresenceIndexEntry *)entry;
+
+/**
+ @brief   Replace entry information with here now response and apply events which arrived in between.
+ @warning Method should be called on \c resourceAccessQueue.
+
+ @param data  Reference on here now response data.
+ @param entry Reference on entry which should be seeded.
+
+ @since 4.5.0
+ */
+- (void)applyHereNowData:(PNPresenceChannelHereNowData *)data toEntry:(PNPresenceIndexEntry *)entry;
+
+
+#pragma mark - Events processing
+
+/**
+ @brief   Apply presence event on channel presence information.
+ @warning Method should be called on \c resourceAccessQueue.
+
+ @param event Reference on presence event data which should be applied.
+ @param entry Reference on entry which should be updated.
+
+ @since 4.5.0
+ */
+- (void)applyEvent:(PNPresenceEventData *)event toEntry:(PNPresenceIndexEntry *)entry;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Translate passed list of names to list of tracked channel names.
+
+ @param channels List of channels with or w/o presence suffix.
+ @param presence Whether only names with presence suffix should be taken into account or not.
+
+ @return List of channel names w/o presence suffix.
+
+ @since 4.5.0
+ */
+- (NSArray<NSString *> *)channelsFromNames:(NSArray<NSString *> *)channels onlyPresence:(BOOL)presence;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNPresenceIndexEntry
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+    
+        _uuids = [NSMutableSet new];
+        _states = [NSMutableDictionary new];
+        _pendingEvents = [NSMutableArray new];
+    }
+    
+    return self;
+}
+
+@end
+
+
+@implementation PNPresenceIndex
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)presenceIndexForClient:(PubNub *)client {
+    
+    return [[self alloc] initForClient:client];
+}
+
+- (instancetype)initForClient:(PubNub *)client {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+    
+        _client = client;
+        _entries = [NSMutableDictionary new];
+        _resourceAccessQueue = dispatch_queue_create("com.pubnub.presence-index", DISPATCH_QUEUE_CONCURRENT);
+    }
+    
+    return self;
+}
+
+- (void)inheritStateFromIndex:(PNPresenceIndex *)index {
+    
+    NSMutableDictionary<NSString *, PNPresenceIndexEntry *> *entries = [NSMutableDictionary new];
+    pn_safe_property_read(index.resourceAccessQueue, ^{
+    
+        [index.entries enumerateKeysAndObjectsUsingBlock:^(NSString *channel, PNPresenceIndexEntry *entry,
+                                                           __unused BOOL *stop) {
+    
+            // Entries which still wait for here now response will be seeded by new client.
+            if (!entry.isSeeded) { return; }
+    
+            PNPresenceIndexEntry *entryCopy = [PNPresenceIndexEntry new];
+            entryCopy.occupancy = entry.occupancy;
+            [entryCopy.uuids unionSet:entry.uuids];
+            [entryCopy.states addEntriesFromDictionary:entry.states];
+            entryCopy.lastTimetoken = entry.lastTimetoken;
+            entryCopy.seeded = YES;
+            entries[channel] = entryCopy;
+        }];
+    });
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+    
+        [self.entries addEntriesFromDictionary:entries];
+    });
+}
+
+
+#pragma mark - Channels management
+
+- (void)seedChannels:(NSArray<NSString *> *)channels {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    if (!self.client.configuration.shouldMaintainPresenceIndex) { return; }
+    #pragma clang diagnostic pop
+    
+    NSArray<NSString *> *channelNames = [self channelsFromNames:channels onlyPresence:YES];
+    if (!channelNames.count) { return; }
+    
+    NSMutableDictionary<NSString *, PNPresenceIndexEntry *> *seedEntries = [NSMutableDictionary new];
+    dispatch_barrier_sync(self.resourceAccessQueue, ^{
+    
+        for (NSString *channel in channelNames) {
+    
+            if (self.entries[channel]) { continue; }
+    
+            PNPresenceIndexEntry *entry = [PNPresenceIndexEntry new];
+            self.entries[channel] = entry;
+            seedEntries[channel] = entry;
+        }
+    });
+    [seedEntries enumerateKeysAndObjectsUsingBlock:^(NSString *channel, PNPresenceIndexEntry *entry,
+                                                     __unused BOOL *stop) {
+    
+        [self seedChannel:channel entry:entry];
+    }];
+}
+
+- (void)removeChannels:(NSArray<NSString *> *)channels {
+    
+    NSArray<NSString *> *channelNames = [self channelsFromNames:channels onlyPresence:YES];
+    if (!channelNames.count) { return; }
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+    
+        [self.entries removeObjectsForKeys:channelNames];
+    });
+}
+
+- (void)removeAllChannels {
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+    
+        [self.entries removeAllObjects];
+    });
+}
+
+
+#pragma mark - Seeding
+
+- (void)seedChannel:(NSString *)channel entry:(PNPresenceIndexEntry *)entry {
+    
+    __weak __typeof(self) weakSelf = self;
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    [self.client hereNowForChannel:channel withVerbosity:PNHereNowState
+                        completion:^(PNPresenceChannelHereNowResult *result, PNErrorStatus *status) {
+    
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        pn_safe_property_write(strongSelf.resourceAccessQueue, ^{
+    
+            // Channel could be removed (or re-added) while request has been in progress.
+            if (strongSelf.entries[channel] != entry) { return; }
+    
+            // Failed entry removed, so it will be seeded again with next subscription.
+            if (status.isError || !result) { [strongSelf.entries removeObjectForKey:channel]; }
+            else { [strongSelf applyHereNowData:result.data toEntry:entry]; }
+        });
+    }];
+    #pragma clang diagnostic pop
+}
+
+- (void)applyHereNowData:(PNPresenceChannelHereNowData *)data toEntry:(PNPresenceIndexEntry *)entry {
+    
+    [entry.uuids removeAllObjects];
+    [entry.states removeAllObjects];
+    entry.occupancy = data.occupancy.unsignedIntegerValue;
+    NSArray *uuidsData = ([data.uuids isKindOfClass:[NSArray class]] ? data.uuids : nil);
+    for (id uuidData in uuidsData) {
+    
+        if ([uuidData isKindOfClass:[NSString class]]) { [entry.uuids addObject:uuidData]; }
+        else if ([uuidData isKindOfClass:[NSDictionary class]] && uuidData[@"uuid"]) {
+    
+            [entry.uuids addObject:uuidData[@"uuid"]];
+            if (uuidData[@"state"]) { entry.states[uuidData[@"uuid"]] = uuidData[@"state"]; }
+        }
+    }
+    entry.seeded = YES;
+    
+    // Events which arrived while request has been in progress can be newer than here now response.
+    for (PNPresenceEventData *event in entry.pendingEvents) { [self applyEvent:event toEntry:entry]; }
+    [entry.pendingEvents removeAllObjects];
+}
+
+
+#pragma mark - Events processing
+
+- (void)handlePresenceEvent:(PNPresenceEventResult *)event {
+    
+    PNPresenceEventData *data = event.data;
+    NSString *channel = (data.actualChannel?: data.subscribedChannel);
+    if (!channel) { return; }
+    
+    // Entries stored under channel name w/o presence suffix.
+    channel = [self channelsFromNames:@[channel] onlyPresence:NO].firstObject;
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+    
+        PNPresenceIndexEntry *entry = self.entries[channel];
+        if (!entry) { return; }
+    
+        if (entry.isSeeded) { [self applyEvent:data toEntry:entry]; }
+        else { [entry.pendingEvents addObject:data]; }
+    });
+}
+
+- (void)applyEvent:(PNPresenceEventData *)event toEntry:(PNPresenceIndexEntry *)entry {
+    
+    PNPresenceDetailsData *presence = event.presence;
+    unsigned long long timetoken = presence.timetoken.unsignedLongLongValue;
+    if (timetoken < entry.lastTimetoken) { return; }
+    entry.lastTimetoken = timetoken;
+    
+    NSString *type = event.presenceEvent;
+    NSString *uuid = presence.uuid;
+    if ([type isEqualToString:@"state-change"]) {
+    
+        if (!uuid) { return; }
+        [entry.uuids addObject:uuid];
+        if (presence.state) { entry.states[uuid] = presence.state; }
+        else { [entry.states removeObjectForKey:uuid]; }
+        return;
+    }
+    
+    if (uuid && [type isEqualToString:@"join"]) {
+    
+        [entry.uuids addObject:uuid];
+        if (presence.state) { entry.states[uuid] = presence.state; }
+    }
+    else if (uuid && ([type isEqualToString:@"leave"] || [type isEqualToString:@"timeout"])) {
+    
+        [entry.uuids removeObject:uuid];
+        [entry.states removeObjectForKey:uuid];
+    }
+    else if ([type isEqualToString:@"interval"]) {
+    
+        // Interval event carry changes which has been accumulated since previous interval event.
+        [entry.uuids addObjectsFromArray:(presence.join?: @[])];
+        for (NSString *leftUUID in [(presence.leave?: @[]) arrayByAddingObjectsFromArray:(presence.timeout?: @[])]) {
+    
+            [entry.uuids removeObject:leftUUID];
+            [entry.states removeObjectForKey:leftUUID];
+        }
+    }
+    entry.occupancy = presence.occupancy.unsignedIntegerValue;
+}
+
+
+#pragma mark - Information
+
+- (NSDictionary<NSString *, id> *)hereNowForChannel:(NSString *)channel {
+    
+    NSString *channelName = [self channelsFromNames:@[channel] onlyPresence:NO].firstObject;
+    __block NSDictionary<NSString *, id> *hereNow = nil;
+    pn_safe_property_read(self.resourceAccessQueue, ^{
+    
+        PNPresenceIndexEntry *entry = self.entries[channelName];
+        if (!entry.isSeeded) { return; }
+    
+        NSMutableArray<NSDictionary *> *uuids = [[NSMutableArray alloc] initWithCapacity:entry.uuids.count];
+        for (NSString *uuid in entry.uuids) {
+    
+            NSDictionary *state = entry.states[uuid];
+            [uuids addObject:(state ? @{@"uuid": uuid, @"state": state} : @{@"uuid": uuid})];
+        }
+        hereNow = @{@"occupancy": @(entry.occupancy), @"uuids": uuids};
+    });
+    
+    return hereNow;
+}
+
+
+#pragma mark - Misc
+
+- (NSArray<NSString *> *)channelsFromNames:(NSArray<NSString *> *)channels onlyPresence:(BOOL)presence {
+    
+    NSMutableArray<NSString *> *channelNames = [[NSMutableArray alloc] initWithCapacity:channels.count];
+    for (NSString *channel in channels) {
+    
+        BOOL isPresenceChannel = [PNChannel isPresenceObject:channel];
+        if (isPresenceChannel) { [channelNames addObject:[PNChannel channelForPresence:channel]]; }
+        else if (!presence) { [channelNames addObject:channel]; }
+    }
+    
+    return channelNames;
+}
+
+#pragma mark -
+
+
+@end
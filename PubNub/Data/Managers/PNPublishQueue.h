@@ -0,0 +1,89 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class PubNub;
+
+
+#pragma mark - Types
+
+/**
+ @brief      Publish task which is called by queue when it's turn come.
+ @discussion Task should call passed \c completion block when publish request processing will be completed, 
+             so queue will be able to send next message for same channel.
+ 
+ @param completion Reference on block which should be called at the end of publish request processing.
+ 
+ @since 4.5.0
+ */
+typedef void(^PNPublishQueueTaskBlock)(dispatch_block_t completion);
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Publish calls queue used by client to limit number of simultaneously processed messages.
+ @discussion Queue keep order of messages for each channel (message sent only after previous message for 
+             same channel has been processed) and process messages for different channels in parallel. 
+             Number of messages which can be processed at the same time limited by \c publishMaximumInFlight 
+             from client configuration.
+ 
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPublishQueue : NSObject
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct and configure publish queue.
+ 
+ @param client Reference on \b PubNub client for which publish queue has been created.
+ 
+ @return Constructed and ready to use publish queue.
+ 
+ @since 4.5.0
+ */
++ (instancetype)publishQueueForClient:(PubNub *)client;
+
+
+///------------------------------------------------
+/// @name Processing
+///------------------------------------------------
+
+/**
+ @brief      Schedule publish task for specified channel.
+ @discussion Task will be called on global queue after all tasks which has been scheduled for same channel 
+             before it will be completed and there will be free slot for in-flight publish.
+ 
+ @param channel Name of channel to which message will be published by task.
+ @param block   Reference on block which will process publish request.
+ 
+ @since 4.5.0
+ */
+- (void)enqueueForChannel:(NSString *)channel usingBlock:(PNPublishQueueTaskBlock)block;
+
+/**
+ @brief      Wait for completion of all scheduled and in-flight publish tasks.
+ @discussion Tasks which will be scheduled while queue wait for flush also should be completed before 
+             \c block will be called with positive result.
+ 
+ @param timeout For how long queue should wait for tasks completion.
+ @param block   Reference on block which is called on private queue with \c YES in case if all tasks has 
+                been completed or \c NO in case if wait timed out.
+ 
+ @since 4.5.0
+ */
+- (void)flushWithTimeout:(NSTimeInterval)timeout completion:(void(^)(BOOL flushed))block;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
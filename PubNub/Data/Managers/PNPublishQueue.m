@@ -0,0 +1,311 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNPublishQueue.h"
+#import "PubNub+CorePrivate.h"
+#import "PNConfiguration.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+/**
+ @brief  Wrapper for publish task which is scheduled in queue.
+ 
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPublishQueueTask : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on block which will process publish request.
+ */
+@property (nonatomic, copy) PNPublishQueueTaskBlock block;
+
+/**
+ @brief  Stores date when task has been scheduled (used for wait time calculation).
+ */
+@property (nonatomic, assign) CFAbsoluteTime enqueueTime;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Protected interface declaration
+
+@interface PNPublishQueue ()
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores weak reference on client for which publish queue has been created.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, weak) PubNub *client;
+
+/**
+ @brief  Stores maximum number of publish tasks which can be processed at the same time.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger maximumInFlight;
+
+/**
+ @brief  Stores number of publish tasks which is processed at this moment.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger inFlightCount;
+
+/**
+ @brief  Stores number of publish tasks which wait for their turn.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger pendingTasksCount;
+
+/**
+ @brief  Stores reference on channel name / FIFO list of scheduled tasks map.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<PNPublishQueueTask *> *> *pendingTasks;
+
+/**
+ @brief  Stores list of channels which has pending tasks and doesn't have task in-flight (in order in which 
+         they became ready).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<NSString *> *readyChannels;
+
+/**
+ @brief  Stores list of channels for which publish task is processed at this moment.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *activeChannels;
+
+/**
+ @brief  Stores list of blocks which wait for queue flush.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<void(^)(BOOL flushed)> *flushBlocks;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to queue information.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize and configure publish queue.
+ 
+ @param client Reference on \b PubNub client for which publish queue has been created.
+ 
+ @return Initialized and ready to use publish queue.
+ 
+ @since 4.5.0
+ */
+- (instancetype)initForClient:(PubNub *)client;
+
+
+#pragma mark - Processing
+
+/**
+ @brief   Launch as many ready tasks as allowed by in-flight limit.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+- (void)processReadyTasks;
+
+/**
+ @brief   Handle publish task completion for specified channel.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @param channel Name of channel for which task has been completed.
+ 
+ @since 4.5.0
+ */
+- (void)handleTaskCompletionForChannel:(NSString *)channel;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNPublishQueueTask
+
+@end
+
+
+@implementation PNPublishQueue
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)publishQueueForClient:(PubNub *)client {
+    
+    return [[self alloc] initForClient:client];
+}
+
+- (instancetype)initForClient:(PubNub *)client {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _client = client;
+        _maximumInFlight = MAX(client.configuration.publishMaximumInFlight, (NSUInteger)1);
+        _pendingTasks = [NSMutableDictionary new];
+        _readyChannels = [NSMutableArray new];
+        _activeChannels = [NSMutableSet new];
+        _flushBlocks = [NSMutableArray new];
+        _resourceAccessQueue = dispatch_queue_create("com.pubnub.publish-queue", DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Processing
+
+- (void)enqueueForChannel:(NSString *)channel usingBlock:(PNPublishQueueTaskBlock)block {
+    
+    PNPublishQueueTask *task = [PNPublishQueueTask new];
+    task.block = block;
+    task.enqueueTime = CFAbsoluteTimeGetCurrent();
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        NSMutableArray<PNPublishQueueTask *> *tasks = self.pendingTasks[channel];
+        if (!tasks) {
+            
+            tasks = [NSMutableArray new];
+            self.pendingTasks[channel] = tasks;
+        }
+        [tasks addObject:task];
+        self.pendingTasksCount++;
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        PNMetricsIncrement(self.client.metricsCounters, publishQueueDepth);
+        #pragma clang diagnostic pop
+        
+        // Channel with in-flight task will become ready when that task will be completed.
+        if (tasks.count == 1 && ![self.activeChannels containsObject:channel]) {
+            
+            [self.readyChannels addObject:channel];
+        }
+        [self processReadyTasks];
+    });
+}
+
+- (void)flushWithTimeout:(NSTimeInterval)timeout completion:(void(^)(BOOL flushed))block {
+    
+    void(^flushBlock)(BOOL flushed) = [block copy];
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        if (!self.inFlightCount && !self.pendingTasksCount) {
+            
+            flushBlock(YES);
+            return;
+        }
+        
+        [self.flushBlocks addObject:flushBlock];
+        dispatch_time_t timeoutTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC));
+        dispatch_after(timeoutTime, self.resourceAccessQueue, ^{
+            
+            // Block already has been called if queue has been flushed before timeout.
+            if ([self.flushBlocks indexOfObjectIdenticalTo:flushBlock] != NSNotFound) {
+                
+                [self.flushBlocks removeObjectIdenticalTo:flushBlock];
+                flushBlock(NO);
+            }
+        });
+    });
+}
+
+- (void)processReadyTasks {
+    
+    while (self.inFlightCount < self.maximumInFlight && self.readyChannels.count) {
+        
+        NSString *channel = self.readyChannels.firstObject;
+        [self.readyChannels removeObjectAtIndex:0];
+        NSMutableArray<PNPublishQueueTask *> *tasks = self.pendingTasks[channel];
+        PNPublishQueueTask *task = tasks.firstObject;
+        [tasks removeObjectAtIndex:0];
+        if (!tasks.count) { [self.pendingTasks removeObjectForKey:channel]; }
+        self.pendingTasksCount--;
+        self.inFlightCount++;
+        [self.activeChannels addObject:channel];
+        
+#if PN_METRICS_ENABLED
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        PNMetricsCounters *counters = self.client.metricsCounters;
+        #pragma clang diagnostic pop
+        int64_t wait = (int64_t)((CFAbsoluteTimeGetCurrent() - task.enqueueTime) * 1000000.f);
+        PNMetricsDecrement(counters, publishQueueDepth);
+        PNMetricsIncrement(counters, publishQueueWaits);
+        PNMetricsAdd(counters, publishQueueWait, wait);
+        PNMetricsStore(counters, lastPublishQueueWait, wait);
+#endif // PN_METRICS_ENABLED
+        
+        // Serialization and encryption done outside of queue to keep it responsive.
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            
+            task.block(^{
+                
+                dispatch_async(self.resourceAccessQueue, ^{ [self handleTaskCompletionForChannel:channel]; });
+            });
+        });
+    }
+    
+    if (!self.inFlightCount && !self.pendingTasksCount && self.flushBlocks.count) {
+        
+        NSArray<void(^)(BOOL flushed)> *flushBlocks = [self.flushBlocks copy];
+        [self.flushBlocks removeAllObjects];
+        for (void(^flushBlock)(BOOL flushed) in flushBlocks) { flushBlock(YES); }
+    }
+}
+
+- (void)handleTaskCompletionForChannel:(NSString *)channel {
+    
+    self.inFlightCount--;
+    [self.activeChannels removeObject:channel];
+    if (self.pendingTasks[channel].count) { [self.readyChannels addObject:channel]; }
+    [self processReadyTasks];
+}
+
+#pragma mark -
+
+
+@end
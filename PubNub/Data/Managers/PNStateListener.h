@@ -50,6 +50,19 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)inheritStateFromListener:(PNStateListener *)listener;
 
 
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief      Stores number of serial workers which is used to process and deliver events.
+ @discussion \b 0 in case if client configured to process events on single queue.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSUInteger eventsProcessingWorkersCount;
+
+
 ///------------------------------------------------
 /// @name Listeners list modification
 ///------------------------------------------------
@@ -111,6 +124,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)notifyMessage:(PNMessageResult *)message;
 
+/**
+ @brief      Notify all message listeners about batch of new messages.
+ @discussion Whole batch delivered with single hop to callback queue. Listeners which implement batch 
+             callback receive whole list, rest of listeners receive messages one-by-one.
+ @warning    Method should be called within \b -notifyWithBlock: block to shift execution to private 
+             protected queue.
+ 
+ @param messages List of event objects which provide information about operation type and service response 
+                 for it.
+ 
+ @since 4.5.0
+ */
+- (void)notifyMessages:(NSArray<PNMessageResult *> *)messages;
+
 /**
  @brief   Notify all presence event listeners about new event.
  @warning Method should be called within \b -notifyWithBlock: block to shift execution to private 
@@ -123,6 +150,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)notifyPresenceEvent:(PNPresenceEventResult *)event;
 
+/**
+ @brief      Notify all presence event listeners about batch of new events.
+ @discussion Whole batch delivered with single hop to callback queue. Listeners which implement batch 
+             callback receive whole list, rest of listeners receive events one-by-one.
+ @warning    Method should be called within \b -notifyWithBlock: block to shift execution to private 
+             protected queue.
+ 
+ @param events List of event objects which provide information about operation type and service response 
+               for it.
+ 
+ @since 4.5.0
+ */
+- (void)notifyPresenceEvents:(NSArray<PNPresenceEventResult *> *)events;
+
 /**
  @brief   Notify all state change listeners about changes in subscriber state.
  @warning Method should be called within \b -notifyWithBlock: block to shift execution to private 
@@ -143,6 +184,60 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)notifyHeartbeatStatus:(PNStatus *)status;
 
+/**
+ @brief      Schedule block which should be called when listeners will take buffered events for delivery.
+ @discussion Used by subscriber to defer next long-poll request when events delivery buffer overflown and 
+             \b PNBlockSubscribeLoopBufferPolicy is used or when events processing workers has too many 
+             scheduled blocks. Block scheduled on \c queue right away when there is nothing to wait for.
+             Calling thread never blocked.
+ 
+ @param block Reference on block which should be called when there is space in events delivery buffer.
+ @param queue Reference on queue on which \c block should be called.
+ 
+ @since 4.5.0
+ */
+- (void)performWhenDeliveryBufferHasSpace:(dispatch_block_t)block onQueue:(dispatch_queue_t)queue;
+
+
+///------------------------------------------------
+/// @name Workers
+///------------------------------------------------
+
+/**
+ @brief      Find out which worker should process events from specified channel.
+ @discussion Same worker returned for same channel, so events from it will be processed in order.
+ 
+ @param channel Name of channel from which event has been received.
+ 
+ @return Index of worker which should be passed to \b -notifyOnWorker:withBlock:.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)workerForChannel:(NSString *)channel;
+
+/**
+ @brief  Shift execution context to specified events processing worker queue.
+ 
+ @param worker Index of worker which has been received from \b -workerForChannel:.
+ @param block  Reference on block which will be called on worker queue.
+ 
+ @since 4.5.0
+ */
+- (void)notifyOnWorker:(NSUInteger)worker withBlock:(dispatch_block_t)block;
+
+/**
+ @brief      Deliver batch of messages and presence events to listeners right away on current queue.
+ @discussion Used by events processing workers, so events from different channels delivered in parallel.
+ @warning    Method should be called within \b -notifyOnWorker:withBlock: block.
+ 
+ @param messages List of messages which should be delivered to listeners.
+ @param events   List of presence events which should be delivered to listeners.
+ 
+ @since 4.5.0
+ */
+- (void)deliverMessages:(NSArray<PNMessageResult *> *)messages
+         presenceEvents:(NSArray<PNPresenceEventResult *> *)events;
+
 #pragma mark -
 
 
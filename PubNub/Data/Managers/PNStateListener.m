@@ -6,13 +6,77 @@
 #import "PNStateListener.h"
 #import "PNObjectEventListener.h"
 #import "PubNub+CorePrivate.h"
+#import "PNSubscriberResults.h"
+#import "PNErrorStatus+Private.h"
 #import "PNSubscribeStatus.h"
+#import "PNResult+Private.h"
+#import "PNStatus+Private.h"
+#import "PNConfiguration.h"
 #import "PNHelpers.h"
+#import <libkern/OSAtomic.h>
+
+
+#pragma mark Static
+
+/**
+ @brief      Maximum number of events which is delivered between time budget checks.
+ @discussion Used only when events delivery time slicing enabled.
+ 
+ @since 4.5.0
+ */
+static NSUInteger const kPNEventsDeliveryChunkSize = 16;
+
+/**
+ @brief      Maximum number of scheduled blocks per events processing worker.
+ @discussion When workers has more scheduled blocks, subscribe loop will be suspended till they catch up.
+ 
+ @since 4.5.0
+ */
+static int32_t const kPNEventsProcessingWorkerBacklog = 8;
 
 
 NS_ASSUME_NONNULL_BEGIN
 
-#pragma mark Protected interface declaration
+#pragma mark - Private interface declaration
+
+/**
+ @brief      Weak reference on registered listener which is stored in listeners snapshots.
+ @discussion Snapshot doesn't retain listeners, so they can be deallocated w/o \c -removeListener: call (in 
+             this case reference will return \c nil and snapshot will be rebuilt).
+ 
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNListenerReference : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores weak reference on listener object.
+ */
+@property (nonatomic, nullable, weak) id <PNObjectEventListener> listener;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Construct reference for listener.
+ 
+ @param listener Reference on listener for which reference should be created.
+ 
+ @return Constructed and ready to use listener reference.
+ */
++ (instancetype)referenceWithListener:(id <PNObjectEventListener>)listener;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Protected interface declaration
 
 @interface PNStateListener ()
 
@@ -46,6 +110,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) NSHashTable<id <PNObjectEventListener>> *presenceEventListeners;
 
+/**
+ @brief  Stores list of listeners which would like to receive new messages in batches (all messages from 
+         single subscribe response).
+ 
+ @return Hash table with list of new messages batch listeners.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSHashTable<id <PNObjectEventListener>> *messagesBatchListeners;
+
+/**
+ @brief  Stores list of listeners which would like to receive presence events in batches (all events from 
+         single subscribe response).
+ 
+ @return Hash table with list of presence events batch listeners.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSHashTable<id <PNObjectEventListener>> *presenceEventsBatchListeners;
+
 
 /**
  @brief  Stores list of listeners which would like to be notified when on subscription state changes 
@@ -55,6 +139,101 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) NSHashTable<id <PNObjectEventListener>> *stateListeners;
 
+/**
+ @brief      Stores immutable snapshot of \c messageListeners.
+ @discussion Snapshots rebuilt only when listeners list changes (or some of listeners has been deallocated) 
+             and replaced as whole on \c resourceAccessQueue, so notification doesn't need to copy listeners 
+             list for each event. Snapshots are atomic because events processing workers read them from 
+             their own queues.
+ 
+ @since 4.5.0
+ */
+@property (atomic, copy) NSArray<PNListenerReference *> *messageListenersSnapshot;
+
+/**
+ @brief  Stores immutable snapshot of \c presenceEventListeners.
+ 
+ @since 4.5.0
+ */
+@property (atomic, copy) NSArray<PNListenerReference *> *presenceEventListenersSnapshot;
+
+/**
+ @brief  Stores immutable snapshot of \c messagesBatchListeners.
+ 
+ @since 4.5.0
+ */
+@property (atomic, copy) NSArray<PNListenerReference *> *messagesBatchListenersSnapshot;
+
+/**
+ @brief  Stores immutable snapshot of \c presenceEventsBatchListeners.
+ 
+ @since 4.5.0
+ */
+@property (atomic, copy) NSArray<PNListenerReference *> *presenceEventsBatchListenersSnapshot;
+
+/**
+ @brief  Stores immutable snapshot of \c stateListeners.
+ 
+ @since 4.5.0
+ */
+@property (atomic, copy) NSArray<PNListenerReference *> *stateListenersSnapshot;
+
+/**
+ @brief      Stores list of received messages and presence events which wait for delivery to listeners.
+ @discussion Buffer size limited by \c eventsDeliveryBufferCapacity client configuration and events handled 
+             according to \c eventsDeliveryBufferPolicy when it overflown.
+ @warning    Should be accessed only from \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<PNResult *> *pendingEvents;
+
+/**
+ @brief  Stores whether block which deliver \c pendingEvents already scheduled on callback queue or not.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign, getter = isDeliveryScheduled) BOOL deliveryScheduled;
+
+/**
+ @brief  Stores number of events which has been dropped because of buffer overflow since last report.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger droppedEventsCount;
+
+/**
+ @brief  Stores how many times buffer has been overflown since last report.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger overflowsCount;
+
+/**
+ @brief      Stores list of blocks which wait for free space in events delivery buffer.
+ @discussion Blocks called each time when buffered events has been taken for delivery or workers made 
+             progress and there is enough space.
+ @warning    Should be accessed only from \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<dispatch_block_t> *spaceAwaitingBlocks;
+
+/**
+ @brief      Stores list of serial queues which is used to process and deliver events in parallel.
+ @discussion List is empty if client not configured to use events processing workers.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSArray<dispatch_queue_t> *workerQueues;
+
+/**
+ @brief  Stores number of blocks which has been scheduled on events processing workers and not completed yet.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) int32_t pendingWorkerBlocks;
+
 /**
  @brief  Stores reference on queue which is used to serialize access to shared listener information.
  
@@ -77,8 +256,125 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initForClient:(PubNub *)client;
 
 
+#pragma mark - Listeners list modification
+
+/**
+ @brief   Rebuild listeners snapshots from current listeners lists.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+- (void)updateSnapshots;
+
+/**
+ @brief  Build list of weak references for listeners from passed table.
+ 
+ @param listeners Reference on table with listeners for which snapshot should be created.
+ 
+ @return Immutable list of listener references.
+ 
+ @since 4.5.0
+ */
+- (NSArray<PNListenerReference *> *)snapshotForListeners:(NSHashTable<id <PNObjectEventListener>> *)listeners;
+
+/**
+ @brief      Rebuild snapshots to get rid of references on deallocated listeners.
+ @discussion Called by notification code when it find out what one of listeners has been deallocated w/o 
+             removal.
+ 
+ @since 4.5.0
+ */
+- (void)pruneReleasedListeners;
+
+
 #pragma mark - Notification
 
+/**
+ @brief      Add received events to delivery buffer and schedule delivery (if required).
+ @discussion In case if buffer overflown, events handled according to \c eventsDeliveryBufferPolicy.
+ @warning    Method should be called on \c resourceAccessQueue.
+ 
+ @param events List of messages and presence events which should be delivered to listeners.
+ 
+ @since 4.5.0
+ */
+- (void)enqueueEvents:(NSArray<PNResult *> *)events;
+
+/**
+ @brief   Drop buffered events using specified policy till buffer will fit into capacity.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @param capacity Maximum number of events which can be stored in buffer.
+ @param policy   Policy which should be used to pick events which should be dropped.
+ 
+ @since 4.5.0
+ */
+- (void)shrinkPendingEventsToCapacity:(NSUInteger)capacity usingPolicy:(PNEventsDeliveryBufferPolicy)policy;
+
+/**
+ @brief  Compose key which is used to find out events which replace each other.
+ 
+ @param event  Reference on message or presence event for which key should be composed.
+ @param policy Policy which is used to shrink buffer.
+ 
+ @return Key or \c nil in case if event can't be replaced by newer events.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)coalescingKeyForEvent:(PNResult *)event usingPolicy:(PNEventsDeliveryBufferPolicy)policy;
+
+/**
+ @brief      Deliver buffered events to listeners.
+ @discussion Method called on callback queue. If client configured with \c eventsDeliverySliceDuration or 
+             \c eventsDeliverySliceMaximumCount, method deliver only single slice of buffered events and 
+             schedule delivery of the rest with new block on callback queue.
+ 
+ @since 4.5.0
+ */
+- (void)deliverBufferedEvents;
+
+/**
+ @brief      Take oldest buffered events and deliver them to listeners.
+ @discussion Method called on callback queue.
+ 
+ @param maximumCount   Maximum number of buffered events which can be delivered.
+ @param client         Reference on client which is passed to listeners.
+ @param deliveredCount Reference on variable which will store number of delivered events.
+ @param remainingCount Reference on variable which will store number of events which left in buffer.
+ 
+ @return Whether some of listeners has been deallocated w/o removal or not.
+ 
+ @since 4.5.0
+ */
+- (BOOL)deliverBufferedEvents:(NSUInteger)maximumCount toClient:(nullable PubNub *)client
+                    delivered:(NSUInteger *)deliveredCount remaining:(NSUInteger *)remainingCount;
+
+/**
+ @brief      Deliver messages and presence events to listeners on current queue.
+ @discussion Listeners snapshots are atomic, so method can be called from any queue.
+ 
+ @param messages List of messages which should be delivered to listeners.
+ @param events   List of presence events which should be delivered to listeners.
+ @param client   Reference on client which is passed to listeners.
+ 
+ @return Whether some of listeners has been deallocated w/o removal or not.
+ 
+ @since 4.5.0
+ */
+- (BOOL)deliverMessages:(NSArray<PNMessageResult *> *)messages
+         presenceEvents:(NSArray<PNPresenceEventResult *> *)events toClient:(nullable PubNub *)client;
+
+/**
+ @brief   Notify state listeners about events delivery buffer overflow.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @param droppedEventsCount Number of events which has been dropped since last report.
+ @param overflowsCount     How many times buffer has been overflown since last report.
+ 
+ @since 4.5.0
+ */
+- (void)notifyOverflowWithDroppedEvents:(NSUInteger)droppedEventsCount overflows:(NSUInteger)overflowsCount;
+
 /**
  @brief  Notify all status event change subscriber about new event.
  
@@ -86,6 +382,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)notifyStatusObservers:(PNStatus *)status;
 
+
+#pragma mark - Delivery buffer
+
+/**
+ @brief  Check whether delivery buffer should be checked for free space before subscribe loop continue.
+ 
+ @return \c YES in case if \b PNBlockSubscribeLoopBufferPolicy used with limited buffer or events processing 
+         workers used.
+ 
+ @since 4.5.0
+ */
+- (BOOL)isDeliveryBufferLimited;
+
+/**
+ @brief   Check whether listeners and events processing workers can accept more events.
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @return \c YES in case if there is space in events delivery buffer and workers' backlog.
+ 
+ @since 4.5.0
+ */
+- (BOOL)hasDeliveryBufferSpace;
+
+/**
+ @brief   Call blocks which wait for free space in events delivery buffer (if there is enough space).
+ @warning Method should be called on \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+- (void)performSpaceAwaitingBlocksIfPossible;
+
 #pragma mark -
 
 
@@ -96,6 +423,25 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark - Interface implementation
 
+@implementation PNListenerReference
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)referenceWithListener:(id <PNObjectEventListener>)listener {
+    
+    PNListenerReference *reference = [self new];
+    reference.listener = listener;
+    
+    return reference;
+}
+
+#pragma mark -
+
+
+@end
+
+
 @implementation PNStateListener
 
 
@@ -114,7 +460,25 @@ NS_ASSUME_NONNULL_END
         _client = client;
         _messageListeners = [NSHashTable weakObjectsHashTable];
         _presenceEventListeners = [NSHashTable weakObjectsHashTable];
+        _messagesBatchListeners = [NSHashTable weakObjectsHashTable];
+        _presenceEventsBatchListeners = [NSHashTable weakObjectsHashTable];
         _stateListeners = [NSHashTable weakObjectsHashTable];
+        _messageListenersSnapshot = @[];
+        _presenceEventListenersSnapshot = @[];
+        _messagesBatchListenersSnapshot = @[];
+        _presenceEventsBatchListenersSnapshot = @[];
+        _stateListenersSnapshot = @[];
+        _pendingEvents = [NSMutableArray new];
+        _spaceAwaitingBlocks = [NSMutableArray new];
+        
+        NSUInteger workersCount = client.configuration.eventsProcessingWorkersCount;
+        NSMutableArray<dispatch_queue_t> *workerQueues = [NSMutableArray arrayWithCapacity:workersCount];
+        for (NSUInteger workerIdx = 0; workerIdx < workersCount; workerIdx++) {
+            
+            NSString *label = [NSString stringWithFormat:@"com.pubnub.listener.worker.%@", @(workerIdx)];
+            [workerQueues addObject:dispatch_queue_create(label.UTF8String, DISPATCH_QUEUE_SERIAL)];
+        }
+        _workerQueues = [workerQueues copy];
         _resourceAccessQueue = dispatch_queue_create("com.pubnub.listener", DISPATCH_QUEUE_SERIAL);
     }
     
@@ -125,7 +489,18 @@ NS_ASSUME_NONNULL_END
     
     _messageListeners = [listener.messageListeners mutableCopy];
     _presenceEventListeners = [listener.presenceEventListeners mutableCopy];
+    _messagesBatchListeners = [listener.messagesBatchListeners mutableCopy];
+    _presenceEventsBatchListeners = [listener.presenceEventsBatchListeners mutableCopy];
     _stateListeners = [listener.stateListeners mutableCopy];
+    dispatch_async(self.resourceAccessQueue, ^{ [self updateSnapshots]; });
+}
+
+
+#pragma mark - Information
+
+- (NSUInteger)eventsProcessingWorkersCount {
+    
+    return self.workerQueues.count;
 }
 
 
@@ -135,11 +510,20 @@ NS_ASSUME_NONNULL_END
     
     dispatch_async(self.resourceAccessQueue, ^{
         
-        if ([listener respondsToSelector:@selector(client:didReceiveMessage:)]) {
+        // Batch callbacks take precedence over single event callbacks.
+        if ([listener respondsToSelector:@selector(client:didReceiveMessages:)]) {
+            
+            [self.messagesBatchListeners addObject:listener];
+        }
+        else if ([listener respondsToSelector:@selector(client:didReceiveMessage:)]) {
             
             [self.messageListeners addObject:listener];
         }
-        if ([listener respondsToSelector:@selector(client:didReceivePresenceEvent:)]) {
+        if ([listener respondsToSelector:@selector(client:didReceivePresenceEvents:)]) {
+            
+            [self.presenceEventsBatchListeners addObject:listener];
+        }
+        else if ([listener respondsToSelector:@selector(client:didReceivePresenceEvent:)]) {
             
             [self.presenceEventListeners addObject:listener];
         }
@@ -148,6 +532,7 @@ NS_ASSUME_NONNULL_END
             
             [self.stateListeners addObject:listener];
         }
+        [self updateSnapshots];
     });
 }
 
@@ -157,7 +542,10 @@ NS_ASSUME_NONNULL_END
         
         [self.messageListeners removeObject:listener];
         [self.presenceEventListeners removeObject:listener];
+        [self.messagesBatchListeners removeObject:listener];
+        [self.presenceEventsBatchListeners removeObject:listener];
         [self.stateListeners removeObject:listener];
+        [self updateSnapshots];
     });
 }
 
@@ -167,10 +555,38 @@ NS_ASSUME_NONNULL_END
             
         [self.messageListeners removeAllObjects];
         [self.presenceEventListeners removeAllObjects];
+        [self.messagesBatchListeners removeAllObjects];
+        [self.presenceEventsBatchListeners removeAllObjects];
         [self.stateListeners removeAllObjects];
+        [self updateSnapshots];
     });
 }
 
+- (void)updateSnapshots {
+    
+    self.messageListenersSnapshot = [self snapshotForListeners:self.messageListeners];
+    self.presenceEventListenersSnapshot = [self snapshotForListeners:self.presenceEventListeners];
+    self.messagesBatchListenersSnapshot = [self snapshotForListeners:self.messagesBatchListeners];
+    self.presenceEventsBatchListenersSnapshot = [self snapshotForListeners:self.presenceEventsBatchListeners];
+    self.stateListenersSnapshot = [self snapshotForListeners:self.stateListeners];
+}
+
+- (NSArray<PNListenerReference *> *)snapshotForListeners:(NSHashTable<id <PNObjectEventListener>> *)listeners {
+    
+    NSMutableArray<PNListenerReference *> *snapshot = [NSMutableArray arrayWithCapacity:listeners.count];
+    for (id <PNObjectEventListener> listener in listeners) {
+        
+        [snapshot addObject:[PNListenerReference referenceWithListener:listener]];
+    }
+    
+    return [snapshot copy];
+}
+
+- (void)pruneReleasedListeners {
+    
+    dispatch_async(self.resourceAccessQueue, ^{ [self updateSnapshots]; });
+}
+
 
 #pragma mark - Listeners notification
 
@@ -181,7 +597,71 @@ NS_ASSUME_NONNULL_END
 
 - (void)notifyMessage:(PNMessageResult *)message {
     
-    NSArray<id <PNObjectEventListener>> *listeners = self.messageListeners.allObjects;
+    [self notifyMessages:@[message]];
+}
+
+- (void)notifyMessages:(NSArray<PNMessageResult *> *)messages {
+    
+    [self enqueueEvents:messages];
+}
+
+- (void)notifyPresenceEvent:(PNPresenceEventResult *)event {
+    
+    [self notifyPresenceEvents:@[event]];
+}
+
+- (void)notifyPresenceEvents:(NSArray<PNPresenceEventResult *> *)events {
+    
+    [self enqueueEvents:events];
+}
+
+- (void)notifyStatusChange:(PNSubscribeStatus *)status {
+    
+    [self notifyStatusObservers:status];
+}
+
+- (void)notifyHeartbeatStatus:(PNStatus *)status {
+    
+    [self notifyStatusObservers:status];
+}
+
+- (void)performWhenDeliveryBufferHasSpace:(dispatch_block_t)block onQueue:(dispatch_queue_t)queue {
+    
+    dispatch_block_t queueBlock = ^{ dispatch_async(queue, block); };
+    if (![self isDeliveryBufferLimited]) { queueBlock(); }
+    else {
+        
+        // Serial queue guarantee what events scheduled with -notifyWithBlock: already in buffer.
+        dispatch_async(self.resourceAccessQueue, ^{
+            
+            [self.spaceAwaitingBlocks addObject:queueBlock];
+            [self performSpaceAwaitingBlocksIfPossible];
+        });
+    }
+}
+
+
+#pragma mark - Delivery buffer
+
+- (BOOL)isDeliveryBufferLimited {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PNConfiguration *configuration = self.client.configuration;
+    #pragma clang diagnostic pop
+    BOOL blockingPolicy = (configuration.eventsDeliveryBufferPolicy == PNBlockSubscribeLoopBufferPolicy);
+    
+    // Workers' backlog always limited, because workers doesn't use events delivery buffer.
+    return ((blockingPolicy && configuration.eventsDeliveryBufferCapacity > 0) || self.workerQueues.count > 0);
+}
+
+- (BOOL)hasDeliveryBufferSpace {
+    
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
     // In most cases if referenced object become 'nil' it mean what there is no more need in
@@ -189,19 +669,73 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    pn_dispatch_async(self.client.callbackQueue, ^{
+    PNConfiguration *configuration = self.client.configuration;
+    #pragma clang diagnostic pop
+    NSUInteger capacity = configuration.eventsDeliveryBufferCapacity;
+    if (configuration.eventsDeliveryBufferPolicy != PNBlockSubscribeLoopBufferPolicy) { capacity = 0; }
+    int32_t workersBacklog = (int32_t)self.workerQueues.count * kPNEventsProcessingWorkerBacklog;
+    
+    return ((!capacity || self.pendingEvents.count <= capacity) &&
+            (!workersBacklog || OSAtomicAdd32Barrier(0, &_pendingWorkerBlocks) <= workersBacklog));
+}
+
+- (void)performSpaceAwaitingBlocksIfPossible {
+    
+    if (!self.spaceAwaitingBlocks.count || ![self hasDeliveryBufferSpace]) { return; }
+    
+    NSArray<dispatch_block_t> *blocks = [self.spaceAwaitingBlocks copy];
+    [self.spaceAwaitingBlocks removeAllObjects];
+    for (dispatch_block_t block in blocks) { block(); }
+}
+
+
+#pragma mark - Workers
+
+- (NSUInteger)workerForChannel:(NSString *)channel {
+    
+    return (self.workerQueues.count ? (channel.hash % self.workerQueues.count) : 0);
+}
+
+- (void)notifyOnWorker:(NSUInteger)worker withBlock:(dispatch_block_t)block {
+    
+    if (worker < self.workerQueues.count) {
         
-        for (id <PNObjectEventListener> listener in listeners) {
+        OSAtomicIncrement32Barrier(&_pendingWorkerBlocks);
+        dispatch_async(self.workerQueues[worker], ^{
             
-            [listener client:self.client didReceiveMessage:message];
-        }
-    });
+            block();
+            
+            // Let suspended subscribe loop know what workers made progress.
+            OSAtomicDecrement32Barrier(&self->_pendingWorkerBlocks);
+            dispatch_async(self.resourceAccessQueue, ^{ [self performSpaceAwaitingBlocksIfPossible]; });
+        });
+    }
+}
+
+- (void)deliverMessages:(NSArray<PNMessageResult *> *)messages
+         presenceEvents:(NSArray<PNPresenceEventResult *> *)events {
+    
+    if (!messages.count && !events.count) { return; }
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PubNub *client = self.client;
     #pragma clang diagnostic pop
+    if ([self deliverMessages:messages presenceEvents:events toClient:client]) { [self pruneReleasedListeners]; }
 }
 
-- (void)notifyPresenceEvent:(PNPresenceEventResult *)event {
+
+#pragma mark - Notification
+
+- (void)enqueueEvents:(NSArray<PNResult *> *)events {
+    
+    if (!events.count) { return; }
     
-    NSArray<id <PNObjectEventListener>> *listeners = self.presenceEventListeners.allObjects;
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
     // In most cases if referenced object become 'nil' it mean what there is no more need in
@@ -209,32 +743,244 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    pn_dispatch_async(self.client.callbackQueue, ^{
+    PubNub *client = self.client;
+    #pragma clang diagnostic pop
+    NSUInteger capacity = client.configuration.eventsDeliveryBufferCapacity;
+    NSUInteger bufferedEventsCount = self.pendingEvents.count;
+    [self.pendingEvents addObjectsFromArray:events];
+    if (capacity && self.pendingEvents.count > capacity) {
         
-        for (id <PNObjectEventListener> listener in listeners) {
+        self.overflowsCount++;
+        PNEventsDeliveryBufferPolicy policy = client.configuration.eventsDeliveryBufferPolicy;
+        if (policy != PNBlockSubscribeLoopBufferPolicy) {
             
-            [listener client:self.client didReceivePresenceEvent:event];
+            [self shrinkPendingEventsToCapacity:capacity usingPolicy:policy];
         }
-    });
-    #pragma clang diagnostic pop
+    }
+    PNMetricsAdd(client.metricsCounters, listenerQueueDepth,
+                 ((int64_t)self.pendingEvents.count - (int64_t)bufferedEventsCount));
+    
+    // Single delivery block scheduled at once, so slow callback queue doesn't accumulate blocks.
+    if (!self.isDeliveryScheduled && client.callbackQueue) {
+        
+        self.deliveryScheduled = YES;
+        pn_dispatch_async(client.callbackQueue, ^{ [self deliverBufferedEvents]; });
+    }
 }
 
-- (void)notifyStatusChange:(PNSubscribeStatus *)status {
+- (void)shrinkPendingEventsToCapacity:(NSUInteger)capacity usingPolicy:(PNEventsDeliveryBufferPolicy)policy {
     
-    [self notifyStatusObservers:status];
+    NSUInteger bufferedEventsCount = self.pendingEvents.count;
+    if (policy == PNLatestPerChannelBufferPolicy || policy == PNCoalescePresenceBufferPolicy) {
+        
+        // Walk from newest to oldest event, so only latest event for each key will be kept.
+        NSMutableSet<NSString *> *keys = [NSMutableSet new];
+        NSMutableIndexSet *obsoleteEvents = [NSMutableIndexSet new];
+        [self.pendingEvents enumerateObjectsWithOptions:NSEnumerationReverse
+                                             usingBlock:^(PNResult *event, NSUInteger eventIdx,
+                                                          __unused BOOL *stop) {
+            
+            NSString *key = [self coalescingKeyForEvent:event usingPolicy:policy];
+            if (key && [keys containsObject:key]) { [obsoleteEvents addIndex:eventIdx]; }
+            else if (key) { [keys addObject:key]; }
+        }];
+        [self.pendingEvents removeObjectsAtIndexes:obsoleteEvents];
+    }
+    
+    if (self.pendingEvents.count > capacity) {
+        
+        [self.pendingEvents removeObjectsInRange:NSMakeRange(0, (self.pendingEvents.count - capacity))];
+    }
+    self.droppedEventsCount += (bufferedEventsCount - self.pendingEvents.count);
 }
 
-- (void)notifyHeartbeatStatus:(PNStatus *)status {
+- (nullable NSString *)coalescingKeyForEvent:(PNResult *)event usingPolicy:(PNEventsDeliveryBufferPolicy)policy {
     
-    [self notifyStatusObservers:status];
+    BOOL isPresenceEvent = [event isKindOfClass:[PNPresenceEventResult class]];
+    PNSubscriberData *data = (isPresenceEvent ? ((PNPresenceEventResult *)event).data : 
+                              ((PNMessageResult *)event).data);
+    NSString *channel = (data.actualChannel?: data.subscribedChannel);
+    NSString *key = nil;
+    if (policy == PNLatestPerChannelBufferPolicy) {
+        
+        key = [NSString stringWithFormat:@"%@:%@", (isPresenceEvent ? @"presence" : @"message"), channel];
+    }
+    else if (isPresenceEvent) {
+        
+        // Events which doesn't relate to concrete user (like 'interval') coalesced by event type.
+        PNPresenceEventData *eventData = (PNPresenceEventData *)data;
+        key = [NSString stringWithFormat:@"%@:%@", channel, (eventData.presence.uuid?: eventData.presenceEvent)];
+    }
+    
+    return key;
+}
+
+- (void)deliverBufferedEvents {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PubNub *client = self.client;
+    #pragma clang diagnostic pop
+    NSTimeInterval sliceDuration = client.configuration.eventsDeliverySliceDuration;
+    NSUInteger sliceMaximumCount = client.configuration.eventsDeliverySliceMaximumCount;
+    CFAbsoluteTime sliceStartDate = CFAbsoluteTimeGetCurrent();
+    NSUInteger deliveredCount = 0;
+    NSUInteger remainingCount = 0;
+    BOOL hasReleasedListeners = NO;
+    BOOL shouldContinueSlice = NO;
+    do {
+        
+        // With time budget events delivered in small chunks, so budget can be checked between them.
+        NSUInteger chunkSize = (sliceMaximumCount ? (sliceMaximumCount - deliveredCount) : NSUIntegerMax);
+        if (sliceDuration > 0.f) { chunkSize = MIN(chunkSize, kPNEventsDeliveryChunkSize); }
+        NSUInteger chunkDeliveredCount = 0;
+        if ([self deliverBufferedEvents:chunkSize toClient:client delivered:&chunkDeliveredCount
+                              remaining:&remainingCount]) {
+            
+            hasReleasedListeners = YES;
+        }
+        deliveredCount += chunkDeliveredCount;
+        shouldContinueSlice = (remainingCount && sliceDuration > 0.f && 
+                               (!sliceMaximumCount || deliveredCount < sliceMaximumCount) &&
+                               (CFAbsoluteTimeGetCurrent() - sliceStartDate) < sliceDuration);
+    } while (shouldContinueSlice);
+    
+    __block NSUInteger droppedEventsCount = 0;
+    __block NSUInteger overflowsCount = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        droppedEventsCount = self.droppedEventsCount;
+        overflowsCount = self.overflowsCount;
+        self.droppedEventsCount = 0;
+        self.overflowsCount = 0;
+        
+        // Events could arrive while slice has been delivered, so backlog checked along with flag update.
+        remainingCount = self.pendingEvents.count;
+        self.deliveryScheduled = (remainingCount > 0);
+    });
+    PNMetricsIncrement(client.metricsCounters, deliverySlices);
+    PNMetricsAdd(client.metricsCounters, deliverySlicesEvents, deliveredCount);
+    PNMetricsStore(client.metricsCounters, lastDeliverySliceSize, deliveredCount);
+    PNMetricsStore(client.metricsCounters, deliveryBacklog, remainingCount);
+    
+    // Next slice scheduled as new block, so callback queue (and main run-loop) can process other work 
+    // between slices.
+    if (remainingCount) { pn_dispatch_async(client.callbackQueue, ^{ [self deliverBufferedEvents]; }); }
+    if (overflowsCount) {
+        
+        [self notifyWithBlock:^{
+            
+            [self notifyOverflowWithDroppedEvents:droppedEventsCount overflows:overflowsCount];
+        }];
+    }
+    if (hasReleasedListeners) { [self pruneReleasedListeners]; }
 }
 
+- (BOOL)deliverBufferedEvents:(NSUInteger)maximumCount toClient:(nullable PubNub *)client
+                    delivered:(NSUInteger *)deliveredCount remaining:(NSUInteger *)remainingCount {
+    
+    NSMutableArray<PNMessageResult *> *messages = [NSMutableArray new];
+    NSMutableArray<PNPresenceEventResult *> *events = [NSMutableArray new];
+    __block NSUInteger pendingEventsCount = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        NSRange chunkRange = NSMakeRange(0, MIN(maximumCount, self.pendingEvents.count));
+        for (PNResult *event in [self.pendingEvents subarrayWithRange:chunkRange]) {
+            
+            if ([event isKindOfClass:[PNPresenceEventResult class]]) { [events addObject:event]; }
+            else { [messages addObject:event]; }
+        }
+        [self.pendingEvents removeObjectsInRange:chunkRange];
+        pendingEventsCount = self.pendingEvents.count;
+        [self performSpaceAwaitingBlocksIfPossible];
+    });
+    
+    BOOL hasReleasedListeners = [self deliverMessages:messages presenceEvents:events toClient:client];
+    PNMetricsAdd(client.metricsCounters, listenerQueueDepth, -(int64_t)(messages.count + events.count));
+    *deliveredCount = (messages.count + events.count);
+    *remainingCount = pendingEventsCount;
+    
+    return hasReleasedListeners;
+}
 
-#pragma mark - Notification
+- (BOOL)deliverMessages:(NSArray<PNMessageResult *> *)messages
+         presenceEvents:(NSArray<PNPresenceEventResult *> *)events toClient:(nullable PubNub *)client {
+    
+    NSArray<PNListenerReference *> *messageListeners = self.messageListenersSnapshot;
+    NSArray<PNListenerReference *> *messagesBatchListeners = self.messagesBatchListenersSnapshot;
+    NSArray<PNListenerReference *> *eventListeners = self.presenceEventListenersSnapshot;
+    NSArray<PNListenerReference *> *eventsBatchListeners = self.presenceEventsBatchListenersSnapshot;
+    
+    BOOL hasReleasedListeners = NO;
+    if (messages.count) {
+        
+        for (PNListenerReference *reference in messagesBatchListeners) {
+            
+            id <PNObjectEventListener> listener = reference.listener;
+            if (listener) { [listener client:client didReceiveMessages:messages]; }
+            else { hasReleasedListeners = YES; }
+        }
+        for (PNListenerReference *reference in messageListeners) {
+            
+            id <PNObjectEventListener> listener = reference.listener;
+            if (!listener) {
+                
+                hasReleasedListeners = YES;
+                continue;
+            }
+            for (PNMessageResult *message in messages) {
+                
+                [listener client:client didReceiveMessage:message];
+            }
+        }
+    }
+    
+    if (events.count) {
+        
+        for (PNListenerReference *reference in eventsBatchListeners) {
+            
+            id <PNObjectEventListener> listener = reference.listener;
+            if (listener) { [listener client:client didReceivePresenceEvents:events]; }
+            else { hasReleasedListeners = YES; }
+        }
+        for (PNListenerReference *reference in eventListeners) {
+            
+            id <PNObjectEventListener> listener = reference.listener;
+            if (!listener) {
+                
+                hasReleasedListeners = YES;
+                continue;
+            }
+            for (PNPresenceEventResult *event in events) {
+                
+                [listener client:client didReceivePresenceEvent:event];
+            }
+        }
+    }
+    
+    return hasReleasedListeners;
+}
+
+- (void)notifyOverflowWithDroppedEvents:(NSUInteger)droppedEventsCount overflows:(NSUInteger)overflowsCount {
+    
+    PNErrorStatus *status = [PNErrorStatus statusForOperation:PNSubscribeOperation
+                                                     category:PNEventsDeliveryOverflowCategory
+                                          withProcessingError:nil];
+    NSString *information = [NSString stringWithFormat:@"Events delivery buffer has been overflown %@ "
+                             "time(s), %@ event(s) has been dropped.", @(overflowsCount), @(droppedEventsCount)];
+    [status updateData:@{@"information": information,
+                         @"data": @{@"dropped": @(droppedEventsCount), @"overflows": @(overflowsCount)}}];
+    [self notifyStatusObservers:status];
+}
 
 - (void)notifyStatusObservers:(PNStatus *)status {
     
-    NSArray<id <PNObjectEventListener>> *listeners = self.stateListeners.allObjects;
+    NSArray<PNListenerReference *> *listeners = self.stateListenersSnapshot;
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
     // In most cases if referenced object become 'nil' it mean what there is no more need in
@@ -242,14 +988,21 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    pn_dispatch_async(self.client.callbackQueue, ^{
+    PubNub *client = self.client;
+    #pragma clang diagnostic pop
+    PNMetricsIncrement(client.metricsCounters, listenerQueueDepth);
+    pn_dispatch_async(client.callbackQueue, ^{
         
-        for (id <PNObjectEventListener> listener in listeners) {
+        BOOL hasReleasedListeners = NO;
+        for (PNListenerReference *reference in listeners) {
             
-            [listener client:self.client didReceiveStatus:status];
+            id <PNObjectEventListener> listener = reference.listener;
+            if (listener) { [listener client:client didReceiveStatus:status]; }
+            else { hasReleasedListeners = YES; }
         }
+        PNMetricsDecrement(client.metricsCounters, listenerQueueDepth);
+        if (hasReleasedListeners) { [self pruneReleasedListeners]; }
     });
-    #pragma clang diagnostic pop
 }
 
 #pragma mark -
@@ -179,6 +179,8 @@ typedef void(^PNSubscriberCompletionBlock)(PNSubscribeStatus * _Nullable status)
  @brief      Perform initial subscription with \b 0 timetoken.
  @discussion Subscription with \b 0 timetoken "register" client in \b PubNub network and allow to receive live
              updates from remote data objects live feed.
+ @discussion If \c subscribeCoalescingInterval is set, request will be sent after this interval along with
+             other subscription list modifications which has been done during it.
  
  @param timeToken Time from which client should try to catch up on messages.
  @param state     Reference on client state which should be bound to channels on which client has been 
@@ -223,6 +225,9 @@ typedef void(^PNSubscriberCompletionBlock)(PNSubscribeStatus * _Nullable status)
  @brief      Perform unsubscription operation.
  @discussion If suitable objects has been passed, then client will ask \b PubNub presence service to trigger 
              \c 'leave' presence events on passed objects.
+ @discussion If \c subscribeCoalescingInterval is set, objects from unsubscribe calls which has been done 
+             during this interval will be left using single request and all completion blocks will be 
+             called with its status.
  
  @param channels Whether unsubscribing from list of channels or channel groups.
  @param objects  List of objects from which client should unsubscribe.
@@ -6,6 +6,7 @@
 #import "PNSubscriber.h"
 #import "PNSubscribeStatus+Private.h"
 #import "PNEnvelopeInformation.h"
+#import "PNSubscribeParser.h"
 #import "PNServiceData+Private.h"
 #import "PNErrorStatus+Private.h"
 #import "PNSubscriberResults.h"
@@ -14,6 +15,7 @@
 #import "PNStatus+Private.h"
 #import "PNResult+Private.h"
 #import "PNConfiguration.h"
+#import <libkern/OSAtomic.h>
 #import <objc/runtime.h>
 #import "PNLogMacro.h"
 #import "PNHelpers.h"
@@ -88,8 +90,311 @@ typedef NS_OPTIONS(NSUInteger, PNSubscriberState) {
 };
 
 
+#pragma mark - Private functions
+
+/**
+ @brief      Calculate index of subscribe shard which should handle specified object.
+ @discussion Presence channel (group) always handled by same shard as corresponding channel (group).
+ 
+ @param object      Name of channel or channel group for which shard should be found.
+ @param shardsCount Number of shards between which objects are distributed.
+ 
+ @return Shard index.
+ 
+ @since 4.5.0
+ */
+static NSUInteger PNSubscribeShardIndexForObject(NSString *object, NSUInteger shardsCount) {
+    
+    NSUInteger index = 0;
+    if (shardsCount > 1) {
+        
+        NSString *name = ([PNChannel isPresenceObject:object] ? [PNChannel channelForPresence:object] : object);
+        index = (name.hash % shardsCount);
+    }
+    
+    return index;
+}
+
+
 NS_ASSUME_NONNULL_BEGIN
 
+#pragma mark - Subscribe shard interface declaration
+
+/**
+ @brief      Additional subscribe long-poll loop state.
+ @discussion Large subscription sets split between few shards and each shard (except first one which is 
+             handled by subscriber itself) has own list of objects and time token. Shard long-poll loop 
+             started only after main subscription loop completed initial subscription and use time token 
+             received by it. Access to shard properties allowed only from subscriber's 
+             \c resourceAccessQueue.
+ 
+ @since 4.5.0
+ */
+@interface PNSubscribeShard : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores shard index (also used to pick long-poll connection).
+ */
+@property (nonatomic, assign) NSUInteger index;
+
+/**
+ @brief  Stores reference on list of channels and groups handled by shard.
+ */
+@property (nonatomic, copy) NSArray<NSString *> *objects;
+
+/**
+ @brief  Stores reference on sorted and percent-escaped list of channels handled by shard.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedChannels;
+
+/**
+ @brief  Stores reference on sorted and percent-escaped list of channel groups handled by shard.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedChannelGroups;
+
+/**
+ @brief  Stores time token which should be used with next shard request.
+ */
+@property (nonatomic, assign) uint64_t timeToken;
+
+/**
+ @brief  Stores \b PubNub server region identifier which should be used with next shard request (\b -1 if 
+         unknown).
+ */
+@property (nonatomic, assign) int32_t region;
+
+/**
+ @brief  Stores reference on percent-escaped serialized client state for shard objects.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedState;
+
+/**
+ @brief  Stores version of client state cache for which \c escapedState has been composed.
+ */
+@property (nonatomic, assign) NSUInteger stateVersion;
+
+/**
+ @brief      Stores identifier of last request which has been sent for shard.
+ @discussion Used to ignore responses for requests which has been replaced by newer one.
+ */
+@property (nonatomic, assign) NSUInteger requestIdentifier;
+
+/**
+ @brief  Stores whether shard long-poll loop is running or has been stopped because of cancellation.
+ */
+@property (nonatomic, assign, getter = isActive) BOOL active;
+
+/**
+ @brief  Stores whether last shard request failed and listeners should be notified when loop will recover.
+ */
+@property (nonatomic, assign, getter = isRecovering) BOOL recovering;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Subscription snapshot interface declaration
+
+/**
+ @brief      Immutable subscriber state snapshot.
+ @discussion Subscriber publish new snapshot each time when subscription list, time tokens, client state, 
+             filter expression or connection state change. Snapshot which has been published never modified,
+             so it can be used by any thread w/o synchronization. New snapshot composed from copy of current 
+             one (copy-on-write).
+ 
+ @since 4.5.0
+ */
+@interface PNSubscriptionSnapshot : NSObject <NSCopying>
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on list of channels on which client subscribed.
+ */
+@property (nonatomic, copy) NSSet<NSString *> *channels;
+
+/**
+ @brief  Stores reference on list of channel groups on which client subscribed.
+ */
+@property (nonatomic, copy) NSSet<NSString *> *channelGroups;
+
+/**
+ @brief  Stores reference on list of presence channels on which client subscribed.
+ */
+@property (nonatomic, copy) NSSet<NSString *> *presenceChannels;
+
+/**
+ @brief      Stores reference on list of all channels, presence channels and groups.
+ @discussion List re-composed by subscriber each time when \c version change.
+ */
+@property (nonatomic, copy) NSArray<NSString *> *allObjects;
+
+/**
+ @brief  Stores subscription list version (changes each time when list of objects modified).
+ */
+@property (nonatomic, assign) NSUInteger version;
+
+/**
+ @brief      Stores time token which is used for current subscribe loop iteration.
+ @discussion \b 0 for initial subscription loop and non-zero for long-poll requests.
+ */
+@property (nonatomic, assign) uint64_t currentTimeToken;
+
+/**
+ @brief  Stores time token which has been used for previous subscribe loop iteration.
+ */
+@property (nonatomic, assign) uint64_t lastTimeToken;
+
+/**
+ @brief      Stores time token which should be used after initial subscription with \b 0 time token.
+ @discussion \b 0 in case if user didn't ask to catch up from specific time token.
+ */
+@property (nonatomic, assign) uint64_t overrideTimeToken;
+
+/**
+ @brief  Stores \b PubNub server region identifier which generated \c currentTimeToken (\b -1 if unknown).
+ */
+@property (nonatomic, assign) int32_t currentTimeTokenRegion;
+
+/**
+ @brief  Stores \b PubNub server region identifier which generated \c lastTimeToken (\b -1 if unknown).
+ */
+@property (nonatomic, assign) int32_t lastTimeTokenRegion;
+
+/**
+ @brief  Stores reference on message filtering expression.
+ */
+@property (nonatomic, nullable, copy) NSString *filterExpression;
+
+/**
+ @brief  Stores reference on percent-escaped message filtering expression.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedFilterExpression;
+
+/**
+ @brief  Stores reference on sorted and percent-escaped list of channels (including presence channels) 
+         which is used in subscribe request path.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedChannels;
+
+/**
+ @brief  Stores reference on sorted and percent-escaped list of channel groups which is used in subscribe 
+         request query.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedChannelGroups;
+
+/**
+ @brief  Stores reference on list of objects for which escaped channels and groups has been composed.
+ */
+@property (nonatomic, nullable, copy) NSArray<NSString *> *requestObjects;
+
+/**
+ @brief      Stores version of subscription list for which escaped channels and groups has been composed.
+ @discussion Escaped lists valid as long as this value is equal to \c version.
+ */
+@property (nonatomic, assign) NSUInteger requestObjectsVersion;
+
+/**
+ @brief  Stores reference on percent-escaped serialized client state for \c requestObjects.
+ */
+@property (nonatomic, nullable, copy) NSString *escapedState;
+
+/**
+ @brief      Stores version of client state cache for which \c escapedState has been composed.
+ @discussion Escaped state valid as long as this value is equal to client state cache version.
+ */
+@property (nonatomic, assign) NSUInteger stateVersion;
+
+/**
+ @brief  Stores version of subscription list for which \c escapedState has been composed.
+ */
+@property (nonatomic, assign) NSUInteger stateObjectsVersion;
+
+/**
+ @brief  Stores whether subscription loop should be restored after unexpected disconnection or not.
+ */
+@property (nonatomic, assign, getter = shouldRestoreSubscription) BOOL restoreSubscription;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Subscription changes interface declaration
+
+/**
+ @brief      Subscription list modifications which has been requested during single coalescing window.
+ @discussion Subscribe and unsubscribe calls which has been done during window merged into single object 
+             which is used to send at most one \c leave and one subscribe request. Access to object 
+             properties allowed only from subscriber's \c changesCoalescingQueue.
+ 
+ @since 4.5.0
+ */
+@interface PNSubscriptionChanges : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on list of channels and groups on which client has been subscribed when window 
+         has been opened.
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *subscribedObjects;
+
+/**
+ @brief  Stores reference on list of channels (including presence) from which client unsubscribed during 
+         window.
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *removedChannels;
+
+/**
+ @brief  Stores reference on list of channel groups from which client unsubscribed during window.
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *removedChannelGroups;
+
+/**
+ @brief  Stores whether unsubscribe has been requested during window or not.
+ */
+@property (nonatomic, assign) BOOL unsubscribeRequested;
+
+/**
+ @brief  Stores whether subscribe has been requested during window or not.
+ */
+@property (nonatomic, assign) BOOL subscribeRequested;
+
+/**
+ @brief  Stores reference on most recent catch up time token which has been passed during window.
+ */
+@property (nonatomic, nullable, strong) NSNumber *timeToken;
+
+/**
+ @brief  Stores reference on merged client state which has been passed during window.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *state;
+
+/**
+ @brief  Stores reference on list of subscribe completion blocks which has been passed during window.
+ */
+@property (nonatomic, strong) NSMutableArray<PNSubscriberCompletionBlock> *subscribeBlocks;
+
+/**
+ @brief  Stores reference on list of unsubscribe completion blocks which has been passed during window.
+ */
+@property (nonatomic, strong) NSMutableArray<PNSubscriberCompletionBlock> *unsubscribeBlocks;
+
+#pragma mark -
+
+
+@end
+
+
 #pragma mark - Protected interface declaration
 
 @interface PNSubscriber ()
@@ -121,95 +426,99 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL mayRequireSubscriptionRestore;
 
 /**
- @brief  Actual storage for list of channels on which client subscribed at this moment and listen 
-         for updates from live feeds.
+ @brief      Stores reference on most recent subscriber state snapshot.
+ @discussion Property is atomic, so readers get whole snapshot with single load and don't need to hop on
+             \c resourceAccessQueue. New snapshot published only with \c -updateSnapshotWithBlock:.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, strong) NSMutableSet<NSString *> *channelsSet;
+@property (atomic, strong) PNSubscriptionSnapshot *snapshot;
 
 /**
- @brief  Actual storage for list of channel groups on which client subscribed at this moment and 
-         listen for updates from live feeds.
+ @brief  Stores lock which is used to serialize snapshot modifications.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, strong) NSMutableSet<NSString *> *channelGroupsSet;
+@property (nonatomic, assign) OSSpinLock snapshotLock;
 
 /**
- @brief  Actual storage for list of presence channels on which client subscribed at this moment and
-         listen for presence updates.
+ @brief  Stores reference on queue which is used to serialize access to shared subscriber 
+         information.
  
  @since 4.0
  */
-@property (nonatomic, strong) NSMutableSet<NSString *> *presenceChannelsSet;
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
 
 /**
- @brief  Stores reference on percent-escaped message filtering expression.
+ @brief      Stores reference on GCD timer used to re-issue subscribe request.
+ @discussion Timer activated in cases if previous subscribe loop failed with category type which
+             can be temporary.
  
- @since 4.3.0
+ @since 4.0
  */
-@property (nonatomic, nullable, copy) NSString *escapedFilterExpression;
+@property (nonatomic, nullable, strong) dispatch_source_t retryTimer;
 
 /**
- @brief      Reference on time token which is used for current subscribe loop iteration.
- @discussion \b 0 for initial subscription loop and non-zero for long-poll requests.
+ @brief      Stores reference on queue which is used to handle subscribe request responses in order in which 
+             requests has been sent.
+ @discussion Next subscription cycle can be started as soon as raw response arrived (before it will be 
+             parsed). Because of this parsed responses may complete out of order and this queue used to put 
+             them back in line. Next subscription cycle also started from this queue (not from transport's 
+             queue on which raw response has been received).
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, strong) NSNumber *currentTimeToken;
+@property (nonatomic, strong) dispatch_queue_t responsesHandlingQueue;
 
 /**
- @brief      Reference on time token which should be used after initial subscription with \b 0
-             timetoken.
- @discussion Override token used by subscribe API which allow to subscribe on arbitrarily time token
-             and will be used in logic which decide which time token should be used for next 
-             subscription cycle.
+ @brief      Stores reference on subscribe responses handling blocks which wait for previous responses 
+             handling.
+ @discussion Access to this property allowed only from \c responsesHandlingQueue.
  
- @since 4.2.0
+ @since 4.5.0
  */
-@property (nonatomic, nullable, strong) NSNumber *overrideTimeToken;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, dispatch_block_t> *pendingResponses;
 
 /**
- @brief      Reference on time token which has been used for previous subscribe loop iteration.
- @discussion \b 0 for initial subscription loop and non-zero for long-poll requests.
+ @brief  Stores identifier which has been assigned to most recent subscribe request.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, strong) NSNumber *lastTimeToken;
+@property (nonatomic, assign) int64_t lastResponseIdentifier;
 
 /**
- @brief      Stores reference on \b PubNub server region identifier (which generated \c currentTimeToken value).
- @discussion \b 0 for initial subscription loop and non-zero for long-poll requests.
+ @brief      Stores identifier of subscribe request response which should be handled next.
+ @discussion Access to this property allowed only from \c responsesHandlingQueue.
  
- @since 4.3.0
+ @since 4.5.0
  */
-@property (nonatomic, readonly, copy) NSNumber *currentTimeTokenRegion;
+@property (nonatomic, assign) int64_t expectedResponseIdentifier;
 
 /**
- @brief      Reference on time token region which has been used for previous subscribe loop iteration.
- @discussion \b 0 for initial subscription loop and non-zero for long-poll requests.
+ @brief      Stores reference on list of additional subscribe shards.
+ @discussion List empty as long as subscription set is small enough to be handled by single long-poll loop.
  
- @since 4.3.0
+ @since 4.5.0
  */
-@property (nonatomic, readonly, copy) NSNumber *lastTimeTokenRegion;
+@property (nonatomic, strong) NSArray<PNSubscribeShard *> *shards;
 
 /**
- @brief  Stores reference on queue which is used to serialize access to shared subscriber 
-         information.
+ @brief  Stores reference on queue which is used to collect subscription list modifications during 
+         coalescing window.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+@property (nonatomic, strong) dispatch_queue_t changesCoalescingQueue;
 
 /**
- @brief      Stores reference on GCD timer used to re-issue subscribe request.
- @discussion Timer activated in cases if previous subscribe loop failed with category type which
-             can be temporary.
+ @brief      Stores reference on subscription list modifications which has been requested during current 
+             coalescing window.
+ @discussion \c nil in case if there is no opened window. Access to this property allowed only from
+             \c changesCoalescingQueue.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, nullable, strong) dispatch_source_t retryTimer;
+@property (nonatomic, nullable, strong) PNSubscriptionChanges *pendingChanges;
 
 
 #pragma mark - Initialization and Configuration
@@ -239,6 +548,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)updateStateTo:(PNSubscriberState)state withStatus:(PNSubscribeStatus *)status;
 
+/**
+ @brief      Publish modified subscriber state snapshot.
+ @discussion Block receive copy of current snapshot which can be modified and will be published right after
+             block return. Modifications serialized, so block should be as short as possible.
+ 
+ @param block Block which is used to modify copy of current snapshot.
+ 
+ @since 4.5.0
+ */
+- (void)updateSnapshotWithBlock:(void(^)(PNSubscriptionSnapshot *snapshot))block;
+
 
 #pragma mark - Subscription
 
@@ -260,6 +580,15 @@ NS_ASSUME_NONNULL_BEGIN
         withState:(nullable NSDictionary<NSString *, id> *)state 
        completion:(nullable PNSubscriberCompletionBlock)block;
 
+/**
+ @brief      Continue subscription cycle as soon as listeners will be able to accept more events.
+ @discussion Next long-poll request deferred (w/o blocking calling queue) while events delivery buffer 
+             overflown. Deferred request won't be sent if subscription cycle has been restarted in meantime.
+ 
+ @since 4.5.0
+ */
+- (void)continueSubscriptionCycleWhenDeliveryBufferHasSpace;
+
 /**
  @brief      Launch subscription retry timer.
  @discussion Launch timer with default 1 second interval after each subscribe attempt. In most of cases timer
@@ -270,6 +599,47 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)startRetryTimer;
 
+/**
+ @brief      Replace list of additional subscribe shards.
+ @discussion Shards which handle same objects as before will be kept as-is, for rest long-poll loop will be
+             stopped and started with next \c -startInactiveShardsWithTimeToken:region: call.
+ 
+ @param shards List of shards composed for current subscription set.
+ 
+ @since 4.5.0
+ */
+- (void)updateShards:(NSArray<PNSubscribeShard *> *)shards;
+
+/**
+ @brief      Start long-poll loops for shards which is new or has been stopped (because of requests 
+             cancellation or error).
+ @discussion Method called when main subscription loop completed initial subscription, so all shards 
+             continue from same time token (including catch up time token).
+ 
+ @param timeToken Time token which is used by main subscription loop.
+ @param region    \b PubNub server region identifier which is used by main subscription loop or \b -1 if it
+                  is unknown.
+ 
+ @since 4.5.0
+ */
+- (void)startInactiveShardsWithTimeToken:(uint64_t)timeToken region:(int32_t)region;
+
+/**
+ @brief  Stop all additional subscribe shards.
+ 
+ @since 4.5.0
+ */
+- (void)stopShards;
+
+/**
+ @brief  Send next subscribe request for specified shard.
+ 
+ @param shard Reference on shard for which request should be sent.
+ 
+ @since 4.5.0
+ */
+- (void)subscribeShard:(PNSubscribeShard *)shard;
+
 /**
  @brief      Terminate previously launched subscription retry counter.
  @discussion In case if another subscribe request from user client better to stop retry timer to eliminate 
@@ -284,55 +654,110 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  @brief      Perform unsubscription operation.
- @discussion If suitable objects has been passed, then client will ask \b PubNub presence service to trigger 
-             \c 'leave' presence events on passed objects.
+ @discussion Client will ask \b PubNub presence service to trigger \c 'leave' presence events on passed
+             channels and groups (except presence channels) using single request.
  
- @param channels                Whether unsubscribing from list of channels or channel groups.
- @param objects                 List of objects from which client should unsubscribe.
- @param shouldInformListener    Whether listener should be informed at the end of operation or not.
- @param subscribeOnRestChannels Whether client should try to subscribe on channels which may be left after 
-                                unsubscription.
- @param block                   Reference on unsubscription completion block which is used to notify code.
+ @param channels List of channels (including presence) from which client unsubscribed.
+ @param groups   List of channel groups from which client unsubscribed.
+ @param block    Reference on unsubscription completion block which is called with acknowledgment status and
+                 whether \c leave request has been sent or not.
  
- @since 4.2.0
+ @since 4.5.0
  */
-- (void)unsubscribeFrom:(BOOL)channels objects:(NSArray<NSString *> *)objects
-      informingListener:(BOOL)shouldInformListener subscribeOnRest:(BOOL)subscribeOnRestChannels
-             completion:(nullable PNSubscriberCompletionBlock)block;
+- (void)unsubscribeFromChannels:(NSArray<NSString *> *)channels groups:(NSArray<NSString *> *)groups
+                     completion:(void(^)(PNStatus *status, BOOL leaveSent))block;
 
 
-#pragma mark - Handlers
+#pragma mark - Coalescing
 
 /**
- @brief      Handle subscription status update.
- @discussion Depending on passed status category and whether it is error it will be sent for processing to
-             corresponding methods.
+ @brief      Add subscription list modification to current coalescing window.
+ @discussion If there is no opened window, it will be opened and scheduled to be applied after configured
+             \c subscribeCoalescingInterval. If interval not set, modification applied synchronously.
  
- @param status Reference on status object which has been received from \b PubNub network.
+ @param removedObjects List of objects which has been removed from subscription list by this modification
+                       (required to know which objects has been subscribed before window has been opened).
+ @param block          Block which is called on \c changesCoalescingQueue to update window information.
  
- @since 4.0
+ @since 4.5.0
  */
-- (void)handleSubscriptionStatus:(PNSubscribeStatus *)status;
+- (void)enqueueChangesWithRemovedObjects:(nullable NSArray<NSString *> *)removedObjects
+                                   block:(void(^)(PNSubscriptionChanges *changes))block;
 
 /**
- @brief      Process successful subscription status.
- @discussion Success can be called as result of initial subscription successful ACK response as well as 
-             long-poll response with events from remote data objects live feed.
+ @brief  Send \c leave (if required) and subscribe requests for merged subscription list modifications.
  
- @param status Reference on status object which has been received from \b PubNub network.
+ @param changes Reference on modifications which has been collected during coalescing window.
  
- @since 4.0
+ @since 4.5.0
  */
-- (void)handleSuccessSubscriptionStatus:(PNSubscribeStatus *)status;
+- (void)applySubscriptionChanges:(PNSubscriptionChanges *)changes;
+
+
+#pragma mark - Handlers
 
 /**
- @brief      Process failed subscription status.
- @discussion Failure can be cause by Access Denied error, network issues or called when last subscribe request
-             has been canceled (to execute new subscription for example).
+ @brief      Handle subscribe request response in order in which requests has been sent.
+ @discussion Block will be called on \c responsesHandlingQueue only after all responses with smaller 
+             identifiers will be handled. Network manager call completion block for each request exactly 
+             once (with response, error, cancellation or bad request status), so each identifier's slot 
+             released as soon as its status received and handling doesn't depend on any timeouts.
  
- @param status Reference on status object which has been received from \b PubNub network.
+ @param identifier Identifier which has been assigned to subscribe request.
+ @param block      Reference on block which should handle response.
  
- @since 4.0
+ @since 4.5.0
+ */
+- (void)handleResponse:(int64_t)identifier withBlock:(dispatch_block_t)block;
+
+/**
+ @brief   Call handling blocks for responses which is next in line.
+ @warning Method should be called on \c responsesHandlingQueue.
+ 
+ @since 4.5.0
+ */
+- (void)handleQueuedResponses;
+
+/**
+ @brief      Handle subscription status update.
+ @discussion Depending on passed status category and whether it is error it will be sent for processing to
+             corresponding methods.
+ 
+ @param status              Reference on status object which has been received from \b PubNub network.
+ @param initialSubscription Whether status has been received for initial subscription (with \b 0 time 
+                            token) or long-poll request.
+ @param cycleContinued      Whether next subscription cycle already has been started using time token 
+                            pre-fetched from raw service response.
+ 
+ @since 4.5.0
+ */
+- (void)handleSubscriptionStatus:(PNSubscribeStatus *)status initialSubscription:(BOOL)initialSubscription
+                  cycleContinued:(BOOL)cycleContinued;
+
+/**
+ @brief      Process successful subscription status.
+ @discussion Success can be called as result of initial subscription successful ACK response as well as 
+             long-poll response with events from remote data objects live feed.
+ 
+ @param status              Reference on status object which has been received from \b PubNub network.
+ @param initialSubscription Whether status has been received for initial subscription (with \b 0 time 
+                            token) or long-poll request.
+ @param cycleContinued      Whether next subscription cycle already has been started using time token 
+                            pre-fetched from raw service response.
+ 
+ @since 4.5.0
+ */
+- (void)handleSuccessSubscriptionStatus:(PNSubscribeStatus *)status initialSubscription:(BOOL)initialSubscription
+                         cycleContinued:(BOOL)cycleContinued;
+
+/**
+ @brief      Process failed subscription status.
+ @discussion Failure can be cause by Access Denied error, network issues or called when last subscribe request
+             has been canceled (to execute new subscription for example).
+ 
+ @param status Reference on status object which has been received from \b PubNub network.
+ 
+ @since 4.0
  */
 - (void)handleFailedSubscriptionStatus:(PNSubscribeStatus *)status;
 
@@ -340,14 +765,13 @@ NS_ASSUME_NONNULL_BEGIN
  @brief  Handle subscription time token received from \b PubNub network.
  
  @param initialSubscription Whether subscription is initial or received time token on long-poll request.
- @param timeToken           Reference on time token which has been received from \b PubNub network.
- @param region              Reference on \b PubNub server region identifier (which generated \c timeToken 
-                            value).
+ @param timeToken           Time token which has been received from \b PubNub network.
+ @param region              \b PubNub server region identifier (which generated \c timeToken value) or \b -1 
+                            if it is unknown.
  
  @since 4.0
  */
-- (void)handleSubscription:(BOOL)initialSubscription timeToken:(nullable NSNumber *)timeToken 
-                    region:(nullable NSNumber *)region;
+- (void)handleSubscription:(BOOL)initialSubscription timeToken:(uint64_t)timeToken region:(int32_t)region;
 
 /**
  @brief  Handle long-poll service response and deliver events to listeners if required.
@@ -359,19 +783,52 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)handleLiveFeedEvents:(PNSubscribeStatus *)status;
 
 /**
- @brief  Process message which just has been received from \b PubNub service through live feed on which client
-         subscribed at this moment.
+ @brief      Distribute live feed events between events processing workers.
+ @discussion Events grouped by worker which is responsible for event's channel, so order of events from same 
+             channel preserved.
+ 
+ @param events List of events from long-poll service response.
+ @param status Reference on status object which has been received from \b PubNub network.
+ 
+ @since 4.5.0
+ */
+- (void)handleLiveFeedEvents:(NSArray<NSMutableDictionary<NSString *, id> *> *)events
+          onWorkersForStatus:(PNSubscribeStatus *)status;
+
+/**
+ @brief  Create messages and presence events result objects from live feed events.
+ 
+ @param events         List of events which should be processed.
+ @param status         Reference on status object which has been received from \b PubNub network.
+ @param messages       Reference on list into which processed messages should be stored.
+ @param presenceEvents Reference on list into which processed presence events should be stored.
+ 
+ @since 4.5.0
+ */
+- (void)processLiveFeedEvents:(NSArray<NSMutableDictionary<NSString *, id> *> *)events
+                    forStatus:(PNSubscribeStatus *)status
+                     messages:(NSMutableArray<PNMessageResult *> *)messages
+               presenceEvents:(NSMutableArray<PNPresenceEventResult *> *)presenceEvents;
+
+/**
+ @brief      Process message which just has been received from \b PubNub service through live feed on which 
+             client subscribed at this moment.
+ @discussion If message can't be decrypted, listeners will be notified with error status instead of message.
  
  @param data Reference on result data which hold information about request on which this response has been 
              received and message itself.
  
+ @return \c YES in case if message should be delivered to listeners.
+ 
  @since 4.0
  */
-- (void)handleNewMessage:(PNMessageResult *)data;
+- (BOOL)handleNewMessage:(PNMessageResult *)data;
 
 /**
- @brief  Process presence event which just has been received from \b PubNub service through presence live
-         feeds on which client subscribed at this moment.
+ @brief      Process presence event which just has been received from \b PubNub service through presence live
+             feeds on which client subscribed at this moment.
+ @discussion State modification events for current client applied to local client state cache. All 
+             events applied to local presence index.
  
  @param data Reference on result data which hold information about request on which this response has been 
              received and presence event itself.
@@ -380,19 +837,115 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)handleNewPresenceEvent:(PNPresenceEventResult *)data;
 
+/**
+ @brief      Handle subscribe request processing results for additional subscribe shard.
+ @discussion Events from all shards delivered through same listeners. Shard errors change subscriber's state 
+             in same way as main subscription loop errors and shard recovery reported with \c connected 
+             (\c reconnected) status.
+ 
+ @param shard             Reference on shard for which request has been sent.
+ @param status            Reference on request processing status.
+ @param requestIdentifier Identifier of request for which \c status has been received.
+ 
+ @since 4.5.0
+ */
+- (void)handleShard:(PNSubscribeShard *)shard subscriptionStatus:(PNSubscribeStatus *)status
+         forRequest:(NSUInteger)requestIdentifier;
+
 
 #pragma mark - Misc
 
 /**
  @brief  Compose request parameters instance basing on current subscriber state.
  
- @param state Reference on merged client state which should be used in request.
+ @param state               Reference on merged client state which should be used in request.
+ @param initialSubscription Pointer to storage for flag whether request is initial subscription (with \b 0 
+                            time token) or long-poll request.
  
  @return Configured and ready to use parameters instance.
  
  @since 4.0
  */
-- (PNRequestParameters *)subscribeRequestParametersWithState:(nullable NSDictionary<NSString *, id> *)state;
+- (PNRequestParameters *)subscribeRequestParametersWithState:(nullable NSDictionary<NSString *, id> *)state
+                                          initialSubscription:(BOOL *)initialSubscription;
+
+/**
+ @brief      Re-compose escaped channels and groups lists if subscription set has been changed since last 
+             time.
+ @discussion Sorting and percent-escaping of thousands of names is expensive, so it done only when 
+             subscription set actually changed and not for each subscription cycle.
+ 
+ @return Version of subscription set for which escaped lists has been composed.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)updateEscapedObjectsIfRequired;
+
+/**
+ @brief      Re-compose escaped client state if it or subscription set has been changed since last time.
+ 
+ @param state               Reference on client state which should be merged with cached state.
+ @param objects             List of objects for which client state should be composed.
+ @param subscriptionVersion Version of subscription set to which \c objects belong.
+ 
+ @return Percent-escaped serialized client state or \c nil in case if there is no state for \c objects.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)escapedStateMergedWith:(nullable NSDictionary<NSString *, id> *)state
+                                   forObjects:(NSArray<NSString *> *)objects
+                          subscriptionVersion:(NSUInteger)subscriptionVersion;
+
+/**
+ @brief  Compose percent-escaped client state for specified objects.
+ 
+ @param objects      List of objects for which client state should be composed.
+ @param stateManager Reference on client state cache manager from which state should be taken.
+ 
+ @return Percent-escaped serialized client state or \c nil in case if there is no state for \c objects.
+ 
+ @since 4.5.0
+ */
+- (nullable NSString *)escapedStateForObjects:(NSArray<NSString *> *)objects
+                             withStateManager:(PNClientState *)stateManager;
+
+/**
+ @brief  Calculate number of subscribe shards which should be used for specified number of objects.
+ 
+ @param objectsCount Number of channels and groups in subscription set.
+ 
+ @return Number of shards (including main subscription loop).
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)shardsCountForObjectsCount:(NSUInteger)objectsCount;
+
+/**
+ @brief      Distribute objects between subscribe shards.
+ @discussion Presence channels placed into same shard as their regular channels.
+ 
+ @param objects     List of channels or channel groups which should be distributed.
+ @param shardsCount Number of shards (including main subscription loop) between which \c objects should be
+                    distributed.
+ 
+ @return List of objects lists (one for each shard).
+ 
+ @since 4.5.0
+ */
+- (NSArray<NSArray<NSString *> *> *)distributeObjects:(NSArray<NSString *> *)objects
+                                        betweenShards:(NSUInteger)shardsCount;
+
+/**
+ @brief      Compose subscribe request parameters for additional shard.
+ @discussion Method should be called only from \c resourceAccessQueue.
+ 
+ @param shard Reference on shard for which parameters should be composed.
+ 
+ @return Configured and ready to use parameters instance.
+ 
+ @since 4.5.0
+ */
+- (PNRequestParameters *)subscribeRequestParametersForShard:(PNSubscribeShard *)shard;
 
 /**
  @brief  Append subscriber information to status object.
@@ -416,12 +969,6 @@ NS_ASSUME_NONNULL_END
 @implementation PNSubscriber
 
 @synthesize retryTimer = _retryTimer;
-@synthesize overrideTimeToken = _overrideTimeToken;
-@synthesize currentTimeToken = _currentTimeToken;
-@synthesize lastTimeToken = _lastTimeToken;
-@synthesize currentTimeTokenRegion = _currentTimeTokenRegion;
-@synthesize lastTimeTokenRegion = _lastTimeTokenRegion;
-@synthesize filterExpression = _filterExpression;
 
 
 #pragma mark - Logger
@@ -457,161 +1004,132 @@ NS_ASSUME_NONNULL_END
 
 - (NSArray<NSString *> *)allObjects {
     
-    return [[[self channels] arrayByAddingObjectsFromArray:[self presenceChannels]]
-            arrayByAddingObjectsFromArray:[self channelGroups]];
+    return self.snapshot.allObjects;
 }
 
 - (NSArray<NSString *> *)channels {
     
-    __block NSArray *channels = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ channels = self.channelsSet.allObjects; });
-    
-    return channels;
+    return self.snapshot.channels.allObjects;
 }
 
 - (void)addChannels:(NSArray<NSString *> *)channels {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    NSArray *channelsOnly = [PNChannel objectsWithOutPresenceFrom:channels];
+    NSMutableSet *presenceChannels = nil;
+    if ([channelsOnly count] != [channels count]) {
+        
+        // Add presence channels to corresponding storage.
+        presenceChannels = [NSMutableSet setWithArray:channels];
+        [presenceChannels minusSet:[NSSet setWithArray:channelsOnly]];
+    }
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        NSArray *channelsOnly = [PNChannel objectsWithOutPresenceFrom:channels];
-        if ([channelsOnly count] != [channels count]) {
+        if (presenceChannels) {
             
-            // Add presence channels to corresponding storage.
-            NSMutableSet *channelsSet = [NSMutableSet setWithArray:channels];
-            [channelsSet minusSet:[NSSet setWithArray:channelsOnly]];
-            [self.presenceChannelsSet unionSet:channelsSet];
+            snapshot.presenceChannels = [snapshot.presenceChannels setByAddingObjectsFromSet:presenceChannels];
         }
-        [self.channelsSet addObjectsFromArray:channelsOnly];
-    });
+        snapshot.channels = [snapshot.channels setByAddingObjectsFromArray:channelsOnly];
+        snapshot.version++;
+    }];
 }
 
 - (void)removeChannels:(NSArray<NSString *> *)channels {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    NSSet *channelsSet = [NSSet setWithArray:channels];
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        NSSet *channelsSet = [NSSet setWithArray:channels];
-        [self.presenceChannelsSet minusSet:channelsSet];
-        [self.channelsSet minusSet:channelsSet];
-    });
+        NSMutableSet *presenceChannels = [snapshot.presenceChannels mutableCopy];
+        NSMutableSet *subscribedChannels = [snapshot.channels mutableCopy];
+        [presenceChannels minusSet:channelsSet];
+        [subscribedChannels minusSet:channelsSet];
+        snapshot.presenceChannels = presenceChannels;
+        snapshot.channels = subscribedChannels;
+        snapshot.version++;
+    }];
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    [self.client.presenceIndex removeChannels:channels];
+    #pragma clang diagnostic pop
 }
 
 - (NSArray<NSString *> *)channelGroups {
     
-    __block NSArray *channelGroups = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ channelGroups = self.channelGroupsSet.allObjects; });
-    
-    return channelGroups;
+    return self.snapshot.channelGroups.allObjects;
 }
 
 - (void)addChannelGroups:(NSArray<NSString *> *)groups {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{ 
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        [self.channelGroupsSet addObjectsFromArray:groups];
-    });
+        snapshot.channelGroups = [snapshot.channelGroups setByAddingObjectsFromArray:groups];
+        snapshot.version++;
+    }];
 }
 
 - (void)removeChannelGroups:(NSArray<NSString *> *)groups {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    NSSet *groupsSet = [NSSet setWithArray:groups];
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        [self.channelGroupsSet minusSet:[NSSet setWithArray:groups]];
-    });
+        NSMutableSet *channelGroups = [snapshot.channelGroups mutableCopy];
+        [channelGroups minusSet:groupsSet];
+        snapshot.channelGroups = channelGroups;
+        snapshot.version++;
+    }];
 }
 
 - (NSArray<NSString *> *)presenceChannels {
     
-    __block NSArray *presenceChannels = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{
-        
-        presenceChannels = self.presenceChannelsSet.allObjects;
-    });
-    
-    return presenceChannels;
+    return self.snapshot.presenceChannels.allObjects;
 }
 
 - (void)addPresenceChannels:(NSArray<NSString *> *)presenceChannels {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        [self.presenceChannelsSet addObjectsFromArray:presenceChannels];
-    });
+        snapshot.presenceChannels = [snapshot.presenceChannels setByAddingObjectsFromArray:presenceChannels];
+        snapshot.version++;
+    }];
 }
 
 - (void)removePresenceChannels:(NSArray<NSString *> *)presenceChannels {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    NSSet *channelsSet = [NSSet setWithArray:presenceChannels];
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        [self.presenceChannelsSet minusSet:[NSSet setWithArray:presenceChannels]];
-    });
-}
-
-- (NSNumber *)currentTimeToken {
-    
-    __block NSNumber *currentTimeToken = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ currentTimeToken = self->_currentTimeToken; });
-    
-    return currentTimeToken;
-}
-
-- (void)setCurrentTimeToken:(NSNumber *)currentTimeToken {
-    
-    pn_safe_property_write(self.resourceAccessQueue, ^{ self->_currentTimeToken = currentTimeToken; });
-}
-
-- (NSNumber *)lastTimeToken {
-    
-    __block NSNumber *lastTimeToken = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ lastTimeToken = self->_lastTimeToken; });
-    
-    return lastTimeToken;
-}
-
-- (void)setLastTimeToken:(NSNumber *)lastTimeToken {
-    
-    pn_safe_property_write(self.resourceAccessQueue, ^{ self->_lastTimeToken = lastTimeToken; });
-}
-
-- (nullable NSNumber *)overrideTimeToken {
-    
-    __block NSNumber *overrideTimeToken = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ overrideTimeToken = self->_overrideTimeToken; });
-    
-    return overrideTimeToken;
+        NSMutableSet *channels = [snapshot.presenceChannels mutableCopy];
+        [channels minusSet:channelsSet];
+        snapshot.presenceChannels = channels;
+        snapshot.version++;
+    }];
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    [self.client.presenceIndex removeChannels:presenceChannels];
+    #pragma clang diagnostic pop
 }
 
-- (void)setOverrideTimeToken:(nullable NSNumber *)overrideTimeToken {
+- (void)updateSnapshotWithBlock:(void(^)(PNSubscriptionSnapshot *snapshot))block {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    OSSpinLockLock(&_snapshotLock);
+    PNSubscriptionSnapshot *currentSnapshot = _snapshot;
+    PNSubscriptionSnapshot *snapshot = [currentSnapshot copy];
+    block(snapshot);
+    if (snapshot.version != currentSnapshot.version) {
         
-        self->_overrideTimeToken = [PNNumber timeTokenFromNumber:overrideTimeToken];
-    });
-}
-
-- (NSNumber *)currentTimeTokenRegion {
-    
-    __block NSNumber *currentTimeTokenRegion = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ currentTimeTokenRegion = self->_currentTimeTokenRegion; });
-    
-    return currentTimeTokenRegion;
-}
-
-- (void)setCurrentTimeTokenRegion:(NSNumber *)currentTimeTokenRegion {
-    
-    pn_safe_property_write(self.resourceAccessQueue, ^{ self->_currentTimeTokenRegion = currentTimeTokenRegion; });
-}
-
-- (NSNumber *)lastTimeTokenRegion {
-    
-    __block NSNumber *lastTimeTokenRegion = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ lastTimeTokenRegion = self->_lastTimeTokenRegion; });
-    
-    return lastTimeTokenRegion;
-}
-
-- (void)setLastTimeTokenRegion:(NSNumber *)lastTimeTokenRegion {
-    
-    pn_safe_property_write(self.resourceAccessQueue, ^{ self->_lastTimeTokenRegion = lastTimeTokenRegion; });
+        snapshot.allObjects = [[snapshot.channels.allObjects
+                                arrayByAddingObjectsFromArray:snapshot.presenceChannels.allObjects]
+                               arrayByAddingObjectsFromArray:snapshot.channelGroups.allObjects];
+    }
+    self.snapshot = snapshot;
+    OSSpinLockUnlock(&_snapshotLock);
 }
 
 - (void)updateStateTo:(PNSubscriberState)state withStatus:(PNSubscribeStatus *)status {
@@ -717,6 +1235,14 @@ NS_ASSUME_NONNULL_END
             }];
             #pragma clang diagnostic pop
         }
+        
+        // Publish restore requirement, so it can be checked w/o hop on resource access queue.
+        BOOL restoreSubscription = (self->_currentState == PNDisconnectedUnexpectedlySubscriberState &&
+                                    self.mayRequireSubscriptionRestore);
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
+            
+            snapshot.restoreSubscription = restoreSubscription;
+        }];
     });
 }
 
@@ -734,13 +1260,17 @@ NS_ASSUME_NONNULL_END
     if ((self = [super init])) {
         
         _client = client;
-        _channelsSet = [NSMutableSet new];
-        _channelGroupsSet = [NSMutableSet new];
-        _presenceChannelsSet = [NSMutableSet new];
-        _currentTimeToken = @0;
-        _lastTimeToken = @0;
+        _snapshot = [PNSubscriptionSnapshot new];
+        _snapshotLock = OS_SPINLOCK_INIT;
         _resourceAccessQueue = dispatch_queue_create("com.pubnub.subscriber",
                                                      DISPATCH_QUEUE_CONCURRENT);
+        _responsesHandlingQueue = dispatch_queue_create("com.pubnub.subscriber.responses",
+                                                        DISPATCH_QUEUE_SERIAL);
+        _pendingResponses = [NSMutableDictionary new];
+        _expectedResponseIdentifier = 1;
+        _shards = @[];
+        _changesCoalescingQueue = dispatch_queue_create("com.pubnub.subscriber.changes",
+                                                        DISPATCH_QUEUE_SERIAL);
     }
     
     return self;
@@ -748,18 +1278,13 @@ NS_ASSUME_NONNULL_END
 
 - (void)inheritStateFromSubscriber:(PNSubscriber *)subscriber {
     
-    _channelsSet = [subscriber.channelsSet mutableCopy];
-    _channelGroupsSet = [subscriber.channelGroupsSet mutableCopy];
-    _presenceChannelsSet = [subscriber.presenceChannelsSet mutableCopy];
-    if (_channelsSet.count || _channelGroupsSet.count || _presenceChannelsSet.count) {
-        
-        _currentState = PNDisconnectedSubscriberState;
-    }
-    _currentTimeToken = subscriber.currentTimeToken;
-    _lastTimeToken = subscriber.lastTimeToken;
-    _currentTimeTokenRegion = subscriber.currentTimeTokenRegion;
-    _lastTimeTokenRegion = subscriber.lastTimeTokenRegion;
-    _escapedFilterExpression = subscriber.escapedFilterExpression;
+    PNSubscriptionSnapshot *snapshot = [subscriber.snapshot copy];
+    snapshot.version = _snapshot.version + 1;
+    snapshot.overrideTimeToken = 0;
+    snapshot.escapedState = nil;
+    snapshot.restoreSubscription = NO;
+    if (snapshot.allObjects.count) { _currentState = PNDisconnectedSubscriberState; }
+    _snapshot = snapshot;
 }
 
 
@@ -767,27 +1292,17 @@ NS_ASSUME_NONNULL_END
 
 - (NSString *)filterExpression {
     
-    __block NSString *expression = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ expression = _filterExpression; });
-
-    return expression;
+    return self.snapshot.filterExpression;
 }
 
 - (void)setFilterExpression:(nullable NSString *)filterExpression {
     
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+    NSString *escapedFilterExpression = (filterExpression? [PNString percentEscapedString:filterExpression] : nil);
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
-        _filterExpression = [filterExpression copy];
-        _escapedFilterExpression = (filterExpression? [PNString percentEscapedString:filterExpression] : nil);
-    });
-}
-
-- (NSString *)escapedFilterExpression {
-    
-    __block NSString *expression = nil;
-    pn_safe_property_read(self.resourceAccessQueue, ^{ expression = _escapedFilterExpression; });
-    
-    return expression;
+        snapshot.filterExpression = filterExpression;
+        snapshot.escapedFilterExpression = escapedFilterExpression;
+    }];
 }
 
 
@@ -797,7 +1312,13 @@ NS_ASSUME_NONNULL_END
                       withState:(nullable NSDictionary<NSString *, id> *)state 
                      completion:(nullable PNSubscriberCompletionBlock)block {
     
-    [self subscribe:YES usingTimeToken:timeToken withState:state completion:block];
+    [self enqueueChangesWithRemovedObjects:nil block:^(PNSubscriptionChanges *changes) {
+        
+        changes.subscribeRequested = YES;
+        if (timeToken) { changes.timeToken = timeToken; }
+        if (state.count) { [changes.state addEntriesFromDictionary:state]; }
+        if (block) { [changes.subscribeBlocks addObject:block]; }
+    }];
 }
 
 - (void)subscribe:(BOOL)initialSubscribe usingTimeToken:(nullable NSNumber *)timeToken 
@@ -815,32 +1336,30 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
     if ([self allObjects].count) {
 
-        // Storing time token override
-        self.overrideTimeToken = timeToken;
-        
         // In case if block is passed, it mean what subscription has been requested by user or
         // internal logic (like unsubscribe and re-subscribe on the rest of the channels/groups).
-        if (initialSubscribe) {
+        if (initialSubscribe) { self.mayRequireSubscriptionRestore = NO; }
+        uint64_t overrideTimeToken = [PNNumber timeTokenFromNumber:timeToken].unsignedLongLongValue;
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
             
-            self.mayRequireSubscriptionRestore = NO;
-            pn_safe_property_write(self.resourceAccessQueue, ^{
+            // Storing time token override
+            snapshot.overrideTimeToken = overrideTimeToken;
+            if (initialSubscribe) {
                 
-                if (self->_currentTimeToken && [self->_currentTimeToken compare:@0] != NSOrderedSame) {
-                    
-                    self->_lastTimeToken = self->_currentTimeToken;
-                }
-                if (self->_currentTimeTokenRegion && [self->_currentTimeTokenRegion compare:@0] != NSOrderedSame &&
-                    [self->_currentTimeTokenRegion compare:@(-1)] == NSOrderedDescending) {
+                if (snapshot.currentTimeToken != 0) { snapshot.lastTimeToken = snapshot.currentTimeToken; }
+                if (snapshot.currentTimeTokenRegion > 0) {
                     
-                    self->_lastTimeTokenRegion = self->_currentTimeTokenRegion;
+                    snapshot.lastTimeTokenRegion = snapshot.currentTimeTokenRegion;
                 }
-                self->_currentTimeToken = @0;
-                self->_currentTimeTokenRegion = @(-1);
-            });
-        }
-        
-        PNRequestParameters *parameters = [self subscribeRequestParametersWithState:state];
+                snapshot.currentTimeToken = 0;
+                snapshot.currentTimeTokenRegion = -1;
+                snapshot.restoreSubscription = NO;
+            }
+        }];
         
+        BOOL isInitialSubscription = NO;
+        PNRequestParameters *parameters = [self subscribeRequestParametersWithState:state
+                                                                 initialSubscription:&isInitialSubscription];
         if (initialSubscribe) {
             
             DDLogAPICall([[self class] ddLogLevel], @"<PubNub::API> Subscribe (channels: %@; groups: %@)%@",
@@ -848,16 +1367,50 @@ NS_ASSUME_NONNULL_END
                          (timeToken ? [NSString stringWithFormat:@" with catch up from %@.", timeToken] : @"."));
         }
         
+        // Long-poll requests (non-zero time token) allow to start next subscription cycle right after raw
+        // response arrival, while received events will be parsed and delivered.
+        // 'cycleContinued' accessed only from 'responsesHandlingQueue'.
+        int64_t responseIdentifier = OSAtomicIncrement64Barrier(&_lastResponseIdentifier);
+        __block BOOL cycleContinued = NO;
         __weak __typeof(self) weakSelf = self;
-        [self.client processOperation:PNSubscribeOperation withParameters:parameters
-                      completionBlock:^(PNStatus *status){
+        PNNetworkResponseDataBlock dataBlock = nil;
+        if (!isInitialSubscription) {
+            
+            dataBlock = ^(NSData *data) {
+                
+                // Block called on transport's delegate queue. Next request can't be issued from it, because
+                // transport wait for same queue to cancel running tasks. Response handling for this request
+                // will be scheduled on same queue later, so it will see updated 'cycleContinued'.
+                __strong __typeof(self) strongSelf = weakSelf;
+                pn_dispatch_async(strongSelf.responsesHandlingQueue, ^{
+                    
+                    uint64_t timeToken = 0;
+                    int32_t region = -1;
+                    if ([PNSubscribeParser getTimeToken:&timeToken region:&region fromResponseData:data]) {
+                        
+                        cycleContinued = YES;
+                        [strongSelf handleSubscription:NO timeToken:timeToken region:region];
+                        
+                        // Next long-poll shouldn't be sent while listeners can't keep up with received
+                        // events (if configured), or responses will pile up in pending responses.
+                        [strongSelf continueSubscriptionCycleWhenDeliveryBufferHasSpace];
+                    }
+                });
+            };
+        }
+        [self.client processOperation:PNSubscribeOperation withParameters:parameters data:nil
+                    responseDataBlock:dataBlock completionBlock:^(PNStatus *status){
                           
               __strong __typeof(self) strongSelf = weakSelf;
-              [strongSelf handleSubscriptionStatus:(PNSubscribeStatus *)status];
-              if (block) {
+              [strongSelf handleResponse:responseIdentifier withBlock:^{
                   
-                  pn_dispatch_async(weakSelf.client.callbackQueue, ^{ block((PNSubscribeStatus *)status); });
-              }
+                  [strongSelf handleSubscriptionStatus:(PNSubscribeStatus *)status
+                                   initialSubscription:isInitialSubscription cycleContinued:cycleContinued];
+                  if (block) {
+                      
+                      pn_dispatch_async(strongSelf.client.callbackQueue, ^{ block((PNSubscribeStatus *)status); });
+                  }
+              }];
           }];
     }
     else {
@@ -865,18 +1418,19 @@ NS_ASSUME_NONNULL_END
         PNStatus *status = [PNStatus statusForOperation:PNSubscribeOperation category:PNDisconnectedCategory
                                     withProcessingError:nil];
         [self.client appendClientInformation:status];
-        pn_safe_property_write(self.resourceAccessQueue, ^{
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
             
-            self->_lastTimeToken = @0;
-            self->_currentTimeToken = @0;
-            self->_lastTimeTokenRegion = @(-1);
-            self->_currentTimeTokenRegion = @(-1);
-        });
+            snapshot.lastTimeToken = 0;
+            snapshot.currentTimeToken = 0;
+            snapshot.lastTimeTokenRegion = -1;
+            snapshot.currentTimeTokenRegion = -1;
+        }];
         if (block) {
             
             pn_dispatch_async(self.client.callbackQueue, ^{ block((PNSubscribeStatus *)status); });
         }
         [self updateStateTo:PNDisconnectedSubscriberState withStatus:(PNSubscribeStatus *)status];
+        [self stopShards];
         [self.client cancelAllLongPollingOperations];
         [self.client callBlock:nil status:YES withResult:nil andStatus:status];
     }
@@ -885,16 +1439,8 @@ NS_ASSUME_NONNULL_END
 
 - (void)restoreSubscriptionCycleIfRequiredWithCompletion:(nullable PNSubscriberCompletionBlock)block {
     
-    __block BOOL shouldRestore;
-    __block BOOL ableToRestore;
-    pn_safe_property_read(self.resourceAccessQueue, ^{
-        
-        shouldRestore = (self.currentState == PNDisconnectedUnexpectedlySubscriberState &&
-                         self.mayRequireSubscriptionRestore);
-        ableToRestore = ([self.channelsSet count] || [self.channelGroupsSet count] ||
-                         [self.presenceChannelsSet count]);
-    });
-    if (shouldRestore && ableToRestore) {
+    PNSubscriptionSnapshot *snapshot = self.snapshot;
+    if (snapshot.shouldRestoreSubscription && snapshot.allObjects.count > 0) {
         
         [self subscribeUsingTimeToken:nil withState:nil completion:block];
     }
@@ -906,40 +1452,62 @@ NS_ASSUME_NONNULL_END
     [self subscribe:NO usingTimeToken:nil withState:nil completion:block];
 }
 
-- (void)unsubscribeFromAll {
+- (void)continueSubscriptionCycleWhenDeliveryBufferHasSpace {
     
+    int64_t responseIdentifier = OSAtomicAdd64Barrier(0, &_lastResponseIdentifier);
     __weak __typeof(self) weakSelf = self;
-    NSArray *channelGroups = [self.channelGroups copy];
-    PNSubscriberCompletionBlock channelUnsubscribeBlock = ^(__unused PNSubscribeStatus * _Nullable status) {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    [self.client.listenersManager performWhenDeliveryBufferHasSpace:^{
         
         __strong __typeof(self) strongSelf = weakSelf;
-        [strongSelf removeChannelGroups:channelGroups];
-        [strongSelf unsubscribeFrom:NO objects:channelGroups informingListener:YES subscribeOnRest:NO 
-                         completion:nil];
-    };
+        if (strongSelf && OSAtomicAdd64Barrier(0, &strongSelf->_lastResponseIdentifier) == responseIdentifier) {
+            
+            [strongSelf continueSubscriptionCycleIfRequiredWithCompletion:nil];
+        }
+    } onQueue:self.responsesHandlingQueue];
+    #pragma clang diagnostic pop
+}
+
+- (void)unsubscribeFromAll {
     
-    if (self.channels.count > 0) {
+    NSArray<NSString *> *channels = [self.channels copy];
+    NSArray<NSString *> *channelGroups = [self.channelGroups copy];
+    if (channels.count > 0 || channelGroups.count > 0) {
         
-        BOOL hasChannelGroups = (channelGroups.count > 0);
-        NSArray *objects = [self.channels copy];
-        [self removeChannels:objects];
-        [self removePresenceChannels:self.presenceChannels];
-        [self unsubscribeFrom:YES objects:objects informingListener:!hasChannelGroups
-              subscribeOnRest:NO completion:(hasChannelGroups ? channelUnsubscribeBlock : nil)];
+        NSArray<NSString *> *presenceChannels = [self.presenceChannels copy];
+        [self removeChannels:channels];
+        [self removePresenceChannels:presenceChannels];
+        [self removeChannelGroups:channelGroups];
+        NSArray<NSString *> *allChannels = [channels arrayByAddingObjectsFromArray:presenceChannels];
+        [self enqueueChangesWithRemovedObjects:[allChannels arrayByAddingObjectsFromArray:channelGroups]
+                                         block:^(PNSubscriptionChanges *changes) {
+            
+            changes.unsubscribeRequested = YES;
+            [changes.removedChannels addObjectsFromArray:allChannels];
+            [changes.removedChannelGroups addObjectsFromArray:channelGroups];
+        }];
     }
-    else if (channelGroups.count > 0) { channelUnsubscribeBlock(nil); }
 }
 
 - (void)unsubscribeFrom:(BOOL)channels objects:(NSArray<NSString *> *)objects
              completion:(nullable PNSubscriberCompletionBlock)block {
     
-    [self unsubscribeFrom:channels objects:objects informingListener:YES subscribeOnRest:YES
-               completion:block];
+    [self enqueueChangesWithRemovedObjects:objects block:^(PNSubscriptionChanges *changes) {
+        
+        changes.unsubscribeRequested = YES;
+        [(channels ? changes.removedChannels : changes.removedChannelGroups) addObjectsFromArray:objects];
+        if (block) { [changes.unsubscribeBlocks addObject:block]; }
+    }];
 }
 
-- (void)unsubscribeFrom:(BOOL)channels objects:(NSArray<NSString *> *)objects
-      informingListener:(BOOL)shouldInformListener subscribeOnRest:(BOOL)subscribeOnRestChannels
-             completion:(nullable PNSubscriberCompletionBlock)block {
+- (void)unsubscribeFromChannels:(NSArray<NSString *> *)channels groups:(NSArray<NSString *> *)groups
+                     completion:(void(^)(PNStatus *status, BOOL leaveSent))block {
     
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
@@ -948,102 +1516,204 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    [self.client.clientStateManager removeStateForObjects:objects];
-    NSArray *objectWithOutPresence = [PNChannel objectsWithOutPresenceFrom:objects];
+    [self.client.clientStateManager removeStateForObjects:[channels arrayByAddingObjectsFromArray:groups]];
+    NSArray *channelsWithOutPresence = [PNChannel objectsWithOutPresenceFrom:channels];
+    NSArray *groupsWithOutPresence = [PNChannel objectsWithOutPresenceFrom:groups];
     PNStatus *successStatus = [PNStatus statusForOperation:PNUnsubscribeOperation
                                                   category:PNAcknowledgmentCategory withProcessingError:nil];
     [self.client appendClientInformation:successStatus];
     __weak __typeof(self) weakSelf = self;
     
     DDLogAPICall([[self class] ddLogLevel], @"<PubNub::API> Unsubscribe (channels: %@; groups: %@)",
-                 (channels ? objectWithOutPresence : nil), (!channels ? objectWithOutPresence : nil));
+                 (channelsWithOutPresence.count ? channelsWithOutPresence : nil),
+                 (groupsWithOutPresence.count ? groupsWithOutPresence : nil));
     
-    NSSet *subscriptionObjects = [NSSet setWithArray:[self allObjects]];
-    if (subscriptionObjects.count == 0) {
+    if ([self allObjects].count == 0) {
         
-        pn_safe_property_write(self.resourceAccessQueue, ^{
+        [self stopShards];
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
             
-            self->_lastTimeToken = @0;
-            self->_currentTimeToken = @0;
-            self->_lastTimeTokenRegion = @(-1);
-            self->_currentTimeTokenRegion = @(-1);
-        });
+            snapshot.lastTimeToken = 0;
+            snapshot.currentTimeToken = 0;
+            snapshot.lastTimeTokenRegion = -1;
+            snapshot.currentTimeTokenRegion = -1;
+        }];
     }
     
-    if (objectWithOutPresence.count) {
+    dispatch_block_t completionBlock = ^{
         
-        NSString *objectsList = [PNChannel namesForRequest:objectWithOutPresence defaultString:@","];
+        [weakSelf updateStateTo:PNDisconnectedSubscriberState withStatus:(PNSubscribeStatus *)successStatus];
+        [weakSelf.client callBlock:nil status:YES withResult:nil andStatus:successStatus];
+    };
+    
+    if (channelsWithOutPresence.count || groupsWithOutPresence.count) {
+        
+        // Channel groups passed in path as well, if there is no channels to leave.
+        NSString *groupsList = [PNChannel namesForRequest:groupsWithOutPresence defaultString:@","];
+        NSString *channelsList = (channelsWithOutPresence.count ? [PNChannel namesForRequest:channelsWithOutPresence]
+                                                                : groupsList);
         PNRequestParameters *parameters = [PNRequestParameters new];
-        [parameters addPathComponent:objectsList forPlaceholder:@"{channels}"];
-        if (!channels) { [parameters addQueryParameter:objectsList forFieldName:@"channel-group"]; }
+        [parameters addPathComponent:channelsList forPlaceholder:@"{channels}"];
+        if (groupsWithOutPresence.count) {
+            
+            [parameters addQueryParameter:groupsList forFieldName:@"channel-group"];
+        }
         [self.client processOperation:PNUnsubscribeOperation withParameters:parameters
                       completionBlock:^(__unused PNStatus *status1){
                           
-            if (shouldInformListener) {
-                
-                [weakSelf updateStateTo:PNDisconnectedSubscriberState
-                             withStatus:(PNSubscribeStatus *)successStatus];
-            }
-            [weakSelf.client callBlock:nil status:YES withResult:nil andStatus:successStatus];
-            BOOL listChanged = ![[NSSet setWithArray:[weakSelf allObjects]] isEqualToSet:subscriptionObjects];
-            if (subscribeOnRestChannels && (subscriptionObjects.count > 0 && !listChanged)) {
-                
-                [weakSelf subscribe:YES usingTimeToken:nil withState:nil completion:nil];
-            }
-            else if (block) {
-                    
-                pn_dispatch_async(weakSelf.client.callbackQueue, ^{
-                    
-                    block((PNSubscribeStatus *)successStatus);
-                });
-            }
+            completionBlock();
+            block(successStatus, YES);
         }];
     }
     else {
         
-        [self subscribe:YES usingTimeToken:nil withState:nil
-             completion:^(__unused PNSubscribeStatus *status) {
-            
-            if (block) {
-                
-                pn_dispatch_async(weakSelf.client.callbackQueue, ^{
-                
-                    block((PNSubscribeStatus *)successStatus);
-                });
-            }
-            if (shouldInformListener) {
-                
-                [weakSelf updateStateTo:PNDisconnectedSubscriberState
-                             withStatus:(PNSubscribeStatus *)successStatus];
-            }
-            [weakSelf.client callBlock:nil status:YES withResult:nil andStatus:successStatus];
-        }];
+        completionBlock();
+        block(successStatus, NO);
     }
     #pragma clang diagnostic pop
 }
 
-- (void)startRetryTimer {
+
+#pragma mark - Coalescing
+
+- (void)enqueueChangesWithRemovedObjects:(NSArray<NSString *> *)removedObjects
+                                   block:(void(^)(PNSubscriptionChanges *changes))block {
     
-    [self stopRetryTimer];
+    NSArray<NSString *> *subscribedObjects = [self allObjects];
+    NSTimeInterval interval = MAX(self.client.configuration.subscribeCoalescingInterval, 0.f);
+    if (interval == 0.f) {
+        
+        PNSubscriptionChanges *changes = [PNSubscriptionChanges new];
+        [changes.subscribedObjects addObjectsFromArray:subscribedObjects];
+        if (removedObjects) { [changes.subscribedObjects addObjectsFromArray:removedObjects]; }
+        block(changes);
+        [self applySubscriptionChanges:changes];
+        return;
+    }
     
-    __weak __typeof(self) weakSelf = self;
-    dispatch_queue_t timerQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
-    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, timerQueue);
-    dispatch_source_set_event_handler(timer, ^{
+    dispatch_async(self.changesCoalescingQueue, ^{
         
-        // Silence static analyzer warnings.
-        // Code is aware about this case and at the end will simply call on 'nil' object method.
-        // In most cases if referenced object become 'nil' it mean what there is no more need in
-        // it and probably whole client instance has been deallocated.
-        #pragma clang diagnostic push
-        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
-        [weakSelf continueSubscriptionCycleIfRequiredWithCompletion:nil];
-        #pragma clang diagnostic pop
-    });
-    dispatch_time_t start = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kPubNubSubscriptionRetryInterval * NSEC_PER_SEC));
-    dispatch_source_set_timer(timer, start, (uint64_t)(kPubNubSubscriptionRetryInterval * NSEC_PER_SEC), NSEC_PER_SEC);
-    self.retryTimer = timer;
-    dispatch_resume(timer);
+        if (!self.pendingChanges) {
+            
+            PNSubscriptionChanges *changes = [PNSubscriptionChanges new];
+            [changes.subscribedObjects addObjectsFromArray:subscribedObjects];
+            if (removedObjects) { [changes.subscribedObjects addObjectsFromArray:removedObjects]; }
+            self.pendingChanges = changes;
+            
+            __weak __typeof(self) weakSelf = self;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(interval * NSEC_PER_SEC)),
+                           self.changesCoalescingQueue, ^{
+                
+                __strong __typeof(self) strongSelf = weakSelf;
+                PNSubscriptionChanges *windowChanges = strongSelf.pendingChanges;
+                strongSelf.pendingChanges = nil;
+                if (windowChanges) { [strongSelf applySubscriptionChanges:windowChanges]; }
+            });
+        }
+        block(self.pendingChanges);
+    });
+}
+
+- (void)applySubscriptionChanges:(PNSubscriptionChanges *)changes {
+    
+    NSNumber *timeToken = changes.timeToken;
+    NSDictionary *state = (changes.state.count ? [changes.state copy] : nil);
+    NSArray<PNSubscriberCompletionBlock> *subscribeBlocks = [changes.subscribeBlocks copy];
+    PNSubscriberCompletionBlock subscribeBlock = nil;
+    if (subscribeBlocks.count) {
+        
+        subscribeBlock = ^(PNSubscribeStatus *status) {
+            
+            for (PNSubscriberCompletionBlock block in subscribeBlocks) { block(status); }
+        };
+    }
+    
+    if (!changes.unsubscribeRequested) {
+        
+        [self subscribe:YES usingTimeToken:timeToken withState:state completion:subscribeBlock];
+        return;
+    }
+    
+    // Objects which has been added and removed during same window (or removed and added back) don't require
+    // 'leave' request.
+    NSSet<NSString *> *objects = [NSSet setWithArray:[self allObjects]];
+    NSMutableArray<NSString *> *channels = [NSMutableArray new];
+    NSMutableArray<NSString *> *groups = [NSMutableArray new];
+    for (NSString *channel in changes.removedChannels) {
+        
+        if ([changes.subscribedObjects containsObject:channel] && ![objects containsObject:channel]) {
+            
+            [channels addObject:channel];
+        }
+    }
+    for (NSString *group in changes.removedChannelGroups) {
+        
+        if ([changes.subscribedObjects containsObject:group] && ![objects containsObject:group]) {
+            
+            [groups addObject:group];
+        }
+    }
+    
+    BOOL subscribeRequested = changes.subscribeRequested;
+    NSArray<PNSubscriberCompletionBlock> *unsubscribeBlocks = [changes.unsubscribeBlocks copy];
+    __weak __typeof(self) weakSelf = self;
+    [self unsubscribeFromChannels:channels groups:groups completion:^(PNStatus *status, BOOL leaveSent) {
+        
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+        // 'leave' request cancel active long-poll request, so subscription on rest of objects should be
+        // restored. If 'leave' hasn't been sent, subscribe request will update presence channels list (or
+        // will stop long-poll if subscription list is empty).
+        if (subscribeRequested || !leaveSent || [weakSelf allObjects].count) {
+            
+            [weakSelf subscribe:YES usingTimeToken:timeToken withState:state completion:subscribeBlock];
+        }
+        if (unsubscribeBlocks.count) {
+            
+            pn_dispatch_async(weakSelf.client.callbackQueue, ^{
+                
+                for (PNSubscriberCompletionBlock block in unsubscribeBlocks) { block((PNSubscribeStatus *)status); }
+            });
+        }
+        #pragma clang diagnostic pop
+    }];
+}
+
+- (void)startRetryTimer {
+    
+    [self stopRetryTimer];
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    PNMetricsIncrement(self.client.metricsCounters, subscribeRetries);
+    #pragma clang diagnostic pop
+    
+    __weak __typeof(self) weakSelf = self;
+    dispatch_queue_t timerQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, timerQueue);
+    dispatch_source_set_event_handler(timer, ^{
+        
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        [weakSelf continueSubscriptionCycleIfRequiredWithCompletion:nil];
+        #pragma clang diagnostic pop
+    });
+    dispatch_time_t start = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kPubNubSubscriptionRetryInterval * NSEC_PER_SEC));
+    dispatch_source_set_timer(timer, start, (uint64_t)(kPubNubSubscriptionRetryInterval * NSEC_PER_SEC), NSEC_PER_SEC);
+    self.retryTimer = timer;
+    dispatch_resume(timer);
 }
 
 - (void)stopRetryTimer {
@@ -1053,23 +1723,137 @@ NS_ASSUME_NONNULL_END
     self.retryTimer = nil;
 }
 
+- (void)updateShards:(NSArray<PNSubscribeShard *> *)shards {
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+        
+        NSMutableArray<PNSubscribeShard *> *updatedShards = [NSMutableArray new];
+        for (PNSubscribeShard *shard in shards) {
+            
+            PNSubscribeShard *currentShard = nil;
+            if (shard.index <= self.shards.count) { currentShard = self.shards[shard.index - 1]; }
+            NSSet *objects = [NSSet setWithArray:shard.objects];
+            if (currentShard && [[NSSet setWithArray:currentShard.objects] isEqualToSet:objects]) {
+                
+                [updatedShards addObject:currentShard];
+                continue;
+            }
+            
+            // Shard objects changed, so long-poll loop should be stopped and started along with main loop
+            // (same way as main loop does on subscription list change).
+            if (currentShard) { [self.client cancelLongPollingOperationsInShard:shard.index]; }
+            [updatedShards addObject:shard];
+        }
+        
+        // Cancel long-poll requests for shards which not needed anymore.
+        for (NSUInteger shardIdx = updatedShards.count; shardIdx < self.shards.count; shardIdx++) {
+            
+            [self.client cancelLongPollingOperationsInShard:(shardIdx + 1)];
+        }
+        self.shards = [updatedShards copy];
+    });
+}
+
+- (void)startInactiveShardsWithTimeToken:(uint64_t)timeToken region:(int32_t)region {
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+        
+        for (PNSubscribeShard *shard in self.shards) {
+            
+            if (!shard.isActive) {
+                
+                shard.timeToken = timeToken;
+                shard.region = region;
+                [self subscribeShard:shard];
+            }
+        }
+    });
+}
+
+- (void)stopShards {
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+        
+        for (PNSubscribeShard *shard in self.shards) {
+            
+            [self.client cancelLongPollingOperationsInShard:shard.index];
+        }
+        self.shards = @[];
+    });
+}
+
+- (void)subscribeShard:(PNSubscribeShard *)shard {
+    
+    pn_safe_property_write(self.resourceAccessQueue, ^{
+        
+        if ([self.shards indexOfObjectIdenticalTo:shard] == NSNotFound) { return; }
+        
+        shard.active = YES;
+        NSUInteger requestIdentifier = ++shard.requestIdentifier;
+        PNRequestParameters *parameters = [self subscribeRequestParametersForShard:shard];
+        __weak __typeof(self) weakSelf = self;
+        [self.client processSubscribeOperationInShard:shard.index withParameters:parameters
+                                      completionBlock:^(PNStatus *status) {
+            
+            // Silence static analyzer warnings.
+            // Code is aware about this case and at the end will simply call on 'nil' object method.
+            // In most cases if referenced object become 'nil' it mean what there is no more need in
+            // it and probably whole client instance has been deallocated.
+            #pragma clang diagnostic push
+            #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+            [weakSelf handleShard:shard subscriptionStatus:(PNSubscribeStatus *)status
+                       forRequest:requestIdentifier];
+            #pragma clang diagnostic pop
+        }];
+    });
+}
+
 
 #pragma mark - Handlers
 
-- (void)handleSubscriptionStatus:(PNSubscribeStatus *)status {
+- (void)handleResponse:(int64_t)identifier withBlock:(dispatch_block_t)block {
+    
+    dispatch_async(self.responsesHandlingQueue, ^{
+        
+        // Slot for this identifier already has been released, so response is late and would be handled after
+        // newer ones. Its state and events are outdated and should be dropped.
+        if (identifier < self.expectedResponseIdentifier || self.pendingResponses[@(identifier)]) {
+            
+            DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Subscriber> Drop late response #%lld.",
+                            (long long)identifier);
+            return;
+        }
+        
+        self.pendingResponses[@(identifier)] = [block copy];
+        [self handleQueuedResponses];
+    });
+}
+
+- (void)handleQueuedResponses {
+    
+    dispatch_block_t handlingBlock = nil;
+    while ((handlingBlock = self.pendingResponses[@(self.expectedResponseIdentifier)])) {
+        
+        [self.pendingResponses removeObjectForKey:@(self.expectedResponseIdentifier)];
+        self.expectedResponseIdentifier++;
+        handlingBlock();
+    }
+}
+
+- (void)handleSubscriptionStatus:(PNSubscribeStatus *)status initialSubscription:(BOOL)initialSubscription
+                  cycleContinued:(BOOL)cycleContinued {
 
     [self stopRetryTimer];
     if (!status.isError && status.category != PNCancelledCategory) {
         
-        [self handleSuccessSubscriptionStatus:status];
+        [self handleSuccessSubscriptionStatus:status initialSubscription:initialSubscription
+                               cycleContinued:cycleContinued];
     }
     else { [self handleFailedSubscriptionStatus:status]; }
 }
 
-- (void)handleSuccessSubscriptionStatus:(PNSubscribeStatus *)status {
-    
-    // Try fetch time token from passed result/status objects.
-    BOOL isInitialSubscription = ([status.clientRequest.URL.query rangeOfString:@"tt=0"].location != NSNotFound);
+- (void)handleSuccessSubscriptionStatus:(PNSubscribeStatus *)status initialSubscription:(BOOL)initialSubscription
+                         cycleContinued:(BOOL)cycleContinued {
     
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
@@ -1078,22 +1862,33 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    if (status.data.timetoken != nil && status.clientRequest.URL != nil) {
+    // Time token from response already has been used if next subscription cycle has been started with data
+    // pre-fetched from raw response.
+    NSNumber *timeToken = status.data.timetoken;
+    if (!cycleContinued && timeToken != nil && status.clientRequest.URL != nil) {
         
-        [self handleSubscription:isInitialSubscription timeToken:status.data.timetoken
-                          region:status.data.region];
+        NSNumber *region = status.data.region;
+        [self handleSubscription:initialSubscription timeToken:timeToken.unsignedLongLongValue
+                          region:(region ? region.intValue : -1)];
     }
     
     [self handleLiveFeedEvents:status];
-    [self continueSubscriptionCycleIfRequiredWithCompletion:nil];
+    if (!cycleContinued) {
+        
+        // Suspend subscribe loop while listeners can't keep up with received events (if configured).
+        [self continueSubscriptionCycleWhenDeliveryBufferHasSpace];
+    }
     
     // Because client received new event from service, it can restart reachability timer with
     // new interval.
     [self.client.heartbeatManager startHeartbeatIfRequired];
     
-    if (status.clientRequest.URL != nil && isInitialSubscription) {
+    if (status.clientRequest.URL != nil && initialSubscription) {
         
+        PNSubscriptionSnapshot *snapshot = self.snapshot;
+        [self startInactiveShardsWithTimeToken:snapshot.currentTimeToken region:snapshot.currentTimeTokenRegion];
         [self updateStateTo:PNConnectedSubscriberState withStatus:status];
+        [self.client.presenceIndex seedChannels:[self presenceChannels]];
         [self.client callBlock:nil status:YES withResult:nil andStatus:(PNStatus *)status];
     }
     #pragma clang diagnostic pop
@@ -1162,48 +1957,50 @@ NS_ASSUME_NONNULL_END
                 /* Do nothing, because we can't stop auto-retry in case of network issues.
                  It handled by client configuration. */ };
                 
-                pn_safe_property_write(self.resourceAccessQueue, ^{
+                BOOL shouldTryCatchUp = self.client.configuration.shouldTryCatchUpOnSubscriptionRestore;
+                [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
                     
-                    if (self.client.configuration.shouldTryCatchUpOnSubscriptionRestore) {
+                    if (shouldTryCatchUp) {
                         
-                        if (self->_currentTimeToken &&
-                            [self->_currentTimeToken compare:@0] != NSOrderedSame) {
+                        if (snapshot.currentTimeToken != 0) {
                             
-                            self->_lastTimeToken = self->_currentTimeToken;
-                            self->_currentTimeToken = @0;
+                            snapshot.lastTimeToken = snapshot.currentTimeToken;
+                            snapshot.currentTimeToken = 0;
                         }   
-                        if (self->_currentTimeTokenRegion &&
-                            [self->_currentTimeTokenRegion compare:@0] != NSOrderedSame &&
-                            [self->_currentTimeTokenRegion compare:@(-1)] == NSOrderedDescending) {
+                        if (snapshot.currentTimeTokenRegion > 0) {
                             
-                            self->_lastTimeTokenRegion = self->_currentTimeTokenRegion;
-                            self->_currentTimeTokenRegion = @(-1);
+                            snapshot.lastTimeTokenRegion = snapshot.currentTimeTokenRegion;
+                            snapshot.currentTimeTokenRegion = -1;
                         }
                     }
                     else {
                         
-                        self->_currentTimeToken = @0;
-                        self->_lastTimeToken = @0;
-                        self->_currentTimeTokenRegion = @(-1);
-                        self->_lastTimeTokenRegion = @(-1);
+                        snapshot.currentTimeToken = 0;
+                        snapshot.lastTimeToken = 0;
+                        snapshot.currentTimeTokenRegion = -1;
+                        snapshot.lastTimeTokenRegion = -1;
                     }
-                });
+                }];
             }
             else {
                 
                 // Ask to clean up cache associated with objects
-                [self.client.clientStateManager removeStateForObjects:self.channelsSet.allObjects];
-                [self.client.clientStateManager removeStateForObjects:self.channelGroupsSet.allObjects];
-                pn_safe_property_write(self.resourceAccessQueue, ^{
+                PNSubscriptionSnapshot *currentSnapshot = self.snapshot;
+                [self.client.clientStateManager removeStateForObjects:currentSnapshot.channels.allObjects];
+                [self.client.clientStateManager removeStateForObjects:currentSnapshot.channelGroups.allObjects];
+                [self.client.presenceIndex removeAllChannels];
+                [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
                     
-                    self.channelsSet = [NSMutableSet new];
-                    self.channelGroupsSet = [NSMutableSet new];
-                    self.presenceChannelsSet = [NSMutableSet new];
-                    self->_currentTimeToken = @0;
-                    self->_lastTimeToken = @0;
-                    self->_currentTimeTokenRegion = @(-1);
-                    self->_lastTimeTokenRegion = @(-1);
-                });
+                    snapshot.channels = [NSSet new];
+                    snapshot.channelGroups = [NSSet new];
+                    snapshot.presenceChannels = [NSSet new];
+                    snapshot.version++;
+                    snapshot.currentTimeToken = 0;
+                    snapshot.lastTimeToken = 0;
+                    snapshot.currentTimeTokenRegion = -1;
+                    snapshot.lastTimeTokenRegion = -1;
+                }];
+                [self stopShards];
             }
             [(PNStatus *)status updateCategory:PNUnexpectedDisconnectCategory];
             
@@ -1215,78 +2012,69 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic pop
 }
 
-- (void)handleSubscription:(BOOL)initialSubscription timeToken:(nullable NSNumber *)timeToken 
-                    region:(nullable NSNumber *)region {
-
-    pn_safe_property_write(self.resourceAccessQueue, ^{
+- (void)handleSubscription:(BOOL)initialSubscription timeToken:(uint64_t)timeToken region:(int32_t)region {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    // 'shouldKeepTimeTokenOnListChange' property should never allow to reset time tokens in case if there is
+    // a few more subscribe requests is waiting for their turn to be sent.
+    PNConfiguration *configuration = self.client.configuration;
+    BOOL shouldKeepTimeToken = configuration.shouldKeepTimeTokenOnListChange;
+    if (!shouldKeepTimeToken) {
+        
+        shouldKeepTimeToken = (configuration.shouldRestoreSubscription &&
+                               configuration.shouldTryCatchUpOnSubscriptionRestore);
+    }
+    #pragma clang diagnostic pop
+    
+    [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *snapshot) {
         
         // Whether new time token from response should be applied for next subscription cycle or
         // not.
         BOOL shouldAcceptNewTimeToken = YES;
         
         // Whether time token should be overridden despite subscription behaviour configuration.
-        BOOL shouldOverrideTimeToken = (initialSubscription && self->_overrideTimeToken &&
-                                        [self->_overrideTimeToken compare:@0] != NSOrderedSame);
+        BOOL shouldOverrideTimeToken = (initialSubscription && snapshot.overrideTimeToken != 0);
         
-        // Silence static analyzer warnings.
-        // Code is aware about this case and at the end will simply call on 'nil' object method.
-        // In most cases if referenced object become 'nil' it mean what there is no more need in
-        // it and probably whole client instance has been deallocated.
-        #pragma clang diagnostic push
-        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
-        #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
         if (initialSubscription) {
             
-            // 'shouldKeepTimeTokenOnListChange' property should never allow to reset time tokens in
-            // case if there is a few more subscribe requests is waiting for their turn to be sent.
-            BOOL shouldUseLastTimeToken = self.client.configuration.shouldKeepTimeTokenOnListChange;
-            if (!shouldUseLastTimeToken) {
-                
-                shouldUseLastTimeToken = (self.client.configuration.shouldRestoreSubscription &&
-                                          self.client.configuration.shouldTryCatchUpOnSubscriptionRestore);
-            }
-            shouldUseLastTimeToken = (shouldUseLastTimeToken && !shouldOverrideTimeToken);
+            BOOL shouldUseLastTimeToken = (shouldKeepTimeToken && !shouldOverrideTimeToken);
             
             // Ensure what we already don't use value from previous time token assigned during
             // previous sessions.
-            if (shouldUseLastTimeToken && self->_lastTimeToken &&
-                [self->_lastTimeToken compare:@0] != NSOrderedSame) {
+            if (shouldUseLastTimeToken && snapshot.lastTimeToken != 0) {
                 
                 shouldAcceptNewTimeToken = NO;
                 
                 // Swap time tokens to catch up on events which happened while client changed
                 // channels and groups list configuration.
-                self->_currentTimeToken = self->_lastTimeToken;
-                self->_lastTimeToken = @0;
-                self->_currentTimeTokenRegion = self->_lastTimeTokenRegion;
-                self->_lastTimeTokenRegion = @(-1);
+                snapshot.currentTimeToken = snapshot.lastTimeToken;
+                snapshot.lastTimeToken = 0;
+                snapshot.currentTimeTokenRegion = snapshot.lastTimeTokenRegion;
+                snapshot.lastTimeTokenRegion = -1;
             }
         }
-        #pragma clang diagnostic pop
         // Ensure what client won't handle delayed requests. It is impossible to have non-initial
         // subscription while current time token report 0.
-        if (!initialSubscription && self->_currentTimeToken &&
-            [self->_currentTimeToken compare:@0] == NSOrderedSame) {
-            
-            shouldAcceptNewTimeToken = NO;
-        }
+        if (!initialSubscription && snapshot.currentTimeToken == 0) { shouldAcceptNewTimeToken = NO; }
         
         if (shouldAcceptNewTimeToken) {
             
-            if (self->_currentTimeToken && [self->_currentTimeToken compare:@0] != NSOrderedSame) {
+            if (snapshot.currentTimeToken != 0) { snapshot.lastTimeToken = snapshot.currentTimeToken; }
+            if (snapshot.currentTimeTokenRegion > 0) {
                 
-                self->_lastTimeToken = self->_currentTimeToken;
+                snapshot.lastTimeTokenRegion = snapshot.currentTimeTokenRegion;
             }
-            if (self->_currentTimeTokenRegion && [self->_currentTimeTokenRegion compare:@0] != NSOrderedSame &&
-                [self->_currentTimeTokenRegion compare:@(-1)] == NSOrderedDescending) {
-                
-                self->_lastTimeTokenRegion = self->_currentTimeTokenRegion;
-            }
-            self->_currentTimeToken = (shouldOverrideTimeToken ? self->_overrideTimeToken : timeToken);
-            self->_currentTimeTokenRegion = region;
+            snapshot.currentTimeToken = (shouldOverrideTimeToken ? snapshot.overrideTimeToken : timeToken);
+            snapshot.currentTimeTokenRegion = region;
         }
-        self->_overrideTimeToken = nil;
-    });
+        snapshot.overrideTimeToken = 0;
+    }];
 }
 
 - (void)handleLiveFeedEvents:(PNSubscribeStatus *)status {
@@ -1300,46 +2088,251 @@ NS_ASSUME_NONNULL_END
         // it and probably whole client instance has been deallocated.
         #pragma clang diagnostic push
         #pragma clang diagnostic ignored "-Wreceiver-is-weak"
-        [self.client.listenersManager notifyWithBlock:^{
+        if (self.client.listenersManager.eventsProcessingWorkersCount) {
+            
+            [self handleLiveFeedEvents:events onWorkersForStatus:status];
+        }
+        else {
             
-            // Iterate through array with notifications and report back using callback blocks to the
-            // user.
-            for (NSMutableDictionary<NSString *, id> *event in events) {
+            [self.client.listenersManager notifyWithBlock:^{
                 
-                // Check whether event has been triggered on presence channel or channel group.
-                // In case if check will return YES this is presence event.
-                BOOL isPresenceEvent = (event[@"presenceEvent"] ? YES : NO);
-                if (isPresenceEvent) {
-                    
-                    if (event[@"subscribedChannel"]) {
-                        
-                        event[@"subscribedChannel"] = [PNChannel channelForPresence:event[@"subscribedChannel"]];
-                    }
-                    if (event[@"actualChannel"]) {
-                        
-                        event[@"actualChannel"] = [PNChannel channelForPresence:event[@"actualChannel"]];
-                    }
-                }
+                NSMutableArray<PNMessageResult *> *messages = [NSMutableArray new];
+                NSMutableArray<PNPresenceEventResult *> *presenceEvents = [NSMutableArray new];
+                [self processLiveFeedEvents:events forStatus:status messages:messages
+                             presenceEvents:presenceEvents];
                 
-                id eventResultObject = [status copyWithMutatedData:event];
-                if (isPresenceEvent) {
-                    
-                    object_setClass(eventResultObject, [PNPresenceEventResult class]);
-                    [self handleNewPresenceEvent:((PNPresenceEventResult *)eventResultObject)];
-                }
-                else {
+                // Deliver whole batch with single hop to callback queue.
+                [self.client.listenersManager notifyMessages:messages];
+                [self.client.listenersManager notifyPresenceEvents:presenceEvents];
+            }];
+        }
+        #pragma clang diagnostic pop
+    }
+    [status updateData:[status.serviceData dictionaryWithValuesForKeys:@[@"timetoken", @"region"]]];
+}
+
+- (void)handleLiveFeedEvents:(NSArray<NSMutableDictionary<NSString *, id> *> *)events
+          onWorkersForStatus:(PNSubscribeStatus *)status {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PNStateListener *listenersManager = self.client.listenersManager;
+    #pragma clang diagnostic pop
+    NSMutableDictionary<NSNumber *, NSMutableArray *> *workerEvents = [NSMutableDictionary new];
+    for (NSMutableDictionary<NSString *, id> *event in events) {
+        
+        // Presence events hashed by channel name w/o presence suffix, so they will be processed by same 
+        // worker as messages from this channel.
+        NSString *channel = (event[@"actualChannel"]?: event[@"subscribedChannel"]);
+        if (channel && event[@"presenceEvent"]) { channel = [PNChannel channelForPresence:channel]; }
+        NSNumber *worker = @([listenersManager workerForChannel:(channel?: @"")]);
+        if (!workerEvents[worker]) { workerEvents[worker] = [NSMutableArray new]; }
+        [workerEvents[worker] addObject:event];
+    }
+    
+    [workerEvents enumerateKeysAndObjectsUsingBlock:^(NSNumber *worker, NSMutableArray *eventsForWorker,
+                                                      __unused BOOL *stop) {
+        
+        [listenersManager notifyOnWorker:worker.unsignedIntegerValue withBlock:^{
+            
+            NSMutableArray<PNMessageResult *> *messages = [NSMutableArray new];
+            NSMutableArray<PNPresenceEventResult *> *presenceEvents = [NSMutableArray new];
+            [self processLiveFeedEvents:eventsForWorker forStatus:status messages:messages
+                         presenceEvents:presenceEvents];
+            [listenersManager deliverMessages:messages presenceEvents:presenceEvents];
+        }];
+    }];
+}
+
+- (void)processLiveFeedEvents:(NSArray<NSMutableDictionary<NSString *, id> *> *)events
+                    forStatus:(PNSubscribeStatus *)status
+                     messages:(NSMutableArray<PNMessageResult *> *)messages
+               presenceEvents:(NSMutableArray<PNPresenceEventResult *> *)presenceEvents {
+    
+    // Iterate through array with notifications and prepare batches which will be reported back
+    // to the user.
+    for (NSMutableDictionary<NSString *, id> *event in events) {
+        
+        // Check whether event has been triggered on presence channel or channel group.
+        // In case if check will return YES this is presence event.
+        BOOL isPresenceEvent = (event[@"presenceEvent"] ? YES : NO);
+        if (isPresenceEvent) {
+            
+            if (event[@"subscribedChannel"]) {
+                
+                event[@"subscribedChannel"] = [PNChannel channelForPresence:event[@"subscribedChannel"]];
+            }
+            if (event[@"actualChannel"]) {
+                
+                event[@"actualChannel"] = [PNChannel channelForPresence:event[@"actualChannel"]];
+            }
+        }
+        
+        id eventResultObject = [status copyWithMutatedData:event];
+        if (isPresenceEvent) {
+            
+            object_setClass(eventResultObject, [PNPresenceEventResult class]);
+            [self handleNewPresenceEvent:((PNPresenceEventResult *)eventResultObject)];
+            [presenceEvents addObject:eventResultObject];
+        }
+        else {
+            
+            object_setClass(eventResultObject, [PNMessageResult class]);
+            if ([self handleNewMessage:(PNMessageResult *)eventResultObject]) {
+                
+                [messages addObject:eventResultObject];
+            }
+        }
+    }
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PNMetricsAdd(self.client.metricsCounters, presenceEventsReceived, presenceEvents.count);
+    PNMetricsAdd(self.client.metricsCounters, messagesReceived, (events.count - presenceEvents.count));
+    #pragma clang diagnostic pop
+}
+
+- (void)handleShard:(PNSubscribeShard *)shard subscriptionStatus:(PNSubscribeStatus *)status
+         forRequest:(NSUInteger)requestIdentifier {
+    
+    __block BOOL isActualResponse = NO;
+    pn_safe_property_read(self.resourceAccessQueue, ^{
+        
+        isActualResponse = ([self.shards indexOfObjectIdenticalTo:shard] != NSNotFound &&
+                            shard.requestIdentifier == requestIdentifier);
+    });
+    if (!isActualResponse) { return; }
+    
+    if (status.category == PNCancelledCategory) {
+        
+        // Loop will be resumed with next initial subscription.
+        pn_safe_property_write(self.resourceAccessQueue, ^{
+            
+            if (shard.requestIdentifier == requestIdentifier) { shard.active = NO; }
+        });
+    }
+    else if (!status.isError) {
+        
+        NSNumber *timeToken = status.data.timetoken;
+        NSNumber *region = status.data.region;
+        __block BOOL recovered = NO;
+        pn_safe_property_read(self.resourceAccessQueue, ^{ recovered = shard.isRecovering; });
+        pn_safe_property_write(self.resourceAccessQueue, ^{
+            
+            if (timeToken) { shard.timeToken = timeToken.unsignedLongLongValue; }
+            if (region) { shard.region = region.intValue; }
+            shard.recovering = NO;
+        });
+        
+        // Shard completion called on network's processing queue, which shouldn't be blocked while
+        // subscribe loop waits for listeners.
+        dispatch_async(self.responsesHandlingQueue, ^{
+            
+            [self handleLiveFeedEvents:status];
+            [self.client.listenersManager performWhenDeliveryBufferHasSpace:^{ [self subscribeShard:shard]; }
+                                                                    onQueue:self.responsesHandlingQueue];
+            
+            // Shard recovered after error, so listeners should be notified in same way as they are for main
+            // subscription loop.
+            if (recovered) { [self updateStateTo:PNConnectedSubscriberState withStatus:status]; }
+        });
+    }
+    else {
+        
+        // Shard errors handled in same way as main subscription loop errors, so listeners observe single
+        // subscriber state.
+        PNSubscriberState subscriberState = PNDisconnectedUnexpectedlySubscriberState;
+        BOOL shouldRetry = YES;
+        if (status.category == PNAccessDeniedCategory) { subscriberState = PNAccessRightsErrorSubscriberState; }
+        else if (status.category == PNMalformedFilterExpressionCategory) {
+            
+            // Shard will be restarted with next initial subscription (after filter expression change).
+            subscriberState = PNMalformedFilterExpressionErrorSubscriberState;
+            shouldRetry = NO;
+        }
+        else {
+            
+            // Silence static analyzer warnings.
+            // Code is aware about this case and at the end will simply call on 'nil' object method.
+            // In most cases if referenced object become 'nil' it mean what there is no more need in
+            // it and probably whole client instance has been deallocated.
+            #pragma clang diagnostic push
+            #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+            if (status.category != PNTimeoutCategory && status.category != PNMalformedResponseCategory &&
+                status.category != PNTLSConnectionFailedCategory) {
+                
+                shouldRetry = self.client.configuration.shouldRestoreSubscription;
+            }
+            #pragma clang diagnostic pop
+            [(PNStatus *)status updateCategory:PNUnexpectedDisconnectCategory];
+        }
+        
+        __weak __typeof(self) weakSelf = self;
+        ((PNStatus *)status).automaticallyRetry = shouldRetry;
+        ((PNStatus *)status).retryCancelBlock = ^{
+            
+            DDLogAPICall([[weakSelf class] ddLogLevel], @"<PubNub::API> Cancel retry");
+            __strong __typeof(self) strongSelf = weakSelf;
+            pn_safe_property_write(strongSelf.resourceAccessQueue, ^{
+                
+                // Changed identifier prevent scheduled retry, shard will be started with next initial
+                // subscription.
+                if (shard.requestIdentifier == requestIdentifier) {
                     
-                    object_setClass(eventResultObject, [PNMessageResult class]);
-                    [self handleNewMessage:(PNMessageResult *)eventResultObject];
+                    shard.requestIdentifier++;
+                    shard.active = NO;
                 }
+            });
+        };
+        pn_safe_property_write(self.resourceAccessQueue, ^{
+            
+            if (shard.requestIdentifier == requestIdentifier) {
+                
+                shard.recovering = YES;
+                if (!shouldRetry) { shard.active = NO; }
             }
-        }];
+        });
+        [self updateStateTo:subscriberState withStatus:status];
+        [self.client callBlock:nil status:YES withResult:nil andStatus:(PNStatus *)status];
+        if (!shouldRetry) { return; }
+        
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        dispatch_time_t retryTime = dispatch_time(DISPATCH_TIME_NOW,
+                                                  (int64_t)(kPubNubSubscriptionRetryInterval * NSEC_PER_SEC));
+        dispatch_after(retryTime, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            
+            __block BOOL shouldRetryNow = NO;
+            __strong __typeof(self) strongSelf = weakSelf;
+            pn_safe_property_read(strongSelf.resourceAccessQueue, ^{
+                
+                shouldRetryNow = (shard.requestIdentifier == requestIdentifier);
+            });
+            if (shouldRetryNow) {
+                
+                PNMetricsIncrement(strongSelf.client.metricsCounters, subscribeRetries);
+                [strongSelf subscribeShard:shard];
+            }
+        });
         #pragma clang diagnostic pop
     }
-    [status updateData:[status.serviceData dictionaryWithValuesForKeys:@[@"timetoken", @"region"]]];
 }
 
-- (void)handleNewMessage:(PNMessageResult *)data {
+- (BOOL)handleNewMessage:(PNMessageResult *)data {
     
     PNErrorStatus *status = nil;
     if (data) {
@@ -1363,9 +2356,14 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    if (status) { [self.client.listenersManager notifyStatusChange:(id)status]; }
-    else if (data) { [self.client.listenersManager notifyMessage:data]; }
+    if (status) {
+        
+        PNMetricsIncrement(self.client.metricsCounters, decryptionFailures);
+        [self.client.listenersManager notifyStatusChange:(id)status];
+    }
     #pragma clang diagnostic pop
+    
+    return (data && !status);
 }
 
 - (void)handleNewPresenceEvent:(PNPresenceEventResult *)data {
@@ -1393,20 +2391,24 @@ NS_ASSUME_NONNULL_END
             [self.client.clientStateManager setState:data.data.presence.state forObject:object];
         }
     }
-    [self.client.listenersManager notifyPresenceEvent:data];
+    [self.client.presenceIndex handlePresenceEvent:data];
     #pragma clang diagnostic pop
 }
 
 
 #pragma mark - Misc
 
-- (PNRequestParameters *)subscribeRequestParametersWithState:(nullable NSDictionary<NSString *, id> *)state {
+- (PNRequestParameters *)subscribeRequestParametersWithState:(nullable NSDictionary<NSString *, id> *)state
+                                          initialSubscription:(BOOL *)initialSubscription {
     
-    // Compose full list of channels and groups stored in active subscription list.
-    NSArray *channels = [[self channels] arrayByAddingObjectsFromArray:[self presenceChannels]];
-    NSString *channelsList = [PNChannel namesForRequest:channels defaultString:@","];
-    NSString *groupsList = [PNChannel namesForRequest:[self channelGroups]];
-    NSArray *fullObjectsList = [channels arrayByAddingObjectsFromArray:[self channelGroups]];
+    // Compose full list of channels and groups stored in active subscription list (cached between
+    // subscription cycles).
+    [self updateEscapedObjectsIfRequired];
+    PNSubscriptionSnapshot *snapshot = self.snapshot;
+    NSString *channelsList = snapshot.escapedChannels;
+    NSString *groupsList = snapshot.escapedChannelGroups;
+    NSString *escapedState = [self escapedStateMergedWith:state forObjects:snapshot.requestObjects
+                                      subscriptionVersion:snapshot.requestObjectsVersion];
     
     // Silence static analyzer warnings.
     // Code is aware about this case and at the end will simply call on 'nil' object method.
@@ -1415,16 +2417,13 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
-    NSDictionary *mergedState = [self.client.clientStateManager stateMergedWith:state
-                                                                     forObjects:fullObjectsList];
-    [self.client.clientStateManager mergeWithState:mergedState];
-    
     PNRequestParameters *parameters = [PNRequestParameters new];
     [parameters addPathComponent:channelsList forPlaceholder:@"{channels}"];
-    [parameters addQueryParameter:self.currentTimeToken.stringValue forFieldName:@"tt"];
-    if ([self.currentTimeTokenRegion compare:@(-1)] == NSOrderedDescending) {
+    [parameters addQueryParameter:@(snapshot.currentTimeToken).stringValue forFieldName:@"tt"];
+    *initialSubscription = (snapshot.currentTimeToken == 0);
+    if (snapshot.currentTimeTokenRegion > -1) {
         
-        [parameters addQueryParameter:self.currentTimeTokenRegion.stringValue forFieldName:@"tr"];
+        [parameters addQueryParameter:@(snapshot.currentTimeTokenRegion).stringValue forFieldName:@"tr"];
     }
     
     if (self.client.configuration.presenceHeartbeatValue > 0 ) {
@@ -1433,32 +2432,306 @@ NS_ASSUME_NONNULL_END
                          forFieldName:@"heartbeat"];
     }
     if (groupsList.length) { [parameters addQueryParameter:groupsList forFieldName:@"channel-group"]; }
-    if (mergedState.count) {
+    if (escapedState.length) { [parameters addQueryParameter:escapedState forFieldName:@"state"]; }
+    if (snapshot.escapedFilterExpression) {
         
-        NSString *mergedStateString = [PNJSON JSONStringFrom:mergedState withError:nil];
-        if (mergedStateString.length) {
+        [parameters addQueryParameter:snapshot.escapedFilterExpression forFieldName:@"filter-expr"];
+    }
+    #pragma clang diagnostic pop
+    
+    return parameters;
+}
+
+- (NSUInteger)updateEscapedObjectsIfRequired {
+    
+    PNSubscriptionSnapshot *snapshot = self.snapshot;
+    NSUInteger version = snapshot.version;
+    NSArray *channels = nil;
+    NSArray *groups = nil;
+    if (!snapshot.requestObjects || snapshot.requestObjectsVersion != version) {
+        
+        channels = [snapshot.channels.allObjects arrayByAddingObjectsFromArray:snapshot.presenceChannels.allObjects];
+        groups = snapshot.channelGroups.allObjects;
+    }
+    
+    if (channels) {
+        
+        // Silence static analyzer warnings.
+        // Code is aware about this case and at the end will simply call on 'nil' object method.
+        // In most cases if referenced object become 'nil' it mean what there is no more need in
+        // it and probably whole client instance has been deallocated.
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+        PNClientState *stateManager = self.client.clientStateManager;
+        #pragma clang diagnostic pop
+        NSUInteger stateVersion = stateManager.version;
+        
+        // Distribute objects between shards (first shard handled by main subscription loop).
+        NSUInteger shardsCount = [self shardsCountForObjectsCount:(channels.count + groups.count)];
+        NSArray<NSArray<NSString *> *> *shardChannels = [self distributeObjects:channels
+                                                                  betweenShards:shardsCount];
+        NSArray<NSArray<NSString *> *> *shardGroups = [self distributeObjects:(groups?: @[])
+                                                                betweenShards:shardsCount];
+        
+        NSMutableArray<PNSubscribeShard *> *shards = [NSMutableArray new];
+        for (NSUInteger shardIdx = 1; shardIdx < shardsCount; shardIdx++) {
             
-            [parameters addQueryParameter:[PNString percentEscapedString:mergedStateString]
-                             forFieldName:@"state"];
+            PNSubscribeShard *shard = [PNSubscribeShard new];
+            shard.index = shardIdx;
+            shard.objects = [shardChannels[shardIdx] arrayByAddingObjectsFromArray:shardGroups[shardIdx]];
+            shard.escapedChannels = [PNChannel namesForRequest:shardChannels[shardIdx] defaultString:@","];
+            shard.escapedChannelGroups = [PNChannel namesForRequest:shardGroups[shardIdx]];
+            shard.timeToken = 0;
+            shard.region = -1;
+            shard.escapedState = [self escapedStateForObjects:shard.objects withStateManager:stateManager];
+            shard.stateVersion = stateVersion;
+            [shards addObject:shard];
         }
+        
+        NSString *channelsList = [PNChannel namesForRequest:shardChannels[0] defaultString:@","];
+        NSString *groupsList = [PNChannel namesForRequest:shardGroups[0]];
+        NSArray *objects = [shardChannels[0] arrayByAddingObjectsFromArray:shardGroups[0]];
+        NSString *escapedState = [self escapedStateForObjects:objects withStateManager:stateManager];
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *updatedSnapshot) {
+            
+            // Don't replace lists which has been composed for newer subscription list version.
+            if (!updatedSnapshot.requestObjects || updatedSnapshot.requestObjectsVersion <= version) {
+                
+                updatedSnapshot.escapedChannels = channelsList;
+                updatedSnapshot.escapedChannelGroups = groupsList;
+                updatedSnapshot.requestObjects = objects;
+                updatedSnapshot.requestObjectsVersion = version;
+                updatedSnapshot.escapedState = escapedState;
+                updatedSnapshot.stateVersion = stateVersion;
+                updatedSnapshot.stateObjectsVersion = version;
+            }
+        }];
+        [self updateShards:shards];
+    }
+    
+    return version;
+}
+
+- (NSUInteger)shardsCountForObjectsCount:(NSUInteger)objectsCount {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    NSUInteger maximumCount = MAX(self.client.configuration.subscribeShardsMaximumCount, 1);
+    NSUInteger threshold = MAX(self.client.configuration.subscribeShardObjectsThreshold, 1);
+    #pragma clang diagnostic pop
+    NSUInteger count = ((objectsCount + threshold - 1) / threshold);
+    
+    return MAX(MIN(count, maximumCount), 1);
+}
+
+- (NSArray<NSArray<NSString *> *> *)distributeObjects:(NSArray<NSString *> *)objects
+                                        betweenShards:(NSUInteger)shardsCount {
+    
+    NSMutableArray<NSMutableArray<NSString *> *> *shardObjects = [NSMutableArray new];
+    for (NSUInteger shardIdx = 0; shardIdx < MAX(shardsCount, 1); shardIdx++) {
+        
+        [shardObjects addObject:[NSMutableArray new]];
     }
-    if (self.escapedFilterExpression) {
+    for (NSString *object in objects) {
         
-        [parameters addQueryParameter:self.escapedFilterExpression forFieldName:@"filter-expr"];
+        [shardObjects[PNSubscribeShardIndexForObject(object, shardObjects.count)] addObject:object];
+    }
+    
+    return shardObjects;
+}
+
+- (PNRequestParameters *)subscribeRequestParametersForShard:(PNSubscribeShard *)shard {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
+    PNClientState *stateManager = self.client.clientStateManager;
+    NSUInteger stateVersion = stateManager.version;
+    if (shard.stateVersion != stateVersion) {
+        
+        shard.escapedState = [self escapedStateForObjects:shard.objects withStateManager:stateManager];
+        shard.stateVersion = stateVersion;
+    }
+    
+    PNRequestParameters *parameters = [PNRequestParameters new];
+    [parameters addPathComponent:(shard.escapedChannels?: @",") forPlaceholder:@"{channels}"];
+    [parameters addQueryParameter:@(shard.timeToken).stringValue forFieldName:@"tt"];
+    if (shard.region > -1) {
+        
+        [parameters addQueryParameter:@(shard.region).stringValue forFieldName:@"tr"];
+    }
+    if (self.client.configuration.presenceHeartbeatValue > 0 ) {
+        
+        [parameters addQueryParameter:@(self.client.configuration.presenceHeartbeatValue).stringValue
+                         forFieldName:@"heartbeat"];
+    }
+    if (shard.escapedChannelGroups.length) {
+        
+        [parameters addQueryParameter:shard.escapedChannelGroups forFieldName:@"channel-group"];
+    }
+    if (shard.escapedState.length) { [parameters addQueryParameter:shard.escapedState forFieldName:@"state"]; }
+    NSString *escapedFilterExpression = self.snapshot.escapedFilterExpression;
+    if (escapedFilterExpression) {
+        
+        [parameters addQueryParameter:escapedFilterExpression forFieldName:@"filter-expr"];
     }
     #pragma clang diagnostic pop
     
     return parameters;
 }
 
+- (NSString *)escapedStateMergedWith:(NSDictionary<NSString *, id> *)state
+                          forObjects:(NSArray<NSString *> *)objects
+                 subscriptionVersion:(NSUInteger)subscriptionVersion {
+    
+    // Silence static analyzer warnings.
+    // Code is aware about this case and at the end will simply call on 'nil' object method.
+    // In most cases if referenced object become 'nil' it mean what there is no more need in
+    // it and probably whole client instance has been deallocated.
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    PNClientState *stateManager = self.client.clientStateManager;
+    #pragma clang diagnostic pop
+    NSUInteger stateVersion = stateManager.version;
+    PNSubscriptionSnapshot *snapshot = self.snapshot;
+    NSString *escapedState = snapshot.escapedState;
+    BOOL outdated = (state.count > 0 || snapshot.stateVersion != stateVersion ||
+                     snapshot.stateObjectsVersion != subscriptionVersion);
+    
+    if (outdated) {
+        
+        // Passed state merged into cache and only changed objects state will be re-encoded.
+        NSString *mergedStateString = [stateManager JSONStateMergedWith:state forObjects:objects];
+        escapedState = (mergedStateString.length ? [PNString percentEscapedString:mergedStateString] : nil);
+        
+        // If merge changed cached state, its version will change as well and state will be re-composed
+        // once again during next subscription cycle.
+        [self updateSnapshotWithBlock:^(PNSubscriptionSnapshot *updatedSnapshot) {
+            
+            // Don't replace state which has been composed for newer subscription list version.
+            if (updatedSnapshot.stateObjectsVersion <= subscriptionVersion) {
+                
+                updatedSnapshot.escapedState = escapedState;
+                updatedSnapshot.stateVersion = stateVersion;
+                updatedSnapshot.stateObjectsVersion = subscriptionVersion;
+            }
+        }];
+    }
+    
+    return escapedState;
+}
+
+- (NSString *)escapedStateForObjects:(NSArray<NSString *> *)objects
+                    withStateManager:(PNClientState *)stateManager {
+    
+    NSString *stateString = [stateManager JSONStateMergedWith:nil forObjects:objects];
+    
+    return (stateString.length ? [PNString percentEscapedString:stateString] : nil);
+}
+
 - (void)appendSubscriberInformation:(PNStatus *)status {
     
-    status.currentTimetoken = _currentTimeToken;
-    status.lastTimeToken = _lastTimeToken;
-    status.currentTimeTokenRegion = _currentTimeTokenRegion;
-    status.lastTimeTokenRegion = _lastTimeTokenRegion;
-    status.subscribedChannels = [_channelsSet setByAddingObjectsFromSet:_presenceChannelsSet].allObjects;
-    status.subscribedChannelGroups = _channelGroupsSet.allObjects;
+    PNSubscriptionSnapshot *snapshot = self.snapshot;
+    status.currentTimetoken = @(snapshot.currentTimeToken);
+    status.lastTimeToken = @(snapshot.lastTimeToken);
+    status.currentTimeTokenRegion = @(snapshot.currentTimeTokenRegion);
+    status.lastTimeTokenRegion = @(snapshot.lastTimeTokenRegion);
+    status.subscribedChannels = [snapshot.channels setByAddingObjectsFromSet:snapshot.presenceChannels].allObjects;
+    status.subscribedChannelGroups = snapshot.channelGroups.allObjects;
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Subscribe shard implementation
+
+@implementation PNSubscribeShard
+@end
+
+
+#pragma mark - Subscription snapshot implementation
+
+@implementation PNSubscriptionSnapshot
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _channels = [NSSet new];
+        _channelGroups = [NSSet new];
+        _presenceChannels = [NSSet new];
+        _allObjects = @[];
+        _currentTimeTokenRegion = -1;
+        _lastTimeTokenRegion = -1;
+    }
+    
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    PNSubscriptionSnapshot *snapshot = [[[self class] allocWithZone:zone] init];
+    snapshot->_channels = _channels;
+    snapshot->_channelGroups = _channelGroups;
+    snapshot->_presenceChannels = _presenceChannels;
+    snapshot->_allObjects = _allObjects;
+    snapshot->_version = _version;
+    snapshot->_currentTimeToken = _currentTimeToken;
+    snapshot->_lastTimeToken = _lastTimeToken;
+    snapshot->_overrideTimeToken = _overrideTimeToken;
+    snapshot->_currentTimeTokenRegion = _currentTimeTokenRegion;
+    snapshot->_lastTimeTokenRegion = _lastTimeTokenRegion;
+    snapshot->_filterExpression = _filterExpression;
+    snapshot->_escapedFilterExpression = _escapedFilterExpression;
+    snapshot->_escapedChannels = _escapedChannels;
+    snapshot->_escapedChannelGroups = _escapedChannelGroups;
+    snapshot->_requestObjects = _requestObjects;
+    snapshot->_requestObjectsVersion = _requestObjectsVersion;
+    snapshot->_escapedState = _escapedState;
+    snapshot->_stateVersion = _stateVersion;
+    snapshot->_stateObjectsVersion = _stateObjectsVersion;
+    snapshot->_restoreSubscription = _restoreSubscription;
+    
+    return snapshot;
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Subscription changes implementation
+
+@implementation PNSubscriptionChanges
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _subscribedObjects = [NSMutableSet new];
+        _removedChannels = [NSMutableSet new];
+        _removedChannelGroups = [NSMutableSet new];
+        _state = [NSMutableDictionary new];
+        _subscribeBlocks = [NSMutableArray new];
+        _unsubscribeBlocks = [NSMutableArray new];
+    }
+    
+    return self;
 }
 
 #pragma mark -
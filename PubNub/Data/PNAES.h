@@ -97,6 +97,22 @@ NS_ASSUME_NONNULL_BEGIN
 + (nullable NSData *)decrypt:(NSString *)object withKey:(NSString *)key 
                     andError:(NSError *__autoreleasing *)error;
 
+/**
+ @brief      Transform list of encrypted Base64 encoded strings to \a NSData instances.
+ @discussion Messages decrypted in parallel, so this method should be used when there is few messages which
+             should be decrypted with same key (for example all messages from subscribe or history 
+             response). Messages decrypted with same quality of service as calling thread.
+ 
+ @param messages List of previously encrypted Base64-encoded strings which should be decrypted.
+ @param key      Reference on key which should be used to decrypt data.
+ 
+ @return List of same length as \c messages, where each entry is decrypted \a NSData or \a NSError which 
+         describe why corresponding message can't be decrypted.
+ 
+ @since 4.5.0
+ */
++ (NSArray *)decryptMessages:(NSArray<NSString *> *)messages withKey:(NSString *)key;
+
 #pragma mark -
 
 
@@ -8,6 +8,7 @@
 #import <CommonCrypto/CommonHMAC.h>
 #import "PubNub+CorePrivate.h"
 #import <libkern/OSAtomic.h>
+#import <pthread/qos.h>
 #import "PNErrorCodes.h"
 #import "PNLogMacro.h"
 #import "PNHelpers.h"
@@ -32,6 +33,156 @@ static DDLogLevel ddLogLevel = (NSUInteger)PNAESErrorLogLevel;
  */
 static const void * kPNAESInitializationVector = "0123456789012345";
 
+/**
+ @brief  Key under which encryptor stored in thread dictionary.
+ 
+ @since 4.5.0
+ */
+static NSString * const kPNAESEncryptorKey = @"com.pubnub.aes.encryptor";
+
+/**
+ @brief  Key under which decryptor stored in thread dictionary.
+ 
+ @since 4.5.0
+ */
+static NSString * const kPNAESDecryptorKey = @"com.pubnub.aes.decryptor";
+
+
+#pragma mark - Private functions
+
+/**
+ @brief      Decode Base64-encoded bytes.
+ @discussion Function work with raw bytes, so there is no need to create intermediate strings. Characters
+             which doesn't belong to Base64 alphabet (like new lines or spaces) ignored.
+ 
+ @param bytes  Pointer to Base64-encoded bytes.
+ @param length Number of bytes which should be decoded.
+ 
+ @return Decoded data or \c nil in case if passed bytes doesn't represent Base64-encoded data.
+ 
+ @since 4.5.0
+ */
+static NSData * _Nullable PNAESBase64DataFrom(const char *bytes, NSUInteger length) {
+    
+    static int8_t decodingTable[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        memset(decodingTable, -1, sizeof(decodingTable));
+        for (int8_t idx = 0; idx < 64; idx++) { decodingTable[(uint8_t)alphabet[idx]] = idx; }
+    });
+    
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:((length / 4) + 1) * 3];
+    uint8_t *output = (uint8_t *)data.mutableBytes;
+    NSUInteger outputLength = 0;
+    NSUInteger symbolsCount = 0;
+    NSUInteger paddingCount = 0;
+    uint32_t quantum = 0;
+    for (NSUInteger idx = 0; idx < length; idx++) {
+        
+        uint8_t character = (uint8_t)bytes[idx];
+        if (character == '=') { paddingCount++; continue; }
+        int8_t value = decodingTable[character];
+        
+        // Skip unknown characters. Data can't continue after padding.
+        if (value < 0) { continue; }
+        if (paddingCount) { return nil; }
+        
+        quantum = (quantum << 6) | (uint32_t)value;
+        if (++symbolsCount % 4 == 0) {
+            
+            output[outputLength++] = (uint8_t)(quantum >> 16);
+            output[outputLength++] = (uint8_t)(quantum >> 8);
+            output[outputLength++] = (uint8_t)quantum;
+            quantum = 0;
+        }
+    }
+    
+    // Base64 string should be padded to 4 symbols block.
+    NSUInteger tailLength = (symbolsCount % 4);
+    if (paddingCount > 2 || (symbolsCount + paddingCount) % 4 != 0 || tailLength == 1) { return nil; }
+    if (tailLength == 2) { output[outputLength++] = (uint8_t)(quantum >> 4); }
+    else if (tailLength == 3) {
+        
+        output[outputLength++] = (uint8_t)(quantum >> 10);
+        output[outputLength++] = (uint8_t)(quantum >> 2);
+    }
+    data.length = outputLength;
+    
+    return data;
+}
+
+/**
+ @brief      Retrieve concurrent queue which should be used to process messages batch.
+ @discussion Batch processed with same priority as calling thread (for example parsing executor's worker),
+             so decryption doesn't run with higher or lower priority than code which requested it.
+ 
+ @return Global concurrent queue with quality of service of calling thread (if supported).
+ 
+ @since 4.5.0
+ */
+static dispatch_queue_t PNAESBatchProcessingQueue(void) {
+    
+    dispatch_queue_t queue = nil;
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wtautological-pointer-compare"
+    if (&qos_class_self != NULL) {
+    #pragma clang diagnostic pop
+        
+        qos_class_t serviceClass = qos_class_self();
+        if (serviceClass == QOS_CLASS_UNSPECIFIED) { serviceClass = QOS_CLASS_DEFAULT; }
+        queue = dispatch_get_global_queue(serviceClass, 0);
+    }
+    else { queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0); }
+    
+    return queue;
+}
+
+
+#pragma mark - Cryptor wrapper interface
+
+/**
+ @brief      \c CCCryptorRef wrapper.
+ @discussion Cryptors cached by \b PNAES in thread dictionary (so each thread use own cryptor instance w/o 
+             locks). Only cryptor for last used key cached for each operation, and wrapper release cryptor 
+             when it is replaced or when thread completes.
+ 
+ @since 4.5.0
+ */
+@interface PNAESCryptor : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on wrapped cryptor.
+ */
+@property (nonatomic, readonly, assign) CCCryptorRef cryptor;
+
+/**
+ @brief  Stores reference on cipher key which has been used to create cryptor.
+ */
+@property (nonatomic, readonly, copy) NSString *cipherKey;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Construct wrapper for created cryptor.
+ 
+ @param cryptor   Reference on cryptor which will be released along with wrapper.
+ @param cipherKey Reference on key which has been used to create \c cryptor.
+ 
+ @return Constructed and ready to use wrapper.
+ */
++ (instancetype)wrapperForCryptor:(CCCryptorRef)cryptor withKey:(NSString *)cipherKey;
+
+#pragma mark -
+
+
+@end
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -49,6 +200,36 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (NSData *)SHA256HexFromKey:(NSString *)cipherKey;
 
+/**
+ @brief      Retrieve cryptor which can be used by current thread.
+ @discussion Cryptor created once for each thread, key and operation type and should be reset before use. 
+             Thread keep only cryptor for last used key, so cache doesn't grow with number of keys.
+ 
+ @param operation Encryption (\c kCCEncrypt) or decryption (\c kCCDecrypt) operation type.
+ @param cipherKey Reference on key which should be used during encryption/decryption.
+ @param status    Cryptor creation status (one of \c CCCryptorStatus fields).
+ 
+ @return Cryptor reference or \c NULL in case if cryptor can't be created.
+ 
+ @since 4.5.0
+ */
++ (nullable CCCryptorRef)cryptorForOperation:(CCOperation)operation withKey:(NSString *)cipherKey
+                                      status:(CCCryptorStatus *)status;
+
+/**
+ @brief  Decrypt Base64-encoded string w/o logging of decryption errors.
+ 
+ @param object Reference on previously encrypted Base64-encoded string which should be decrypted.
+ @param key    Reference on key which should be used to decrypt data.
+ @param error  Reference on pointer into which decryption error will be stored in case of decryption failure.
+ 
+ @return Decrypted data or original string data in case of decryption error.
+ 
+ @since 4.5.0
+ */
++ (nullable NSData *)decryptedDataFrom:(NSString *)object withKey:(NSString *)key
+                                 error:(NSError *__autoreleasing *)error;
+
 /**
  @brief Data processing method which basing on configuration able to encrypt or decrypt provided \c data.
  
@@ -177,15 +358,65 @@ NS_ASSUME_NONNULL_END
                     andError:(NSError *__autoreleasing *)error {
     
     NSError *decryptionError = nil;
-    id decryptedObject = nil;
+    NSData *decryptedObject = [self decryptedDataFrom:object withKey:key error:&decryptionError];
+    if (decryptionError) {
+        
+        if (error != NULL) { *error = decryptionError; }
+        else { DDLogAESError([self ddLogLevel], @"<PubNub::AES> Decryption error: %@", decryptionError); }
+    }
+    
+    return decryptedObject;
+}
+
++ (NSArray *)decryptMessages:(NSArray<NSString *> *)messages withKey:(NSString *)key {
+    
+    NSUInteger count = messages.count;
+    void **results = (void **)calloc(count, sizeof(void *));
+    dispatch_apply(count, PNAESBatchProcessingQueue(), ^(size_t messageIdx) {
+        
+        @autoreleasepool {
+            
+            NSError *decryptionError = nil;
+            NSData *decryptedObject = [self decryptedDataFrom:messages[messageIdx] withKey:key
+                                                        error:&decryptionError];
+            id result = (decryptionError?: decryptedObject);
+            if (!result) {
+                
+                result = [NSError errorWithDomain:kPNAESErrorDomain code:kPNAESDecryptionError
+                                         userInfo:@{NSLocalizedDescriptionKey: @"Unable to decrypt message."}];
+            }
+            results[messageIdx] = (__bridge_retained void *)result;
+        }
+    });
     
-    // Clean up source string from enclosing "
-    NSCharacterSet *trimCharSet = [NSCharacterSet characterSetWithCharactersInString:@"\""];
-    object = [object stringByTrimmingCharactersInSet:trimCharSet];
-    if ([object length] && [key length]) {
+    NSMutableArray *decryptedMessages = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger messageIdx = 0; messageIdx < count; messageIdx++) {
+        
+        [decryptedMessages addObject:(__bridge_transfer id)results[messageIdx]];
+    }
+    free(results);
+    
+    return [decryptedMessages copy];
+}
+
++ (nullable NSData *)decryptedDataFrom:(NSString *)object withKey:(NSString *)key
+                                 error:(NSError *__autoreleasing *)error {
+    
+    NSData *decryptedObject = nil;
+    NSString *description = nil;
+    NSInteger errorCode = kPNAESDecryptionError;
+    
+    // Work with string bytes directly and skip enclosing " w/o trimmed string copy creation.
+    const char *bytes = ([object isKindOfClass:[NSString class]] ? object.UTF8String : NULL);
+    NSUInteger length = (bytes ? strlen(bytes) : 0);
+    NSUInteger start = 0;
+    while (start < length && bytes[start] == '"') { start++; }
+    while (length > start && bytes[length - 1] == '"') { length--; }
+    
+    if (length > start && [key length]) {
         
         // Extract NSData which was encoded into Base64 string.
-        NSData *JSONData = [PNString base64DataFrom:object];
+        NSData *JSONData = PNAESBase64DataFrom(bytes + start, length - start);
         
         if ([JSONData length]) {
             
@@ -194,43 +425,34 @@ NS_ASSUME_NONNULL_END
             decryptedObject = [self processedDataFrom:JSONData withKey:key forOperation:kCCDecrypt
                                             andStatus:&status];
             
-            if (status != kCCSuccess) {
-                
-                decryptionError = [self errorFor:status];
-            }
+            if (status != kCCSuccess && error != NULL) { *error = [self errorFor:status]; }
         }
         // Looks like non-Base64 encoded string has been provided. Construct processing error
         // instance which will be passed to the user.
         else {
             
-            decryptedObject = [PNString UTF8DataFrom:object];
-            NSString *description = @"Incompatible string has been passed. Required Base64-encoded "
-                                     "string.";
-            decryptionError = [NSError errorWithDomain:kPNAESErrorDomain code:kPNAESDecryptionError
-                                              userInfo:@{NSLocalizedDescriptionKey:description}];
+            decryptedObject = [NSData dataWithBytes:(bytes + start) length:(length - start)];
+            description = @"Incompatible string has been passed. Required Base64-encoded string.";
         }
     }
     // AES can't complete w/o actual data or decryption key. Construct processing error instance
     // which will be passed to the user.
     else {
         
-        decryptedObject = [PNString UTF8DataFrom:object];
-        NSString *description = @"Empty string has been passed for decryption.";
-        NSInteger errorCode = kPNAESEmptyObjectError;
+        if (bytes) { decryptedObject = [NSData dataWithBytes:(bytes + start) length:(length - start)]; }
+        description = @"Empty string has been passed for decryption.";
+        errorCode = kPNAESEmptyObjectError;
         if ([key length]) {
             
             description = @"Empty decryption key has been passed.";
             errorCode = kPNAESConfigurationError;
         }
-        
-        decryptionError = [NSError errorWithDomain:kPNAESErrorDomain code:errorCode
-                                          userInfo:@{NSLocalizedDescriptionKey:description}];
     }
     
-    if (decryptionError) {
+    if (description && error != NULL) {
         
-        if (error != NULL) { *error = decryptionError; }
-        else { DDLogAESError([self ddLogLevel], @"<PubNub::AES> Decryption error: %@", decryptionError); }
+        *error = [NSError errorWithDomain:kPNAESErrorDomain code:errorCode
+                                 userInfo:@{NSLocalizedDescriptionKey:description}];
     }
     
     return decryptedObject;
@@ -263,22 +485,49 @@ NS_ASSUME_NONNULL_END
     return key;
 }
 
++ (nullable CCCryptorRef)cryptorForOperation:(CCOperation)operation withKey:(NSString *)cipherKey
+                                      status:(CCCryptorStatus *)status {
+    
+    NSMutableDictionary *threadData = [NSThread currentThread].threadDictionary;
+    NSString *cacheKey = (operation == kCCEncrypt ? kPNAESEncryptorKey : kPNAESDecryptorKey);
+    PNAESCryptor *cryptor = threadData[cacheKey];
+    if (cryptor && ![cryptor.cipherKey isEqualToString:cipherKey]) {
+        
+        // Cryptor for previous key will be released along with wrapper.
+        [threadData removeObjectForKey:cacheKey];
+        cryptor = nil;
+    }
+    
+    *status = kCCSuccess;
+    if (!cryptor) {
+        
+        NSData *cryptorKeyData = [self SHA256HexFromKey:cipherKey];
+        CCCryptorRef cryptorRef = NULL;
+        *status = CCCryptorCreate(operation, kCCAlgorithmAES128, kCCOptionPKCS7Padding, [cryptorKeyData bytes],
+                                  [cryptorKeyData length], kPNAESInitializationVector, &cryptorRef);
+        if (*status == kCCSuccess) {
+            
+            cryptor = [PNAESCryptor wrapperForCryptor:cryptorRef withKey:cipherKey];
+            threadData[cacheKey] = cryptor;
+        }
+    }
+    
+    return cryptor.cryptor;
+}
+
 + (nullable  NSData *)processedDataFrom:(NSData *)data withKey:(NSString *)cipherKey
                            forOperation:(CCOperation)operation andStatus:(CCCryptorStatus *)status {
     
-    NSData *cryptorKeyData = [self SHA256HexFromKey:cipherKey];
     NSMutableData *processedData = nil;
     CCCryptorStatus processingStatus = kCCParamError;
     
-    // Create new cryptor
-    CCCryptorRef cryptor;
-    CCCryptorStatus initStatus = CCCryptorCreate(operation, kCCAlgorithmAES128,
-                                                 kCCOptionPKCS7Padding, [cryptorKeyData bytes],
-                                                 [cryptorKeyData length],kPNAESInitializationVector,
-                                                 &cryptor);
+    // Cryptor cached for current thread and should be returned to initial state before data processing.
+    CCCryptorStatus initStatus;
+    CCCryptorRef cryptor = [self cryptorForOperation:operation withKey:cipherKey status:&initStatus];
+    if (cryptor) { initStatus = CCCryptorReset(cryptor, kPNAESInitializationVector); }
     
-    // Check whether cryptor was successfully created or not
-    if (initStatus == kCCSuccess) {
+    // Check whether cryptor is ready for data processing or not
+    if (cryptor && initStatus == kCCSuccess) {
         
         // Prepare storage for processed data
         size_t processedDataLength = CCCryptorGetOutputLength(cryptor, [data length], true);
@@ -315,7 +564,6 @@ NS_ASSUME_NONNULL_END
             }
         }
     }
-    CCCryptorRelease(cryptor);
     
     if (status) {
         
@@ -366,4 +614,31 @@ NS_ASSUME_NONNULL_END
 #pragma mark -
 
 
+@end
+
+
+#pragma mark - Cryptor wrapper implementation
+
+@implementation PNAESCryptor
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)wrapperForCryptor:(CCCryptorRef)cryptor withKey:(NSString *)cipherKey {
+    
+    PNAESCryptor *wrapper = [self new];
+    wrapper->_cryptor = cryptor;
+    wrapper->_cipherKey = [cipherKey copy];
+    
+    return wrapper;
+}
+
+- (void)dealloc {
+    
+    if (_cryptor) { CCCryptorRelease(_cryptor); }
+}
+
+#pragma mark -
+
+
 @end
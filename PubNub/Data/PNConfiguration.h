@@ -1,5 +1,6 @@
 #import <Foundation/Foundation.h>
 #import "PNStructures.h"
+#import "PNTransport.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -190,6 +191,241 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign, getter = shouldTryCatchUpOnSubscriptionRestore) BOOL catchUpOnSubscriptionRestore;
 
+/**
+ @brief      Stores type of transport which should be used by client to communicate with \b PubNub network.
+ @discussion \c PNSocketTransportType allow to use lightweight transport which keep connections open between
+             requests. This transport doesn't support secured connection, so it will be used only if
+             \c TLSEnabled is set to \c NO.
+ 
+ @default    By default client use \b PNURLSessionTransportType.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) PNTransportType transportType;
+
+/**
+ @brief      Stores reference on custom class which should be used by client to communicate with \b PubNub
+             network.
+ @discussion Class should conform to \b PNTransport protocol. If specified, \c transportType will be ignored.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, strong) Class <PNTransport> transportClass;
+
+/**
+ @brief      Stores maximum number of simultaneous message publish requests.
+ @discussion Publish requests use own connections budget and won't wait for completion of history or here now
+             requests.
+ 
+ @default    By default client use \b 2 connections for publish requests.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger publishRequestsMaximumConnections;
+
+/**
+ @brief      Stores maximum number of simultaneous presence heartbeat, state, channel groups, push notifications
+             and time requests.
+ 
+ @default    By default client use \b 1 connection for control requests.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger controlRequestsMaximumConnections;
+
+/**
+ @brief      Stores maximum number of simultaneous history, here now and where now requests.
+ 
+ @default    By default client use \b 1 connection for bulk read requests.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger bulkReadRequestsMaximumConnections;
+
+/**
+ @brief      Stores maximum number of parallel subscribe long-poll loops.
+ @discussion When number of channels and groups exceed \c subscribeShardObjectsThreshold, client split them 
+             between few long-poll loops (each use own connection and time token). Each channel always 
+             handled by single loop, so order of events for it is preserved. Set to \b 1 to disable 
+             sharding.
+ 
+ @default    By default client use single long-poll loop (sharding disabled).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger subscribeShardsMaximumCount;
+
+/**
+ @brief      Stores number of channels and groups which single subscribe long-poll loop should handle before
+             client will use one more loop.
+ 
+ @default    By default client will add one more long-poll loop for each \b 200 channels and groups.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger subscribeShardObjectsThreshold;
+
+/**
+ @brief      Stores for how long client should collect subscribe and unsubscribe calls before it will send 
+             single request for all of them.
+ @discussion Subscription list modifications which has been done during this interval merged together, so 
+             client will send at most one \c leave and one subscribe request. Set to \b 0 to apply each 
+             call right away (w/o merging).
+ 
+ @default    By default calls not merged and applied right away.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSTimeInterval subscribeCoalescingInterval;
+
+/**
+ @brief      Stores priority which should be used by client to parse and decrypt service responses.
+ @discussion Subscribe and history responses parsed outside of network processing queue (when cipher key is 
+             set), so their delivery depend from this priority. Events from streamed subscribe responses 
+             always de-serialized and decrypted with this priority (in batches, while response body is 
+             downloading).
+ 
+ @default    By default client parse responses with \b PNUserInitiatedQualityOfService priority.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) PNQualityOfService parsingQualityOfService;
+
+/**
+ @brief      Stores maximum number of responses which client can parse and decrypt at the same time.
+ @discussion Parsing executor shared by all client's networks, so this value limit number of threads which 
+             client can occupy for responses processing.
+ 
+ @default    By default client parse at most \b 2 responses at the same time.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger parsingMaximumConcurrency;
+
+/**
+ @brief      Stores whether client should collect requests processing duration histogram for each operation 
+             type or not.
+ @discussion Collected histograms can be retrieved with \c -requestMetricsHistogramForOperation:. Metrics 
+             for each separate request available with \b PNResult and \b PNStatus regardless of this option.
+ 
+ @default    By default histograms not collected.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign, getter = shouldCollectRequestMetricsHistogram) BOOL collectRequestMetricsHistogram;
+
+/**
+ @brief      Stores whether client should keep local presence information for channels to which it 
+             subscribed with presence or not.
+ @discussion When enabled, client send single here now request for each \c -pnpres channel after 
+             subscription and keep information up-to-date using presence events, so it can be retrieved 
+             with \c -localHereNowForChannel:.
+ 
+ @default    By default local presence information not maintained.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign, getter = shouldMaintainPresenceIndex) BOOL maintainPresenceIndex;
+
+/**
+ @brief      Stores level which should be used by client to compress messages published with \c compressed 
+             flag.
+ @discussion Level should be in \b 0-9 range where \b 1 gives best speed and \b 9 best compression. Set to 
+             \b -1 to use default \c zlib compression level.
+ 
+ @default    By default client use \b -1 (default \c zlib compression level).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger compressionLevel;
+
+/**
+ @brief  Stores strategy which should be used by client to compress messages published with \c compressed 
+         flag.
+ 
+ @default    By default client use \b PNDefaultCompressionStrategy.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) PNCompressionStrategy compressionStrategy;
+
+/**
+ @brief      Stores maximum number of publish calls which can be processed (serialized, encrypted and sent) at 
+             the same time.
+ @discussion Rest of publish calls wait in client's publish queue. Messages for same channel always sent one 
+             after another in order in which they has been passed to the client, messages for different 
+             channels sent in parallel. Value \b 0 treated as \b 1.
+ 
+ @default    By default client process at most \b 4 publish calls at the same time.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger publishMaximumInFlight;
+
+/**
+ @brief      Stores maximum number of received messages and presence events which can wait for delivery to 
+             listeners.
+ @discussion Events buffered while listeners process previous events on \c callbackQueue. When buffer 
+             overflown, client handle new events according to \c eventsDeliveryBufferPolicy and report it 
+             with \b PNEventsDeliveryOverflowCategory status. Set to \b 0 to disable limit.
+ 
+ @default    By default buffer capacity not limited.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger eventsDeliveryBufferCapacity;
+
+/**
+ @brief  Stores policy which should be used by client when events delivery buffer overflown.
+ 
+ @default    By default client use \b PNBlockSubscribeLoopBufferPolicy.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) PNEventsDeliveryBufferPolicy eventsDeliveryBufferPolicy;
+
+/**
+ @brief      Stores maximum time which client can spend on callback queue to deliver buffered events at once.
+ @discussion When set, client deliver buffered events in slices and return control to the callback queue 
+             between them, so large bursts of events (like catch up after reconnection) won't block main 
+             queue for long time. For example, \b 0.004 leave most of the frame budget to the UI.
+ 
+ @default    By default time slicing is disabled (\b 0) and all buffered events delivered at once.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSTimeInterval eventsDeliverySliceDuration;
+
+/**
+ @brief      Stores maximum number of buffered events which can be delivered by client during single slice.
+ @discussion Can be used along with \c eventsDeliverySliceDuration (slice ends with whichever limit is 
+             reached first) or on its own.
+ 
+ @default    By default slice size not limited (\b 0).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger eventsDeliverySliceMaximumCount;
+
+/**
+ @brief      Stores number of serial workers which should be used by client to process received events.
+ @discussion Mode intended for server-side consumers which subscribe on large number of channels. Events 
+             distributed between workers using channel name hash, so events from different channels processed 
+             and delivered in parallel, while events from same channel always processed and delivered one 
+             after another in order in which they has been received.
+ @discussion Messages de-serialized and decrypted on parsing executor before distribution, so workers
+             only create result objects and call listeners. When workers can't keep up with received events,
+             subscribe loop will be suspended till they catch up.
+ @warning    When enabled, messages and presence events delivered to listeners on worker queues (not on 
+             \c callbackQueue) and listeners should be thread-safe. Events delivery buffer and time slicing 
+             options not used in this mode. Statuses still delivered on \c callbackQueue.
+ 
+ @default    By default workers not used (\b 0) and all events processed on single queue.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger eventsProcessingWorkersCount;
+
 /**
  @brief  Construct configuration instance using minimal required data.
  
@@ -136,6 +136,25 @@ NS_ASSUME_NONNULL_END
         _keepTimeTokenOnListChange = kPNDefaultShouldKeepTimeTokenOnListChange;
         _restoreSubscription = kPNDefaultShouldRestoreSubscription;
         _catchUpOnSubscriptionRestore = kPNDefaultShouldTryCatchUpOnSubscriptionRestore;
+        _transportType = kPNDefaultTransportType;
+        _publishRequestsMaximumConnections = kPNDefaultPublishRequestsMaximumConnections;
+        _controlRequestsMaximumConnections = kPNDefaultControlRequestsMaximumConnections;
+        _bulkReadRequestsMaximumConnections = kPNDefaultBulkReadRequestsMaximumConnections;
+        _subscribeShardsMaximumCount = kPNDefaultSubscribeShardsMaximumCount;
+        _subscribeShardObjectsThreshold = kPNDefaultSubscribeShardObjectsThreshold;
+        _subscribeCoalescingInterval = kPNDefaultSubscribeCoalescingInterval;
+        _parsingQualityOfService = kPNDefaultParsingQualityOfService;
+        _parsingMaximumConcurrency = kPNDefaultParsingMaximumConcurrency;
+        _collectRequestMetricsHistogram = kPNDefaultShouldCollectRequestMetricsHistogram;
+        _maintainPresenceIndex = kPNDefaultShouldMaintainPresenceIndex;
+        _compressionLevel = kPNDefaultCompressionLevel;
+        _compressionStrategy = kPNDefaultCompressionStrategy;
+        _publishMaximumInFlight = kPNDefaultPublishMaximumInFlight;
+        _eventsDeliveryBufferCapacity = kPNDefaultEventsDeliveryBufferCapacity;
+        _eventsDeliveryBufferPolicy = kPNDefaultEventsDeliveryBufferPolicy;
+        _eventsDeliverySliceDuration = kPNDefaultEventsDeliverySliceDuration;
+        _eventsDeliverySliceMaximumCount = kPNDefaultEventsDeliverySliceMaximumCount;
+        _eventsProcessingWorkersCount = kPNDefaultEventsProcessingWorkersCount;
     }
     
     return self;
@@ -160,6 +179,26 @@ NS_ASSUME_NONNULL_END
     configuration.keepTimeTokenOnListChange = self.shouldKeepTimeTokenOnListChange;
     configuration.restoreSubscription = self.shouldRestoreSubscription;
     configuration.catchUpOnSubscriptionRestore = self.shouldTryCatchUpOnSubscriptionRestore;
+    configuration.transportType = self.transportType;
+    configuration.transportClass = self.transportClass;
+    configuration.publishRequestsMaximumConnections = self.publishRequestsMaximumConnections;
+    configuration.controlRequestsMaximumConnections = self.controlRequestsMaximumConnections;
+    configuration.bulkReadRequestsMaximumConnections = self.bulkReadRequestsMaximumConnections;
+    configuration.subscribeShardsMaximumCount = self.subscribeShardsMaximumCount;
+    configuration.subscribeShardObjectsThreshold = self.subscribeShardObjectsThreshold;
+    configuration.subscribeCoalescingInterval = self.subscribeCoalescingInterval;
+    configuration.parsingQualityOfService = self.parsingQualityOfService;
+    configuration.parsingMaximumConcurrency = self.parsingMaximumConcurrency;
+    configuration.collectRequestMetricsHistogram = self.shouldCollectRequestMetricsHistogram;
+    configuration.maintainPresenceIndex = self.shouldMaintainPresenceIndex;
+    configuration.compressionLevel = self.compressionLevel;
+    configuration.compressionStrategy = self.compressionStrategy;
+    configuration.publishMaximumInFlight = self.publishMaximumInFlight;
+    configuration.eventsDeliveryBufferCapacity = self.eventsDeliveryBufferCapacity;
+    configuration.eventsDeliveryBufferPolicy = self.eventsDeliveryBufferPolicy;
+    configuration.eventsDeliverySliceDuration = self.eventsDeliverySliceDuration;
+    configuration.eventsDeliverySliceMaximumCount = self.eventsDeliverySliceMaximumCount;
+    configuration.eventsProcessingWorkersCount = self.eventsProcessingWorkersCount;
     
     return configuration;
 }
@@ -0,0 +1,42 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNMetricsCounters.h"
+#import "PNMetrics.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+@interface PNMetrics (Private)
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct metrics snapshot from current counters state.
+
+ @param counters        Pointer on client-wide counters.
+ @param previousMetrics Reference on previous snapshot which should be used to calculate rates (if \c nil,
+                        rates will be calculated since \c startDate).
+ @param startDate       Reference on date when counters has been created.
+
+ @return Constructed and ready to use metrics snapshot.
+
+ @since 4.5.0
+ */
++ (instancetype)metricsWithCounters:(PNMetricsCounters *)counters
+                    previousMetrics:(nullable PNMetrics *)previousMetrics
+                          startDate:(NSDate *)startDate;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,189 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      \b PubNub client-wide metrics snapshot.
+ @discussion Snapshot built from counters which client update on hot paths with atomic operations. Metrics
+             collection can be removed from compiled code by adding \c PN_METRICS_ENABLED=0 to preprocessor
+             definitions (client won't provide snapshots in this case).
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNMetrics : NSObject
+
+
+///------------------------------------------------
+/// @name Real-time events
+///------------------------------------------------
+
+/**
+ @brief  Stores number of messages which has been received by client.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t messagesReceived;
+
+/**
+ @brief      Stores number of messages which has been received per second.
+ @discussion Rate calculated for period since previous snapshot (or client creation).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) double messagesPerSecond;
+
+/**
+ @brief  Stores number of presence events which has been received by client.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t presenceEventsReceived;
+
+/**
+ @brief      Stores number of presence events which has been received per second.
+ @discussion Rate calculated for period since previous snapshot (or client creation).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) double presenceEventsPerSecond;
+
+/**
+ @brief  Stores number of bytes which has been received from \b PubNub service.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t bytesReceived;
+
+/**
+ @brief  Stores number of messages which client wasn't able to decrypt (\b PNDecryptionErrorCategory).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t decryptionFailures;
+
+/**
+ @brief  Stores length of period for which rates has been calculated (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval interval;
+
+
+///------------------------------------------------
+/// @name Subscribe loop
+///------------------------------------------------
+
+/**
+ @brief  Stores number of completed subscribe cycles.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t subscribeCycles;
+
+/**
+ @brief  Stores average time between subscribe request start and response arrival (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval averageSubscribeCycleLatency;
+
+/**
+ @brief  Stores time between start and response arrival for last subscribe request (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval lastSubscribeCycleLatency;
+
+/**
+ @brief  Stores average time between subscribe response arrival and next subscribe request start
+         (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval averagePollGap;
+
+/**
+ @brief  Stores time between last subscribe response arrival and next subscribe request start (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval lastPollGap;
+
+/**
+ @brief  Stores number of subscribe loop restarts which has been scheduled after failed requests.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) uint64_t subscribeRetries;
+
+
+///------------------------------------------------
+/// @name Queues
+///------------------------------------------------
+
+/**
+ @brief  Stores number of events and statuses which wait for delivery to listeners.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t listenerQueueDepth;
+
+/**
+ @brief  Stores number of publish requests which wait for completion.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t publishesInFlight;
+
+/**
+ @brief  Stores number of publish requests which wait in publish queue for their turn to be sent.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t publishQueueDepth;
+
+/**
+ @brief  Stores average time which publish request spent in publish queue before it has been sent
+         (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval averagePublishQueueWait;
+
+/**
+ @brief  Stores time which last sent publish request spent in publish queue (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval lastPublishQueueWait;
+
+/**
+ @brief  Stores average number of events which has been delivered to listeners during single slice.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) double averageDeliverySliceSize;
+
+/**
+ @brief  Stores number of events which has been delivered to listeners during last slice.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t lastDeliverySliceSize;
+
+/**
+ @brief  Stores number of buffered events which left for next slices after last slice completion.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t deliveryBacklog;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
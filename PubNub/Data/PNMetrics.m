@@ -0,0 +1,136 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNMetrics+Private.h"
+
+
+#pragma mark Private functions
+
+/**
+ @brief  Atomically read counter value.
+
+ @param counter Pointer on counter which should be read.
+
+ @return Current counter value.
+
+ @since 4.5.0
+ */
+static inline int64_t PNMetricsValue(volatile int64_t *counter) {
+
+    return OSAtomicAdd64Barrier(0, counter);
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNMetrics ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) uint64_t messagesReceived;
+@property (nonatomic, assign) double messagesPerSecond;
+@property (nonatomic, assign) uint64_t presenceEventsReceived;
+@property (nonatomic, assign) double presenceEventsPerSecond;
+@property (nonatomic, assign) uint64_t bytesReceived;
+@property (nonatomic, assign) uint64_t decryptionFailures;
+@property (nonatomic, assign) NSTimeInterval interval;
+@property (nonatomic, assign) uint64_t subscribeCycles;
+@property (nonatomic, assign) NSTimeInterval averageSubscribeCycleLatency;
+@property (nonatomic, assign) NSTimeInterval lastSubscribeCycleLatency;
+@property (nonatomic, assign) NSTimeInterval averagePollGap;
+@property (nonatomic, assign) NSTimeInterval lastPollGap;
+@property (nonatomic, assign) uint64_t subscribeRetries;
+@property (nonatomic, assign) int64_t listenerQueueDepth;
+@property (nonatomic, assign) int64_t publishesInFlight;
+@property (nonatomic, assign) int64_t publishQueueDepth;
+@property (nonatomic, assign) NSTimeInterval averagePublishQueueWait;
+@property (nonatomic, assign) NSTimeInterval lastPublishQueueWait;
+@property (nonatomic, assign) double averageDeliverySliceSize;
+@property (nonatomic, assign) int64_t lastDeliverySliceSize;
+@property (nonatomic, assign) int64_t deliveryBacklog;
+
+/**
+ @brief  Stores date when snapshot has been created.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSDate *date;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNMetrics
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)metricsWithCounters:(PNMetricsCounters *)counters
+                    previousMetrics:(PNMetrics *)previousMetrics
+                          startDate:(NSDate *)startDate {
+
+    PNMetrics *metrics = [self new];
+    metrics.date = [NSDate date];
+    metrics.messagesReceived = (uint64_t)PNMetricsValue(&counters->messagesReceived);
+    metrics.presenceEventsReceived = (uint64_t)PNMetricsValue(&counters->presenceEventsReceived);
+    metrics.bytesReceived = (uint64_t)PNMetricsValue(&counters->bytesReceived);
+    metrics.decryptionFailures = (uint64_t)PNMetricsValue(&counters->decryptionFailures);
+    metrics.subscribeRetries = (uint64_t)PNMetricsValue(&counters->subscribeRetries);
+    metrics.listenerQueueDepth = PNMetricsValue(&counters->listenerQueueDepth);
+    metrics.publishesInFlight = PNMetricsValue(&counters->publishesInFlight);
+    metrics.publishQueueDepth = PNMetricsValue(&counters->publishQueueDepth);
+    metrics.lastDeliverySliceSize = PNMetricsValue(&counters->lastDeliverySliceSize);
+    metrics.deliveryBacklog = PNMetricsValue(&counters->deliveryBacklog);
+
+    metrics.subscribeCycles = (uint64_t)PNMetricsValue(&counters->subscribeCycles);
+    metrics.lastSubscribeCycleLatency = (PNMetricsValue(&counters->lastSubscribeCycleLatency) / 1000000.f);
+    if (metrics.subscribeCycles) {
+
+        metrics.averageSubscribeCycleLatency = (PNMetricsValue(&counters->subscribeCycleLatency) /
+                                                (double)metrics.subscribeCycles / 1000000.f);
+    }
+    int64_t pollGaps = PNMetricsValue(&counters->pollGaps);
+    metrics.lastPollGap = (PNMetricsValue(&counters->lastPollGap) / 1000000.f);
+    if (pollGaps) { metrics.averagePollGap = (PNMetricsValue(&counters->pollGap) / (double)pollGaps / 1000000.f); }
+    int64_t publishQueueWaits = PNMetricsValue(&counters->publishQueueWaits);
+    metrics.lastPublishQueueWait = (PNMetricsValue(&counters->lastPublishQueueWait) / 1000000.f);
+    if (publishQueueWaits) {
+
+        metrics.averagePublishQueueWait = (PNMetricsValue(&counters->publishQueueWait) /
+                                           (double)publishQueueWaits / 1000000.f);
+    }
+    int64_t deliverySlices = PNMetricsValue(&counters->deliverySlices);
+    if (deliverySlices) {
+
+        metrics.averageDeliverySliceSize = (PNMetricsValue(&counters->deliverySlicesEvents) / (double)deliverySlices);
+    }
+
+    // Rates calculated for period since previous snapshot.
+    NSDate *periodStartDate = (previousMetrics.date?: startDate);
+    metrics.interval = [metrics.date timeIntervalSinceDate:periodStartDate];
+    if (metrics.interval > 0.f) {
+
+        uint64_t messages = (metrics.messagesReceived - previousMetrics.messagesReceived);
+        uint64_t presenceEvents = (metrics.presenceEventsReceived - previousMetrics.presenceEventsReceived);
+        metrics.messagesPerSecond = (messages / metrics.interval);
+        metrics.presenceEventsPerSecond = (presenceEvents / metrics.interval);
+    }
+
+    return metrics;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,57 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNRequestMetrics.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+@interface PNRequestMetrics (Private)
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+@property (nonatomic, nullable, strong) NSDate *enqueueDate;
+@property (nonatomic, nullable, strong) NSDate *startDate;
+@property (nonatomic, nullable, strong) NSDate *responseCompletionDate;
+@property (nonatomic, nullable, strong) NSDate *parseCompletionDate;
+@property (nonatomic, nullable, strong) NSDate *callbackDispatchDate;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct metrics object for request which has been just built.
+
+ @param operation Type of operation for which request has been built.
+
+ @return Constructed and ready to use metrics object.
+
+ @since 4.5.0
+ */
++ (instancetype)metricsForOperation:(PNOperationType)operation;
+
+/**
+ @brief      Update metrics with information reported by transport.
+ @discussion Dictionary may contain keys described for \b PNTransportMetricsBlock.
+
+ @param metrics Reference on dictionary with metrics collected by transport.
+
+ @since 4.5.0
+ */
+- (void)updateWithTransportMetrics:(NSDictionary<NSString *, id> *)metrics;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,175 @@
+#import <Foundation/Foundation.h>
+#import "PNStructures.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      \b PubNub request processing metrics.
+ @discussion Instance collect moments when request passed through each processing stage (from request
+             construction till completion block call) along with connection metrics reported by transport.
+             Same instance shared by \b PNResult and \b PNStatus which has been created for single request.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNRequestMetrics : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores type of operation for which metrics has been collected.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) PNOperationType operation;
+
+/**
+ @brief  Stores date when request has been built.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, strong) NSDate *requestCreationDate;
+
+/**
+ @brief  Stores date when request has been scheduled for sending.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *enqueueDate;
+
+/**
+ @brief      Stores date when transport has been asked to send request.
+ @discussion Requests may wait in lane till connection from their lane will be released.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *startDate;
+
+/**
+ @brief      Stores date when first byte of service response has been received.
+ @discussion Value available only if transport is able to report it.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *firstByteDate;
+
+/**
+ @brief  Stores date when whole response body has been received.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *responseCompletionDate;
+
+/**
+ @brief  Stores date when service response has been parsed.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *parseCompletionDate;
+
+/**
+ @brief  Stores date when processing results has been passed to completion block.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSDate *callbackDispatchDate;
+
+/**
+ @brief      Stores time which has been spent on DNS lookup.
+ @discussion Value available only if transport is able to report it (otherwise \b 0).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval domainLookupDuration;
+
+/**
+ @brief      Stores time which has been spent on TCP connection establishment (including TLS handshake).
+ @discussion Value available only if transport is able to report it (otherwise \b 0).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval connectDuration;
+
+/**
+ @brief      Stores time which has been spent on TLS handshake.
+ @discussion Value available only if transport is able to report it (otherwise \b 0).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval secureConnectionDuration;
+
+/**
+ @brief  Stores number of bytes which has been sent to \b PubNub service.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t bytesSent;
+
+/**
+ @brief  Stores number of bytes which has been received from \b PubNub service.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int64_t bytesReceived;
+
+/**
+ @brief  Stores whether request has been sent using already opened connection or not.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign, getter = isReusedConnection) BOOL reusedConnection;
+
+
+///------------------------------------------------
+/// @name Durations
+///------------------------------------------------
+
+/**
+ @brief  Time which request spent waiting for free connection.
+
+ @return Duration between \c enqueueDate and \c startDate or \b 0 if one of them unknown.
+
+ @since 4.5.0
+ */
+- (NSTimeInterval)queueDuration;
+
+/**
+ @brief  Time which request spent in transport.
+
+ @return Duration between \c startDate and \c responseCompletionDate or \b 0 if one of them unknown.
+
+ @since 4.5.0
+ */
+- (NSTimeInterval)networkDuration;
+
+/**
+ @brief  Time which has been spent on service response processing.
+
+ @return Duration between \c responseCompletionDate and \c parseCompletionDate or \b 0 if one of them
+         unknown.
+
+ @since 4.5.0
+ */
+- (NSTimeInterval)parseDuration;
+
+/**
+ @brief  Time which has been spent on whole request processing.
+
+ @return Duration between \c requestCreationDate and \c callbackDispatchDate or \b 0 if request still
+         processed.
+
+ @since 4.5.0
+ */
+- (NSTimeInterval)totalDuration;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,144 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNRequestMetrics+Private.h"
+
+
+#pragma mark Private functions
+
+/**
+ @brief  Calculate duration between two dates.
+
+ @param startDate Reference on date which represent beginning of processing stage.
+ @param endDate   Reference on date which represent end of processing stage.
+
+ @return Duration between dates or \b 0 if one of them is unknown.
+
+ @since 4.5.0
+ */
+static NSTimeInterval PNDurationBetween(NSDate *startDate, NSDate *endDate) {
+
+    return (startDate && endDate ? [endDate timeIntervalSinceDate:startDate] : 0.f);
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNRequestMetrics ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) PNOperationType operation;
+@property (nonatomic, strong) NSDate *requestCreationDate;
+@property (nonatomic, nullable, strong) NSDate *enqueueDate;
+@property (nonatomic, nullable, strong) NSDate *startDate;
+@property (nonatomic, nullable, strong) NSDate *firstByteDate;
+@property (nonatomic, nullable, strong) NSDate *responseCompletionDate;
+@property (nonatomic, nullable, strong) NSDate *parseCompletionDate;
+@property (nonatomic, nullable, strong) NSDate *callbackDispatchDate;
+@property (nonatomic, assign) NSTimeInterval domainLookupDuration;
+@property (nonatomic, assign) NSTimeInterval connectDuration;
+@property (nonatomic, assign) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, assign) int64_t bytesSent;
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign, getter = isReusedConnection) BOOL reusedConnection;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize metrics object for request which has been just built.
+
+ @param operation Type of operation for which request has been built.
+
+ @return Initialized and ready to use metrics object.
+
+ @since 4.5.0
+ */
+- (instancetype)initForOperation:(PNOperationType)operation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNRequestMetrics
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)metricsForOperation:(PNOperationType)operation {
+
+    return [[self alloc] initForOperation:operation];
+}
+
+- (instancetype)initForOperation:(PNOperationType)operation {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        _operation = operation;
+        _requestCreationDate = [NSDate date];
+    }
+
+    return self;
+}
+
+- (void)updateWithTransportMetrics:(NSDictionary<NSString *, id> *)metrics {
+
+    if (metrics[@"firstByte"]) { self.firstByteDate = metrics[@"firstByte"]; }
+    self.domainLookupDuration = ((NSNumber *)metrics[@"domainLookupDuration"]).doubleValue;
+    self.connectDuration = ((NSNumber *)metrics[@"connectDuration"]).doubleValue;
+    self.secureConnectionDuration = ((NSNumber *)metrics[@"secureConnectionDuration"]).doubleValue;
+    self.bytesSent = ((NSNumber *)metrics[@"bytesSent"]).longLongValue;
+    self.bytesReceived = ((NSNumber *)metrics[@"bytesReceived"]).longLongValue;
+    self.reusedConnection = ((NSNumber *)metrics[@"reusedConnection"]).boolValue;
+}
+
+
+#pragma mark - Durations
+
+- (NSTimeInterval)queueDuration {
+
+    return PNDurationBetween(self.enqueueDate, self.startDate);
+}
+
+- (NSTimeInterval)networkDuration {
+
+    return PNDurationBetween(self.startDate, self.responseCompletionDate);
+}
+
+- (NSTimeInterval)parseDuration {
+
+    return PNDurationBetween(self.responseCompletionDate, self.parseCompletionDate);
+}
+
+- (NSTimeInterval)totalDuration {
+
+    return PNDurationBetween(self.requestCreationDate, self.callbackDispatchDate);
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)debugDescription {
+
+    return [NSString stringWithFormat:@"<%@: %p queue: %.2f ms, network: %.2f ms, parse: %.2f ms, "
+            "total: %.2f ms>", NSStringFromClass([self class]), self, ([self queueDuration] * 1000.f),
+            ([self networkDuration] * 1000.f), ([self parseDuration] * 1000.f), ([self totalDuration] * 1000.f)];
+}
+
+#pragma mark -
+
+
+@end
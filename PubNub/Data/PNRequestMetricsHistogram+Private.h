@@ -0,0 +1,63 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNRequestMetricsHistogram.h"
+
+
+#pragma mark Class forward
+
+@class PNRequestMetrics;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+@interface PNRequestMetricsHistogram (Private) <NSCopying>
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct empty histogram for specified operation type.
+
+ @param operation Type of operation for which requests durations will be collected.
+
+ @return Constructed and ready to use histogram.
+
+ @since 4.5.0
+ */
++ (instancetype)histogramForOperation:(PNOperationType)operation;
+
+
+///------------------------------------------------
+/// @name Recording
+///------------------------------------------------
+
+/**
+ @brief      Add completed request processing duration to histogram.
+ @discussion Method is thread-safe. \c -copy should be used to get consistent snapshot of histogram state.
+
+ @param metrics Reference on metrics of request which has been completed.
+
+ @since 4.5.0
+ */
+- (void)recordMetrics:(PNRequestMetrics *)metrics;
+
+/**
+ @brief  Remove all collected durations.
+
+ @since 4.5.0
+ */
+- (void)reset;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,80 @@
+#import <Foundation/Foundation.h>
+#import "PNStructures.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      \b PubNub requests processing duration histogram.
+ @discussion Instance represent snapshot of total processing duration (from request construction till
+             completion block call) distribution for all requests of single operation type.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNRequestMetricsHistogram : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores type of operation for which requests durations has been collected.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) PNOperationType operation;
+
+/**
+ @brief  Stores number of requests which has been completed.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/**
+ @brief  Stores shortest request processing duration (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval minimumDuration;
+
+/**
+ @brief  Stores longest request processing duration (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval maximumDuration;
+
+/**
+ @brief  Stores average request processing duration (in seconds).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval averageDuration;
+
+/**
+ @brief      Stores list of histogram buckets upper bounds (in seconds).
+ @discussion Bounds: 10ms, 25ms, 50ms, 100ms, 250ms, 500ms, 1s, 2.5s, 5s and 10s.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, copy) NSArray<NSNumber *> *bucketBounds;
+
+/**
+ @brief      Stores number of requests in each histogram bucket.
+ @discussion List contain one more element than \c bucketBounds: number of requests which took longer than
+             last bound.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, copy) NSArray<NSNumber *> *bucketCounts;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,188 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNRequestMetricsHistogram+Private.h"
+#import "PNRequestMetrics.h"
+#import <libkern/OSAtomic.h>
+
+
+#pragma mark Static
+
+/**
+ @brief  Number of histogram buckets with upper bound.
+
+ @since 4.5.0
+ */
+static NSUInteger const kPNHistogramBoundsCount = 10;
+
+/**
+ @brief  Histogram buckets upper bounds (in seconds).
+
+ @since 4.5.0
+ */
+static NSTimeInterval const kPNHistogramBounds[kPNHistogramBoundsCount] = {
+    0.01f, 0.025f, 0.05f, 0.1f, 0.25f, 0.5f, 1.f, 2.5f, 5.f, 10.f
+};
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNRequestMetricsHistogram () {
+
+    /**
+     @brief  Stores number of requests in each bucket (last one for requests which exceed all bounds).
+
+     @since 4.5.0
+     */
+    NSUInteger _buckets[kPNHistogramBoundsCount + 1];
+
+    /**
+     @brief  Stores summary duration of all recorded requests.
+
+     @since 4.5.0
+     */
+    NSTimeInterval _totalDuration;
+
+    /**
+     @brief  Spin-lock which is used to protect histogram state.
+
+     @since 4.5.0
+     */
+    OSSpinLock _lock;
+}
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) PNOperationType operation;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) NSTimeInterval minimumDuration;
+@property (nonatomic, assign) NSTimeInterval maximumDuration;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize empty histogram for specified operation type.
+
+ @param operation Type of operation for which requests durations will be collected.
+
+ @return Initialized and ready to use histogram.
+
+ @since 4.5.0
+ */
+- (instancetype)initForOperation:(PNOperationType)operation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNRequestMetricsHistogram
+
+
+#pragma mark - Information
+
+- (NSTimeInterval)averageDuration {
+
+    return (self.count ? (_totalDuration / self.count) : 0.f);
+}
+
+- (NSArray<NSNumber *> *)bucketBounds {
+
+    NSMutableArray<NSNumber *> *bounds = [[NSMutableArray alloc] initWithCapacity:kPNHistogramBoundsCount];
+    for (NSUInteger boundIdx = 0; boundIdx < kPNHistogramBoundsCount; boundIdx++) {
+
+        [bounds addObject:@(kPNHistogramBounds[boundIdx])];
+    }
+
+    return [bounds copy];
+}
+
+- (NSArray<NSNumber *> *)bucketCounts {
+
+    NSMutableArray<NSNumber *> *counts = [[NSMutableArray alloc] initWithCapacity:(kPNHistogramBoundsCount + 1)];
+    for (NSUInteger bucketIdx = 0; bucketIdx <= kPNHistogramBoundsCount; bucketIdx++) {
+
+        [counts addObject:@(_buckets[bucketIdx])];
+    }
+
+    return [counts copy];
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)histogramForOperation:(PNOperationType)operation {
+
+    return [[self alloc] initForOperation:operation];
+}
+
+- (instancetype)initForOperation:(PNOperationType)operation {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        _operation = operation;
+        _lock = OS_SPINLOCK_INIT;
+    }
+
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+
+    PNRequestMetricsHistogram *histogram = [[[self class] allocWithZone:zone] initForOperation:self.operation];
+    OSSpinLockLock(&_lock);
+    histogram.count = self.count;
+    histogram.minimumDuration = self.minimumDuration;
+    histogram.maximumDuration = self.maximumDuration;
+    histogram->_totalDuration = _totalDuration;
+    memcpy(histogram->_buckets, _buckets, sizeof(_buckets));
+    OSSpinLockUnlock(&_lock);
+
+    return histogram;
+}
+
+
+#pragma mark - Recording
+
+- (void)recordMetrics:(PNRequestMetrics *)metrics {
+
+    NSTimeInterval duration = [metrics totalDuration];
+    NSUInteger bucketIdx = 0;
+    while (bucketIdx < kPNHistogramBoundsCount && duration > kPNHistogramBounds[bucketIdx]) { bucketIdx++; }
+
+    OSSpinLockLock(&_lock);
+    self.minimumDuration = (self.count ? MIN(self.minimumDuration, duration) : duration);
+    self.maximumDuration = MAX(self.maximumDuration, duration);
+    self.count++;
+    _totalDuration += duration;
+    _buckets[bucketIdx]++;
+    OSSpinLockUnlock(&_lock);
+}
+
+- (void)reset {
+
+    OSSpinLockLock(&_lock);
+    self.count = 0;
+    self.minimumDuration = 0.f;
+    self.maximumDuration = 0.f;
+    _totalDuration = 0.f;
+    memset(_buckets, 0, sizeof(_buckets));
+    OSSpinLockUnlock(&_lock);
+}
+
+#pragma mark -
+
+
+@end
@@ -5,6 +5,7 @@
  */
 #import "PNResult.h"
 #import "PNStructures.h"
+#import "PNTransport.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -30,6 +31,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, nullable, copy) NSString *authKey;
 @property (nonatomic, copy) NSString *origin;
 @property (nonatomic, nullable, copy) NSURLRequest *clientRequest;
+@property (nonatomic, nullable, strong) PNRequestMetrics *metrics;
 
 /**
  @brief      Stores reference on processed \c response which is ready to use by user.
@@ -59,7 +61,7 @@ NS_ASSUME_NONNULL_BEGIN
  @since 4.0
  */
 + (instancetype)objectForOperation:(PNOperationType)operation
-                 completedWithTask:(nullable NSURLSessionDataTask *)task
+                 completedWithTask:(nullable id <PNTransportTask>)task
                      processedData:(nullable NSDictionary<NSString *, id> *)processedData
                    processingError:(nullable NSError *)error;
 
@@ -77,7 +79,7 @@ NS_ASSUME_NONNULL_BEGIN
  @since 4.0
  */
 - (instancetype)initForOperation:(PNOperationType)operation
-               completedWithTask:(nullable NSURLSessionDataTask *)task
+               completedWithTask:(nullable id <PNTransportTask>)task
                    processedData:(nullable NSDictionary<NSString *, id> *)processedData
                  processingError:(nullable NSError *)error;
 
@@ -2,6 +2,11 @@
 #import "PNStructures.h"
 
 
+#pragma mark Class forward
+
+@class PNRequestMetrics;
+
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -74,6 +79,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, nullable, readonly, copy) NSURLRequest *clientRequest;
 
+/**
+ @brief      Stores reference on request processing metrics.
+ @discussion Metrics available only for objects which has been created in response on request to \b PubNub 
+             service.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) PNRequestMetrics *metrics;
+
 /**
  @brief  Stringified \c operation value.
  
@@ -26,6 +26,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, nullable, copy) NSString *authKey;
 @property (nonatomic, copy) NSString *origin;
 @property (nonatomic, nullable, copy) NSURLRequest *clientRequest;
+@property (nonatomic, nullable, strong) PNRequestMetrics *metrics;
 @property (nonatomic, nullable, copy) NSDictionary<NSString *, id> *serviceData;
 
 
@@ -77,7 +78,7 @@ NS_ASSUME_NONNULL_END
 #pragma mark - Initialization and Configuration
 
 + (instancetype)objectForOperation:(PNOperationType)operation
-                 completedWithTask:(nullable NSURLSessionDataTask *)task
+                 completedWithTask:(nullable id <PNTransportTask>)task
                      processedData:(nullable NSDictionary<NSString *, id> *)processedData 
                    processingError:(nullable NSError *)error {
     
@@ -86,7 +87,7 @@ NS_ASSUME_NONNULL_END
 }
 
 - (instancetype)initForOperation:(PNOperationType)operation
-               completedWithTask:(nullable NSURLSessionDataTask *)task
+               completedWithTask:(nullable id <PNTransportTask>)task
                    processedData:(nullable NSDictionary<NSString *, id> *)processedData 
                  processingError:(nullable NSError *)__unused error {
     
@@ -148,6 +149,7 @@ NS_ASSUME_NONNULL_END
     result.authKey = self.authKey;
     result.origin = self.origin;
     result.clientRequest = self.clientRequest;
+    result.metrics = self.metrics;
     if (shouldCopyServiceData) {
         
         [result updateData:self.serviceData];
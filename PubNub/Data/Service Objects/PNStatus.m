@@ -46,7 +46,7 @@
  
  @since 4.0
  */
-- (instancetype)initForOperation:(PNOperationType)operation completedWithTask:(NSURLSessionDataTask *)task
+- (instancetype)initForOperation:(PNOperationType)operation completedWithTask:(id <PNTransportTask>)task
                    processedData:(NSDictionary<NSString *, id> *)processedData 
                  processingError:(NSError *)error;
 
@@ -106,7 +106,10 @@
 - (void)setCategory:(PNStatusCategory)category {
     
     _category = category;
-    if (_category == PNDecryptionErrorCategory) { self.error = YES; }
+    if (_category == PNDecryptionErrorCategory || _category == PNEventsDeliveryOverflowCategory) {
+        
+        self.error = YES;
+    }
     else if (_category == PNConnectedCategory || _category == PNReconnectedCategory ||
              _category == PNDisconnectedCategory || _category == PNUnexpectedDisconnectCategory) {
         
@@ -149,7 +152,7 @@
 }
 
 - (instancetype)initForOperation:(PNOperationType)operation 
-               completedWithTask:(nullable NSURLSessionDataTask *)task
+               completedWithTask:(nullable id <PNTransportTask>)task
                    processedData:(nullable NSDictionary<NSString *, id> *)processedData 
                  processingError:(nullable NSError *)error {
     
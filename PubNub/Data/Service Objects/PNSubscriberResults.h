@@ -56,6 +56,33 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, nullable, readonly, strong) NSDictionary<NSString *, id> *state;
 
+/**
+ @brief  List of clients which joined channel since previous \c interval event.
+ 
+ @return List of unique identifiers or \c nil if event doesn't carry this information.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSArray<NSString *> *join;
+
+/**
+ @brief  List of clients which left channel since previous \c interval event.
+ 
+ @return List of unique identifiers or \c nil if event doesn't carry this information.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSArray<NSString *> *leave;
+
+/**
+ @brief  List of clients which has been timed out since previous \c interval event.
+ 
+ @return List of unique identifiers or \c nil if event doesn't carry this information.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, strong) NSArray<NSString *> *timeout;
+
 #pragma mark -
 
 
@@ -35,6 +35,21 @@
     return self.serviceData[@"state"];
 }
 
+- (nullable NSArray<NSString *> *)join {
+    
+    return self.serviceData[@"join"];
+}
+
+- (nullable NSArray<NSString *> *)leave {
+    
+    return self.serviceData[@"leave"];
+}
+
+- (nullable NSArray<NSString *> *)timeout {
+    
+    return self.serviceData[@"timeout"];
+}
+
 #pragma mark -
 
 
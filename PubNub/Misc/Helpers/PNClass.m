@@ -15,7 +15,8 @@
 #pragma mark - Misc
 
 /**
- @brief  Registered classes.
+ @brief      Registered classes.
+ @discussion Only classes from binary image which contain SDK is returned.
  
  @return List of PubNub SDK classes which has been loaded to the memory.
  
@@ -66,18 +67,22 @@
 
 + (nullable NSArray<Class> *)classes {
     
+    // Only classes from image which contain SDK is checked, so lookup doesn't depend from number of classes 
+    // loaded by application and system frameworks.
     NSMutableArray *classesList = [NSMutableArray new];
-    unsigned int visibleClassesCount;
-    Class *classes = objc_copyClassList(&visibleClassesCount);
-    for (unsigned int classIdx = 0; classIdx < visibleClassesCount; classIdx++) {
+    unsigned int imageClassesCount = 0;
+    const char *imageName = class_getImageName(self);
+    const char **classNames = (imageName ? objc_copyClassNamesForImage(imageName, &imageClassesCount) : NULL);
+    for (unsigned int classIdx = 0; classIdx < imageClassesCount; classIdx++) {
         
-        NSString *className = NSStringFromClass(classes[classIdx]);
+        NSString *className = @(classNames[classIdx]);
         if ([className hasPrefix:@"PN"] || [className isEqualToString:@"PubNub"]) {
             
-            [classesList addObject:classes[classIdx]];
+            Class class = objc_getClass(classNames[classIdx]);
+            if (class) { [classesList addObject:class]; }
         }
     }
-    free(classes);
+    free(classNames);
     
     return (classesList.count ? [classesList copy] : nil);
 }
@@ -1,10 +1,13 @@
 #import <Foundation/Foundation.h>
+#import "PNStructures.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- @brief  Useful methods collection to work with data compression/uncompression.
+ @brief      Useful methods collection to work with data compression/uncompression.
+ @discussion Each thread which use compression keep it's own \c zlib stream which is reset between calls, so
+             compression of sequence of messages doesn't require stream initialization for each of them.
  
  @author Sergey Mamontov
  @since 4.0
@@ -19,6 +22,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  @brief      Allow to compress passed \c data.
+ @discussion Data compressed with default \c zlib compression level and strategy.
 
  @param data Data which should be compressed with GZIP deflate algorithm.
 
@@ -28,6 +32,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable NSData *)GZIPDeflatedData:(NSData *)data;
 
+/**
+ @brief  Allow to compress passed \c data using specified compression level and strategy.
+
+ @param data     Data which should be compressed with GZIP deflate algorithm.
+ @param level    Compression level in \b 0-9 range (\b -1 to use default \c zlib compression level).
+ @param strategy One of \b PNCompressionStrategy fields which describe how data should be compressed.
+
+ @return Compressed \a NSData instance or \c nil in case if compression error occurred.
+
+ @since 4.5.0
+ */
++ (nullable NSData *)GZIPDeflatedData:(NSData *)data withLevel:(NSInteger)level
+                             strategy:(PNCompressionStrategy)strategy;
+
+
+///------------------------------------------------
+/// @name Uncompression
+///------------------------------------------------
+
+/**
+ @brief      Allow to uncompress passed \c data.
+ @discussion Both GZIP and zlib wrapped data can be uncompressed.
+
+ @param data Data which has been compressed with GZIP deflate algorithm.
+
+ @return Uncompressed \a NSData instance or \c nil in case if data is malformed or truncated.
+
+ @since 4.5.0
+ */
++ (nullable NSData *)GZIPInflatedData:(NSData *)data;
+
 #pragma mark -
 
 
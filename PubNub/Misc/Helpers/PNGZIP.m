@@ -4,10 +4,160 @@
  @copyright © 2009-2016 PubNub, Inc.
  */
 #import "PNGZIP.h"
+#import <pthread.h>
 #import <zlib.h>
 
 
-#pragma mark Interface implementation
+#pragma mark Static
+
+/**
+ @brief  Window size which is used for compression (\b 15 bits window with GZIP header and trailer).
+
+ @since 4.5.0
+ */
+static int const kPNGZIPDeflateWindowBits = 31;
+
+/**
+ @brief  Window size which is used for uncompression (\b 15 bits window with GZIP / zlib header detection).
+
+ @since 4.5.0
+ */
+static int const kPNGZIPInflateWindowBits = 47;
+
+/**
+ @brief  How much memory should be allocated by \c zlib for internal compression state.
+
+ @since 4.5.0
+ */
+static int const kPNGZIPMemoryLevel = 8;
+
+/**
+ @brief      Maximum size of uncompressed data which can be pre-allocated using GZIP trailer information.
+ @discussion Trailer can't be trusted (it store size modulo 2^32 and can be forged), so larger buffers grow
+             only while data is uncompressed.
+
+ @since 4.5.0
+ */
+static NSUInteger const kPNGZIPMaximumInflatedLengthHint = (16 * 1024 * 1024);
+
+
+#pragma mark - Structures
+
+/**
+ @brief  Structure which describe \c zlib streams which is used by single thread.
+
+ @since 4.5.0
+ */
+typedef struct PNGZIPStreams {
+
+    /**
+     @brief  Stores compression stream which is reset after each use.
+     */
+    z_stream deflateStream;
+
+    /**
+     @brief  Stores whether \c deflateStream has been initialized or not.
+     */
+    BOOL deflateStreamInitialized;
+
+    /**
+     @brief  Stores compression level with which \c deflateStream currently configured.
+     */
+    int level;
+
+    /**
+     @brief  Stores compression strategy with which \c deflateStream currently configured.
+     */
+    int strategy;
+
+    /**
+     @brief  Stores uncompression stream which is reset after each use.
+     */
+    z_stream inflateStream;
+
+    /**
+     @brief  Stores whether \c inflateStream has been initialized or not.
+     */
+    BOOL inflateStreamInitialized;
+} PNGZIPStreams;
+
+
+#pragma mark - Thread storage
+
+/**
+ @brief  Stores reference on key which is used to store \c PNGZIPStreams in thread local storage.
+
+ @since 4.5.0
+ */
+static pthread_key_t PNGZIPStreamsKey;
+
+/**
+ @brief  Release \c zlib resources which has been allocated for thread which is about to exit.
+
+ @param streams Reference on \c PNGZIPStreams structure which has been stored for thread.
+
+ @since 4.5.0
+ */
+static void PNGZIPStreamsDestroy(void *streams) {
+
+    PNGZIPStreams *threadStreams = (PNGZIPStreams *)streams;
+    if (threadStreams->deflateStreamInitialized) { deflateEnd(&threadStreams->deflateStream); }
+    if (threadStreams->inflateStreamInitialized) { inflateEnd(&threadStreams->inflateStream); }
+    free(threadStreams);
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+@interface PNGZIP ()
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Retrieve \c zlib streams which can be used by current thread.
+
+ @return Reference on streams structure or \c NULL in case if it can't be allocated.
+
+ @since 4.5.0
+ */
++ (nullable PNGZIPStreams *)streams;
+
+/**
+ @brief  Translate client's compression strategy to \c zlib strategy.
+
+ @param strategy One of \b PNCompressionStrategy fields which should be translated.
+
+ @return One of \c zlib strategy constants.
+
+ @since 4.5.0
+ */
++ (int)zlibStrategyFrom:(PNCompressionStrategy)strategy;
+
+/**
+ @brief      Calculate with which buffer size uncompression should start.
+ @discussion GZIP trailer store size of uncompressed data, so in most cases uncompression will be done
+             without buffer re-allocation.
+
+ @param data Reference on compressed data for which buffer should be allocated.
+
+ @return Initial buffer size.
+
+ @since 4.5.0
+ */
++ (NSUInteger)inflatedLengthHintForData:(NSData *)data;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
 
 @implementation PNGZIP
 
@@ -15,57 +165,185 @@
 #pragma mark - Compression
 
 + (NSData *)GZIPDeflatedData:(NSData *)data {
+    
+    return [self GZIPDeflatedData:data withLevel:Z_DEFAULT_COMPRESSION strategy:PNDefaultCompressionStrategy];
+}
 
-    NSMutableData *processedDataStorage = nil;
-    NSUInteger window = 31;
-    if (data.length > 0) {
-
-        BOOL done = NO;
-        int status;
-        z_stream stream;
-        bzero(&stream, sizeof(stream));
-        stream.zalloc = Z_NULL;
-        stream.zfree = Z_NULL;
-        stream.opaque = Z_NULL;
-        stream.next_in = (Bytef *)data.bytes;
-        stream.avail_in = (uint)data.length;
-        stream.total_out = 0;
-        status = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window, 8, Z_DEFAULT_STRATEGY);
++ (NSData *)GZIPDeflatedData:(NSData *)data withLevel:(NSInteger)level
+                             strategy:(PNCompressionStrategy)strategy {
 
+    NSMutableData *processedDataStorage = nil;
+    PNGZIPStreams *streams = (data.length > 0 && data.length <= UINT_MAX ? [self streams] : NULL);
+    if (streams) {
+        
+        z_stream *stream = &streams->deflateStream;
+        int zlibLevel = (int)MIN(MAX(level, (NSInteger)Z_DEFAULT_COMPRESSION), (NSInteger)Z_BEST_COMPRESSION);
+        int zlibStrategy = [self zlibStrategyFrom:strategy];
+        int status = Z_OK;
+        if (!streams->deflateStreamInitialized) {
+            
+            status = deflateInit2(stream, zlibLevel, Z_DEFLATED, kPNGZIPDeflateWindowBits, kPNGZIPMemoryLevel,
+                                  zlibStrategy);
+            streams->deflateStreamInitialized = (status == Z_OK);
+        }
+        else if (streams->level != zlibLevel || streams->strategy != zlibStrategy) {
+            
+            // Stream reset after each use, so parameters can be changed without pending output flush.
+            status = deflateParams(stream, zlibLevel, zlibStrategy);
+        }
+        
         if (status == Z_OK) {
+            
+            streams->level = zlibLevel;
+            streams->strategy = zlibStrategy;
+            
+            // Bound take into account GZIP header and trailer, so whole data can be compressed at once.
+            uLong bound = deflateBound(stream, (uLong)data.length);
+            if (bound <= UINT_MAX) {
+                
+                processedDataStorage = [[NSMutableData alloc] initWithLength:bound];
+                stream->next_in = (Bytef *)data.bytes;
+                stream->avail_in = (uInt)data.length;
+                stream->next_out = (Bytef *)processedDataStorage.mutableBytes;
+                stream->avail_out = (uInt)bound;
+                
+                if (deflate(stream, Z_FINISH) == Z_STREAM_END) {
+                    
+                    // Set real length.
+                    [processedDataStorage setLength:stream->total_out];
+                }
+                else { processedDataStorage = nil; }
+            }
+            
+            // Drop stream state, so it won't be used on next call if reset failed.
+            if (deflateReset(stream) != Z_OK) {
+                
+                deflateEnd(stream);
+                streams->deflateStreamInitialized = NO;
+            }
+        }
+    }
 
-            BOOL isOperationCompleted = NO;
-            processedDataStorage = [[NSMutableData alloc] initWithLength:1024];
+    return (processedDataStorage.length ? processedDataStorage : nil);
+}
 
-            while (!isOperationCompleted) {
 
-                // Make sure we have enough room and reset the lengths.
-                if ((status == Z_BUF_ERROR)  || stream.total_out >= processedDataStorage.length) {
+#pragma mark - Uncompression
 
-                    [processedDataStorage increaseLengthBy:1024];
++ (NSData *)GZIPInflatedData:(NSData *)data {
+    
+    NSMutableData *processedDataStorage = nil;
+    PNGZIPStreams *streams = (data.length > 0 && data.length <= UINT_MAX ? [self streams] : NULL);
+    if (streams) {
+        
+        z_stream *stream = &streams->inflateStream;
+        int status = Z_OK;
+        if (!streams->inflateStreamInitialized) {
+            
+            status = inflateInit2(stream, kPNGZIPInflateWindowBits);
+            streams->inflateStreamInitialized = (status == Z_OK);
+        }
+        
+        if (status == Z_OK) {
+            
+            processedDataStorage = [[NSMutableData alloc] initWithLength:[self inflatedLengthHintForData:data]];
+            stream->next_in = (Bytef *)data.bytes;
+            stream->avail_in = (uInt)data.length;
+            
+            while (status == Z_OK) {
+                
+                // Grow buffer geometrically to keep number of re-allocations low for wrong size hint.
+                if (stream->total_out >= processedDataStorage.length) {
+                    
+                    [processedDataStorage increaseLengthBy:processedDataStorage.length];
                 }
-                stream.next_out = (Bytef*)processedDataStorage.mutableBytes + stream.total_out;
-                stream.avail_out = (uInt)(processedDataStorage.length - stream.total_out);
-
-                // Deflate another chunk
-                status = deflate(&stream, Z_FINISH);
-                isOperationCompleted = ((status != Z_OK) && (status != Z_BUF_ERROR));
+                stream->next_out = (Bytef *)processedDataStorage.mutableBytes + stream->total_out;
+                stream->avail_out = (uInt)MIN(processedDataStorage.length - stream->total_out,
+                                              (NSUInteger)UINT_MAX);
+                
+                // Z_BUF_ERROR returned when there is no more input, so compressed data is truncated.
+                status = inflate(stream, Z_NO_FLUSH);
+            }
+            
+            if (status == Z_STREAM_END) { [processedDataStorage setLength:stream->total_out]; }
+            else { processedDataStorage = nil; }
+            
+            // Drop stream state, so it won't be used on next call if reset failed.
+            if (inflateReset(stream) != Z_OK) {
+                
+                inflateEnd(stream);
+                streams->inflateStreamInitialized = NO;
             }
+        }
+    }
+    
+    return processedDataStorage;
+}
 
-            status = deflateEnd(&stream);
-            done = (status == Z_OK || status == Z_STREAM_END);
 
-            if (status == Z_OK) {
+#pragma mark - Misc
 
-                // Set real length.
-                if (done) { [processedDataStorage setLength:stream.total_out]; }
-            }
++ (PNGZIPStreams *)streams {
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        pthread_key_create(&PNGZIPStreamsKey, &PNGZIPStreamsDestroy);
+    });
+    
+    PNGZIPStreams *streams = pthread_getspecific(PNGZIPStreamsKey);
+    if (!streams) {
+        
+        // Zero-filled structure means that zlib will use default allocation functions.
+        streams = calloc(1, sizeof(PNGZIPStreams));
+        if (streams && pthread_setspecific(PNGZIPStreamsKey, streams) != 0) {
+            
+            free(streams);
+            streams = NULL;
         }
     }
+    
+    return streams;
+}
 
-    return (processedDataStorage.length ? processedDataStorage : nil);
++ (int)zlibStrategyFrom:(PNCompressionStrategy)strategy {
+    
+    int zlibStrategy = Z_DEFAULT_STRATEGY;
+    switch (strategy) {
+        case PNFilteredCompressionStrategy:
+            zlibStrategy = Z_FILTERED;
+            break;
+        case PNHuffmanOnlyCompressionStrategy:
+            zlibStrategy = Z_HUFFMAN_ONLY;
+            break;
+        case PNRLECompressionStrategy:
+            zlibStrategy = Z_RLE;
+            break;
+        case PNFixedCompressionStrategy:
+            zlibStrategy = Z_FIXED;
+            break;
+        default:
+            break;
+    }
+    
+    return zlibStrategy;
 }
 
++ (NSUInteger)inflatedLengthHintForData:(NSData *)data {
+    
+    NSUInteger hint = (data.length * 4);
+    const uint8_t *bytes = data.bytes;
+    
+    // GZIP member has at least 10 bytes header and 8 bytes trailer with uncompressed size at the end.
+    if (data.length >= 18 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        
+        const uint8_t *size = (bytes + data.length - 4);
+        hint = (NSUInteger)((uint32_t)size[0] | ((uint32_t)size[1] << 8) | ((uint32_t)size[2] << 16) |
+                            ((uint32_t)size[3] << 24));
+    }
+    
+    return MAX(MIN(hint, kPNGZIPMaximumInflatedLengthHint), (NSUInteger)1024);
+}
 
 #pragma mark -
 
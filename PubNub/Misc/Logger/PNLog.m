@@ -143,6 +143,8 @@ NS_ASSUME_NONNULL_END
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         
+        // Classes which declare own 'ddLogLevel' derived from SDK image, so new classes doesn't need to be 
+        // registered anywhere.
         logEnabledClasses = [PNClass classesRespondingToSelector:@selector(ddLogLevel)];
     });
     
@@ -41,5 +41,24 @@ static PNHeartbeatNotificationOptions const kPNDefaultHeartbeatNotificationOptio
 static BOOL const kPNDefaultShouldKeepTimeTokenOnListChange = YES;
 static BOOL const kPNDefaultShouldRestoreSubscription = YES;
 static BOOL const kPNDefaultShouldTryCatchUpOnSubscriptionRestore = YES;
+static PNTransportType const kPNDefaultTransportType = PNURLSessionTransportType;
+static NSInteger const kPNDefaultPublishRequestsMaximumConnections = 2;
+static NSInteger const kPNDefaultControlRequestsMaximumConnections = 1;
+static NSInteger const kPNDefaultBulkReadRequestsMaximumConnections = 1;
+static NSUInteger const kPNDefaultSubscribeShardsMaximumCount = 1;
+static NSUInteger const kPNDefaultSubscribeShardObjectsThreshold = 200;
+static NSTimeInterval const kPNDefaultSubscribeCoalescingInterval = 0.f;
+static PNQualityOfService const kPNDefaultParsingQualityOfService = PNUserInitiatedQualityOfService;
+static NSUInteger const kPNDefaultParsingMaximumConcurrency = 2;
+static BOOL const kPNDefaultShouldCollectRequestMetricsHistogram = NO;
+static BOOL const kPNDefaultShouldMaintainPresenceIndex = NO;
+static NSInteger const kPNDefaultCompressionLevel = -1;
+static PNCompressionStrategy const kPNDefaultCompressionStrategy = PNDefaultCompressionStrategy;
+static NSUInteger const kPNDefaultPublishMaximumInFlight = 4;
+static NSUInteger const kPNDefaultEventsDeliveryBufferCapacity = 0;
+static PNEventsDeliveryBufferPolicy const kPNDefaultEventsDeliveryBufferPolicy = PNBlockSubscribeLoopBufferPolicy;
+static NSTimeInterval const kPNDefaultEventsDeliverySliceDuration = 0.f;
+static NSUInteger const kPNDefaultEventsDeliverySliceMaximumCount = 0;
+static NSUInteger const kPNDefaultEventsProcessingWorkersCount = 0;
 
 #endif // PNConstants_h
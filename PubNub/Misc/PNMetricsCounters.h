@@ -0,0 +1,93 @@
+/**
+ @brief      Set of counters and macro which is used by \b PubNub client to collect metrics on hot paths.
+ @discussion Counters updated with atomic operations w/o locks. Metrics collection can be removed from
+             compiled code by adding \c PN_METRICS_ENABLED=0 to preprocessor definitions: in this case all
+             macro expand to nothing and counters not allocated.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import <Foundation/Foundation.h>
+#import <libkern/OSAtomic.h>
+
+
+#ifndef PNMetricsCounters_h
+#define PNMetricsCounters_h
+
+#ifndef PN_METRICS_ENABLED
+    #define PN_METRICS_ENABLED 1
+#endif // PN_METRICS_ENABLED
+
+
+#pragma mark Types
+
+/**
+ @brief      Structure which store client-wide metrics counters.
+ @discussion All durations stored in microseconds.
+
+ @since 4.5.0
+ */
+typedef struct PNMetricsCounters {
+
+    volatile int64_t messagesReceived;
+    volatile int64_t presenceEventsReceived;
+    volatile int64_t bytesReceived;
+    volatile int64_t decryptionFailures;
+    volatile int64_t subscribeCycles;
+    volatile int64_t subscribeCycleLatency;
+    volatile int64_t lastSubscribeCycleLatency;
+    volatile int64_t pollGaps;
+    volatile int64_t pollGap;
+    volatile int64_t lastPollGap;
+    volatile int64_t listenerQueueDepth;
+    volatile int64_t publishesInFlight;
+    volatile int64_t publishQueueDepth;
+    volatile int64_t publishQueueWaits;
+    volatile int64_t publishQueueWait;
+    volatile int64_t lastPublishQueueWait;
+    volatile int64_t deliverySlices;
+    volatile int64_t deliverySlicesEvents;
+    volatile int64_t lastDeliverySliceSize;
+    volatile int64_t deliveryBacklog;
+    volatile int64_t subscribeRetries;
+} PNMetricsCounters;
+
+
+#pragma mark - Functions
+
+/**
+ @brief  Atomically replace counter value.
+
+ @param counter Pointer on counter which should be updated.
+ @param value   New counter value.
+
+ @since 4.5.0
+ */
+static inline void PNMetricsStoreValue(volatile int64_t *counter, int64_t value) {
+
+    int64_t oldValue = *counter;
+    while (!OSAtomicCompareAndSwap64Barrier(oldValue, value, counter)) { oldValue = *counter; }
+}
+
+
+#pragma mark - Macro
+
+#if PN_METRICS_ENABLED
+    #define PNMetricsAdd(counters, counter, value) do { \
+        PNMetricsCounters *pn_counters = (counters); \
+        if (pn_counters) { OSAtomicAdd64Barrier((int64_t)(value), &pn_counters->counter); } \
+    } while (0)
+    #define PNMetricsStore(counters, counter, value) do { \
+        PNMetricsCounters *pn_counters = (counters); \
+        if (pn_counters) { PNMetricsStoreValue(&pn_counters->counter, (int64_t)(value)); } \
+    } while (0)
+#else
+    #define PNMetricsAdd(counters, counter, value)
+    #define PNMetricsStore(counters, counter, value)
+#endif // PN_METRICS_ENABLED
+
+#define PNMetricsIncrement(counters, counter) PNMetricsAdd(counters, counter, 1)
+#define PNMetricsDecrement(counters, counter) PNMetricsAdd(counters, counter, -1)
+
+#endif // PNMetricsCounters_h
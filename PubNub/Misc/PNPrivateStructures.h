@@ -41,43 +41,210 @@ static NSString * const PNOperationTypeStrings[22] = {
     [PNTimeOperation] = @"Time",
 };
 
-static NSString * const PNOperationResultClasses[22] = {
-    [PNHistoryOperation] = @"PNHistoryResult",
-    [PNWhereNowOperation] = @"PNPresenceWhereNowResult",
-    [PNHereNowGlobalOperation] = @"PNPresenceGlobalHereNowResult",
-    [PNHereNowForChannelOperation] = @"PNPresenceChannelHereNowResult",
-    [PNHereNowForChannelGroupOperation] = @"PNPresenceChannelGroupHereNowResult",
-    [PNStateForChannelOperation] = @"PNChannelClientStateResult",
-    [PNStateForChannelGroupOperation] = @"PNChannelGroupClientStateResult",
-    [PNChannelGroupsOperation] = @"PNChannelGroupsResult",
-    [PNChannelsForGroupOperation] = @"PNChannelGroupChannelsResult",
-    [PNPushNotificationEnabledChannelsOperation] = @"PNAPNSEnabledChannelsResult",
-    [PNTimeOperation] = @"PNTimeResult",
-};
+/**
+ @brief      Structure which describe how client should build request and process response for operation.
+ @discussion Class names resolved by \b PNNetwork once, so lookup on response processing doesn't require any
+             runtime classes scanning.
+
+ @since 4.5.0
+ */
+typedef struct PNOperationDescription {
+
+    /**
+     @brief  Request path template with placeholders which will be replaced by \b PNURLBuilder.
+     */
+    __unsafe_unretained NSString *requestTemplate;
+
+    /**
+     @brief  Name of class which conforms to \b PNParser protocol and can process service response.
+     */
+    __unsafe_unretained NSString *parserClass;
+
+    /**
+     @brief  Name of class which should be used to represent request processing results (if expected).
+     */
+    __unsafe_unretained NSString *resultClass;
+
+    /**
+     @brief  Name of class which should be used to represent request processing status.
+     */
+    __unsafe_unretained NSString *statusClass;
 
-static NSString * const PNOperationStatusClasses[22] = {
-    [PNSubscribeOperation] = @"PNSubscribeStatus",
-    [PNUnsubscribeOperation] = @"PNAcknowledgmentStatus",
-    [PNPublishOperation] = @"PNPublishStatus",
-    [PNHistoryOperation] = @"PNErrorStatus",
-    [PNWhereNowOperation] = @"PNErrorStatus",
-    [PNHereNowGlobalOperation] = @"PNErrorStatus",
-    [PNHereNowForChannelOperation] = @"PNErrorStatus",
-    [PNHereNowForChannelGroupOperation] = @"PNErrorStatus",
-    [PNHeartbeatOperation] = @"PNAcknowledgmentStatus",
-    [PNSetStateOperation] = @"PNClientStateUpdateStatus",
-    [PNStateForChannelOperation] = @"PNErrorStatus",
-    [PNStateForChannelGroupOperation] = @"PNErrorStatus",
-    [PNAddChannelsToGroupOperation] = @"PNAcknowledgmentStatus",
-    [PNRemoveChannelsFromGroupOperation] = @"PNAcknowledgmentStatus",
-    [PNChannelGroupsOperation] = @"PNErrorStatus",
-    [PNRemoveGroupOperation] = @"PNAcknowledgmentStatus",
-    [PNChannelsForGroupOperation] = @"PNErrorStatus",
-    [PNPushNotificationEnabledChannelsOperation] = @"PNErrorStatus",
-    [PNAddPushNotificationsOnChannelsOperation] = @"PNAcknowledgmentStatus",
-    [PNRemovePushNotificationsFromChannelsOperation] = @"PNAcknowledgmentStatus",
-    [PNRemoveAllPushNotificationsOperation] = @"PNAcknowledgmentStatus",
-    [PNTimeOperation] = @"PNErrorStatus",
+    /**
+     @brief  Whether operation is expecting result object or not.
+     */
+    BOOL expectResult;
+} PNOperationDescription;
+
+/**
+ @brief      Number of operations in \b PNOperationType.
+ @discussion Should be used to size tables which is indexed by \b PNOperationType, so new operation (which is 
+             always added before \b PNTimeOperation) won't be out of tables bounds.
+
+ @since 4.5.0
+ */
+#define PNOperationsCount (PNTimeOperation + 1)
+
+/**
+ @brief  Operations registry which is indexed by \b PNOperationType.
+
+ @since 4.5.0
+ */
+static PNOperationDescription const PNOperationDescriptions[PNOperationsCount] = {
+    [PNSubscribeOperation] = {
+        .requestTemplate = @"/v2/subscribe/{sub-key}/{channels}/0",
+        .parserClass = @"PNSubscribeParser",
+        .resultClass = nil,
+        .statusClass = @"PNSubscribeStatus",
+        .expectResult = NO
+    },
+    [PNUnsubscribeOperation] = {
+        .requestTemplate = @"/v2/presence/sub_key/{sub-key}/channel/{channels}/leave",
+        .parserClass = @"PNLeaveParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNPublishOperation] = {
+        .requestTemplate = @"/publish/{pub-key}/{sub-key}/0/{channel}/0/{message}",
+        .parserClass = @"PNMessagePublishParser",
+        .resultClass = nil,
+        .statusClass = @"PNPublishStatus",
+        .expectResult = NO
+    },
+    [PNHistoryOperation] = {
+        .requestTemplate = @"/v2/history/sub-key/{sub-key}/channel/{channel}",
+        .parserClass = @"PNHistoryParser",
+        .resultClass = @"PNHistoryResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNWhereNowOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/uuid/{uuid}",
+        .parserClass = @"PNPresenceWhereNowParser",
+        .resultClass = @"PNPresenceWhereNowResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNHereNowGlobalOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}",
+        .parserClass = @"PNPresenceHereNowParser",
+        .resultClass = @"PNPresenceGlobalHereNowResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNHereNowForChannelOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channel}",
+        .parserClass = @"PNPresenceHereNowParser",
+        .resultClass = @"PNPresenceChannelHereNowResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNHereNowForChannelGroupOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channel}",
+        .parserClass = @"PNPresenceHereNowParser",
+        .resultClass = @"PNPresenceChannelGroupHereNowResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNHeartbeatOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channels}/heartbeat",
+        .parserClass = @"PNHeartbeatParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNSetStateOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channel}/uuid/{uuid}/data",
+        .parserClass = @"PNClientStateParser",
+        .resultClass = nil,
+        .statusClass = @"PNClientStateUpdateStatus",
+        .expectResult = NO
+    },
+    [PNStateForChannelOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channel}/uuid/{uuid}",
+        .parserClass = @"PNClientStateParser",
+        .resultClass = @"PNChannelClientStateResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNStateForChannelGroupOperation] = {
+        .requestTemplate = @"/v2/presence/sub-key/{sub-key}/channel/{channel}/uuid/{uuid}",
+        .parserClass = @"PNClientStateParser",
+        .resultClass = @"PNChannelGroupClientStateResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNAddChannelsToGroupOperation] = {
+        .requestTemplate = @"/v1/channel-registration/sub-key/{sub-key}/channel-group/{channel-group}",
+        .parserClass = @"PNChannelGroupModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNRemoveChannelsFromGroupOperation] = {
+        .requestTemplate = @"/v1/channel-registration/sub-key/{sub-key}/channel-group/{channel-group}",
+        .parserClass = @"PNChannelGroupModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNChannelGroupsOperation] = {
+        .requestTemplate = @"/v1/channel-registration/sub-key/{sub-key}/channel-group",
+        .parserClass = @"PNChannelGroupAuditionParser",
+        .resultClass = @"PNChannelGroupsResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNRemoveGroupOperation] = {
+        .requestTemplate = @"/v1/channel-registration/sub-key/{sub-key}/channel-group/{channel-group}/remove",
+        .parserClass = @"PNChannelGroupModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNChannelsForGroupOperation] = {
+        .requestTemplate = @"/v1/channel-registration/sub-key/{sub-key}/channel-group/{channel-group}",
+        .parserClass = @"PNChannelGroupAuditionParser",
+        .resultClass = @"PNChannelGroupChannelsResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNPushNotificationEnabledChannelsOperation] = {
+        .requestTemplate = @"/v1/push/sub-key/{sub-key}/devices/{token}",
+        .parserClass = @"PNPushNotificationsAuditParser",
+        .resultClass = @"PNAPNSEnabledChannelsResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
+    [PNAddPushNotificationsOnChannelsOperation] = {
+        .requestTemplate = @"/v1/push/sub-key/{sub-key}/devices/{token}",
+        .parserClass = @"PNPushNotificationsStateModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNRemovePushNotificationsFromChannelsOperation] = {
+        .requestTemplate = @"/v1/push/sub-key/{sub-key}/devices/{token}",
+        .parserClass = @"PNPushNotificationsStateModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNRemoveAllPushNotificationsOperation] = {
+        .requestTemplate = @"/v1/push/sub-key/{sub-key}/devices/{token}/remove",
+        .parserClass = @"PNPushNotificationsStateModificationParser",
+        .resultClass = nil,
+        .statusClass = @"PNAcknowledgmentStatus",
+        .expectResult = NO
+    },
+    [PNTimeOperation] = {
+        .requestTemplate = @"/time/0",
+        .parserClass = @"PNTimeParser",
+        .resultClass = @"PNTimeResult",
+        .statusClass = @"PNErrorStatus",
+        .expectResult = YES
+    },
 };
 
 /**
@@ -85,7 +252,7 @@ static NSString * const PNOperationStatusClasses[22] = {
 
  @since 4.0
  */
-static NSString * const PNStatusCategoryStrings[16] = {
+static NSString * const PNStatusCategoryStrings[17] = {
     [PNUnknownCategory] = @"Unknown",
     [PNAcknowledgmentCategory] = @"Acknowledgment",
     [PNAccessDeniedCategory] = @"Access Denied",
@@ -101,7 +268,8 @@ static NSString * const PNStatusCategoryStrings[16] = {
     [PNMalformedResponseCategory] = @"Malformed Response",
     [PNDecryptionErrorCategory] = @"Decryption Error",
     [PNTLSConnectionFailedCategory] = @"TLS Connection Failed",
-    [PNTLSUntrustedCertificateCategory] = @"Untrusted TLS Certificate"
+    [PNTLSUntrustedCertificateCategory] = @"Untrusted TLS Certificate",
+    [PNEventsDeliveryOverflowCategory] = @"Events Delivery Overflow"
 };
 
 /**
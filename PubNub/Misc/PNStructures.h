@@ -314,7 +314,18 @@ typedef NS_ENUM(NSInteger, PNStatusCategory) {
                  "nslookup pubsub.pubnub.com" status object debug description and mail to
                  support@pubnub.com
     */
-    PNTLSUntrustedCertificateCategory
+    PNTLSUntrustedCertificateCategory,
+
+    /**
+     @brief      Status is sent in case if listeners didn't process received events in time and events 
+                 delivery buffer has been overflown.
+     @discussion Status \c errorData.data contain dictionary with number of events which has been dropped 
+                 (\c dropped key) and number of times when buffer has been overflown (\c overflows key) 
+                 since previous report. Events handling depends from \c eventsDeliveryBufferPolicy.
+
+     @since 4.5.0
+     */
+    PNEventsDeliveryOverflowCategory
 };
 
 /**
@@ -349,6 +360,195 @@ typedef NS_ENUM(NSInteger, PNHereNowVerbosityLevel) {
     PNHereNowState
 };
 
+/**
+ @brief  Definition for set of transports which can be used by client to communicate with \b PubNub network.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSInteger, PNTransportType) {
+
+    /**
+     @brief  Client will use \a NSURLSession to send requests.
+
+     @since 4.5.0
+     */
+    PNURLSessionTransportType,
+
+    /**
+     @brief      Client will use POSIX sockets with persistent (keep-alive) connections to send requests.
+     @discussion Transport doesn't support secured connection and client will use \a NSURLSession transport in
+                 case if TLS is enabled.
+
+     @since 4.5.0
+     */
+    PNSocketTransportType
+};
+
+/**
+ @brief      Definition for set of lanes which is used by client to schedule non-subscribe requests.
+ @discussion Each lane has own connections budget, so slow requests from one lane won't delay requests from
+             another.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSInteger, PNRequestLane) {
+
+    /**
+     @brief  Lane for message publish requests.
+
+     @since 4.5.0
+     */
+    PNPublishRequestLane,
+
+    /**
+     @brief  Lane for presence heartbeat, state, channel groups, push notifications and time requests.
+
+     @since 4.5.0
+     */
+    PNControlRequestLane,
+
+    /**
+     @brief  Lane for requests which may return large amount of data: history, here now and where now.
+
+     @since 4.5.0
+     */
+    PNBulkReadRequestLane
+};
+
+/**
+ @brief      Definition for set of priorities which can be used by client for background processing.
+ @discussion On systems which doesn't support quality of service classes, corresponding global queue 
+             priority will be used.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSInteger, PNQualityOfService) {
+
+    /**
+     @brief  Work which is interacting with the user (maps to \c QOS_CLASS_USER_INTERACTIVE).
+
+     @since 4.5.0
+     */
+    PNUserInteractiveQualityOfService,
+
+    /**
+     @brief  Work which user is waiting for (maps to \c QOS_CLASS_USER_INITIATED).
+
+     @since 4.5.0
+     */
+    PNUserInitiatedQualityOfService,
+
+    /**
+     @brief  Default priority (maps to \c QOS_CLASS_DEFAULT).
+
+     @since 4.5.0
+     */
+    PNDefaultQualityOfService,
+
+    /**
+     @brief  Long-running work which user doesn't wait for immediately (maps to \c QOS_CLASS_UTILITY).
+
+     @since 4.5.0
+     */
+    PNUtilityQualityOfService,
+
+    /**
+     @brief  Work which user isn't aware of (maps to \c QOS_CLASS_BACKGROUND).
+
+     @since 4.5.0
+     */
+    PNBackgroundQualityOfService
+};
+
+/**
+ @brief      Definition for set of strategies which can be used by client to compress published messages.
+ @discussion Strategy affect only compression speed and ratio, compressed data always can be uncompressed 
+             in same way.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSInteger, PNCompressionStrategy) {
+
+    /**
+     @brief  Strategy which suit most of data (maps to \c Z_DEFAULT_STRATEGY).
+
+     @since 4.5.0
+     */
+    PNDefaultCompressionStrategy,
+
+    /**
+     @brief  Strategy for data with small values with random distribution (maps to \c Z_FILTERED).
+
+     @since 4.5.0
+     */
+    PNFilteredCompressionStrategy,
+
+    /**
+     @brief  Fastest strategy which doesn't search for repeated strings (maps to \c Z_HUFFMAN_ONLY).
+
+     @since 4.5.0
+     */
+    PNHuffmanOnlyCompressionStrategy,
+
+    /**
+     @brief  Strategy which look only for repeated bytes sequences (maps to \c Z_RLE).
+
+     @since 4.5.0
+     */
+    PNRLECompressionStrategy,
+
+    /**
+     @brief  Strategy which doesn't use dynamic Huffman codes (maps to \c Z_FIXED).
+
+     @since 4.5.0
+     */
+    PNFixedCompressionStrategy
+};
+
+/**
+ @brief      Definition for set of policies which can be used by client when received events doesn't fit 
+             into events delivery buffer.
+ @discussion Buffer fill up in case if listeners (or \c callbackQueue) can't process events as fast as they 
+             arrive.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSInteger, PNEventsDeliveryBufferPolicy) {
+
+    /**
+     @brief      Subscribe loop will wait till listeners process buffered events.
+     @discussion Events won't be lost (if service still will have them when subscribe loop will be 
+                 resumed).
+
+     @since 4.5.0
+     */
+    PNBlockSubscribeLoopBufferPolicy,
+
+    /**
+     @brief  Oldest buffered events will be dropped.
+
+     @since 4.5.0
+     */
+    PNDropOldestBufferPolicy,
+
+    /**
+     @brief      Only latest message and presence event for each channel will be kept in buffer.
+     @discussion If buffer still overflown (more channels than capacity) oldest events will be dropped.
+
+     @since 4.5.0
+     */
+    PNLatestPerChannelBufferPolicy,
+
+    /**
+     @brief      Only latest presence event for each channel and \c uuid will be kept in buffer (messages 
+                 kept as-is).
+     @discussion If buffer still overflown oldest events will be dropped.
+
+     @since 4.5.0
+     */
+    PNCoalescePresenceBufferPolicy
+};
+
 /**
  @brief  Base block structure used by client for all API endpoints to handle request processing
          completion.
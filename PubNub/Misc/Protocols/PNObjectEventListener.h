@@ -50,6 +50,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)client:(PubNub *)client didReceivePresenceEvent:(PNPresenceEventResult *)event;
 
+/**
+ @brief      Notify listener about batch of new messages which arrived from remote data object's live feeds 
+             on which client subscribed at this moment.
+ @discussion Messages received with single subscribe response delivered with one call (in order in which 
+             they has been received). If listener implement this method, \c -client:didReceiveMessage: 
+             won't be called for it.
+ 
+ @param client   Reference on \b PubNub client which triggered this callback method call.
+ @param messages List of \b PNResult instances which store message information in \c data property.
+ 
+ @since 4.5.0
+ */
+- (void)client:(PubNub *)client didReceiveMessages:(NSArray<PNMessageResult *> *)messages;
+
+/**
+ @brief      Notify listener about batch of new presence events which arrived from remote data object's 
+             presence live feeds on which client subscribed at this moment.
+ @discussion Presence events received with single subscribe response delivered with one call (in order in 
+             which they has been received). If listener implement this method, 
+             \c -client:didReceivePresenceEvent: won't be called for it.
+ 
+ @param client Reference on \b PubNub client which triggered this callback method call.
+ @param events List of \b PNResult instances which store presence event information in \c data property.
+ 
+ @since 4.5.0
+ */
+- (void)client:(PubNub *)client didReceivePresenceEvents:(NSArray<PNPresenceEventResult *> *)events;
+
 
 ///------------------------------------------------
 /// @name Status change handler.
@@ -0,0 +1,246 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Protocols
+
+/**
+ @brief      Interface description for object which represent single request processed by \b PNTransport.
+ @discussion Set of properties has been chosen to be compatible with \a NSURLSessionTask, so it can be used
+             by default transport as-is.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@protocol PNTransportTask <NSObject>
+
+
+@required
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on request which is processed by task.
+
+ @since 4.5.0
+ */
+@property (nullable, readonly, copy) NSURLRequest *currentRequest;
+
+/**
+ @brief  Stores reference on service response (available only after response has been received).
+
+ @since 4.5.0
+ */
+@property (nullable, readonly, copy) NSURLResponse *response;
+
+/**
+ @brief  Stores reference on request processing error (if any).
+
+ @since 4.5.0
+ */
+@property (nullable, readonly, copy) NSError *error;
+
+
+///------------------------------------------------
+/// @name Processing
+///------------------------------------------------
+
+/**
+ @brief  Start request processing.
+
+ @since 4.5.0
+ */
+- (void)resume;
+
+/**
+ @brief      Cancel request processing.
+ @discussion Completion block will be called with \a NSURLErrorCancelled error.
+
+ @since 4.5.0
+ */
+- (void)cancel;
+
+@end
+
+
+#pragma mark - Types
+
+/**
+ @brief  Definition for block which is used by transport to report task processing completion.
+
+ @param data     Actual raw data which has been received from \b PubNub service in response.
+ @param response HTTP response instance which hold metadata about response.
+ @param error    Reference on error instance in case of any processing issues.
+
+ @since 4.5.0
+ */
+typedef void(^PNTransportTaskCompletionBlock)(NSData * _Nullable data, NSURLResponse * _Nullable response,
+                                              NSError * _Nullable error);
+
+/**
+ @brief      Definition for block which is used by transport to report task processing metrics.
+ @discussion Metrics dictionary may contain: \c start and \c end (\a NSDate instances which represent moment
+             when task has been started and completed), \c bytesSent and \c bytesReceived (\a NSNumber with
+             amount of bytes which has been written and read) and \c reusedConnection (\a NSNumber with
+             \a BOOL which specify whether existing connection has been used for request).
+ @discussion Transports which is able to collect connection metrics may also pass: \c firstByte (\a NSDate
+             when first byte of response has been received), \c domainLookupDuration, \c connectDuration and
+             \c secureConnectionDuration (\a NSNumber with duration of corresponding connection stage in
+             seconds).
+
+ @param task    Reference on task for which metrics has been collected.
+ @param metrics Dictionary with collected metrics.
+
+ @since 4.5.0
+ */
+typedef void(^PNTransportMetricsBlock)(id <PNTransportTask> task, NSDictionary<NSString *, id> *metrics);
+
+/**
+ @brief      Definition for block which is used by transport to pass response body chunks as soon as they has
+             been received.
+ @discussion Block called for each chunk in order in which they has been received. Task's \c response
+             property already contain service response at this moment.
+
+ @param task Reference on task for which response body chunk has been received.
+ @param data Reference on received response body chunk.
+
+ @return \c YES in case if chunk has been consumed by block and transport shouldn't accumulate it to pass
+         along with completion block.
+
+ @since 4.5.0
+ */
+typedef BOOL(^PNTransportTaskDataBlock)(id <PNTransportTask> task, NSData *data);
+
+
+/**
+ @brief      Interface description for classes which can be used by \b PubNub client to communicate with
+             \b PubNub network.
+ @discussion Client create separate transport instances for long-poll (subscribe) and non-subscribe
+             requests. Class which should be used can be specified with \b PNConfiguration.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@protocol PNTransport <NSObject>
+
+
+@required
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct transport with predefined options.
+
+ @param identifier         Unique identifier which can be used by transport to name it's resources.
+ @param timeout            Maximum time which transport should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+ @param longPollEnabled    Whether transport will be used for long-poll requests or not.
+
+ @return Constructed and ready to use transport.
+
+ @since 4.5.0
+ */
++ (instancetype)transportWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                     maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled;
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on additional headers which transport will send along with each request.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, readonly, copy) NSDictionary<NSString *, NSString *> *HTTPAdditionalHeaders;
+
+/**
+ @brief  Stores cache policy which should be used with requests sent by transport.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) NSURLRequestCachePolicy requestCachePolicy;
+
+
+///------------------------------------------------
+/// @name Request processing
+///------------------------------------------------
+
+/**
+ @brief      Construct task which will send \c request to \b PubNub network.
+ @discussion Task won't start processing till \c -resume will be called.
+
+ @param request Reference on complete request which should be sent.
+ @param block   Reference on block which should be called at the end of request processing.
+
+ @return Constructed and ready to use task.
+
+ @since 4.5.0
+ */
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             completion:(PNTransportTaskCompletionBlock)block;
+
+/**
+ @brief  Cancel all active and scheduled tasks.
+
+ @since 4.5.0
+ */
+- (void)cancelAllTasks;
+
+/**
+ @brief      Invalidate transport.
+ @discussion All active tasks will be cancelled and transport won't be usable anymore.
+
+ @since 4.5.0
+ */
+- (void)invalidate;
+
+
+@optional
+
+///------------------------------------------------
+/// @name Streamed request processing
+///------------------------------------------------
+
+/**
+ @brief      Construct task which will send \c request to \b PubNub network and pass response body by chunks
+             as they arrive.
+ @discussion Task won't start processing till \c -resume will be called. Completion block will receive only
+             those chunks which hasn't been consumed by \c dataBlock.
+
+ @param request   Reference on complete request which should be sent.
+ @param dataBlock Reference on block which should be called for each received response body chunk.
+ @param block     Reference on block which should be called at the end of request processing.
+
+ @return Constructed and ready to use task.
+
+ @since 4.5.0
+ */
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request dataChunk:(PNTransportTaskDataBlock)dataBlock
+                             completion:(PNTransportTaskCompletionBlock)block;
+
+///------------------------------------------------
+/// @name Metrics
+///------------------------------------------------
+
+/**
+ @brief  Set block which should be called by transport each time when task processing metrics will be
+         collected.
+
+ @param block Reference on block which should be called with metrics or \c nil to stop metrics reporting.
+
+ @since 4.5.0
+ */
+- (void)setMetricsBlock:(nullable PNTransportMetricsBlock)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -1,5 +1,6 @@
 #import <Foundation/Foundation.h>
 #import "PNStructures.h"
+#import "PNTransport.h"
 
 
 #pragma mark Class forward
@@ -7,6 +8,19 @@
 @class PNRequestParameters, PubNub;
 
 
+#pragma mark - Types
+
+/**
+ @brief  Definition for block which is used to preview raw service response before it will be serialized 
+         and parsed.
+ 
+ @param data Raw data which has been received from \b PubNub service with \c 200 status code.
+ 
+ @since 4.5.0
+ */
+typedef void(^PNNetworkResponseDataBlock)(NSData *data);
+
+
 /**
  @brief      Class which translate \b PubNub operations to request for \b PubNub network.
  @discussion Intermediate layer between \b PubNub client operations and networking which is used to send 
@@ -39,6 +53,56 @@
 + (instancetype)networkForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
               maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled;
 
+/**
+ @brief  Construct \b PubNub network manager which will use specified transport to communicate with 
+         \b PubNub network.
+ 
+ @param client             Reference on client for which this network manager is creating.
+ @param timeout            Maximum time which manager should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+ @param longPollEnabled    Whether \b PubNub network manager should be configured for long-poll requests or 
+                           not. This option affect the way how network manager handle reset.
+ @param transportClass     Reference on class which conforms to \b PNTransport protocol and should be used to
+                           send requests.
+ 
+ @return Constructed and ready to use \b PubNub network manager.
+ 
+ @since 4.5.0
+ */
++ (instancetype)networkForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
+              maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled
+                       transport:(Class <PNTransport>)transportClass;
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief      Retrieve number of requests which wait for free connection in specified lane.
+ @discussion Requests scheduled using lanes only by network manager which is not configured for long-poll 
+             requests.
+ 
+ @param lane One of \b PNRequestLane enum fields which specify for which lane queue depth should be returned.
+ 
+ @return Number of requests which wait in \c lane queue.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)pendingRequestsCountInLane:(PNRequestLane)lane;
+
+/**
+ @brief  Retrieve number of requests which is processed at this moment in specified lane.
+ 
+ @param lane One of \b PNRequestLane enum fields which specify for which lane active requests count should be 
+             returned.
+ 
+ @return Number of requests which occupy \c lane connections.
+ 
+ @since 4.5.0
+ */
+- (NSUInteger)activeRequestsCountInLane:(PNRequestLane)lane;
+
 
 ///------------------------------------------------
 /// @name Request processing
@@ -61,6 +125,28 @@
           withParameters:(PNRequestParameters *)parameters data:(NSData *)data
          completionBlock:(id)block;
 
+/**
+ @brief      Process passed operation using set of parameters.
+ @discussion Translate client operation to actual request to \b PubNub network. \c dataBlock will be called 
+             on transport's callback queue as soon as response body has been received (before serialization 
+             and parsing will start). This allow caller to act on service response as early as possible.
+ @discussion Subscribe response body can be parsed while it arrive (if transport able to deliver it by 
+             chunks). In this case \c dataBlock will receive only response envelope fields (w/o events list).
+ 
+ @param operationType One of \b PNOperationType enumerator fields which describe what kind of operation should
+                      be executed by client.
+ @param parameters    Request parameters representation object.
+ @param data          Reference on binary data which should be pushed to \b PubNub network along with request.
+ @param dataBlock     Reference on block which should be called with raw response data.
+ @param block         Depending on operation type it can be \b PNResultBlock, \b PNStatusBlock or
+                      \b PNCompletionBlock blocks.`
+ 
+ @since 4.5.0
+ */
+- (void)processOperation:(PNOperationType)operationType
+          withParameters:(PNRequestParameters *)parameters data:(NSData *)data
+       responseDataBlock:(PNNetworkResponseDataBlock)dataBlock completionBlock:(id)block;
+
 /**
  @brief  Fetch list of active requests and cancel their processing.
  
@@ -4,7 +4,6 @@
  @copyright © 2009-2016 PubNub, Inc.
  */
 #import "PNNetwork.h"
-#import "NSURLSessionConfiguration+PNConfigurationPrivate.h"
 #import "PNNetworkResponseSerializer.h"
 #import "PNConfiguration+Private.h"
 #import "PNRequestParameters.h"
@@ -12,13 +11,17 @@
 #import "PubNub+CorePrivate.h"
 #import "PNResult+Private.h"
 #import "PNStatus+Private.h"
-#import <libkern/OSAtomic.h>
+#import "PNSubscribeStreamParser.h"
+#import "PNRequestMetrics+Private.h"
+#import "PNParsingExecutor.h"
+#import "PNURLSessionTransport.h"
 #import "PNErrorStatus.h"
 #import "PNErrorParser.h"
 #import "PNURLBuilder.h"
 #import "PNConstants.h"
 #import "PNLogMacro.h"
 #import "PNHelpers.h"
+#import <libkern/OSAtomic.h>
 
 
 #pragma mark CocoaLumberjack logging support
@@ -31,20 +34,64 @@
 static DDLogLevel ddLogLevel;
 
 
-#pragma mark - Types
+#pragma mark - Static
 
 /**
- @brief  Definition for block which is used as NSURLSessionDataTask completion handler (passed during task 
-         creation.
+ @brief  Number of lanes which is used to schedule non-subscribe requests.
  
- @param data     Actual raw data which has been received from \b PubNub service in response.
- @param response HTTP response instance which hold metadata about response.
- @param error    Reference on error instance in case of any processing issues.
+ @since 4.5.0
+ */
+static NSUInteger const kPNRequestLanesCount = 3;
+
+/**
+ @brief      Stores reference on parser classes resolved from \c PNOperationDescriptions.
+ @discussion Classes can't be unloaded, so it is safe to store them as unretained references.
  
- @since 4.0.2
+ @since 4.5.0
+ */
+static __unsafe_unretained Class PNOperationParsers[PNOperationsCount];
+
+/**
+ @brief  Stores reference on result classes resolved from \c PNOperationDescriptions.
+ 
+ @since 4.5.0
+ */
+static __unsafe_unretained Class PNOperationResults[PNOperationsCount];
+
+/**
+ @brief  Stores reference on status classes resolved from \c PNOperationDescriptions.
+ 
+ @since 4.5.0
+ */
+static __unsafe_unretained Class PNOperationStatuses[PNOperationsCount];
+
+
+#pragma mark - Private functions
+
+/**
+ @brief  Resolve classes from operations registry (only once).
+ 
+ @since 4.5.0
  */
-typedef void(^NSURLSessionDataTaskCompletion)(NSData * _Nullable data, NSURLResponse * _Nullable response, 
-                                              NSError * _Nullable error);
+static void PNResolveOperationClasses(void) {
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        for (NSUInteger operation = PNSubscribeOperation; operation < PNOperationsCount; operation++) {
+            
+            PNOperationDescription description = PNOperationDescriptions[operation];
+            PNOperationParsers[operation] = NSClassFromString(description.parserClass);
+            PNOperationResults[operation] = (description.resultClass ? NSClassFromString(description.resultClass) 
+                                                                     : [PNResult class]);
+            PNOperationStatuses[operation] = (description.statusClass ? NSClassFromString(description.statusClass)
+                                                                      : [PNStatus class]);
+        }
+    });
+}
+
+
+#pragma mark - Types
 
 /**
  @brief  Definition for block which is used by \b PubNub SDK to process successfully completed request with
@@ -53,9 +100,9 @@ typedef void(^NSURLSessionDataTaskCompletion)(NSData * _Nullable data, NSURLResp
  @param task           Reference on data load task which has been used to communicate with \b PubNub network.
  @param responseObject Serialized \b PubNub service response.
  
- @since 4.0.2
+ @since 4.5.0
  */
-typedef void(^NSURLSessionDataTaskSuccess)(NSURLSessionDataTask * _Nullable task, id _Nullable responseObject);
+typedef void(^PNNetworkTaskSuccess)(id <PNTransportTask> _Nullable task, id _Nullable responseObject);
 
 /**
  @brief  Definition for block which is used by \b PubNub SDK to process failed request.
@@ -63,16 +110,16 @@ typedef void(^NSURLSessionDataTaskSuccess)(NSURLSessionDataTask * _Nullable task
  @param task  Reference on data load task which has been used to communicate with \b PubNub network.
  @param error Reference on error instance in case of any processing issues.
  
- @since 4.0.2
+ @since 4.5.0
  */
-typedef void(^NSURLSessionDataTaskFailure)(NSURLSessionDataTask * _Nullable task, NSError * _Nullable error);
+typedef void(^PNNetworkTaskFailure)(id <PNTransportTask> _Nullable task, NSError * _Nullable error);
 
 
 NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - Protected interface declaration
 
-@interface PNNetwork () <NSURLSessionDelegate>
+@interface PNNetwork ()
 
 
 #pragma mark - Information
@@ -99,37 +146,71 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy) NSString *identifier;
 
 /**
- @brief      Stores whether \b PubNub network manager configured for long-poll request processing or not.
- @discussion This property taken into account when manager need to invalidate underlying \a NSURLSession and 
-             dictate whether all scheduled requests should be completed or terminated.
+ @brief      Stores reference on transport which is used to send network requests.
+ @discussion Transport is created with options passed during network manager initialization and own all
+             connections to \b PubNub network.
  
- @since 4.0
+ @since 4.5.0
  */
-@property (nonatomic, assign) BOOL forLongPollRequests;
+@property (nonatomic, strong) id <PNTransport> transport;
 
 /**
- @brief      Stores value which should be as timeout interval for request.
- @discussion This property also used when session instance should be re-created.
+ @brief      Stores whether requests should be scheduled using lanes or not.
+ @discussion Lanes used only by network manager which is not configured for long-poll requests.
  
- @since 4.0.2
+ @since 4.5.0
  */
-@property (nonatomic, assign) NSTimeInterval requestTimeout;
+@property (nonatomic, assign) BOOL lanesEnabled;
 
 /**
- @brief      Stores value which should be as maximum simultaneous requests.
- @discussion This property also used when session instance should be re-created.
+ @brief  Stores reference on list of tasks which wait for free connection (one list per \b PNRequestLane).
  
- @since 4.0.2
+ @since 4.5.0
  */
-@property (nonatomic, assign) NSInteger maximumConnections;
+@property (nonatomic, strong) NSArray<NSMutableArray<id <PNTransportTask>> *> *pendingTasks;
 
+/**
+ @brief      Stores reference on set of tasks which has been resumed with one of lane connections.
+ @discussion Only completion of task from this set release lane connection. Pending task which has been
+             cancelled before it received connection simply removed from \c pendingTasks.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSHashTable<id <PNTransportTask>> *resumedTasks;
 
 /**
- @brief  Stores reference on session instance which is used to send network requests.
+ @brief  Stores reference on spin-lock which is used to protect lanes state.
  
- @since 4.0.2
+ @since 4.5.0
+ */
+@property (nonatomic, assign) OSSpinLock lanesLock;
+
+/**
+ @brief      Stores reference on metrics of tasks which is processed at this moment.
+ @discussion Metrics object created when request is built and passed to \b PNResult and \b PNStatus at the 
+             end of processing.
+ 
+ @since 4.5.0
  */
-@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSMapTable<id <PNTransportTask>, PNRequestMetrics *> *tasksMetrics;
+
+/**
+ @brief  Stores reference on spin-lock which is used to protect tasks metrics map.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) OSSpinLock tasksMetricsLock;
+
+/**
+ @brief      Stores time (in microseconds since reference date) when response on previous subscribe request 
+             has been received.
+ @discussion Used to measure gap between subscribe requests for client-wide metrics (each subscribe loop
+             use own network manager). Value accessed only with atomic operations, because requests 
+             completed on concurrent processing queue.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) int64_t lastSubscribeResponseTime;
 
 /**
  @brief  Stores reference on base URL which should be appeanded with reasource path to perform network
@@ -146,14 +227,6 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) PNNetworkResponseSerializer *serializer;
 
-/**
- @brief  Stores reference on queue which should be used by session to call callbacks and completion blocks on
-         \c PNNetwork instance.
- 
- @since 4.0.2
- */
-@property (nonatomic, strong) NSOperationQueue *delegateQueue;
-
 /**
  @brief      Stores reference on queue which is used to call \b PNNetwork response processing on another 
              queue.
@@ -165,13 +238,13 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) dispatch_queue_t processingQueue;
 
 /**
- @brief  Stores reference on spin-lock which is used to protect access to session instance which can be 
-         changed at any moment (invalidated instances can't be used and SDK should instantiate new instance).
+ @brief      Stores reference on executor which is used to parse responses which require additional data.
+ @discussion Executor owned by client and shared between all it's networks. Network keep strong reference on 
+             it, so responses which arrive while client deallocates still can be processed.
  
- @since 4.0.2
+ @since 4.5.0
  */
-@property (nonatomic, assign) OSSpinLock lock;
-
+@property (nonatomic, strong) PNParsingExecutor *parsingExecutor;
 
 #pragma mark - Initialization and Configuration
 
@@ -183,13 +256,16 @@ NS_ASSUME_NONNULL_BEGIN
  @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
  @param longPollEnabled    Whether \b PubNub network manager should be configured for long-poll requests or 
                            not. This option affect the way how network manager handle reset.
+ @param transportClass     Reference on class which conforms to \b PNTransport protocol and should be used to
+                           send requests.
  
- @return 4.0
+ @return Initialized and ready to use \b PubNub network manager.
  
- @since Initialized and ready to use \b PubNub network manager.
+ @since 4.0
  */
 - (instancetype)initForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
-           maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled;
+           maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled
+                    transport:(Class <PNTransport>)transportClass;
 
 
 #pragma mark - Request helper
@@ -217,20 +293,109 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSURLRequest *)requestWithURL:(NSURL *)requestURL data:(NSData *)postData;
 
 /**
- @brief  Construct data task which should be used to process provided request.
+ @brief  Construct transport task which should be used to process provided request.
  
- @param request Reference on request which should be issued with data task to NSURL session.
- @param success Reference on data task success handling block which will be called by network manager.
- @param failure Reference on data task processing failure handling block which will be called by network 
-                manager.
+ @param request   Reference on request which should be issued with task to transport.
+ @param dataBlock Reference on block which should be called with raw response data before it will be
+                  serialized.
+ @param success   Reference on data task success handling block which will be called by network manager.
+ @param failure   Reference on data task processing failure handling block which will be called by network 
+                  manager.
  
- @return Constructed and ready to use data task.
+ @return Constructed and ready to use transport task.
  
  @since 4.0
  */
-- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
-                                      success:(NSURLSessionDataTaskSuccess)success
-                                      failure:(NSURLSessionDataTaskFailure)failure;
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                           responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+                                success:(PNNetworkTaskSuccess)success
+                                failure:(PNNetworkTaskFailure)failure;
+
+/**
+ @brief      Construct transport task which should be used to process provided request.
+ @discussion If \c streamParser passed and transport able to deliver response body by chunks, successful 
+             response will be processed by parser while it arrive and \c success block will receive parser's 
+             processed response instead of de-serialized JSON.
+ 
+ @param request      Reference on request which should be issued with task to transport.
+ @param dataBlock    Reference on block which should be called with raw response data before it will be
+                     serialized.
+ @param streamParser Reference on parser which should process response body chunks.
+ @param success      Reference on data task success handling block which will be called by network manager.
+ @param failure      Reference on data task processing failure handling block which will be called by network
+                     manager.
+ 
+ @return Constructed and ready to use transport task.
+ 
+ @since 4.5.0
+ */
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                           responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+                           streamParser:(nullable PNSubscribeStreamParser *)streamParser
+                                success:(PNNetworkTaskSuccess)success
+                                failure:(PNNetworkTaskFailure)failure;
+
+
+#pragma mark - Lanes
+
+/**
+ @brief  Retrieve reference on lane which should be used to schedule request for \c operation.
+ 
+ @param operation Type of operation for which request should be scheduled.
+ 
+ @return One of \b PNRequestLane enum fields.
+ 
+ @since 4.5.0
+ */
+- (PNRequestLane)laneForOperation:(PNOperationType)operation;
+
+/**
+ @brief      Start task processing or put it into lane queue if there is no free connections.
+ @discussion If lanes is disabled, task will be resumed right away.
+ 
+ @param task Reference on task which should be scheduled.
+ @param lane One of \b PNRequestLane enum fields which specify to which lane task belong.
+ 
+ @since 4.5.0
+ */
+- (void)scheduleTask:(id <PNTransportTask>)task inLane:(PNRequestLane)lane;
+
+/**
+ @brief      Release lane connection which has been used by completed task and start next pending task (if 
+             any).
+ @discussion If task completed (cancelled) while it still has been waiting for connection, it will be removed
+             from pending tasks list w/o affecting lane connections.
+ 
+ @param task Reference on task which completed processing.
+ @param lane One of \b PNRequestLane enum fields which specify to which lane completed task belong.
+ 
+ @since 4.5.0
+ */
+- (void)completeTask:(id <PNTransportTask>)task inLane:(PNRequestLane)lane;
+
+/**
+ @brief  Start task processing and mark moment when it has been passed to transport.
+ 
+ @param task Reference on task which should be started.
+ 
+ @since 4.5.0
+ */
+- (void)resumeTask:(id <PNTransportTask>)task;
+
+
+#pragma mark - Metrics
+
+/**
+ @brief  Retrieve metrics which has been created for task.
+ 
+ @param task         Reference on task for which metrics should be found.
+ @param shouldRemove Whether metrics should be forgotten by network or not (when task processing completed).
+ 
+ @return Metrics object or \c nil in case if task unknown to network.
+ 
+ @since 4.5.0
+ */
+- (nullable PNRequestMetrics *)metricsForTask:(nullable id <PNTransportTask>)task remove:(BOOL)shouldRemove;
 
 
 #pragma mark - Request processing
@@ -292,54 +457,7 @@ NS_ASSUME_NONNULL_BEGIN
        completion:(void(^)(NSDictionary * _Nullable parsedData, BOOL parseError))block;
 
 
-#pragma mark - Session constructor
-
-/**
- @brief  Complete AFNetworking/NSURLSession instantiation and configuration.
- 
- @param timeout            Maximum time which manager should wait for response on request.
- @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
- 
- @since 4.0
- */
-- (void)prepareSessionWithRequesrTimeout:(NSTimeInterval)timeout
-                      maximumConnections:(NSInteger)maximumConnections;
-
-/**
- @brief  Construct base NSURL session configuration.
- 
- @param timeout            Maximum time which manager should wait for response on request.
- @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
- 
- @return Constructed and ready to use session configuration.
- 
- @since 4.0
- */
-- (NSURLSessionConfiguration *)configurationWithRequestTimeout:(NSTimeInterval)timeout
-                                            maximumConnections:(NSInteger)maximumConnections;
-
-/**
- @brief  Construct qaueue on which session will call delegate callbacks and completion blocks.
- 
- @param configuration Reference on session configuration instance which should be used to complete queue 
-                      configuration.
- 
- @return Initialized and ready to use operaiton queue.
- 
- @since 4.0.2
- */
-- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration;
-
-/**
- @brief  Construct NSURL session manager used to communicate with \b PubNub network.
- 
- @param configuration Reference on complete configuration which should be applied to NSURL session.
- 
- @return Constructed and ready to use NSURL session manager instance.
- 
- @since 4.0
- */
-- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration;
+#pragma mark - Misc
 
 /**
  @brief  Allow to construct base URL basing on network configuraiton.
@@ -358,18 +476,25 @@ NS_ASSUME_NONNULL_BEGIN
  @discussion Depending on received metadata and data code will call passed success or failure blocks after 
              serialization process completion on secondary queue.
  
- @param data    Reference on RAW data received from service.
- @param task    Reference on data task which has been used to communicate with \b PubNub network.
- @param error   Reference on data/request processing error.
- @param success Reference on data task success handling block which will be called by network manager.
- @param failure Reference on data task processing failure handling block which will be called by network 
-                manager.
+ @discussion If response body has been processed by \c streamParser, \c dataBlock will receive only
+             envelope fields and \c success block will be called with parser's processed response.
+ 
+ @param data         Reference on RAW data received from service.
+ @param task         Reference on data task which has been used to communicate with \b PubNub network.
+ @param error        Reference on data/request processing error.
+ @param dataBlock    Reference on block which should be called with RAW data (if request successfully 
+                     completed) before serialization will be started.
+ @param streamParser Reference on parser which processed response body chunks (if any).
+ @param success      Reference on data task success handling block which will be called by network manager.
+ @param failure      Reference on data task processing failure handling block which will be called by network
+                     manager.
  
  @since 4.0
  */
-- (void)handleData:(nullable NSData *)data loadedWithTask:(nullable NSURLSessionDataTask *)task
-             error:(nullable NSError *)requestError usingSuccess:(NSURLSessionDataTaskSuccess)success
-           failure:(NSURLSessionDataTaskFailure)failure;
+- (void)handleData:(nullable NSData *)data loadedWithTask:(nullable id <PNTransportTask>)task
+             error:(nullable NSError *)requestError responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+      streamParser:(nullable PNSubscribeStreamParser *)streamParser
+      usingSuccess:(PNNetworkTaskSuccess)success failure:(PNNetworkTaskFailure)failure;
 
 /**
  @brief      Handle successful operation processing completion.
@@ -384,9 +509,27 @@ NS_ASSUME_NONNULL_BEGIN
  
  @since 4.0
  */
-- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable NSURLSessionDataTask *)task
+- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable id <PNTransportTask>)task
                withData:(nullable id)responseObject completionBlock:(id)block;
 
+/**
+ @brief      Handle successful operation processing completion for response which has been parsed while 
+             it has been received.
+ @discussion If \c parsedData is \c nil (malformed response) operation will be completed same way as it 
+             would be done for response which can't be parsed.
+ 
+ @param operation  Reference on operation type for which actual network request has been sent to \b PubNub
+                   network.
+ @param task       Reference on data task which has been used to deliver operation to \b PubNub network.
+ @param parsedData Reference on data which has been processed by stream parser.
+ @param block      Depending on operation type it can be \b PNResultBlock, \b PNStatusBlock or
+                   \b PNCompletionBlock blocks.`
+ 
+ @since 4.5.0
+ */
+- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable id <PNTransportTask>)task
+         withParsedData:(nullable NSDictionary *)parsedData completionBlock:(id)block;
+
 /**
  @brief      Handle operation failure.
  @discussion Called when request for \b PubNub network did fail to process or service respond with error.
@@ -401,7 +544,7 @@ NS_ASSUME_NONNULL_BEGIN
  
  @since 4.0
  */
-- (void)handleOperation:(PNOperationType)operation taskDidFail:(nullable NSURLSessionDataTask *)task
+- (void)handleOperation:(PNOperationType)operation taskDidFail:(nullable id <PNTransportTask>)task
               withError:(nullable NSError *)error completionBlock:(id)block;
 
 /**
@@ -418,7 +561,7 @@ NS_ASSUME_NONNULL_BEGIN
  
  @since 4.0
  */
-- (void)handleParsedData:(nullable NSDictionary *)data loadedWithTask:(nullable NSURLSessionDataTask *)task
+- (void)handleParsedData:(nullable NSDictionary *)data loadedWithTask:(nullable id <PNTransportTask>)task
             forOperation:(PNOperationType)operation parsedAsError:(BOOL)isError
          processingError:(nullable NSError *)error completionBlock:(id)block;
 
@@ -436,16 +579,6 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)handleOperation:(PNOperationType)operation processingCompletedWithResult:(nullable PNResult *)result
                  status:(nullable PNStatus *)status completionBlock:(id)block;
 
-
-#pragma mark - Misc
-
-/**
- @brief  Print out any session configuration instance customizations which has been done by developer.
- 
- @since 4.4.0
- */
-- (void)printIfRequiredSessionCustomizationInformation;
-
 #pragma mark -
 
 
@@ -456,7 +589,22 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark - Interface implementation
 
-@implementation PNNetwork
+@implementation PNNetwork {
+    
+    /**
+     @brief  Stores number of requests which is processed at this moment in each lane.
+     
+     @since 4.5.0
+     */
+    NSUInteger _activeRequests[kPNRequestLanesCount];
+    
+    /**
+     @brief  Stores maximum number of simultaneous requests for each lane.
+     
+     @since 4.5.0
+     */
+    NSUInteger _lanesBudget[kPNRequestLanesCount];
+}
 
 
 #pragma mark - Logger
@@ -477,31 +625,89 @@ NS_ASSUME_NONNULL_END
 + (instancetype)networkForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
               maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled {
     
+    return [self networkForClient:client requestTimeout:timeout maximumConnections:maximumConnections
+                         longPoll:longPollEnabled transport:[PNURLSessionTransport class]];
+}
+
++ (instancetype)networkForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
+              maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled
+                       transport:(Class <PNTransport>)transportClass {
+    
     return [[self alloc] initForClient:client requestTimeout:timeout maximumConnections:maximumConnections 
-                              longPoll:longPollEnabled];
+                              longPoll:longPollEnabled transport:transportClass];
 }
 
 - (instancetype)initForClient:(PubNub *)client requestTimeout:(NSTimeInterval)timeout
-           maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled {
+           maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled
+                    transport:(Class <PNTransport>)transportClass {
     
     // Check whether initialization was successful or not.
     if ((self = [super init])) {
         
+        PNResolveOperationClasses();
         _client = client;
         _configuration = client.configuration;
-        _forLongPollRequests = longPollEnabled;
         _identifier = [[NSString stringWithFormat:@"com.pubnub.network.%p", self] copy];
-        _processingQueue = dispatch_queue_create([_identifier UTF8String], DISPATCH_QUEUE_CONCURRENT);;
+        _processingQueue = dispatch_queue_create([_identifier UTF8String], DISPATCH_QUEUE_CONCURRENT);
+        _parsingExecutor = client.parsingExecutor;
         _serializer = [PNNetworkResponseSerializer new];
         _baseURL = [self requestBaseURL];
-        _lock = OS_SPINLOCK_INIT;
-        [self prepareSessionWithRequesrTimeout:timeout maximumConnections:maximumConnections];
+        _lanesEnabled = !longPollEnabled;
+        _lanesLock = OS_SPINLOCK_INIT;
+        _tasksMetrics = [NSMapTable weakToStrongObjectsMapTable];
+        _tasksMetricsLock = OS_SPINLOCK_INIT;
+        _pendingTasks = @[[NSMutableArray new], [NSMutableArray new], [NSMutableArray new]];
+        _resumedTasks = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        _lanesBudget[PNPublishRequestLane] = (NSUInteger)MAX(_configuration.publishRequestsMaximumConnections, 1);
+        _lanesBudget[PNControlRequestLane] = (NSUInteger)MAX(_configuration.controlRequestsMaximumConnections, 1);
+        _lanesBudget[PNBulkReadRequestLane] = (NSUInteger)MAX(_configuration.bulkReadRequestsMaximumConnections, 1);
+        _transport = [(transportClass?: [PNURLSessionTransport class])
+                      transportWithIdentifier:_identifier requestTimeout:timeout
+                           maximumConnections:maximumConnections longPoll:longPollEnabled];
+        if ([_transport respondsToSelector:@selector(setMetricsBlock:)]) {
+            
+            __weak __typeof(self) weakSelf = self;
+            [_transport setMetricsBlock:^(id <PNTransportTask> task, NSDictionary<NSString *, id> *metrics) {
+                
+                // Silence static analyzer warnings.
+                // Code is aware about this case and at the end will simply call on 'nil' object method.
+                // In most cases if referenced object become 'nil' it mean what there is no more need in
+                // it and probably whole client instance has been deallocated.
+                #pragma clang diagnostic push
+                #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+                [[weakSelf metricsForTask:task remove:NO] updateWithTransportMetrics:metrics];
+                PNMetricsAdd(weakSelf.client.metricsCounters, bytesReceived,
+                             ((NSNumber *)metrics[@"bytesReceived"]).longLongValue);
+                #pragma clang diagnostic pop
+            }];
+        }
     }
     
     return self;
 }
 
 
+#pragma mark - Information
+
+- (NSUInteger)pendingRequestsCountInLane:(PNRequestLane)lane {
+    
+    OSSpinLockLock(&_lanesLock);
+    NSUInteger count = self.pendingTasks[lane].count;
+    OSSpinLockUnlock(&_lanesLock);
+    
+    return count;
+}
+
+- (NSUInteger)activeRequestsCountInLane:(PNRequestLane)lane {
+    
+    OSSpinLockLock(&_lanesLock);
+    NSUInteger count = _activeRequests[lane];
+    OSSpinLockUnlock(&_lanesLock);
+    
+    return count;
+}
+
+
 #pragma mark - Request helper
 
 - (void)appendRequiredParametersTo:(PNRequestParameters *)parameters {
@@ -523,10 +729,8 @@ NS_ASSUME_NONNULL_END
     NSURL *fullURL = [NSURL URLWithString:requestURL.absoluteString relativeToURL:self.baseURL];
     NSMutableURLRequest *httpRequest = [NSMutableURLRequest requestWithURL:fullURL];
     httpRequest.HTTPMethod = ([postData length] ? @"POST" : @"GET");
-    OSSpinLockLock(&_lock);
-    httpRequest.cachePolicy = self.session.configuration.requestCachePolicy;
-    httpRequest.allHTTPHeaderFields = self.session.configuration.HTTPAdditionalHeaders;
-    OSSpinLockUnlock(&_lock);
+    httpRequest.cachePolicy = self.transport.requestCachePolicy;
+    httpRequest.allHTTPHeaderFields = self.transport.HTTPAdditionalHeaders;
     if (postData) {
         
         NSMutableDictionary *allHeaders = [httpRequest.allHTTPHeaderFields mutableCopy];
@@ -541,13 +745,24 @@ NS_ASSUME_NONNULL_END
     return [httpRequest copy];
 }
 
-- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
-                                      success:(NSURLSessionDataTaskSuccess)success
-                                      failure:(NSURLSessionDataTaskFailure)failure {
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                           responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+                                success:(PNNetworkTaskSuccess)success
+                                failure:(PNNetworkTaskFailure)failure {
     
-    __block NSURLSessionDataTask *task = nil;
+    return [self taskWithRequest:request responseData:dataBlock streamParser:nil success:success
+                         failure:failure];
+}
+
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                           responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+                           streamParser:(nullable PNSubscribeStreamParser *)streamParser
+                                success:(PNNetworkTaskSuccess)success
+                                failure:(PNNetworkTaskFailure)failure {
+    
+    __block id <PNTransportTask> task = nil;
     __weak __typeof(self) weakSelf = self;
-    NSURLSessionDataTaskCompletion handler = ^(NSData * _Nullable data, NSURLResponse * _Nullable response,
+    PNTransportTaskCompletionBlock handler = ^(NSData * _Nullable data, NSURLResponse * _Nullable response,
                                                NSError * _Nullable error) {
         
         // Silence static analyzer warnings.
@@ -556,80 +771,147 @@ NS_ASSUME_NONNULL_END
         // it and probably whole client instance has been deallocated.
         #pragma clang diagnostic push
         #pragma clang diagnostic ignored "-Wreceiver-is-weak"
-        [weakSelf handleData:data loadedWithTask:task error:(error?: task.error)
-                usingSuccess:success failure:failure];
+        [weakSelf handleData:data loadedWithTask:task error:(error?: task.error) responseData:dataBlock
+                streamParser:streamParser usingSuccess:success failure:failure];
         #pragma clang diagnostic pop
     };
-    OSSpinLockLock(&_lock);
-    task = [self.session dataTaskWithRequest:request completionHandler:[handler copy]];
-    OSSpinLockUnlock(&_lock);
+    if (streamParser && [self.transport respondsToSelector:@selector(taskWithRequest:dataChunk:completion:)]) {
+        
+        // Only successful response body passed to parser, error response will be accumulated by transport.
+        PNTransportTaskDataBlock chunkBlock = ^BOOL(id <PNTransportTask> streamedTask, NSData *chunk) {
+            
+            BOOL shouldConsume = (((NSHTTPURLResponse *)streamedTask.response).statusCode == 200);
+            if (shouldConsume) { [streamParser appendData:chunk]; }
+            
+            return shouldConsume;
+        };
+        task = [self.transport taskWithRequest:request dataChunk:[chunkBlock copy] completion:[handler copy]];
+    }
+    else { task = [self.transport taskWithRequest:request completion:[handler copy]]; }
     
     return task;
 }
 
 
-#pragma mark - Request processing
+#pragma mark - Lanes
 
-- (BOOL)operationExpectResult:(PNOperationType)operation {
+- (PNRequestLane)laneForOperation:(PNOperationType)operation {
     
-    static NSArray *_resultExpectingOperations;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
+    PNRequestLane lane = PNControlRequestLane;
+    if (operation == PNPublishOperation) { lane = PNPublishRequestLane; }
+    else if (operation == PNHistoryOperation || operation == PNWhereNowOperation ||
+             operation == PNHereNowGlobalOperation || operation == PNHereNowForChannelOperation ||
+             operation == PNHereNowForChannelGroupOperation) {
         
-        _resultExpectingOperations = @[
-                   @(PNHistoryOperation), @(PNWhereNowOperation), @(PNHereNowGlobalOperation),
-                   @(PNHereNowForChannelOperation), @(PNHereNowForChannelGroupOperation),
-                   @(PNStateForChannelOperation), @(PNStateForChannelGroupOperation),
-                   @(PNChannelGroupsOperation), @(PNChannelsForGroupOperation),
-                   @(PNPushNotificationEnabledChannelsOperation), @(PNTimeOperation)];
-    });
+        lane = PNBulkReadRequestLane;
+    }
     
-    return [_resultExpectingOperations containsObject:@(operation)];
+    return lane;
 }
 
-- (nullable Class <PNParser>)parserForOperation:(PNOperationType)operation {
+- (void)scheduleTask:(id <PNTransportTask>)task inLane:(PNRequestLane)lane {
     
-    static NSDictionary *_parsers;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
+    BOOL shouldResume = !self.lanesEnabled;
+    if (self.lanesEnabled) {
         
-        NSMutableDictionary *parsers = [NSMutableDictionary new];
-        for (Class class in [PNClass classesConformingToProtocol:@protocol(PNParser)]) {
+        OSSpinLockLock(&_lanesLock);
+        if (_activeRequests[lane] < _lanesBudget[lane]) {
             
-            NSArray<NSNumber *> *operations = [(Class<PNParser>)class operations];
-            for (NSNumber *operationType in operations) { parsers[operationType] = class; }
+            _activeRequests[lane]++;
+            [self.resumedTasks addObject:task];
+            shouldResume = YES;
         }
-        _parsers = [parsers copy];
-    });
+        else { [self.pendingTasks[lane] addObject:task]; }
+        OSSpinLockUnlock(&_lanesLock);
+    }
     
-    return _parsers[@(operation)];
+    if (shouldResume) { [self resumeTask:task]; }
 }
 
-- (Class)resultClassForOperation:(PNOperationType)operation {
+- (void)completeTask:(id <PNTransportTask>)task inLane:(PNRequestLane)lane {
     
-    Class class = [PNResult class];
-    if (PNOperationResultClasses[operation]) {
+    if (self.lanesEnabled) {
         
-        class = NSClassFromString(PNOperationResultClasses[operation]);
+        id <PNTransportTask> nextTask = nil;
+        OSSpinLockLock(&_lanesLock);
+        NSMutableArray<id <PNTransportTask>> *pendingTasks = self.pendingTasks[lane];
+        if ([self.resumedTasks containsObject:task]) {
+            
+            [self.resumedTasks removeObject:task];
+            
+            // Connection released by completed task passed to next pending task, so active requests count
+            // changes only if there is nothing to process.
+            if (pendingTasks.count) {
+                
+                nextTask = pendingTasks.firstObject;
+                [pendingTasks removeObjectAtIndex:0];
+                [self.resumedTasks addObject:nextTask];
+            }
+            else if (_activeRequests[lane] > 0) { _activeRequests[lane]--; }
+        }
+        else if (task) { [pendingTasks removeObjectIdenticalTo:task]; }
+        OSSpinLockUnlock(&_lanesLock);
+        if (nextTask) { [self resumeTask:nextTask]; }
     }
+}
+
+- (void)resumeTask:(id <PNTransportTask>)task {
     
-    return class;
+    [self metricsForTask:task remove:NO].startDate = [NSDate date];
+    [task resume];
 }
 
-- (Class)statusClassForOperation:(PNOperationType)operation {
+
+#pragma mark - Metrics
+
+- (PNRequestMetrics *)metricsForTask:(id <PNTransportTask>)task remove:(BOOL)shouldRemove {
     
-    Class class = [PNStatus class];
-    if (PNOperationStatusClasses[operation]) {
+    PNRequestMetrics *metrics = nil;
+    if (task) {
         
-        class = NSClassFromString(PNOperationStatusClasses[operation]);
+        OSSpinLockLock(&_tasksMetricsLock);
+        metrics = [self.tasksMetrics objectForKey:task];
+        if (metrics && shouldRemove) { [self.tasksMetrics removeObjectForKey:task]; }
+        OSSpinLockUnlock(&_tasksMetricsLock);
     }
     
-    return class;
+    return metrics;
+}
+
+
+#pragma mark - Request processing
+
+- (BOOL)operationExpectResult:(PNOperationType)operation {
+    
+    return PNOperationDescriptions[operation].expectResult;
+}
+
+- (nullable Class <PNParser>)parserForOperation:(PNOperationType)operation {
+    
+    return PNOperationParsers[operation];
+}
+
+- (Class)resultClassForOperation:(PNOperationType)operation {
+    
+    return (PNOperationResults[operation]?: [PNResult class]);
+}
+
+- (Class)statusClassForOperation:(PNOperationType)operation {
+    
+    return (PNOperationStatuses[operation]?: [PNStatus class]);
 }
 
 - (void)processOperation:(PNOperationType)operationType
           withParameters:(nullable PNRequestParameters *)parameters data:(nullable NSData *)data
          completionBlock:(nullable id)block {
+    
+    [self processOperation:operationType withParameters:parameters data:data responseDataBlock:nil
+           completionBlock:block];
+}
+
+- (void)processOperation:(PNOperationType)operationType
+          withParameters:(nullable PNRequestParameters *)parameters data:(nullable NSData *)data
+       responseDataBlock:(nullable PNNetworkResponseDataBlock)dataBlock completionBlock:(nullable id)block {
 
     if (operationType == PNSubscribeOperation || operationType == PNUnsubscribeOperation) {
         
@@ -643,26 +925,64 @@ NS_ASSUME_NONNULL_END
     // it and probably whole client instance has been deallocated.
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wreceiver-is-weak"
+    #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
     NSURL *requestURL = [PNURLBuilder URLForOperation:operationType withParameters:parameters];
+    id <PNTransportTask> task = nil;
     if (requestURL) {
         
         DDLogRequest([[self class] ddLogLevel], @"<PubNub::Network> %@ %@", (data.length ? @"POST" : @"GET"), 
                      requestURL.absoluteString);
         
         __weak __typeof(self) weakSelf = self;
-        [[self dataTaskWithRequest:[self requestWithURL:requestURL data:data]
-                           success:^(NSURLSessionDataTask *task, id responseObject) {
+        PNRequestLane lane = [self laneForOperation:operationType];
+        PNSubscribeStreamParser *streamParser = nil;
+        if (operationType == PNSubscribeOperation &&
+            [self.transport respondsToSelector:@selector(taskWithRequest:dataChunk:completion:)]) {
+            
+            NSDictionary *additionalData = nil;
+            if ([self.configuration.cipherKey length]) {
+                
+                additionalData = @{@"cipherKey": self.configuration.cipherKey};
+            }
+            streamParser = [PNSubscribeStreamParser parserWithAdditionalData:additionalData
+                                                                    executor:self.parsingExecutor];
+        }
+        NSURLRequest *request = [self requestWithURL:requestURL data:data];
+        PNRequestMetrics *metrics = [PNRequestMetrics metricsForOperation:operationType];
+        task = [self taskWithRequest:request responseData:dataBlock streamParser:streamParser
+                             success:^(id <PNTransportTask> completedTask, id responseObject) {
                                
-               [weakSelf handleOperation:operationType taskDidComplete:task withData:responseObject
-                         completionBlock:block];
+               [weakSelf completeTask:completedTask inLane:lane];
+               if (streamParser) {
+                   
+                   [weakSelf handleOperation:operationType taskDidComplete:completedTask
+                              withParsedData:responseObject completionBlock:block];
+               }
+               else {
+                   
+                   [weakSelf handleOperation:operationType taskDidComplete:completedTask
+                                    withData:responseObject completionBlock:block];
+               }
            }
-           failure:^(NSURLSessionDataTask *task, id error) {
+           failure:^(id <PNTransportTask> failedTask, id error) {
                
-               [weakSelf handleOperation:operationType taskDidFail:task withError:error
+               [weakSelf completeTask:failedTask inLane:lane];
+               [weakSelf handleOperation:operationType taskDidFail:failedTask withError:error
                          completionBlock:block];
-           }] resume];
+           }];
+        
+        // Transport may refuse to create task (for example after session invalidation).
+        if (task) {
+            
+            OSSpinLockLock(&_tasksMetricsLock);
+            [self.tasksMetrics setObject:metrics forKey:task];
+            OSSpinLockUnlock(&_tasksMetricsLock);
+            metrics.enqueueDate = [NSDate date];
+            [self scheduleTask:task inLane:lane];
+        }
     }
-    else {
+    
+    if (!task) {
         
         PNErrorStatus *badRequestStatus = [PNErrorStatus statusForOperation:operationType
                                                                    category:PNBadRequestCategory
@@ -716,37 +1036,38 @@ NS_ASSUME_NONNULL_END
         }
         
         // If additional data required client should assume what potentially additional calculations
-        // may be required and should temporarily shift to background queue.
-        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
-
-            NSDictionary *parsedData = [parser parsedServiceResponse:data withData:additionalData];
-            pn_dispatch_async(self.processingQueue, ^{
-                
-                parseCompletion(parsedData);
-            });
-        });
+        // may be required and should temporarily shift to parsing executor.
+        __block NSDictionary *parsedData = nil;
+        [self.parsingExecutor executeBlock:^{ parsedData = [parser parsedServiceResponse:data
+                                                                                withData:additionalData]; }
+                            withCompletion:^(PNParsingTimings timings) {
+                                
+                DDLogRequest([[self class] ddLogLevel], @"<PubNub::Network> %@ response waited %.2f ms and "
+                             "processed in %.2f ms.", NSStringFromClass(parser), (timings.queueTime * 1000.f),
+                             (timings.executionTime * 1000.f));
+                pn_dispatch_async(self.processingQueue, ^{ parseCompletion(parsedData); });
+            }];
     }
 }
 
 - (void)cancelAllRequests {
 
-    OSSpinLockLock(&_lock);
-    [self.session getTasksWithCompletionHandler:^(NSArray *dataTasks, NSArray *uploadTasks,
-                                                  NSArray *downloadTasks) {
-        
-        [dataTasks makeObjectsPerformSelector:@selector(cancel)];
-        [uploadTasks makeObjectsPerformSelector:@selector(cancel)];
-        [downloadTasks makeObjectsPerformSelector:@selector(cancel)];
-        OSSpinLockUnlock(&self->_lock);
-    }];
+    [self.transport cancelAllTasks];
 }
 
 - (void)invalidate {
     
-    OSSpinLockLock(&_lock);
-    [_session invalidateAndCancel];
-    _session = nil;
-    OSSpinLockUnlock(&self->_lock);
+    OSSpinLockLock(&_lanesLock);
+    NSMutableArray<id <PNTransportTask>> *pendingTasks = [NSMutableArray new];
+    for (NSMutableArray<id <PNTransportTask>> *laneTasks in self.pendingTasks) {
+        
+        [pendingTasks addObjectsFromArray:laneTasks];
+        [laneTasks removeAllObjects];
+    }
+    OSSpinLockUnlock(&_lanesLock);
+    
+    [self.transport invalidate];
+    [pendingTasks makeObjectsPerformSelector:@selector(cancel)];
 }
 
 
@@ -767,51 +1088,7 @@ NS_ASSUME_NONNULL_END
 }
 
 
-#pragma mark - Session constructor
-
-- (void)prepareSessionWithRequesrTimeout:(NSTimeInterval)timeout
-                      maximumConnections:(NSInteger)maximumConnections {
-    
-    _requestTimeout = timeout;
-    _maximumConnections = maximumConnections;
-    NSURLSessionConfiguration *config = [self configurationWithRequestTimeout:timeout
-                                                           maximumConnections:maximumConnections];
-    _delegateQueue = [self operationQueueWithConfiguration:config];
-    _session = [self sessionWithConfiguration:config];
-    [self printIfRequiredSessionCustomizationInformation];
-    
-}
-
-- (NSURLSessionConfiguration *)configurationWithRequestTimeout:(NSTimeInterval)timeout
-                                            maximumConnections:(NSInteger)maximumConnections {
-    
-    // Prepare base configuration with predefined timeout values and maximum connections
-    // to same host (basically how many requests can be handled at once).
-    NSURLSessionConfiguration *configuration = nil;
-    configuration = [NSURLSessionConfiguration pn_ephemeralSessionConfigurationWithIdentifier:self.identifier];
-    configuration.HTTPShouldUsePipelining = !self.forLongPollRequests;
-    configuration.timeoutIntervalForRequest = timeout;
-    configuration.HTTPMaximumConnectionsPerHost = maximumConnections;
-    
-    return configuration;
-}
-
-- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration {
-    
-    NSOperationQueue *queue = [NSOperationQueue new];
-    queue.maxConcurrentOperationCount = configuration.HTTPMaximumConnectionsPerHost;
-    
-    return queue;
-}
-
-- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration {
-    
-    // Construct sessions to process requests which should be sent to PubNub network.
-    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration delegate:self
-                                                     delegateQueue:_delegateQueue];
-    
-    return session;
-}
+#pragma mark - Misc
 
 - (NSURL *)requestBaseURL {
     
@@ -822,21 +1099,28 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark - Handlers
 
--(void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)error {
+- (void)handleData:(nullable NSData *)data loadedWithTask:(nullable id <PNTransportTask>)task
+             error:(nullable NSError *)requestError responseData:(nullable PNNetworkResponseDataBlock)dataBlock
+      streamParser:(nullable PNSubscribeStreamParser *)streamParser
+      usingSuccess:(PNNetworkTaskSuccess)success failure:(PNNetworkTaskFailure)failure {
+    
+    [self metricsForTask:task remove:NO].responseCompletionDate = [NSDate date];
+    BOOL isSuccessful = (!requestError && ((NSHTTPURLResponse *)task.response).statusCode == 200);
+    BOOL isStreamed = (streamParser && isSuccessful);
     
-    if (error) {
+    // Let caller preview response before it will be pushed through serialization and parsing.
+    NSData *previewData = (isStreamed ? streamParser.envelopeData : data);
+    if (dataBlock && isSuccessful && previewData.length) { dataBlock(previewData); }
+    
+    // Response body events processed on parsing executor while it has been received.
+    if (isStreamed) {
         
-        OSSpinLockLock(&_lock);
-        // Replace invalidated session with new one which can be used for next requests.
-        [self prepareSessionWithRequesrTimeout:self.requestTimeout
-                            maximumConnections:self.maximumConnections];
-        OSSpinLockUnlock(&_lock);
+        [streamParser processedResponseOnQueue:self.processingQueue withCompletion:^(NSDictionary *response) {
+            
+            success(task, response);
+        }];
+        return;
     }
-}
-
-- (void)handleData:(nullable NSData *)data loadedWithTask:(nullable NSURLSessionDataTask *)task
-             error:(nullable NSError *)requestError usingSuccess:(NSURLSessionDataTaskSuccess)success
-           failure:(NSURLSessionDataTaskFailure)failure {
     
     dispatch_async(self.processingQueue, ^{
         
@@ -848,7 +1132,7 @@ NS_ASSUME_NONNULL_END
     });
 }
 
-- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable NSURLSessionDataTask *)task
+- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable id <PNTransportTask>)task
                withData:(nullable id)responseObject completionBlock:(id)block {
     
     __weak __typeof(self) weakSelf = self;
@@ -868,7 +1152,18 @@ NS_ASSUME_NONNULL_END
          }];
 }
 
-- (void)handleOperation:(PNOperationType)operation taskDidFail:(nullable NSURLSessionDataTask *)task
+- (void)handleOperation:(PNOperationType)operation taskDidComplete:(nullable id <PNTransportTask>)task
+         withParsedData:(nullable NSDictionary *)parsedData completionBlock:(id)block {
+    
+    if (parsedData) {
+        
+        [self handleParsedData:parsedData loadedWithTask:task forOperation:operation parsedAsError:NO
+               processingError:task.error completionBlock:block];
+    }
+    else { [self handleOperation:operation taskDidComplete:task withData:nil completionBlock:block]; }
+}
+
+- (void)handleOperation:(PNOperationType)operation taskDidFail:(nullable id <PNTransportTask>)task
               withError:(nullable NSError *)error completionBlock:(id)block {
     
     if (error.code == NSURLErrorCancelled) {
@@ -894,7 +1189,7 @@ NS_ASSUME_NONNULL_END
     }
 }
 
-- (void)handleParsedData:(nullable NSDictionary *)data loadedWithTask:(nullable NSURLSessionDataTask *)task
+- (void)handleParsedData:(nullable NSDictionary *)data loadedWithTask:(nullable id <PNTransportTask>)task
             forOperation:(PNOperationType)operation parsedAsError:(BOOL)isError
          processingError:(nullable NSError *)error completionBlock:(id)block {
     
@@ -925,6 +1220,11 @@ NS_ASSUME_NONNULL_END
                                                processedData:data processingError:error];
     }
     
+    PNRequestMetrics *metrics = [self metricsForTask:task remove:YES];
+    metrics.parseCompletionDate = [NSDate date];
+    result.metrics = metrics;
+    status.metrics = metrics;
+    
     if (result || status) {
 
         [self handleOperation:operation processingCompletedWithResult:result
@@ -944,6 +1244,33 @@ NS_ASSUME_NONNULL_END
     #pragma clang diagnostic ignored "-Warc-repeated-use-of-weak"
     [self.client appendClientInformation:result];
     [self.client appendClientInformation:status];
+    PNRequestMetrics *metrics = (result.metrics?: status.metrics);
+    metrics.callbackDispatchDate = [NSDate date];
+    [self.client storeRequestMetrics:metrics];
+#if PN_METRICS_ENABLED
+    if (operation == PNSubscribeOperation && !status.isError && metrics.responseCompletionDate) {
+        
+        PNMetricsCounters *counters = self.client.metricsCounters;
+        int64_t latency = (int64_t)([metrics networkDuration] * 1000000.f);
+        PNMetricsIncrement(counters, subscribeCycles);
+        PNMetricsAdd(counters, subscribeCycleLatency, latency);
+        PNMetricsStore(counters, lastSubscribeCycleLatency, latency);
+        int64_t responseTime = (int64_t)(metrics.responseCompletionDate.timeIntervalSinceReferenceDate * 1000000.f);
+        int64_t previousResponseTime = _lastSubscribeResponseTime;
+        while (!OSAtomicCompareAndSwap64Barrier(previousResponseTime, responseTime, &_lastSubscribeResponseTime)) {
+            
+            previousResponseTime = _lastSubscribeResponseTime;
+        }
+        if (previousResponseTime && metrics.startDate) {
+            
+            int64_t startTime = (int64_t)(metrics.startDate.timeIntervalSinceReferenceDate * 1000000.f);
+            int64_t pollGap = MAX(startTime - previousResponseTime, 0);
+            PNMetricsIncrement(counters, pollGaps);
+            PNMetricsAdd(counters, pollGap, pollGap);
+            PNMetricsStore(counters, lastPollGap, pollGap);
+        }
+    }
+#endif // PN_METRICS_ENABLED
     if (block) {
         
         if ([self operationExpectResult:operation]) {
@@ -959,41 +1286,6 @@ NS_ASSUME_NONNULL_END
 }
 
 
-#pragma mark - Misc
-
-- (void)printIfRequiredSessionCustomizationInformation {
-    
-    if ([NSURLSessionConfiguration pn_HTTPAdditionalHeaders].count) {
-        
-        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Custom HTTP headers is set by user: "
-                        "%@", [NSURLSessionConfiguration pn_HTTPAdditionalHeaders]);
-    }
-    
-    if ([NSURLSessionConfiguration pn_networkServiceType] != NSURLNetworkServiceTypeDefault) {
-        
-        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Custom network service type is set by "
-                        "user: %@", @([NSURLSessionConfiguration pn_networkServiceType]));
-    }
-    
-    if (![NSURLSessionConfiguration pn_allowsCellularAccess]) {
-        
-        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> User limited access to cellular data "
-                        "and only WiFi connection can be used.");
-    }
-    
-    if ([NSURLSessionConfiguration pn_protocolClasses].count) {
-        
-        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Extra requests handling protocols "
-                        "defined by user: %@", [NSURLSessionConfiguration pn_protocolClasses]);
-    }
-    
-    if ([NSURLSessionConfiguration pn_connectionProxyDictionary].count) {
-        
-        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Connection proxy has been set by user:"
-                        " %@", [NSURLSessionConfiguration pn_connectionProxyDictionary]);
-    }
-}
-
 #pragma mark -
 
 
@@ -0,0 +1,136 @@
+#import <Foundation/Foundation.h>
+#import "PNStructures.h"
+
+
+#pragma mark Types
+
+/**
+ @brief  Structure which describe how long single block spent in executor.
+
+ @since 4.5.0
+ */
+typedef struct PNParsingTimings {
+
+    /**
+     @brief  Time which block spent waiting for free worker (in seconds).
+
+     @since 4.5.0
+     */
+    NSTimeInterval queueTime;
+
+    /**
+     @brief  Time which has been spent on block execution (in seconds).
+
+     @since 4.5.0
+     */
+    NSTimeInterval executionTime;
+} PNParsingTimings;
+
+/**
+ @brief  Structure which describe accumulated executor statistics.
+
+ @since 4.5.0
+ */
+typedef struct PNParsingStatistics {
+
+    /**
+     @brief  Number of blocks which has been executed.
+
+     @since 4.5.0
+     */
+    NSUInteger executedBlocksCount;
+
+    /**
+     @brief  Summary time which executed blocks spent waiting for free worker (in seconds).
+
+     @since 4.5.0
+     */
+    NSTimeInterval queueTime;
+
+    /**
+     @brief  Maximum time which single block spent waiting for free worker (in seconds).
+
+     @since 4.5.0
+     */
+    NSTimeInterval maximumQueueTime;
+
+    /**
+     @brief  Summary time which has been spent on blocks execution (in seconds).
+
+     @since 4.5.0
+     */
+    NSTimeInterval executionTime;
+} PNParsingStatistics;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Class which is used by client to parse and decrypt service responses.
+ @discussion Executor owned by client and shared between all it's networks. Blocks distributed between fixed
+             number of serial workers, so client won't occupy more threads than it has been configured, and
+             each worker run with configured priority instead of lowest global queue priority.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNParsingExecutor : NSObject
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct executor with specified priority and width.
+
+ @param identifier         Reference on identifier which is used as prefix for workers' queue labels.
+ @param qualityOfService   Priority with which blocks should be executed.
+ @param maximumConcurrency Maximum number of blocks which can be executed at the same time.
+
+ @return Constructed and ready to use executor.
+
+ @since 4.5.0
+ */
++ (instancetype)executorWithIdentifier:(NSString *)identifier
+                      qualityOfService:(PNQualityOfService)qualityOfService
+                    maximumConcurrency:(NSUInteger)maximumConcurrency;
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Retrieve statistics accumulated by executor since it has been created.
+
+ @return Structure with number of executed blocks and time which they spent in executor.
+
+ @since 4.5.0
+ */
+- (PNParsingStatistics)statistics;
+
+
+///------------------------------------------------
+/// @name Execution
+///------------------------------------------------
+
+/**
+ @brief  Execute block on one of executor's workers.
+
+ @param block      Reference on block which should be executed.
+ @param completion Reference on block which will be called on same worker right after \c block execution
+                   with information about time which it spent in executor.
+
+ @since 4.5.0
+ */
+- (void)executeBlock:(dispatch_block_t)block
+      withCompletion:(nullable void(^)(PNParsingTimings timings))completion;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
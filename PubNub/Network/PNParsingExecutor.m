@@ -0,0 +1,231 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNParsingExecutor.h"
+#import <libkern/OSAtomic.h>
+
+
+#pragma mark Private functions
+
+/**
+ @brief      Create serial worker queue which will execute blocks with specified priority.
+ @discussion On systems which doesn't support quality of service classes worker will target global queue
+             with corresponding priority.
+
+ @param label            Reference on label which should be assigned to the queue.
+ @param qualityOfService Priority with which queue should execute blocks.
+
+ @return Configured and ready to use serial queue.
+
+ @since 4.5.0
+ */
+static dispatch_queue_t PNParsingWorkerQueue(const char *label, PNQualityOfService qualityOfService) {
+
+    NSUInteger serviceClass = (NSUInteger)MIN(MAX(qualityOfService, PNUserInteractiveQualityOfService),
+                                              PNBackgroundQualityOfService);
+    dispatch_queue_t queue = nil;
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wtautological-pointer-compare"
+    if (&dispatch_queue_attr_make_with_qos_class != NULL) {
+    #pragma clang diagnostic pop
+
+        qos_class_t const classes[] = {QOS_CLASS_USER_INTERACTIVE, QOS_CLASS_USER_INITIATED, QOS_CLASS_DEFAULT,
+                                       QOS_CLASS_UTILITY, QOS_CLASS_BACKGROUND};
+        queue = dispatch_queue_create(label, dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                                                     classes[serviceClass], 0));
+    }
+    else {
+
+        long const priorities[] = {DISPATCH_QUEUE_PRIORITY_HIGH, DISPATCH_QUEUE_PRIORITY_HIGH,
+                                   DISPATCH_QUEUE_PRIORITY_DEFAULT, DISPATCH_QUEUE_PRIORITY_LOW,
+                                   DISPATCH_QUEUE_PRIORITY_BACKGROUND};
+        queue = dispatch_queue_create(label, DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(queue, dispatch_get_global_queue(priorities[serviceClass], 0));
+    }
+
+    return queue;
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+@interface PNParsingExecutor () {
+
+    /**
+     @brief  Stores number of blocks which has been scheduled on each worker and not completed yet.
+
+     @since 4.5.0
+     */
+    volatile int32_t *_pendingBlocks;
+
+    /**
+     @brief  Stores accumulated executor statistics.
+
+     @since 4.5.0
+     */
+    PNParsingStatistics _statistics;
+
+    /**
+     @brief  Spin-lock which is used to protect access to accumulated statistics.
+
+     @since 4.5.0
+     */
+    OSSpinLock _statisticsLock;
+}
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on list of serial queues which is used to execute blocks.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSArray<dispatch_queue_t> *workers;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize executor with specified priority and width.
+
+ @param identifier         Reference on identifier which is used as prefix for workers' queue labels.
+ @param qualityOfService   Priority with which blocks should be executed.
+ @param maximumConcurrency Maximum number of blocks which can be executed at the same time.
+
+ @return Initialized and ready to use executor.
+
+ @since 4.5.0
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier qualityOfService:(PNQualityOfService)qualityOfService
+                maximumConcurrency:(NSUInteger)maximumConcurrency;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Find worker which has smallest number of scheduled blocks.
+
+ @return Index of worker which should be used for next block.
+
+ @since 4.5.0
+ */
+- (NSUInteger)leastLoadedWorkerIndex;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNParsingExecutor
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)executorWithIdentifier:(NSString *)identifier
+                      qualityOfService:(PNQualityOfService)qualityOfService
+                    maximumConcurrency:(NSUInteger)maximumConcurrency {
+
+    return [[self alloc] initWithIdentifier:identifier qualityOfService:qualityOfService
+                         maximumConcurrency:maximumConcurrency];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier qualityOfService:(PNQualityOfService)qualityOfService
+                maximumConcurrency:(NSUInteger)maximumConcurrency {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        NSUInteger workersCount = MAX(maximumConcurrency, 1);
+        NSMutableArray<dispatch_queue_t> *workers = [[NSMutableArray alloc] initWithCapacity:workersCount];
+        for (NSUInteger workerIdx = 0; workerIdx < workersCount; workerIdx++) {
+
+            NSString *label = [NSString stringWithFormat:@"%@.parser.%@", identifier, @(workerIdx)];
+            [workers addObject:PNParsingWorkerQueue(label.UTF8String, qualityOfService)];
+        }
+        _workers = [workers copy];
+        _pendingBlocks = calloc(workersCount, sizeof(int32_t));
+        _statisticsLock = OS_SPINLOCK_INIT;
+    }
+
+    return self;
+}
+
+
+#pragma mark - Information
+
+- (PNParsingStatistics)statistics {
+
+    OSSpinLockLock(&_statisticsLock);
+    PNParsingStatistics statistics = _statistics;
+    OSSpinLockUnlock(&_statisticsLock);
+
+    return statistics;
+}
+
+
+#pragma mark - Execution
+
+- (void)executeBlock:(dispatch_block_t)block
+      withCompletion:(void(^)(PNParsingTimings timings))completion {
+
+    NSUInteger workerIdx = [self leastLoadedWorkerIndex];
+    OSAtomicIncrement32Barrier(&_pendingBlocks[workerIdx]);
+    CFAbsoluteTime scheduleDate = CFAbsoluteTimeGetCurrent();
+    dispatch_async(self.workers[workerIdx], ^{
+
+        CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+        block();
+        PNParsingTimings timings = {.queueTime = (startDate - scheduleDate),
+                                    .executionTime = (CFAbsoluteTimeGetCurrent() - startDate)};
+        OSAtomicDecrement32Barrier(&self->_pendingBlocks[workerIdx]);
+
+        OSSpinLockLock(&self->_statisticsLock);
+        self->_statistics.executedBlocksCount++;
+        self->_statistics.queueTime += timings.queueTime;
+        self->_statistics.maximumQueueTime = MAX(self->_statistics.maximumQueueTime, timings.queueTime);
+        self->_statistics.executionTime += timings.executionTime;
+        OSSpinLockUnlock(&self->_statisticsLock);
+
+        if (completion) { completion(timings); }
+    });
+}
+
+
+#pragma mark - Misc
+
+- (NSUInteger)leastLoadedWorkerIndex {
+
+    NSUInteger workerIdx = 0;
+    int32_t smallestLoad = INT32_MAX;
+    for (NSUInteger idx = 0; idx < self.workers.count && smallestLoad > 0; idx++) {
+
+        int32_t load = _pendingBlocks[idx];
+        if (load < smallestLoad) {
+
+            smallestLoad = load;
+            workerIdx = idx;
+        }
+    }
+
+    return workerIdx;
+}
+
+- (void)dealloc {
+
+    free((void *)_pendingBlocks);
+}
+
+#pragma mark -
+
+
+@end
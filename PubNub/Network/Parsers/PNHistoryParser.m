@@ -67,7 +67,28 @@ static DDLogLevel ddLogLevel = (DDLogLevel)PNAESErrorLogLevel;
         NSMutableDictionary *data = [@{@"start": (NSArray *)response[1], @"end": (NSArray *)response[2],
                                        @"messages": [NSMutableArray new]} mutableCopy];
         NSArray *messages = (NSArray *)response[0];
-        [messages enumerateObjectsUsingBlock:^(id messageObject, __unused NSUInteger messageObjectIdx,
+        NSString *cipherKey = additionalData[@"cipherKey"];
+        
+        // Decrypt all messages at once if there is more than one history entry.
+        NSArray *decryptedMessages = nil;
+        if (cipherKey.length && messages.count > 1) {
+            
+            NSMutableArray<NSString *> *encryptedMessages = [[NSMutableArray alloc] initWithCapacity:messages.count];
+            for (id messageObject in messages) {
+                
+                id message = messageObject;
+                if ([messageObject isKindOfClass:[NSDictionary class]] && messageObject[@"message"] &&
+                    messageObject[@"timetoken"]) {
+                    
+                    message = messageObject[@"message"];
+                }
+                if ([message isKindOfClass:[NSDictionary class]]) { message = message[@"pn_other"]; }
+                [encryptedMessages addObject:([message isKindOfClass:[NSString class]] ? message : @"")];
+            }
+            decryptedMessages = [PNAES decryptMessages:encryptedMessages withKey:cipherKey];
+        }
+        
+        [messages enumerateObjectsUsingBlock:^(id messageObject, NSUInteger messageObjectIdx,
                                                __unused BOOL *messageObjectEnumeratorStop) {
             
             NSNumber *timeToken = nil;
@@ -83,15 +104,18 @@ static DDLogLevel ddLogLevel = (DDLogLevel)PNAESErrorLogLevel;
             }
             
             // Try decrypt message if possible.
-            if (((NSString *)additionalData[@"cipherKey"]).length){
+            if (cipherKey.length){
                 
                 NSError *decryptionError;
                 id decryptedMessage = nil;
                 id dataForDecryption = ([message isKindOfClass:[NSDictionary class]] ? ((NSDictionary *)message)[@"pn_other"] : message);
                 if ([dataForDecryption isKindOfClass:[NSString class]]) {
                     
-                    NSData *eventData = [PNAES decrypt:dataForDecryption withKey:additionalData[@"cipherKey"]
-                                              andError:&decryptionError];
+                    NSData *eventData = nil;
+                    id decryptedData = decryptedMessages[messageObjectIdx];
+                    if ([decryptedData isKindOfClass:[NSError class]]) { decryptionError = decryptedData; }
+                    else if (decryptedData) { eventData = decryptedData; }
+                    else { eventData = [PNAES decrypt:dataForDecryption withKey:cipherKey andError:&decryptionError]; }
                     NSString *decryptedMessageString = nil;
                     if (eventData) {
                         
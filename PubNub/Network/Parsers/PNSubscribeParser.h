@@ -2,6 +2,8 @@
 #import "PNParser.h"
 
 
+NS_ASSUME_NONNULL_BEGIN
+
 /**
  @brief      Class suitable to handle and process \b PubNub service response on subscribe request.
  @discussion Handle and pre-process provided server data to fetch operation result from it.
@@ -20,7 +22,65 @@
 @interface PNSubscribeParser : NSObject <PNParser>
 
 
+///------------------------------------------------
+/// @name Time token pre-fetch
+///------------------------------------------------
+
+/**
+ @brief      Extract next subscription cycle time token information from raw service response.
+ @discussion Scan raw response bytes for top-level \c t object (time token and region) w/o de-serialization 
+             of whole response body. This allow subscriber to issue next long-poll request while events 
+             from current response still processed.
+ 
+ @param timeToken Pointer to storage for time token which has been found in response.
+ @param region    Pointer to storage for \b PubNub server region identifier which has been found in 
+                  response (\b -1 if response doesn't specify region).
+ @param data      Reference on raw data which has been received from \b PubNub service in response on 
+                  subscribe request.
+ 
+ @return \c NO in case if response doesn't contain well-formed time token information.
+ 
+ @since 4.5.0
+ */
++ (BOOL)getTimeToken:(uint64_t *)timeToken region:(int32_t *)region fromResponseData:(nullable NSData *)data;
+
+
+///------------------------------------------------
+/// @name Events processing
+///------------------------------------------------
+
+/**
+ @brief      Parse real-time event received from data object live feed.
+ @discussion Exposed for parsers which process subscribe response by parts (one event at a time).
+ 
+ @param data           Reference on service-provided data about event.
+ @param additionalData Additional information provided by client to complete parsing.
+ 
+ @return Pre-processed event information (depending on stored data).
+ 
+ @since 4.3.0
+ */
++ (NSMutableDictionary *)eventFromData:(NSDictionary<NSString *, id> *)data
+              withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData;
+
+/**
+ @brief      Parse list of real-time events received from data object live feed.
+ @discussion Messages from list decrypted at once (if there is more than one event and cipher key has been 
+             passed with \c additionalData).
+ 
+ @param events         List of service-provided events.
+ @param additionalData Additional information provided by client to complete parsing.
+ 
+ @return List of pre-processed events information (in same order as \c events).
+ 
+ @since 4.5.0
+ */
++ (NSArray<NSMutableDictionary *> *)eventsFromData:(NSArray<NSDictionary *> *)events
+                          withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData;
+
 #pragma mark -
 
 
 @end
+
+NS_ASSUME_NONNULL_END
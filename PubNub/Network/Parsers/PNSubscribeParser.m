@@ -145,6 +145,21 @@ struct PNEventEnvelopeStructure {
          @brief  Stores reference on unique client identifier which caused presence event triggering.
          */
         __unsafe_unretained NSString *uuid;
+        
+        /**
+         @brief  Stores reference on key under which \c interval event store list of joined clients.
+         */
+        __unsafe_unretained NSString *join;
+        
+        /**
+         @brief  Stores reference on key under which \c interval event store list of clients which left.
+         */
+        __unsafe_unretained NSString *leave;
+        
+        /**
+         @brief  Stores reference on key under which \c interval event store list of timed out clients.
+         */
+        __unsafe_unretained NSString *timeout;
     } presence;
 } PNEventEnvelope = {
     .senderTimeToken = { .key = @"o" },
@@ -153,10 +168,136 @@ struct PNEventEnvelopeStructure {
     .subscribedChannel = @"b",
     .payload = @"d",
     .presence = { .action = @"action", .data = @"data", .occupancy = @"occupancy",
-        .timestamp = @"timestamp", .uuid = @"uuid" }
+        .timestamp = @"timestamp", .uuid = @"uuid", .join = @"join", .leave = @"leave",
+        .timeout = @"timeout" }
 };
 
 
+#pragma mark - Time token scanner
+
+/**
+ @brief  Skip whitespace characters starting from specified \c position.
+ 
+ @param bytes    Pointer on raw response bytes.
+ @param length   Length of raw response.
+ @param position Position starting from which whitespaces should be skipped.
+ 
+ @return Position of first non-whitespace character (or \c length if end reached).
+ 
+ @since 4.5.0
+ */
+static NSUInteger PNSkipWhitespaces(const char *bytes, NSUInteger length, NSUInteger position) {
+    
+    while (position < length && (bytes[position] == ' ' || bytes[position] == '\n' ||
+                                 bytes[position] == '\r' || bytes[position] == '\t')) {
+        
+        position++;
+    }
+    
+    return position;
+}
+
+/**
+ @brief  Check whether at specified \c position stored single-character object key (\c "<key>":).
+ 
+ @param bytes    Pointer on raw response bytes.
+ @param length   Length of raw response.
+ @param position Position of opening quote.
+ @param key      Expected key character.
+ 
+ @return Position right after key/value separator or \c 0 in case if there is no such key.
+ 
+ @since 4.5.0
+ */
+static NSUInteger PNKeyValueStart(const char *bytes, NSUInteger length, NSUInteger position, char key) {
+    
+    NSUInteger valueStart = 0;
+    if (position + 2 < length && bytes[position + 1] == key && bytes[position + 2] == '"') {
+        
+        NSUInteger separator = PNSkipWhitespaces(bytes, length, position + 3);
+        if (separator < length && bytes[separator] == ':') {
+            
+            valueStart = PNSkipWhitespaces(bytes, length, separator + 1);
+        }
+    }
+    
+    return valueStart;
+}
+
+/**
+ @brief  Read integer value (which can be wrapped into quotes) starting from specified \c position.
+ 
+ @param bytes    Pointer on raw response bytes.
+ @param length   Length of raw response.
+ @param position Position from which value starts.
+ @param value    Pointer on storage for parsed value.
+ 
+ @return Position right after read value or \c 0 in case if there is no digits at specified position.
+ 
+ @since 4.5.0
+ */
+static NSUInteger PNReadInteger(const char *bytes, NSUInteger length, NSUInteger position, long long *value) {
+    
+    BOOL isQuoted = (position < length && bytes[position] == '"');
+    NSUInteger digitsStart = (position + (isQuoted ? 1 : 0));
+    NSUInteger end = digitsStart;
+    long long result = 0;
+    while (end < length && bytes[end] >= '0' && bytes[end] <= '9') {
+        
+        result = (result * 10) + (bytes[end] - '0');
+        end++;
+    }
+    if (isQuoted && end < length && bytes[end] == '"') { end++; }
+    *value = result;
+    
+    return (end > digitsStart ? end : 0);
+}
+
+/**
+ @brief  Scan time token object (\c {"t":"<time token>","r":<region>}) which start at specified 
+         \c position.
+ 
+ @param bytes     Pointer on raw response bytes.
+ @param length    Length of raw response.
+ @param position  Position of time token object opening brace.
+ @param timeToken Pointer on storage for parsed time token.
+ @param region    Pointer on storage for parsed region.
+ 
+ @return \c YES in case if time token has been found in object.
+ 
+ @since 4.5.0
+ */
+static BOOL PNScanTimeTokenObject(const char *bytes, NSUInteger length, NSUInteger position,
+                                  long long *timeToken, long long *region) {
+    
+    BOOL timeTokenFound = NO;
+    for (NSUInteger idx = position + 1; idx < length && bytes[idx] != '}'; idx++) {
+        
+        if (bytes[idx] != '"') { continue; }
+        NSUInteger valueEnd = 0;
+        NSUInteger valueStart = PNKeyValueStart(bytes, length, idx, 't');
+        if (valueStart) {
+            
+            valueEnd = PNReadInteger(bytes, length, valueStart, timeToken);
+            timeTokenFound = (valueEnd > 0);
+        }
+        else if ((valueStart = PNKeyValueStart(bytes, length, idx, 'r'))) {
+            
+            valueEnd = PNReadInteger(bytes, length, valueStart, region);
+        }
+        
+        // Move to the end of processed value or skip the rest of unknown string (key or value).
+        if (valueEnd) { idx = (valueEnd - 1); }
+        else {
+            
+            while (++idx < length && bytes[idx] != '"') { if (bytes[idx] == '\\') { idx++; } }
+        }
+    }
+    
+    return timeTokenFound;
+}
+
+
 NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - Protected interface
@@ -167,31 +308,51 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Events processing
 
 /**
- @brief  Parse real-time event received from data object live feed.
+ @brief      Parse real-time event received from data object live feed.
+ @discussion Extension to \c +eventFromData:withAdditionalParserData: which allow to pass message which 
+             already has been decrypted.
  
  @param data           Reference on service-provided data about event.
+ @param decryptedData  Decrypted message data (\a NSData) or decryption error (\a NSError). Message will be 
+                       decrypted during parsing if \c nil passed.
  @param additionalData Additional information provided by client to complete parsing.
  
  @return Pre-processed event information (depending on stored data).
  
- @since 4.3.0
+ @since 4.5.0
  */
-+ (NSMutableDictionary *)eventFromData:(NSDictionary<NSString *, id> *)data
++ (NSMutableDictionary *)eventFromData:(NSDictionary<NSString *, id> *)data decryptedData:(nullable id)decryptedData
               withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData;
 
 /**
  @brief  Parse provided data as new message event.
  
  @param data           Data which should be parsed to required 'message' object format.
+ @param decryptedData  Decrypted message data (\a NSData) or decryption error (\a NSError). Message will be 
+                       decrypted during parsing if \c nil passed.
  @param additionalData Additional information provided by client to complete parsing.
  
  @return Processed and parsed 'message' object.
  
  @since 4.0
  */
-+ (NSMutableDictionary *)messageFromData:(id)data
++ (NSMutableDictionary *)messageFromData:(id)data decryptedData:(nullable id)decryptedData
                 withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData;
 
+/**
+ @brief      Decrypt messages from list of live feed events.
+ @discussion Messages decrypted in parallel before events will be parsed.
+ 
+ @param events    List of service-provided events.
+ @param cipherKey Reference on key which should be used to decrypt messages.
+ 
+ @return List of same length as \c events with decrypted data or decryption errors (for presence events and 
+         non-encrypted messages too).
+ 
+ @since 4.5.0
+ */
++ (NSArray *)decryptedMessagesFromEvents:(NSArray<NSDictionary *> *)events withKey:(NSString *)cipherKey;
+
 /**
  @brief  Parse provded data as presence event.
  
@@ -262,16 +423,13 @@ NS_ASSUME_NONNULL_END
         NSArray<NSDictionary *> *feedEvents = response[kPNResponseEventsListKey];
         if (feedEvents.count) {
             
-            NSMutableArray<NSDictionary *> *events = [[NSMutableArray alloc] initWithCapacity:feedEvents.count];
-            for (NSUInteger eventIdx = 0; eventIdx < [feedEvents count]; eventIdx++) {
+            NSArray<NSMutableDictionary *> *events = [self eventsFromData:feedEvents
+                                                 withAdditionalParserData:additionalData];
+            for (NSMutableDictionary *event in events) {
                 
-                // Fetching remote data object name on which event fired.
-                NSMutableDictionary *event = [self eventFromData:feedEvents[eventIdx]
-                                        withAdditionalParserData:additionalData];
                 if (!event[@"timetoken"]) { event[@"timetoken"] = timeToken; }
-                [events addObject:event];
             }
-            feedEvents = [events copy];
+            feedEvents = events;
         }
         processedResponse = @{@"events": feedEvents, @"timetoken": timeToken, @"region": region};
     }
@@ -280,11 +438,81 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Time token pre-fetch
+
++ (BOOL)getTimeToken:(uint64_t *)timeToken region:(int32_t *)region fromResponseData:(nullable NSData *)data {
+    
+    BOOL timeTokenFound = NO;
+    const char *bytes = (const char *)data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger depth = 0;
+    BOOL insideString = NO;
+    
+    // Walk through response tracking strings and nesting level, so 't' key will be taken only from
+    // envelope and not from one of messages' payloads.
+    for (NSUInteger idx = 0; idx < length && !timeTokenFound; idx++) {
+        
+        char character = bytes[idx];
+        if (insideString) {
+            
+            if (character == '\\') { idx++; }
+            else if (character == '"') { insideString = NO; }
+        }
+        else if (character == '"') {
+            
+            NSUInteger valueStart = (depth == 1 ? PNKeyValueStart(bytes, length, idx, 't') : 0);
+            long long scannedTimeToken = 0;
+            long long scannedRegion = 0;
+            if (valueStart && valueStart < length && bytes[valueStart] == '{' &&
+                PNScanTimeTokenObject(bytes, length, valueStart, &scannedTimeToken, &scannedRegion)) {
+                
+                timeTokenFound = YES;
+                *timeToken = (uint64_t)scannedTimeToken;
+                *region = (int32_t)scannedRegion;
+            }
+            insideString = YES;
+        }
+        else if (character == '{' || character == '[') { depth++; }
+        else if ((character == '}' || character == ']') && depth > 0) { depth--; }
+    }
+    
+    return timeTokenFound;
+}
+
+
 #pragma mark - Events processing
 
 + (NSMutableDictionary *)eventFromData:(NSDictionary<NSString *, id> *)data
               withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData {
     
+    return [self eventFromData:data decryptedData:nil withAdditionalParserData:additionalData];
+}
+
++ (NSArray<NSMutableDictionary *> *)eventsFromData:(NSArray<NSDictionary *> *)events
+                          withAdditionalParserData:(NSDictionary<NSString *, id> *)additionalData {
+    
+    // Decrypt all messages at once if there is more than one event.
+    NSString *cipherKey = additionalData[@"cipherKey"];
+    NSArray *decryptedMessages = nil;
+    if (cipherKey.length && events.count > 1) {
+        
+        decryptedMessages = [self decryptedMessagesFromEvents:events withKey:cipherKey];
+    }
+    
+    NSMutableArray<NSMutableDictionary *> *parsedEvents = [[NSMutableArray alloc] initWithCapacity:events.count];
+    for (NSUInteger eventIdx = 0; eventIdx < events.count; eventIdx++) {
+        
+        // Fetching remote data object name on which event fired.
+        [parsedEvents addObject:[self eventFromData:events[eventIdx] decryptedData:decryptedMessages[eventIdx]
+                           withAdditionalParserData:additionalData]];
+    }
+    
+    return parsedEvents;
+}
+
++ (NSMutableDictionary *)eventFromData:(NSDictionary<NSString *, id> *)data decryptedData:(nullable id)decryptedData
+              withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData {
+    
     NSMutableDictionary *event = [NSMutableDictionary new];
     NSString *channel = data[PNEventEnvelope.actualChannel];
     NSString *subscriptionMatch = data[PNEventEnvelope.subscribedChannel];
@@ -309,13 +537,27 @@ NS_ASSUME_NONNULL_END
     else {
         
         [event addEntriesFromDictionary:[self messageFromData:data[PNEventEnvelope.payload]
+                                                decryptedData:decryptedData
                                      withAdditionalParserData:additionalData]];
     }
     
     return event;
 }
 
-+ (NSMutableDictionary *)messageFromData:(id)data
++ (NSArray *)decryptedMessagesFromEvents:(NSArray<NSDictionary *> *)events withKey:(NSString *)cipherKey {
+    
+    NSMutableArray<NSString *> *messages = [[NSMutableArray alloc] initWithCapacity:events.count];
+    for (NSDictionary *event in events) {
+        
+        id message = event[PNEventEnvelope.payload];
+        if ([message isKindOfClass:[NSDictionary class]]) { message = ((NSDictionary *)message)[@"pn_other"]; }
+        [messages addObject:([message isKindOfClass:[NSString class]] ? message : @"")];
+    }
+    
+    return [PNAES decryptMessages:messages withKey:cipherKey];
+}
+
++ (NSMutableDictionary *)messageFromData:(id)data decryptedData:(nullable id)decryptedData
                 withAdditionalParserData:(nullable NSDictionary<NSString *, id> *)additionalData {
     
     NSMutableDictionary *message = nil;
@@ -328,8 +570,14 @@ NS_ASSUME_NONNULL_END
         id dataForDecryption = ([data isKindOfClass:[NSDictionary class]] ? ((NSDictionary *)data)[@"pn_other"] : data);
         if ([dataForDecryption isKindOfClass:[NSString class]]) {
             
-            NSData *eventData = [PNAES decrypt:dataForDecryption withKey:additionalData[@"cipherKey"]
-                                      andError:&decryptionError];
+            NSData *eventData = nil;
+            if ([decryptedData isKindOfClass:[NSError class]]) { decryptionError = decryptedData; }
+            else if (decryptedData) { eventData = decryptedData; }
+            else {
+                
+                eventData = [PNAES decrypt:dataForDecryption withKey:additionalData[@"cipherKey"]
+                                  andError:&decryptionError];
+            }
             NSString *decryptedEventData = nil;
             if (eventData) {
                 
@@ -390,6 +638,13 @@ NS_ASSUME_NONNULL_END
         presence[@"presence"][@"state"] = data[PNEventEnvelope.presence.data];
     }
     
+    // 'interval' event may carry changes in subscribers list since previous 'interval' event.
+    for (NSString *key in @[PNEventEnvelope.presence.join, PNEventEnvelope.presence.leave,
+                            PNEventEnvelope.presence.timeout]) {
+        
+        if ([data[key] isKindOfClass:[NSArray class]]) { presence[@"presence"][key] = data[key]; }
+    }
+    
     return presence;
 }
 
@@ -0,0 +1,106 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class PNParsingExecutor;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Class suitable to incrementally process \b PubNub service response on subscribe request.
+ @discussion Parser is fed with response body chunks as they arrive from network and know about v2 subscribe
+             envelope structure: time token object (\c t) and list of events (\c m). Feeding only scan bytes 
+             and copy completely received event objects, so it is cheap enough to be done on transport's 
+             queue. Captured events de-serialized and decrypted (if required) in batches on parsing executor
+             while rest of response body still downloading.
+ @discussion Parser output has same format as \b PNSubscribeParser's output.
+ @warning    Parser instance should be fed with data from single response and chunks should be passed in
+             order in which they has been received.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSubscribeStreamParser : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores whether whole response envelope has been received and processed or not.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign, getter = isCompleted) BOOL completed;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Construct parser which will use additional data to process events.
+
+ @param additionalData Additional information provided by client to complete parsing (for example cipher key
+                       which should be used to decrypt messages).
+ @param executor       Reference on executor which should be used to de-serialize and decrypt events. If 
+                       \c nil is passed, events will be processed on global queue.
+
+ @return Constructed and ready to use parser.
+
+ @since 4.5.0
+ */
++ (instancetype)parserWithAdditionalData:(nullable NSDictionary<NSString *, id> *)additionalData
+                                executor:(nullable PNParsingExecutor *)executor;
+
+
+///------------------------------------------------
+/// @name Parsing
+///------------------------------------------------
+
+/**
+ @brief  Process next chunk of response body.
+
+ @param data Reference on response body chunk.
+
+ @return \c NO in case if malformed response has been received and further processing is impossible.
+
+ @since 4.5.0
+ */
+- (BOOL)appendData:(NSData *)data;
+
+/**
+ @brief      Retrieve response envelope fields which has been received so far.
+ @discussion Returned data represent JSON object which contain all envelope fields except list of events.
+             This data can be used to pre-fetch time token information.
+
+ @return JSON object data or \c nil in case if none of envelope fields has been received yet.
+
+ @since 4.5.0
+ */
+- (nullable NSData *)envelopeData;
+
+/**
+ @brief      Retrieve processed response.
+ @discussion Block will be called when all captured events will be processed.
+ @warning    Method should be called after last chunk has been passed to parser (on same queue).
+
+ @param queue Reference on queue on which \c block should be called.
+ @param block Reference on block which is called with dictionary which has \c events, \c timetoken and
+              \c region keys or \c nil in case if response not completed or malformed.
+
+ @since 4.5.0
+ */
+- (void)processedResponseOnQueue:(dispatch_queue_t)queue
+                  withCompletion:(void(^)(NSDictionary<NSString *, id> * _Nullable response))block;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
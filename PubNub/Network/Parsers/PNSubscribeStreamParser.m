@@ -0,0 +1,729 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNSubscribeStreamParser.h"
+#import "PNParsingExecutor.h"
+#import "PNSubscribeParser.h"
+#import <libkern/OSAtomic.h>
+
+
+#pragma mark Static
+
+/**
+ @brief  Number of captured events which is passed for processing at once.
+
+ @since 4.5.0
+ */
+static NSUInteger const kPNStreamEventsBatchSize = 32;
+
+
+#pragma mark - Types and structures
+
+/**
+ @brief  Describes states in which envelope scanner can be.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSUInteger, PNStreamScannerState) {
+
+    /**
+     @brief  Scanner wait for envelope object opening brace.
+     */
+    PNStreamScannerExpectEnvelope,
+
+    /**
+     @brief  Scanner wait for next envelope key (or envelope object closing brace).
+     */
+    PNStreamScannerExpectKey,
+
+    /**
+     @brief  Scanner read envelope key.
+     */
+    PNStreamScannerReadKey,
+
+    /**
+     @brief  Scanner wait for key/value separator.
+     */
+    PNStreamScannerExpectSeparator,
+
+    /**
+     @brief  Scanner wait for envelope field value.
+     */
+    PNStreamScannerExpectValue,
+
+    /**
+     @brief  Scanner capture envelope field value.
+     */
+    PNStreamScannerCaptureValue,
+
+    /**
+     @brief  Scanner wait for next event object in events list (or list closing bracket).
+     */
+    PNStreamScannerExpectEvent,
+
+    /**
+     @brief  Scanner capture event object.
+     */
+    PNStreamScannerCaptureEvent,
+
+    /**
+     @brief  Whole envelope has been received.
+     */
+    PNStreamScannerCompleted,
+
+    /**
+     @brief  Received data doesn't represent subscribe response envelope.
+     */
+    PNStreamScannerMalformed
+};
+
+/**
+ @brief  Describes what kind of value has been captured by scanner.
+
+ @since 4.5.0
+ */
+typedef NS_ENUM(NSUInteger, PNStreamValueType) {
+
+    /**
+     @brief  Captured value of envelope field.
+     */
+    PNStreamEnvelopeValue,
+
+    /**
+     @brief  Captured one of objects from events list.
+     */
+    PNStreamEventValue
+};
+
+/**
+ @brief  Describes envelope scanner state which is preserved between received chunks.
+
+ @since 4.5.0
+ */
+typedef struct PNStreamScanner {
+
+    /**
+     @brief  Current scanner state.
+     */
+    PNStreamScannerState state;
+
+    /**
+     @brief  Nesting level of captured value.
+     */
+    NSUInteger depth;
+
+    /**
+     @brief  Whether scanner is inside of string at this moment or not.
+     */
+    BOOL insideString;
+
+    /**
+     @brief  Whether previous character was escape character inside of string.
+     */
+    BOOL escaped;
+
+    /**
+     @brief  Whether captured value is scalar (number, boolean or null) which doesn't have explicit end.
+     */
+    BOOL scalarValue;
+
+    /**
+     @brief  Name of envelope field which is processed at this moment (only short names stored completely).
+     */
+    char key[16];
+
+    /**
+     @brief  Length of stored envelope field name.
+     */
+    NSUInteger keyLength;
+} PNStreamScanner;
+
+/**
+ @brief  Function which is called by scanner with part of captured value bytes.
+
+ @param context Reference on object which has been passed to scanner.
+ @param bytes   Pointer on part of captured value.
+ @param length  Length of captured part.
+
+ @since 4.5.0
+ */
+typedef void(*PNStreamCaptureFunction)(void *context, const char *bytes, NSUInteger length);
+
+/**
+ @brief  Function which is called by scanner when whole value has been captured.
+
+ @param context Reference on object which has been passed to scanner.
+ @param type    One of \b PNStreamValueType enum fields which describe captured value.
+ @param key     Name of envelope field to which captured value belong.
+
+ @since 4.5.0
+ */
+typedef void(*PNStreamValueFunction)(void *context, PNStreamValueType type, const char *key);
+
+
+#pragma mark - Envelope scanner
+
+/**
+ @brief  Check whether passed character is JSON whitespace.
+
+ @param character Character which should be checked.
+
+ @return \c YES in case if \c character is whitespace.
+
+ @since 4.5.0
+ */
+static inline BOOL PNStreamIsWhitespace(char character) {
+
+    return (character == ' ' || character == '\n' || character == '\r' || character == '\t');
+}
+
+/**
+ @brief  Track nesting level and strings for value which is captured at this moment.
+
+ @param scanner   Pointer on scanner state.
+ @param character Next character of captured value.
+
+ @return \c YES in case if \c character completed captured value.
+
+ @since 4.5.0
+ */
+static BOOL PNStreamScannerTrackValue(PNStreamScanner *scanner, char character) {
+
+    BOOL completed = NO;
+    if (scanner->insideString) {
+
+        if (scanner->escaped) { scanner->escaped = NO; }
+        else if (character == '\\') { scanner->escaped = YES; }
+        else if (character == '"') {
+
+            scanner->insideString = NO;
+            completed = (scanner->depth == 0);
+        }
+    }
+    else if (character == '"') { scanner->insideString = YES; }
+    else if (character == '{' || character == '[') { scanner->depth++; }
+    else if ((character == '}' || character == ']') && scanner->depth > 0) {
+
+        scanner->depth--;
+        completed = (scanner->depth == 0);
+    }
+
+    return completed;
+}
+
+/**
+ @brief      Process next chunk of response body.
+ @discussion Scanner walk through envelope fields and report captured values using provided functions. Value
+             of events list field (\c m) reported by scanner as separate event objects.
+
+ @param scanner  Pointer on scanner state.
+ @param bytes    Pointer on response body chunk.
+ @param length   Length of response body chunk.
+ @param context  Reference on object which should be passed to \c capture and \c complete functions.
+ @param capture  Function which is called with captured value bytes (can be called few times for single
+                 value if it split between chunks).
+ @param complete Function which is called when whole value has been captured.
+
+ @return \c NO in case if malformed response has been received.
+
+ @since 4.5.0
+ */
+static BOOL PNStreamScannerProcess(PNStreamScanner *scanner, const char *bytes, NSUInteger length,
+                                   void *context, PNStreamCaptureFunction capture,
+                                   PNStreamValueFunction complete) {
+
+    // Value capture continue from the beginning of chunk if it has been started in one of previous chunks.
+    BOOL capturing = (scanner->state == PNStreamScannerCaptureValue ||
+                      scanner->state == PNStreamScannerCaptureEvent);
+    NSUInteger captureStart = 0;
+    for (NSUInteger idx = 0; idx < length && scanner->state != PNStreamScannerMalformed; idx++) {
+
+        char character = bytes[idx];
+        switch (scanner->state) {
+            case PNStreamScannerExpectEnvelope:
+                if (character == '{') { scanner->state = PNStreamScannerExpectKey; }
+                else if (!PNStreamIsWhitespace(character)) { scanner->state = PNStreamScannerMalformed; }
+                break;
+            case PNStreamScannerExpectKey:
+                if (character == '"') {
+
+                    scanner->state = PNStreamScannerReadKey;
+                    scanner->escaped = NO;
+                    scanner->keyLength = 0;
+                    scanner->key[0] = '\0';
+                }
+                else if (character == '}') { scanner->state = PNStreamScannerCompleted; }
+                else if (character != ',' && !PNStreamIsWhitespace(character)) {
+
+                    scanner->state = PNStreamScannerMalformed;
+                }
+                break;
+            case PNStreamScannerReadKey:
+                if (!scanner->escaped && character == '"') {
+
+                    scanner->state = PNStreamScannerExpectSeparator;
+                }
+                else {
+
+                    // Key stored with escape characters, so it can be put back into envelope fields as-is.
+                    scanner->escaped = (!scanner->escaped && character == '\\');
+                    if (scanner->keyLength < sizeof(scanner->key) - 1) {
+
+                        scanner->key[scanner->keyLength++] = character;
+                        scanner->key[scanner->keyLength] = '\0';
+                    }
+                }
+                break;
+            case PNStreamScannerExpectSeparator:
+                if (character == ':') { scanner->state = PNStreamScannerExpectValue; }
+                else if (!PNStreamIsWhitespace(character)) { scanner->state = PNStreamScannerMalformed; }
+                break;
+            case PNStreamScannerExpectValue:
+                if (PNStreamIsWhitespace(character)) { break; }
+                if (character == '[' && scanner->keyLength == 1 && scanner->key[0] == 'm') {
+
+                    scanner->state = PNStreamScannerExpectEvent;
+                    break;
+                }
+                scanner->state = PNStreamScannerCaptureValue;
+                scanner->depth = (character == '{' || character == '[' ? 1 : 0);
+                scanner->insideString = (character == '"');
+                scanner->escaped = NO;
+                scanner->scalarValue = (!scanner->depth && !scanner->insideString);
+                capturing = YES;
+                captureStart = idx;
+                break;
+            case PNStreamScannerCaptureValue:
+                if (scanner->scalarValue) {
+
+                    // Scalar value end can be detected only by next character which should be processed
+                    // as part of envelope.
+                    if (character == ',' || character == '}' || PNStreamIsWhitespace(character)) {
+
+                        capture(context, bytes + captureStart, idx - captureStart);
+                        complete(context, PNStreamEnvelopeValue, scanner->key);
+                        capturing = NO;
+                        scanner->state = (character == '}' ? PNStreamScannerCompleted :
+                                          PNStreamScannerExpectKey);
+                    }
+                }
+                else if (PNStreamScannerTrackValue(scanner, character)) {
+
+                    capture(context, bytes + captureStart, idx + 1 - captureStart);
+                    complete(context, PNStreamEnvelopeValue, scanner->key);
+                    capturing = NO;
+                    scanner->state = PNStreamScannerExpectKey;
+                }
+                break;
+            case PNStreamScannerExpectEvent:
+                if (character == '{') {
+
+                    scanner->state = PNStreamScannerCaptureEvent;
+                    scanner->depth = 1;
+                    scanner->insideString = NO;
+                    scanner->escaped = NO;
+                    capturing = YES;
+                    captureStart = idx;
+                }
+                else if (character == ']') { scanner->state = PNStreamScannerExpectKey; }
+                else if (character != ',' && !PNStreamIsWhitespace(character)) {
+
+                    scanner->state = PNStreamScannerMalformed;
+                }
+                break;
+            case PNStreamScannerCaptureEvent:
+                if (PNStreamScannerTrackValue(scanner, character)) {
+
+                    capture(context, bytes + captureStart, idx + 1 - captureStart);
+                    complete(context, PNStreamEventValue, scanner->key);
+                    capturing = NO;
+                    scanner->state = PNStreamScannerExpectEvent;
+                }
+                break;
+            case PNStreamScannerCompleted:
+                if (!PNStreamIsWhitespace(character)) { scanner->state = PNStreamScannerMalformed; }
+                break;
+            case PNStreamScannerMalformed:
+                break;
+        }
+    }
+
+    // Pass captured part of value which will be continued in next chunk.
+    if (capturing && scanner->state != PNStreamScannerMalformed) {
+
+        capture(context, bytes + captureStart, length - captureStart);
+    }
+
+    return (scanner->state != PNStreamScannerMalformed);
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNSubscribeStreamParser () {
+
+    /**
+     @brief  Stores envelope scanner state.
+     */
+    PNStreamScanner _scanner;
+
+    /**
+     @brief  Spin-lock which is used to protect access to processed batches list.
+     */
+    OSSpinLock _batchesLock;
+}
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on additional information which should be used to process events.
+ */
+@property (nonatomic, nullable, copy) NSDictionary<NSString *, id> *additionalData;
+
+/**
+ @brief  Stores reference on bytes of value which is captured at this moment.
+ */
+@property (nonatomic, strong) NSMutableData *valueData;
+
+/**
+ @brief  Stores reference on serialized envelope fields (w/o events list).
+ */
+@property (nonatomic, strong) NSMutableData *envelopeFields;
+
+/**
+ @brief  Stores reference on executor which is used to process captured events.
+ */
+@property (nonatomic, nullable, strong) PNParsingExecutor *executor;
+
+/**
+ @brief  Stores reference on list of captured events which hasn't been passed for processing yet.
+ */
+@property (nonatomic, strong) NSMutableArray<NSData *> *capturedEvents;
+
+/**
+ @brief      Stores reference on list of processed events batches (in order in which they has been captured).
+ @discussion Batch which is processed at this moment or which can't be de-serialized represented by 
+             \c NSNull instance. Access to this property allowed only with \c _batchesLock.
+ */
+@property (nonatomic, strong) NSMutableArray *batches;
+
+/**
+ @brief  Stores reference on group which is used to track batches processing completion.
+ */
+@property (nonatomic, strong) dispatch_group_t batchesGroup;
+
+/**
+ @brief  Stores reference on time token which has been received in envelope.
+ */
+@property (nonatomic, nullable, strong) NSNumber *timeToken;
+
+/**
+ @brief  Stores reference on region which has been received in envelope.
+ */
+@property (nonatomic, nullable, strong) NSNumber *region;
+
+/**
+ @brief  Stores whether received data doesn't represent subscribe response envelope.
+ */
+@property (nonatomic, assign) BOOL malformed;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize parser which will use additional data to process events.
+
+ @param additionalData Additional information provided by client to complete parsing.
+ @param executor       Reference on executor which should be used to process events.
+
+ @return Initialized and ready to use parser.
+
+ @since 4.5.0
+ */
+- (instancetype)initWithAdditionalData:(nullable NSDictionary<NSString *, id> *)additionalData
+                              executor:(nullable PNParsingExecutor *)executor;
+
+
+#pragma mark - Processing
+
+/**
+ @brief  Handle envelope field value which has been captured by scanner.
+
+ @param key Name of envelope field.
+
+ @since 4.5.0
+ */
+- (void)handleEnvelopeValueForKey:(const char *)key;
+
+/**
+ @brief  Handle event object which has been captured by scanner.
+
+ @since 4.5.0
+ */
+- (void)handleEvent;
+
+/**
+ @brief  Pass captured events for processing on executor.
+
+ @since 4.5.0
+ */
+- (void)processCapturedEvents;
+
+/**
+ @brief  De-serialize and parse (decrypt if required) captured events.
+
+ @param events         List of captured events' JSON objects.
+ @param additionalData Additional information provided by client to complete parsing.
+
+ @return List of processed events or \c nil in case if one of events can't be de-serialized.
+
+ @since 4.5.0
+ */
++ (nullable NSArray<NSMutableDictionary *> *)eventsFromCapturedEvents:(NSArray<NSData *> *)events
+                                                   withAdditionalData:(nullable NSDictionary *)additionalData;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Scanner callbacks
+
+/**
+ @brief  Store part of value captured by envelope scanner.
+
+ @param context Reference on parser which requested scanning.
+ @param bytes   Pointer on part of captured value.
+ @param length  Length of captured part.
+
+ @since 4.5.0
+ */
+static void PNStreamParserCapture(void *context, const char *bytes, NSUInteger length) {
+
+    [((__bridge PNSubscribeStreamParser *)context).valueData appendBytes:bytes length:length];
+}
+
+/**
+ @brief  Handle value which has been completely captured by envelope scanner.
+
+ @param context Reference on parser which requested scanning.
+ @param type    One of \b PNStreamValueType enum fields which describe captured value.
+ @param key     Name of envelope field to which captured value belong.
+
+ @since 4.5.0
+ */
+static void PNStreamParserComplete(void *context, PNStreamValueType type, const char *key) {
+
+    PNSubscribeStreamParser *parser = (__bridge PNSubscribeStreamParser *)context;
+    if (type == PNStreamEventValue) { [parser handleEvent]; }
+    else { [parser handleEnvelopeValueForKey:key]; }
+    parser.valueData.length = 0;
+}
+
+
+#pragma mark - Interface implementation
+
+@implementation PNSubscribeStreamParser
+
+
+#pragma mark - Information
+
+- (BOOL)isCompleted {
+
+    return (_scanner.state == PNStreamScannerCompleted);
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)parserWithAdditionalData:(NSDictionary<NSString *, id> *)additionalData
+                                executor:(PNParsingExecutor *)executor {
+
+    return [[self alloc] initWithAdditionalData:additionalData executor:executor];
+}
+
+- (instancetype)initWithAdditionalData:(NSDictionary<NSString *, id> *)additionalData
+                              executor:(PNParsingExecutor *)executor {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        _additionalData = [additionalData copy];
+        _executor = executor;
+        _valueData = [NSMutableData new];
+        _envelopeFields = [NSMutableData new];
+        _capturedEvents = [NSMutableArray new];
+        _batches = [NSMutableArray new];
+        _batchesGroup = dispatch_group_create();
+        _batchesLock = OS_SPINLOCK_INIT;
+        _scanner.state = PNStreamScannerExpectEnvelope;
+    }
+
+    return self;
+}
+
+
+#pragma mark - Parsing
+
+- (BOOL)appendData:(NSData *)data {
+
+    __block BOOL processed = !self.malformed;
+    if (processed) {
+
+        // Chunk bytes can be stored in few non-contiguous regions.
+        [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+
+            processed = (PNStreamScannerProcess(&self->_scanner, (const char *)bytes, byteRange.length,
+                                                (__bridge void *)self, PNStreamParserCapture,
+                                                PNStreamParserComplete) && !self.malformed);
+            *stop = !processed;
+        }];
+        self.malformed = !processed;
+    }
+
+    return processed;
+}
+
+- (NSData *)envelopeData {
+
+    NSMutableData *data = nil;
+    if (self.envelopeFields.length) {
+
+        data = [NSMutableData dataWithBytes:"{" length:1];
+        [data appendData:self.envelopeFields];
+        [data appendBytes:"}" length:1];
+    }
+
+    return data;
+}
+
+- (void)processedResponseOnQueue:(dispatch_queue_t)queue
+                  withCompletion:(void(^)(NSDictionary<NSString *, id> *response))block {
+
+    if (!self.isCompleted || self.malformed) {
+
+        dispatch_async(queue, ^{ block(nil); });
+        return;
+    }
+
+    if (self.capturedEvents.count) { [self processCapturedEvents]; }
+    dispatch_group_notify(self.batchesGroup, queue, ^{
+
+        NSNumber *timeToken = (self.timeToken?: @0);
+        NSMutableArray<NSMutableDictionary *> *events = [NSMutableArray new];
+        BOOL malformed = NO;
+        OSSpinLockLock(&self->_batchesLock);
+        for (id batch in self.batches) {
+
+            malformed = (malformed || ![batch isKindOfClass:[NSArray class]]);
+            if (!malformed) { [events addObjectsFromArray:batch]; }
+        }
+        OSSpinLockUnlock(&self->_batchesLock);
+        for (NSMutableDictionary *event in events) {
+
+            if (!event[@"timetoken"]) { event[@"timetoken"] = timeToken; }
+        }
+
+        block(malformed ? nil : @{@"events": [events copy], @"timetoken": timeToken,
+                                  @"region": (self.region?: @0)});
+    });
+}
+
+
+#pragma mark - Processing
+
+- (void)handleEnvelopeValueForKey:(const char *)key {
+
+    // Envelope fields preserved in serialized form, so they can be used for time token pre-fetch.
+    if (self.envelopeFields.length) { [self.envelopeFields appendBytes:"," length:1]; }
+    [self.envelopeFields appendBytes:"\"" length:1];
+    [self.envelopeFields appendBytes:key length:strlen(key)];
+    [self.envelopeFields appendBytes:"\":" length:2];
+    [self.envelopeFields appendData:self.valueData];
+
+    if (strcmp(key, "t") == 0) {
+
+        NSDictionary *timeTokenData = [NSJSONSerialization JSONObjectWithData:self.valueData options:0
+                                                                        error:nil];
+        if ([timeTokenData isKindOfClass:[NSDictionary class]]) {
+
+            self.timeToken = @([timeTokenData[@"t"] longLongValue]);
+            self.region = @([timeTokenData[@"r"] longLongValue]);
+        }
+    }
+}
+
+- (void)handleEvent {
+
+    // Event only copied here, because parser fed on transport's queue.
+    [self.capturedEvents addObject:[self.valueData copy]];
+    if (self.capturedEvents.count >= kPNStreamEventsBatchSize) { [self processCapturedEvents]; }
+}
+
+- (void)processCapturedEvents {
+
+    NSArray<NSData *> *capturedEvents = [self.capturedEvents copy];
+    NSDictionary *additionalData = self.additionalData;
+    [self.capturedEvents removeAllObjects];
+
+    OSSpinLockLock(&_batchesLock);
+    NSUInteger batchIdx = self.batches.count;
+    [self.batches addObject:[NSNull null]];
+    OSSpinLockUnlock(&_batchesLock);
+
+    dispatch_group_t group = self.batchesGroup;
+    dispatch_group_enter(group);
+    dispatch_block_t block = ^{
+
+        NSArray *events = [[self class] eventsFromCapturedEvents:capturedEvents withAdditionalData:additionalData];
+        if (events) {
+
+            OSSpinLockLock(&self->_batchesLock);
+            self.batches[batchIdx] = events;
+            OSSpinLockUnlock(&self->_batchesLock);
+        }
+    };
+
+    if (self.executor) {
+
+        [self.executor executeBlock:block withCompletion:^(__unused PNParsingTimings timings) {
+
+            dispatch_group_leave(group);
+        }];
+    }
+    else {
+
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+            block();
+            dispatch_group_leave(group);
+        });
+    }
+}
+
++ (NSArray<NSMutableDictionary *> *)eventsFromCapturedEvents:(NSArray<NSData *> *)events
+                                          withAdditionalData:(NSDictionary *)additionalData {
+
+    NSMutableArray<NSDictionary *> *eventsData = [[NSMutableArray alloc] initWithCapacity:events.count];
+    for (NSData *event in events) {
+
+        NSDictionary *eventData = [NSJSONSerialization JSONObjectWithData:event options:0 error:nil];
+        if (![eventData isKindOfClass:[NSDictionary class]]) { return nil; }
+        [eventsData addObject:eventData];
+    }
+
+    return [PNSubscribeParser eventsFromData:eventsData withAdditionalParserData:additionalData];
+}
+
+#pragma mark -
+
+
+@end
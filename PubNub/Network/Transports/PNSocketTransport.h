@@ -0,0 +1,27 @@
+#import <Foundation/Foundation.h>
+#import "PNTransport.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Lightweight \b PubNub network transport built on top of POSIX sockets.
+ @discussion Transport maintain pool of persistent (keep-alive) HTTP/1.1 connections and send requests with
+             blocking I/O on private concurrent queue. This allow to avoid \a NSURLSession overhead for
+             high-rate traffic and communicate with local (loopback) servers.
+ @warning    Transport doesn't support TLS and can be used only with configuration where \c TLSEnabled set to
+             \c NO (client will fallback to \b PNURLSessionTransport otherwise).
+ 
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSocketTransport : NSObject <PNTransport>
+
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,1047 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNSocketTransport.h"
+#import "NSURLSessionConfiguration+PNConfigurationPrivate.h"
+#import <netinet/in.h>
+#import <netinet/tcp.h>
+#import <sys/socket.h>
+#import "PNLogMacro.h"
+#import <unistd.h>
+#import <fcntl.h>
+#import <netdb.h>
+#import <poll.h>
+
+
+#pragma mark Static
+
+/**
+ @brief  Cocoa Lumberjack logging level configuration for socket based transport.
+
+ @since 4.5.0
+ */
+static DDLogLevel ddLogLevel;
+
+/**
+ @brief  Size of buffer which is used to read data from socket.
+
+ @since 4.5.0
+ */
+static size_t const kPNSocketReadBufferSize = 16384;
+
+
+#pragma mark - Private functions
+
+/**
+ @brief  Construct \a NSURLErrorDomain error for socket operation.
+
+ @param code      One of \a NSURLError codes which describe issue.
+ @param posixCode Underlying POSIX error code (\c errno) or \c 0 if not available.
+ @param url       Reference on URL for which request has been sent.
+
+ @return Constructed and ready to use error instance.
+
+ @since 4.5.0
+ */
+static NSError * PNSocketError(NSInteger code, int posixCode, NSURL *url) {
+
+    NSMutableDictionary *userInfo = [NSMutableDictionary new];
+    if (url) {
+
+        userInfo[NSURLErrorFailingURLErrorKey] = url;
+        userInfo[NSURLErrorFailingURLStringErrorKey] = url.absoluteString;
+    }
+    if (posixCode != 0) {
+
+        userInfo[NSUnderlyingErrorKey] = [NSError errorWithDomain:NSPOSIXErrorDomain code:posixCode
+                                                         userInfo:nil];
+    }
+
+    return [NSError errorWithDomain:NSURLErrorDomain code:code userInfo:userInfo];
+}
+
+/**
+ @brief  Translate I/O \c errno value into \a NSURLError code.
+
+ @param posixCode POSIX error code which should be translated.
+
+ @return Suitable \a NSURLError code.
+
+ @since 4.5.0
+ */
+static NSInteger PNSocketErrorCode(int posixCode) {
+
+    NSInteger code = NSURLErrorNetworkConnectionLost;
+    if (posixCode == EAGAIN || posixCode == EWOULDBLOCK || posixCode == ETIMEDOUT) {
+
+        code = NSURLErrorTimedOut;
+    }
+    else if (posixCode == ECONNREFUSED) { code = NSURLErrorCannotConnectToHost; }
+    else if (posixCode == ENETUNREACH || posixCode == EHOSTUNREACH || posixCode == ENETDOWN) {
+
+        code = NSURLErrorNotConnectedToInternet;
+    }
+
+    return code;
+}
+
+/**
+ @brief  Connect socket to remote address with timeout.
+
+ @param socketDescriptor Socket which should be connected.
+ @param address          Reference on remote address information.
+ @param timeout          Maximum time which can be spent on connection.
+ @param posixCode        Pointer on storage for connection error code.
+
+ @return \c YES in case if connection has been established.
+
+ @since 4.5.0
+ */
+static BOOL PNSocketConnect(int socketDescriptor, struct addrinfo *address, NSTimeInterval timeout,
+                            int *posixCode) {
+
+    int flags = fcntl(socketDescriptor, F_GETFL, 0);
+    fcntl(socketDescriptor, F_SETFL, flags | O_NONBLOCK);
+    BOOL connected = (connect(socketDescriptor, address->ai_addr, address->ai_addrlen) == 0);
+    if (!connected && errno == EINPROGRESS) {
+
+        struct pollfd descriptor = { .fd = socketDescriptor, .events = POLLOUT, .revents = 0 };
+        int pollResult = poll(&descriptor, 1, (int)(timeout * 1000));
+        if (pollResult > 0) {
+
+            int socketError = 0;
+            socklen_t length = sizeof(socketError);
+            getsockopt(socketDescriptor, SOL_SOCKET, SO_ERROR, &socketError, &length);
+            connected = (socketError == 0);
+            *posixCode = socketError;
+        }
+        else { *posixCode = (pollResult == 0 ? ETIMEDOUT : errno); }
+    }
+    else if (!connected) { *posixCode = errno; }
+    fcntl(socketDescriptor, F_SETFL, flags);
+
+    return connected;
+}
+
+
+#pragma mark - Connection interface declaration
+
+/**
+ @brief      Persistent connection to remote host.
+ @discussion Connection allow to write request and read HTTP/1.1 response (including chunked transfer
+             encoding). Connection can be reused for next requests if server allow it.
+
+ @since 4.5.0
+ */
+@interface PNSocketConnection : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on remote endpoint identifier (host and port).
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, copy) NSString *endpoint;
+
+/**
+ @brief  Stores reference on descriptor of connected socket.
+
+ @since 4.5.0
+ */
+@property (nonatomic, readonly, assign) int socketDescriptor;
+
+/**
+ @brief  Stores reference on data which has been read from socket but not processed yet.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableData *buffer;
+
+/**
+ @brief  Stores number of bytes which has been read during last request processing.
+
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSUInteger bytesRead;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Open connection to remote host.
+
+ @param host    Remote host name or address.
+ @param port    Remote host port.
+ @param timeout Maximum time which can be spent on connection and on single read/write operation.
+ @param error   Pointer on storage for connection error.
+
+ @return Connected and ready to use connection or \c nil in case of error.
+
+ @since 4.5.0
+ */
++ (nullable instancetype)connectionToHost:(NSString *)host port:(NSInteger)port
+                                  timeout:(NSTimeInterval)timeout error:(NSError **)error;
+
+
+#pragma mark - I/O
+
+/**
+ @brief  Write whole \c data into socket.
+
+ @param data  Reference on data which should be written.
+ @param url   Reference on URL for which request has been sent (used for error composition).
+ @param error Pointer on storage for write error.
+
+ @return \c YES in case if all data has been written.
+
+ @since 4.5.0
+ */
+- (BOOL)writeData:(NSData *)data forURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief  Read HTTP response from socket.
+
+ @param url       Reference on URL for which request has been sent.
+ @param data      Pointer on storage for response body.
+ @param keepAlive Pointer on storage for flag whether connection can be reused.
+ @param error     Pointer on storage for read error.
+
+ @return Received response or \c nil in case of error.
+
+ @since 4.5.0
+ */
+- (nullable NSHTTPURLResponse *)readResponseForURL:(NSURL *)url data:(NSData **)data
+                                         keepAlive:(BOOL *)keepAlive error:(NSError **)error;
+
+/**
+ @brief  Interrupt any blocking I/O operation which is performed with connection at this moment.
+
+ @since 4.5.0
+ */
+- (void)interrupt;
+
+/**
+ @brief  Close connection and release socket.
+
+ @since 4.5.0
+ */
+- (void)close;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Task interface declaration
+
+/**
+ @brief  Represent single request which is processed by socket transport.
+
+ @since 4.5.0
+ */
+@interface PNSocketTransportTask : NSObject <PNTransportTask>
+
+
+#pragma mark - Information
+
+@property (nullable, copy) NSURLRequest *currentRequest;
+@property (nullable, copy) NSURLResponse *response;
+@property (nullable, copy) NSError *error;
+
+/**
+ @brief  Stores reference on transport which created this task.
+
+ @since 4.5.0
+ */
+@property (nonatomic, weak) PNSocketTransport *transport;
+
+/**
+ @brief  Stores reference on block which should be called at the end of task processing.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, copy) PNTransportTaskCompletionBlock completionBlock;
+
+/**
+ @brief  Stores whether task has been cancelled or not.
+
+ @since 4.5.0
+ */
+@property (assign, getter = isCancelled) BOOL cancelled;
+
+/**
+ @brief  Stores reference on connection which is used by task at this moment.
+
+ @since 4.5.0
+ */
+@property (nullable, strong) PNSocketConnection *connection;
+
+#pragma mark -
+
+
+@end
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNSocketTransport ()
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on unique transport identifier.
+
+ @since 4.5.0
+ */
+@property (nonatomic, copy) NSString *identifier;
+
+/**
+ @brief  Stores value which should be used as timeout for connection and for every I/O operation.
+
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSTimeInterval requestTimeout;
+
+/**
+ @brief  Stores maximum number of simultaneously processed requests (and opened connections).
+
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger maximumConnections;
+
+@property (nonatomic, nullable, copy) NSDictionary<NSString *, NSString *> *HTTPAdditionalHeaders;
+
+/**
+ @brief  Stores reference on block which should be called with task processing metrics.
+
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, copy) PNTransportMetricsBlock metricsBlock;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to tasks and connections pool.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+/**
+ @brief  Stores reference on queue on which blocking socket I/O is performed.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) dispatch_queue_t processingQueue;
+
+/**
+ @brief  Stores list of tasks which wait for free connection.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<PNSocketTransportTask *> *pendingTasks;
+
+/**
+ @brief  Stores list of tasks which is processed at this moment.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableSet<PNSocketTransportTask *> *activeTasks;
+
+/**
+ @brief  Stores list of keep-alive connections which can be used for next requests.
+
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMutableArray<PNSocketConnection *> *idleConnections;
+
+/**
+ @brief  Stores whether transport has been invalidated or not.
+
+ @since 4.5.0
+ */
+@property (nonatomic, assign, getter = isInvalidated) BOOL invalidated;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize socket based transport with predefined options.
+
+ @param identifier         Unique identifier which will be used to name transport queues.
+ @param timeout            Maximum time which transport should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+
+ @return Initialized and ready to use transport.
+
+ @since 4.5.0
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                maximumConnections:(NSInteger)maximumConnections;
+
+
+#pragma mark - Tasks processing
+
+/**
+ @brief  Schedule task for processing.
+
+ @param task Reference on task which should be processed as soon as connection will be available.
+
+ @since 4.5.0
+ */
+- (void)resumeTask:(PNSocketTransportTask *)task;
+
+/**
+ @brief  Cancel scheduled or active task.
+
+ @param task Reference on task which should be cancelled.
+
+ @since 4.5.0
+ */
+- (void)cancelTask:(PNSocketTransportTask *)task;
+
+/**
+ @brief      Start processing of pending tasks while there is free connection slots.
+ @discussion Method should be called on \c resourceAccessQueue.
+
+ @since 4.5.0
+ */
+- (void)startPendingTasks;
+
+/**
+ @brief  Send task's request and read response using blocking I/O.
+
+ @param task       Reference on task which should be processed.
+ @param connection Reference on idle keep-alive connection which can be used (if exists).
+
+ @since 4.5.0
+ */
+- (void)processTask:(PNSocketTransportTask *)task withConnection:(nullable PNSocketConnection *)connection;
+
+/**
+ @brief  Complete task processing and return connection to the pool (if possible).
+
+ @param task       Reference on task which has been processed.
+ @param data       Reference on received response body.
+ @param response   Reference on received response.
+ @param error      Reference on processing error.
+ @param connection Reference on connection which can be reused for next requests.
+
+ @since 4.5.0
+ */
+- (void)completeTask:(PNSocketTransportTask *)task withData:(nullable NSData *)data
+            response:(nullable NSHTTPURLResponse *)response error:(nullable NSError *)error
+          connection:(nullable PNSocketConnection *)connection;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Serialize request into HTTP/1.1 message.
+
+ @param request Reference on request which should be serialized.
+
+ @return Data which can be written into socket.
+
+ @since 4.5.0
+ */
+- (NSData *)dataForRequest:(NSURLRequest *)request;
+
+/**
+ @brief  Compose remote endpoint identifier for URL.
+
+ @param url Reference on URL for which identifier should be created.
+
+ @return Endpoint identifier (host and port).
+
+ @since 4.5.0
+ */
+- (NSString *)endpointForURL:(NSURL *)url;
+
+/**
+ @brief  Retrieve port which should be used to communicate with host from passed URL.
+
+ @param url Reference on URL for which port should be found.
+
+ @return Remote host port.
+
+ @since 4.5.0
+ */
+- (NSInteger)portForURL:(NSURL *)url;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Connection implementation
+
+@implementation PNSocketConnection
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)connectionToHost:(NSString *)host port:(NSInteger)port timeout:(NSTimeInterval)timeout
+                           error:(NSError **)error {
+
+    PNSocketConnection *connection = nil;
+    NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:@"http://%@:%@", host, @(port)]];
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addresses = NULL;
+    if (getaddrinfo(host.UTF8String, @(port).stringValue.UTF8String, &hints, &addresses) != 0) {
+
+        if (error) { *error = PNSocketError(NSURLErrorCannotFindHost, 0, url); }
+        return nil;
+    }
+
+    int posixCode = 0;
+    int socketDescriptor = -1;
+    for (struct addrinfo *address = addresses; address && socketDescriptor < 0; address = address->ai_next) {
+
+        socketDescriptor = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socketDescriptor < 0) { posixCode = errno; }
+        else if (!PNSocketConnect(socketDescriptor, address, timeout, &posixCode)) {
+
+            close(socketDescriptor);
+            socketDescriptor = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (socketDescriptor >= 0) {
+
+        int enabled = 1;
+        struct timeval ioTimeout = { .tv_sec = (time_t)timeout,
+                                     .tv_usec = (suseconds_t)((timeout - (NSInteger)timeout) * 1000000) };
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_KEEPALIVE, &enabled, sizeof(enabled));
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+        setsockopt(socketDescriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_RCVTIMEO, &ioTimeout, sizeof(ioTimeout));
+        setsockopt(socketDescriptor, SOL_SOCKET, SO_SNDTIMEO, &ioTimeout, sizeof(ioTimeout));
+
+        connection = [self new];
+        connection->_socketDescriptor = socketDescriptor;
+        connection->_endpoint = [[NSString alloc] initWithFormat:@"%@:%@", host, @(port)];
+        connection->_buffer = [NSMutableData new];
+    }
+    else if (error) { *error = PNSocketError(PNSocketErrorCode(posixCode), posixCode, url); }
+
+    return connection;
+}
+
+- (void)dealloc {
+
+    [self close];
+}
+
+
+#pragma mark - I/O
+
+- (BOOL)writeData:(NSData *)data forURL:(NSURL *)url error:(NSError **)error {
+
+    const uint8_t *bytes = (const uint8_t *)data.bytes;
+    NSUInteger offset = 0;
+    while (offset < data.length) {
+
+        ssize_t count = send(_socketDescriptor, bytes + offset, (data.length - offset), 0);
+        if (count < 0 && errno == EINTR) { continue; }
+        if (count <= 0) {
+
+            int posixCode = (count < 0 ? errno : EPIPE);
+            if (error) { *error = PNSocketError(PNSocketErrorCode(posixCode), posixCode, url); }
+            return NO;
+        }
+        offset += (NSUInteger)count;
+    }
+
+    return YES;
+}
+
+- (BOOL)readIntoBufferForURL:(NSURL *)url error:(NSError **)error {
+
+    uint8_t chunk[kPNSocketReadBufferSize];
+    ssize_t count = 0;
+    do { count = recv(_socketDescriptor, chunk, sizeof(chunk), 0); } while (count < 0 && errno == EINTR);
+    if (count > 0) {
+
+        [self.buffer appendBytes:chunk length:(NSUInteger)count];
+        self.bytesRead += (NSUInteger)count;
+    }
+    else {
+
+        int posixCode = (count < 0 ? errno : ECONNRESET);
+        if (error) { *error = PNSocketError(PNSocketErrorCode(posixCode), posixCode, url); }
+    }
+
+    return (count > 0);
+}
+
+- (BOOL)ensureBufferLength:(NSUInteger)length forURL:(NSURL *)url error:(NSError **)error {
+
+    BOOL filled = YES;
+    while (filled && self.buffer.length < length) { filled = [self readIntoBufferForURL:url error:error]; }
+
+    return filled;
+}
+
+- (NSData *)consumeBytes:(NSUInteger)length {
+
+    NSData *data = [self.buffer subdataWithRange:NSMakeRange(0, length)];
+    [self.buffer replaceBytesInRange:NSMakeRange(0, length) withBytes:NULL length:0];
+
+    return data;
+}
+
+- (nullable NSString *)readLineForURL:(NSURL *)url error:(NSError **)error {
+
+    static NSData *_lineSeparator;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{ _lineSeparator = [@"\r\n" dataUsingEncoding:NSASCIIStringEncoding]; });
+
+    NSString *line = nil;
+    NSRange range = NSMakeRange(NSNotFound, 0);
+    BOOL filled = YES;
+    while (filled && (range = [self.buffer rangeOfData:_lineSeparator options:0
+                                                 range:NSMakeRange(0, self.buffer.length)]).location == NSNotFound) {
+
+        filled = [self readIntoBufferForURL:url error:error];
+    }
+    if (range.location != NSNotFound) {
+
+        NSData *lineData = [self consumeBytes:NSMaxRange(range)];
+        line = [[NSString alloc] initWithBytes:lineData.bytes length:range.location
+                                      encoding:NSISOLatin1StringEncoding];
+    }
+
+    return line;
+}
+
+- (NSHTTPURLResponse *)readResponseForURL:(NSURL *)url data:(NSData **)data keepAlive:(BOOL *)keepAlive
+                                    error:(NSError **)error {
+
+    *keepAlive = NO;
+    NSString *statusLine = [self readLineForURL:url error:error];
+    NSArray<NSString *> *statusComponents = [statusLine componentsSeparatedByString:@" "];
+    if (statusComponents.count < 2 || ![statusComponents[0] hasPrefix:@"HTTP/"]) {
+
+        if (statusLine && error) { *error = PNSocketError(NSURLErrorBadServerResponse, 0, url); }
+        return nil;
+    }
+    NSString *version = statusComponents[0];
+    NSInteger statusCode = statusComponents[1].integerValue;
+
+    // Read headers till empty line.
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSString *> *normalizedHeaders = [NSMutableDictionary new];
+    NSString *headerLine = nil;
+    while ((headerLine = [self readLineForURL:url error:error]).length) {
+
+        NSRange separatorRange = [headerLine rangeOfString:@":"];
+        if (separatorRange.location == NSNotFound) { continue; }
+        NSCharacterSet *whitespaces = [NSCharacterSet whitespaceCharacterSet];
+        NSString *field = [[headerLine substringToIndex:separatorRange.location]
+                           stringByTrimmingCharactersInSet:whitespaces];
+        NSString *value = [[headerLine substringFromIndex:NSMaxRange(separatorRange)]
+                           stringByTrimmingCharactersInSet:whitespaces];
+        NSString *existingValue = headers[field];
+        headers[field] = (existingValue ? [existingValue stringByAppendingFormat:@", %@", value] : value);
+        normalizedHeaders[field.lowercaseString] = headers[field];
+    }
+    if (!headerLine) { return nil; }
+
+    NSString *connectionHeader = normalizedHeaders[@"connection"].lowercaseString;
+    BOOL canKeepAlive = ([version isEqualToString:@"HTTP/1.1"] ?
+                         ![connectionHeader isEqualToString:@"close"] :
+                         [connectionHeader isEqualToString:@"keep-alive"]);
+
+    // Read response body.
+    NSMutableData *body = [NSMutableData new];
+    NSString *contentLength = normalizedHeaders[@"content-length"];
+    if ([normalizedHeaders[@"transfer-encoding"].lowercaseString rangeOfString:@"chunked"].location != NSNotFound) {
+
+        NSString *chunkSizeLine = nil;
+        while ((chunkSizeLine = [self readLineForURL:url error:error])) {
+
+            NSUInteger chunkSize = (NSUInteger)strtoul(chunkSizeLine.UTF8String, NULL, 16);
+            if (chunkSize == 0) {
+
+                // Skip trailer headers (if any) till empty line.
+                while ((chunkSizeLine = [self readLineForURL:url error:error]).length) {}
+                break;
+            }
+            if (![self ensureBufferLength:(chunkSize + 2) forURL:url error:error]) { return nil; }
+            [body appendData:[self consumeBytes:chunkSize]];
+            [self consumeBytes:2];
+        }
+        if (!chunkSizeLine) { return nil; }
+    }
+    else if (contentLength) {
+
+        NSUInteger length = (NSUInteger)contentLength.longLongValue;
+        if (![self ensureBufferLength:length forURL:url error:error]) { return nil; }
+        [body appendData:[self consumeBytes:length]];
+    }
+    else if (statusCode != 204 && statusCode != 304 && statusCode >= 200) {
+
+        // Body length defined by connection close.
+        NSError *readError = nil;
+        while ([self readIntoBufferForURL:url error:&readError]) {}
+        [body appendData:[self consumeBytes:self.buffer.length]];
+        canKeepAlive = NO;
+    }
+
+    *keepAlive = canKeepAlive;
+    *data = [body copy];
+
+    return [[NSHTTPURLResponse alloc] initWithURL:url statusCode:statusCode HTTPVersion:version
+                                     headerFields:headers];
+}
+
+- (void)interrupt {
+
+    if (_socketDescriptor >= 0) { shutdown(_socketDescriptor, SHUT_RDWR); }
+}
+
+- (void)close {
+
+    if (_socketDescriptor >= 0) {
+
+        close(_socketDescriptor);
+        _socketDescriptor = -1;
+    }
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Task implementation
+
+@implementation PNSocketTransportTask
+
+@synthesize currentRequest = _currentRequest;
+@synthesize response = _response;
+@synthesize error = _error;
+
+
+#pragma mark - Processing
+
+- (void)resume {
+
+    [self.transport resumeTask:self];
+}
+
+- (void)cancel {
+
+    self.cancelled = YES;
+    [self.transport cancelTask:self];
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNSocketTransport
+
+
+#pragma mark - Logger
+
++ (DDLogLevel)ddLogLevel {
+
+    return ddLogLevel;
+}
+
++ (void)ddSetLogLevel:(DDLogLevel)logLevel {
+
+    ddLogLevel = logLevel;
+}
+
+
+#pragma mark - Information
+
+- (NSURLRequestCachePolicy)requestCachePolicy {
+
+    return NSURLRequestReloadIgnoringLocalCacheData;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)transportWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                     maximumConnections:(NSInteger)maximumConnections
+                               longPoll:(__unused BOOL)longPollEnabled {
+
+    return [[self alloc] initWithIdentifier:identifier requestTimeout:timeout
+                         maximumConnections:maximumConnections];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                maximumConnections:(NSInteger)maximumConnections {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        _identifier = [identifier copy];
+        _requestTimeout = timeout;
+        _maximumConnections = MAX(maximumConnections, 1);
+        _pendingTasks = [NSMutableArray new];
+        _activeTasks = [NSMutableSet new];
+        _idleConnections = [NSMutableArray new];
+
+        // Re-use headers which has been configured by user for NSURLSession based transport.
+        NSURLSessionConfiguration *configuration = nil;
+        configuration = [NSURLSessionConfiguration pn_ephemeralSessionConfigurationWithIdentifier:identifier];
+        _HTTPAdditionalHeaders = [configuration.HTTPAdditionalHeaders copy];
+
+        NSString *resourceQueueIdentifier = [identifier stringByAppendingString:@".socket"];
+        NSString *processingQueueIdentifier = [identifier stringByAppendingString:@".socket.io"];
+        _resourceAccessQueue = dispatch_queue_create([resourceQueueIdentifier UTF8String], DISPATCH_QUEUE_SERIAL);
+        _processingQueue = dispatch_queue_create([processingQueueIdentifier UTF8String],
+                                                 DISPATCH_QUEUE_CONCURRENT);
+    }
+
+    return self;
+}
+
+
+#pragma mark - Request processing
+
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             completion:(PNTransportTaskCompletionBlock)block {
+
+    PNSocketTransportTask *task = [PNSocketTransportTask new];
+    task.currentRequest = request;
+    task.transport = self;
+    task.completionBlock = block;
+
+    return task;
+}
+
+- (void)cancelAllTasks {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+
+        NSArray<PNSocketTransportTask *> *tasks = [self.activeTasks.allObjects
+                                                   arrayByAddingObjectsFromArray:self.pendingTasks];
+        for (PNSocketTransportTask *task in tasks) { [task cancel]; }
+    });
+}
+
+- (void)invalidate {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+
+        self.invalidated = YES;
+        [self.idleConnections makeObjectsPerformSelector:@selector(close)];
+        [self.idleConnections removeAllObjects];
+    });
+    [self cancelAllTasks];
+}
+
+
+#pragma mark - Tasks processing
+
+- (void)resumeTask:(PNSocketTransportTask *)task {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+
+        if (self.isInvalidated || task.isCancelled) { [self cancelTask:task]; }
+        else {
+
+            [self.pendingTasks addObject:task];
+            [self startPendingTasks];
+        }
+    });
+}
+
+- (void)cancelTask:(PNSocketTransportTask *)task {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+
+        task.cancelled = YES;
+        if ([self.activeTasks containsObject:task]) { [task.connection interrupt]; }
+        else if (task.completionBlock) {
+
+            [self.pendingTasks removeObject:task];
+            dispatch_async(self.processingQueue, ^{
+
+                NSError *error = PNSocketError(NSURLErrorCancelled, 0, task.currentRequest.URL);
+                [self completeTask:task withData:nil response:nil error:error connection:nil];
+            });
+        }
+    });
+}
+
+- (void)startPendingTasks {
+
+    while (self.pendingTasks.count && (NSInteger)self.activeTasks.count < self.maximumConnections) {
+
+        PNSocketTransportTask *task = self.pendingTasks.firstObject;
+        [self.pendingTasks removeObjectAtIndex:0];
+        [self.activeTasks addObject:task];
+
+        PNSocketConnection *connection = nil;
+        NSString *endpoint = [self endpointForURL:task.currentRequest.URL];
+        for (PNSocketConnection *idleConnection in self.idleConnections) {
+
+            if ([idleConnection.endpoint isEqualToString:endpoint]) {
+
+                connection = idleConnection;
+                break;
+            }
+        }
+        if (connection) { [self.idleConnections removeObject:connection]; }
+
+        dispatch_async(self.processingQueue, ^{ [self processTask:task withConnection:connection]; });
+    }
+}
+
+- (void)processTask:(PNSocketTransportTask *)task withConnection:(PNSocketConnection *)connection {
+
+    NSURL *url = task.currentRequest.URL;
+    NSDate *startDate = [NSDate date];
+    NSData *requestData = [self dataForRequest:task.currentRequest];
+    NSHTTPURLResponse *response = nil;
+    NSData *data = nil;
+    NSError *error = nil;
+    BOOL keepAlive = NO;
+    BOOL reusedConnection = NO;
+
+    // Connection from pool may be already closed by server, so request will be repeated once with new
+    // connection.
+    for (NSUInteger attempt = 0; attempt < 2 && !response && !task.isCancelled; attempt++) {
+
+        error = nil;
+        reusedConnection = (connection != nil);
+        if (!connection) {
+
+            connection = [PNSocketConnection connectionToHost:url.host port:[self portForURL:url]
+                                                      timeout:self.requestTimeout error:&error];
+            if (!connection) { break; }
+        }
+
+        task.connection = connection;
+        if (task.isCancelled) { break; }
+        connection.bytesRead = 0;
+        if ([connection writeData:requestData forURL:url error:&error]) {
+
+            response = [connection readResponseForURL:url data:&data keepAlive:&keepAlive error:&error];
+        }
+
+        if (!response) {
+
+            [connection close];
+            task.connection = nil;
+            if (!reusedConnection || error.code == NSURLErrorTimedOut) { break; }
+            connection = nil;
+        }
+    }
+
+    if (task.isCancelled) {
+
+        response = nil;
+        data = nil;
+        keepAlive = NO;
+        error = PNSocketError(NSURLErrorCancelled, 0, url);
+    }
+
+    PNTransportMetricsBlock metricsBlock = self.metricsBlock;
+    if (metricsBlock) {
+
+        metricsBlock(task, @{@"start": startDate, @"end": [NSDate date], @"bytesSent": @(requestData.length),
+                             @"bytesReceived": @(connection.bytesRead), @"reusedConnection": @(reusedConnection)});
+    }
+
+    if (!keepAlive) { [connection close]; }
+    [self completeTask:task withData:data response:response error:error
+            connection:(keepAlive ? connection : nil)];
+}
+
+- (void)completeTask:(PNSocketTransportTask *)task withData:(NSData *)data response:(NSHTTPURLResponse *)response
+               error:(NSError *)error connection:(PNSocketConnection *)connection {
+
+    PNTransportTaskCompletionBlock block = task.completionBlock;
+    task.completionBlock = nil;
+    task.connection = nil;
+    task.response = response;
+    task.error = error;
+
+    dispatch_async(self.resourceAccessQueue, ^{
+
+        [self.activeTasks removeObject:task];
+        if (connection && !self.isInvalidated &&
+            (NSInteger)self.idleConnections.count < self.maximumConnections) {
+
+            [self.idleConnections addObject:connection];
+        }
+        else { [connection close]; }
+        [self startPendingTasks];
+    });
+
+    if (block) { block(data, response, error); }
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)dataForRequest:(NSURLRequest *)request {
+
+    NSURL *url = request.URL;
+    NSURLComponents *components = [NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:YES];
+    NSMutableString *target = [(components.percentEncodedPath.length ? components.percentEncodedPath : @"/") mutableCopy];
+    if (components.percentEncodedQuery.length) { [target appendFormat:@"?%@", components.percentEncodedQuery]; }
+
+    NSMutableDictionary *headers = [NSMutableDictionary dictionaryWithDictionary:self.HTTPAdditionalHeaders];
+    [headers addEntriesFromDictionary:request.allHTTPHeaderFields];
+    headers[@"Host"] = (url.port ? [NSString stringWithFormat:@"%@:%@", url.host, url.port] : url.host);
+    headers[@"Connection"] = @"keep-alive";
+    headers[@"Accept-Encoding"] = @"identity";
+    [headers removeObjectForKey:@"Content-Length"];
+    if (request.HTTPBody.length) { headers[@"Content-Length"] = @(request.HTTPBody.length).stringValue; }
+
+    NSMutableString *head = [NSMutableString stringWithFormat:@"%@ %@ HTTP/1.1\r\n",
+                             (request.HTTPMethod?: @"GET"), target];
+    [headers enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value, __unused BOOL *stop) {
+
+        [head appendFormat:@"%@: %@\r\n", field, value];
+    }];
+    [head appendString:@"\r\n"];
+
+    NSMutableData *data = [[head dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+    if (request.HTTPBody.length) { [data appendData:request.HTTPBody]; }
+
+    return data;
+}
+
+- (NSString *)endpointForURL:(NSURL *)url {
+
+    return [NSString stringWithFormat:@"%@:%@", url.host, @([self portForURL:url])];
+}
+
+- (NSInteger)portForURL:(NSURL *)url {
+
+    return (url.port ? url.port.integerValue : ([url.scheme isEqualToString:@"https"] ? 443 : 80));
+}
+
+#pragma mark -
+
+
+@end
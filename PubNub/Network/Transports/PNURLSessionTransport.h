@@ -0,0 +1,24 @@
+#import <Foundation/Foundation.h>
+#import "PNTransport.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Default \b PubNub network transport.
+ @discussion Transport use \a NSURLSession to send requests to \b PubNub network. Session configuration can
+             be customized using \a NSURLSessionConfiguration (PNConfiguration) category methods.
+ 
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNURLSessionTransport : NSObject <PNTransport>
+
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,585 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNURLSessionTransport.h"
+#import "NSURLSessionConfiguration+PNConfigurationPrivate.h"
+#import <libkern/OSAtomic.h>
+#import "PNLogMacro.h"
+
+
+#pragma mark Macro
+
+/**
+ @brief  Whether SDK against which transport is compiled provide \a NSURLSessionTaskMetrics or not.
+ 
+ @since 4.5.0
+ */
+#define PN_URL_SESSION_TASK_METRICS_AVAILABLE (__IPHONE_OS_VERSION_MAX_ALLOWED >= 100000 || \
+                                               __MAC_OS_X_VERSION_MAX_ALLOWED >= 101200 || \
+                                               __TV_OS_VERSION_MAX_ALLOWED >= 100000 || \
+                                               __WATCH_OS_VERSION_MAX_ALLOWED >= 30000)
+
+
+#pragma mark - CocoaLumberjack logging support
+
+/**
+ @brief  Cocoa Lumberjack logging level configuration for session based transport.
+ 
+ @since 4.5.0
+ */
+static DDLogLevel ddLogLevel;
+
+
+#pragma mark - Category interface declaration
+
+/**
+ @brief  Declare \a NSURLSessionTask conformance to \b PNTransportTask protocol (all required properties and 
+         methods already provided by \a NSURLSessionTask).
+ 
+ @since 4.5.0
+ */
+@interface NSURLSessionTask (PNTransportTask) <PNTransportTask>
+@end
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface PNURLSessionTransport () <NSURLSessionDataDelegate>
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on unique transport identifier (used as session identifier).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, copy) NSString *identifier;
+
+/**
+ @brief      Stores whether transport configured for long-poll request processing or not.
+ @discussion Long-poll requests doesn't use HTTP pipelining.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) BOOL forLongPollRequests;
+
+/**
+ @brief      Stores value which should be as timeout interval for request.
+ @discussion This property also used when session instance should be re-created.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSTimeInterval requestTimeout;
+
+/**
+ @brief      Stores value which should be as maximum simultaneous requests.
+ @discussion This property also used when session instance should be re-created.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) NSInteger maximumConnections;
+
+/**
+ @brief  Stores reference on session instance which is used to send network requests.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSURLSession *session;
+
+/**
+ @brief  Stores reference on queue which should be used by session to call callbacks and completion blocks.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSOperationQueue *delegateQueue;
+
+/**
+ @brief  Stores reference on block which should be called with task processing metrics.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, nullable, copy) PNTransportMetricsBlock metricsBlock;
+
+/**
+ @brief  Stores reference on spin-lock which is used to protect access to session instance which can be 
+         changed at any moment (invalidated instances can't be used and SDK should instantiate new instance).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) OSSpinLock lock;
+
+/**
+ @brief      Stores reference on map of streamed tasks to their processing context.
+ @discussion Context is dictionary which store: \c dataBlock, \c completion, \c data (not consumed response 
+             body chunks), \c start (task creation date) and \c firstByte (date when first response body 
+             chunk has been received).
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMapTable<NSURLSessionTask *, NSMutableDictionary *> *streamedTasks;
+
+/**
+ @brief      Stores reference on map of tasks to connection metrics collected by session.
+ @discussion Session report metrics before task completion, so they stored till task metrics will be 
+             reported.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, strong) NSMapTable<NSURLSessionTask *, NSDictionary *> *collectedMetrics;
+
+/**
+ @brief  Stores reference on spin-lock which is used to protect access to streamed tasks and collected 
+         metrics maps.
+ 
+ @since 4.5.0
+ */
+@property (nonatomic, assign) OSSpinLock streamedTasksLock;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize session based transport with predefined options.
+ 
+ @param identifier         Unique identifier which will be used for session configuration.
+ @param timeout            Maximum time which transport should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+ @param longPollEnabled    Whether transport will be used for long-poll requests or not.
+ 
+ @return Initialized and ready to use transport.
+ 
+ @since 4.5.0
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled;
+
+
+#pragma mark - Session constructor
+
+/**
+ @brief  Complete NSURLSession instantiation and configuration.
+ 
+ @param timeout            Maximum time which manager should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+ 
+ @since 4.5.0
+ */
+- (void)prepareSessionWithRequesrTimeout:(NSTimeInterval)timeout
+                      maximumConnections:(NSInteger)maximumConnections;
+
+/**
+ @brief  Construct base NSURL session configuration.
+ 
+ @param timeout            Maximum time which manager should wait for response on request.
+ @param maximumConnections Maximum simultaneously connections (requests) which can be opened.
+ 
+ @return Constructed and ready to use session configuration.
+ 
+ @since 4.5.0
+ */
+- (NSURLSessionConfiguration *)configurationWithRequestTimeout:(NSTimeInterval)timeout
+                                            maximumConnections:(NSInteger)maximumConnections;
+
+/**
+ @brief  Construct qaueue on which session will call delegate callbacks and completion blocks.
+ 
+ @param configuration Reference on session configuration instance which should be used to complete queue 
+                      configuration.
+ 
+ @return Initialized and ready to use operaiton queue.
+ 
+ @since 4.5.0
+ */
+- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration;
+
+/**
+ @brief  Construct NSURL session manager used to communicate with \b PubNub network.
+ 
+ @param configuration Reference on complete configuration which should be applied to NSURL session.
+ 
+ @return Constructed and ready to use NSURL session manager instance.
+ 
+ @since 4.5.0
+ */
+- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration;
+
+
+#pragma mark - Handlers
+
+/**
+ @brief  Retrieve processing context for streamed task.
+ 
+ @param task   Reference on task for which context should be retrieved.
+ @param remove Whether context should be removed from streamed tasks map or not.
+ 
+ @return Task processing context or \c nil in case if task has been created with completion handler.
+ 
+ @since 4.5.0
+ */
+- (nullable NSMutableDictionary *)contextForStreamedTask:(NSURLSessionTask *)task remove:(BOOL)remove;
+
+/**
+ @brief  Report task processing metrics (if metrics block has been set).
+ 
+ @param task      Reference on task for which metrics should be reported.
+ @param startDate Reference on date when task has been created.
+ 
+ @since 4.5.0
+ */
+- (void)reportMetricsForTask:(NSURLSessionTask *)task startedAt:(NSDate *)startDate;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Print out any session configuration instance customizations which has been done by developer.
+ 
+ @since 4.5.0
+ */
+- (void)printIfRequiredSessionCustomizationInformation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNURLSessionTransport
+
+
+#pragma mark - Logger
+
++ (DDLogLevel)ddLogLevel {
+    
+    return ddLogLevel;
+}
+
++ (void)ddSetLogLevel:(DDLogLevel)logLevel {
+    
+    ddLogLevel = logLevel;
+}
+
+
+#pragma mark - Information
+
+- (NSDictionary<NSString *, NSString *> *)HTTPAdditionalHeaders {
+    
+    OSSpinLockLock(&_lock);
+    NSDictionary *headers = self.session.configuration.HTTPAdditionalHeaders;
+    OSSpinLockUnlock(&_lock);
+    
+    return headers;
+}
+
+- (NSURLRequestCachePolicy)requestCachePolicy {
+    
+    OSSpinLockLock(&_lock);
+    NSURLRequestCachePolicy policy = self.session.configuration.requestCachePolicy;
+    OSSpinLockUnlock(&_lock);
+    
+    return policy;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)transportWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                     maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled {
+    
+    return [[self alloc] initWithIdentifier:identifier requestTimeout:timeout
+                         maximumConnections:maximumConnections longPoll:longPollEnabled];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _identifier = [identifier copy];
+        _forLongPollRequests = longPollEnabled;
+        _lock = OS_SPINLOCK_INIT;
+        _streamedTasksLock = OS_SPINLOCK_INIT;
+        _streamedTasks = [NSMapTable strongToStrongObjectsMapTable];
+        _collectedMetrics = [NSMapTable weakToStrongObjectsMapTable];
+        [self prepareSessionWithRequesrTimeout:timeout maximumConnections:maximumConnections];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Request processing
+
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             completion:(PNTransportTaskCompletionBlock)block {
+    
+    __block NSURLSessionDataTask *task = nil;
+    __weak __typeof(self) weakSelf = self;
+    NSDate *startDate = [NSDate date];
+    PNTransportTaskCompletionBlock handler = ^(NSData * _Nullable data, NSURLResponse * _Nullable response,
+                                               NSError * _Nullable error) {
+        
+        [weakSelf reportMetricsForTask:task startedAt:startDate];
+        block(data, response, error);
+    };
+    OSSpinLockLock(&_lock);
+    task = [self.session dataTaskWithRequest:request completionHandler:[handler copy]];
+    OSSpinLockUnlock(&_lock);
+    
+    return task;
+}
+
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request dataChunk:(PNTransportTaskDataBlock)dataBlock
+                             completion:(PNTransportTaskCompletionBlock)block {
+    
+    // Task created w/o completion handler, so session will pass response body chunks to delegate.
+    OSSpinLockLock(&_lock);
+    NSURLSessionDataTask *task = [self.session dataTaskWithRequest:request];
+    OSSpinLockUnlock(&_lock);
+    if (task) {
+        
+        NSMutableDictionary *context = [@{@"dataBlock": [dataBlock copy], @"completion": [block copy],
+                                          @"data": [NSMutableData new], @"start": [NSDate date]} mutableCopy];
+        OSSpinLockLock(&_streamedTasksLock);
+        [self.streamedTasks setObject:context forKey:task];
+        OSSpinLockUnlock(&_streamedTasksLock);
+    }
+    
+    return task;
+}
+
+- (void)cancelAllTasks {
+    
+    OSSpinLockLock(&_lock);
+    [self.session getTasksWithCompletionHandler:^(NSArray *dataTasks, NSArray *uploadTasks,
+                                                  NSArray *downloadTasks) {
+        
+        [dataTasks makeObjectsPerformSelector:@selector(cancel)];
+        [uploadTasks makeObjectsPerformSelector:@selector(cancel)];
+        [downloadTasks makeObjectsPerformSelector:@selector(cancel)];
+        OSSpinLockUnlock(&self->_lock);
+    }];
+}
+
+- (void)invalidate {
+    
+    OSSpinLockLock(&_lock);
+    [_session invalidateAndCancel];
+    _session = nil;
+    OSSpinLockUnlock(&self->_lock);
+}
+
+
+#pragma mark - Session constructor
+
+- (void)prepareSessionWithRequesrTimeout:(NSTimeInterval)timeout
+                      maximumConnections:(NSInteger)maximumConnections {
+    
+    _requestTimeout = timeout;
+    _maximumConnections = maximumConnections;
+    NSURLSessionConfiguration *config = [self configurationWithRequestTimeout:timeout
+                                                           maximumConnections:maximumConnections];
+    _delegateQueue = [self operationQueueWithConfiguration:config];
+    _session = [self sessionWithConfiguration:config];
+    [self printIfRequiredSessionCustomizationInformation];
+}
+
+- (NSURLSessionConfiguration *)configurationWithRequestTimeout:(NSTimeInterval)timeout
+                                            maximumConnections:(NSInteger)maximumConnections {
+    
+    // Prepare base configuration with predefined timeout values and maximum connections
+    // to same host (basically how many requests can be handled at once).
+    NSURLSessionConfiguration *configuration = nil;
+    configuration = [NSURLSessionConfiguration pn_ephemeralSessionConfigurationWithIdentifier:self.identifier];
+    configuration.HTTPShouldUsePipelining = !self.forLongPollRequests;
+    configuration.timeoutIntervalForRequest = timeout;
+    configuration.HTTPMaximumConnectionsPerHost = maximumConnections;
+    
+    return configuration;
+}
+
+- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    NSOperationQueue *queue = [NSOperationQueue new];
+    queue.maxConcurrentOperationCount = configuration.HTTPMaximumConnectionsPerHost;
+    
+    return queue;
+}
+
+- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    // Construct sessions to process requests which should be sent to PubNub network.
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration delegate:self
+                                                     delegateQueue:_delegateQueue];
+    
+    return session;
+}
+
+
+#pragma mark - Handlers
+
+-(void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)error {
+    
+    if (error) {
+        
+        OSSpinLockLock(&_lock);
+        // Replace invalidated session with new one which can be used for next requests.
+        [self prepareSessionWithRequesrTimeout:self.requestTimeout
+                            maximumConnections:self.maximumConnections];
+        OSSpinLockUnlock(&_lock);
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+    
+    NSMutableDictionary *context = [self contextForStreamedTask:dataTask remove:NO];
+    if (context) {
+        
+        // Session call delegate for single task serially, so context can be modified w/o lock.
+        if (!context[@"firstByte"]) { context[@"firstByte"] = [NSDate date]; }
+        PNTransportTaskDataBlock dataBlock = context[@"dataBlock"];
+        if (!dataBlock(dataTask, data)) { [(NSMutableData *)context[@"data"] appendData:data]; }
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task
+didCompleteWithError:(NSError *)error {
+    
+    NSMutableDictionary *context = [self contextForStreamedTask:task remove:YES];
+    if (context) {
+        
+        if (context[@"firstByte"]) {
+            
+            OSSpinLockLock(&_streamedTasksLock);
+            NSMutableDictionary *metrics = [([self.collectedMetrics objectForKey:task]?: @{}) mutableCopy];
+            if (!metrics[@"firstByte"]) { metrics[@"firstByte"] = context[@"firstByte"]; }
+            [self.collectedMetrics setObject:metrics forKey:task];
+            OSSpinLockUnlock(&_streamedTasksLock);
+        }
+        [self reportMetricsForTask:task startedAt:context[@"start"]];
+        NSData *data = context[@"data"];
+        PNTransportTaskCompletionBlock block = context[@"completion"];
+        block((data.length ? data : nil), task.response, error);
+    }
+}
+
+#if PN_URL_SESSION_TASK_METRICS_AVAILABLE
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)taskMetrics {
+    
+    // Only last transaction (after redirects and retries) describe connection which has been used to get 
+    // response.
+    NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+    if (transaction) {
+        
+        NSMutableDictionary *metrics = [NSMutableDictionary new];
+        if (transaction.responseStartDate) { metrics[@"firstByte"] = transaction.responseStartDate; }
+        if (transaction.domainLookupStartDate && transaction.domainLookupEndDate) {
+            
+            metrics[@"domainLookupDuration"] = @([transaction.domainLookupEndDate
+                                                  timeIntervalSinceDate:transaction.domainLookupStartDate]);
+        }
+        if (transaction.connectStartDate && transaction.connectEndDate) {
+            
+            metrics[@"connectDuration"] = @([transaction.connectEndDate
+                                             timeIntervalSinceDate:transaction.connectStartDate]);
+        }
+        if (transaction.secureConnectionStartDate && transaction.secureConnectionEndDate) {
+            
+            metrics[@"secureConnectionDuration"] = @([transaction.secureConnectionEndDate
+                                                      timeIntervalSinceDate:transaction.secureConnectionStartDate]);
+        }
+        metrics[@"reusedConnection"] = @(transaction.isReusedConnection);
+        
+        OSSpinLockLock(&_streamedTasksLock);
+        [self.collectedMetrics setObject:metrics forKey:task];
+        OSSpinLockUnlock(&_streamedTasksLock);
+    }
+}
+#endif // PN_URL_SESSION_TASK_METRICS_AVAILABLE
+
+- (NSMutableDictionary *)contextForStreamedTask:(NSURLSessionTask *)task remove:(BOOL)remove {
+    
+    OSSpinLockLock(&_streamedTasksLock);
+    NSMutableDictionary *context = [self.streamedTasks objectForKey:task];
+    if (context && remove) { [self.streamedTasks removeObjectForKey:task]; }
+    OSSpinLockUnlock(&_streamedTasksLock);
+    
+    return context;
+}
+
+- (void)reportMetricsForTask:(NSURLSessionTask *)task startedAt:(NSDate *)startDate {
+    
+    OSSpinLockLock(&_streamedTasksLock);
+    NSDictionary *collectedMetrics = [self.collectedMetrics objectForKey:task];
+    if (collectedMetrics) { [self.collectedMetrics removeObjectForKey:task]; }
+    OSSpinLockUnlock(&_streamedTasksLock);
+    
+    PNTransportMetricsBlock metricsBlock = self.metricsBlock;
+    if (metricsBlock) {
+        
+        NSMutableDictionary *metrics = [(collectedMetrics?: @{}) mutableCopy];
+        [metrics addEntriesFromDictionary:@{@"start": startDate, @"end": [NSDate date],
+                                            @"bytesSent": @(task.countOfBytesSent),
+                                            @"bytesReceived": @(task.countOfBytesReceived)}];
+        metricsBlock(task, metrics);
+    }
+}
+
+
+#pragma mark - Misc
+
+- (void)printIfRequiredSessionCustomizationInformation {
+    
+    if ([NSURLSessionConfiguration pn_HTTPAdditionalHeaders].count) {
+        
+        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Custom HTTP headers is set by user: "
+                        "%@", [NSURLSessionConfiguration pn_HTTPAdditionalHeaders]);
+    }
+    
+    if ([NSURLSessionConfiguration pn_networkServiceType] != NSURLNetworkServiceTypeDefault) {
+        
+        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Custom network service type is set by "
+                        "user: %@", @([NSURLSessionConfiguration pn_networkServiceType]));
+    }
+    
+    if (![NSURLSessionConfiguration pn_allowsCellularAccess]) {
+        
+        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> User limited access to cellular data "
+                        "and only WiFi connection can be used.");
+    }
+    
+    if ([NSURLSessionConfiguration pn_protocolClasses].count) {
+        
+        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Extra requests handling protocols "
+                        "defined by user: %@", [NSURLSessionConfiguration pn_protocolClasses]);
+    }
+    
+    if ([NSURLSessionConfiguration pn_connectionProxyDictionary].count) {
+        
+        DDLogClientInfo([[self class] ddLogLevel], @"<PubNub::Network> Connection proxy has been set by user:"
+                        " %@", [NSURLSessionConfiguration pn_connectionProxyDictionary]);
+    }
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Category implementation
+
+@implementation NSURLSessionTask (PNTransportTask)
+@end
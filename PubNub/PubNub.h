@@ -3,6 +3,7 @@
 
 // Protocols
 #import "PNObjectEventListener.h"
+#import "PNTransport.h"
 
 // Categories
 #import "NSURLSessionConfiguration+PNConfiguration.h"
@@ -19,7 +20,10 @@
 #import "PNPresenceWhereNowResult.h"
 #import "PNAcknowledgmentStatus.h"
 #import "PNChannelGroupsResult.h"
+#import "PNRequestMetricsHistogram.h"
 #import "PNClientInformation.h"
+#import "PNRequestMetrics.h"
+#import "PNMetrics.h"
 #import "PNSubscriberResults.h"
 #import "PNSubscribeStatus.h"
 #import "PNPublishStatus.h"
@@ -0,0 +1,57 @@
+#import <XCTest/XCTest.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Base class for \b PubNub client hot paths micro-benchmarks.
+ @discussion Each benchmark warm up measured code, take several samples and use median time per iteration as
+             result. Result compared with value stored in \c PNBenchmarkBaseline.json and behaviour depends
+             from mode which is passed through \c PN_BENCHMARK_MODE environment variable:
+             - \c report (default) - results and difference with baseline printed to the log;
+             - \c compare - benchmark fails if median time exceed baseline value by more than threshold 
+               (benchmark w/o recorded baseline value skipped with message in the log);
+             - \c record - results written into \c PN_BENCHMARK_OUTPUT file (or temporary directory) in
+               baseline format, so it can be used to replace stored baseline.
+             Threshold taken from baseline file and can be overridden with \c PN_BENCHMARK_THRESHOLD
+             environment variable (\c 0.15 means 15% slower than baseline).
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNBenchmarkTestCase : XCTestCase
+
+
+///------------------------------------------------
+/// @name Measurement
+///------------------------------------------------
+
+/**
+ @brief  Measure average execution time of passed \c block.
+
+ @param name       Unique benchmark name which is used to find baseline value.
+ @param iterations How many times \c block should be called during single sample.
+ @param block      Reference on block which execution time should be measured.
+
+ @since 4.5.0
+ */
+- (void)measureBenchmark:(NSString *)name iterations:(NSUInteger)iterations usingBlock:(dispatch_block_t)block;
+
+/**
+ @brief      Compare measured value with baseline and record it (depending from benchmark mode).
+ @discussion Can be used by benchmarks which measure value by their own (for example latency percentiles).
+
+ @param name  Unique benchmark name which is used to find baseline value.
+ @param value Measured time (in seconds).
+
+ @since 4.5.0
+ */
+- (void)reportBenchmark:(NSString *)name value:(NSTimeInterval)value;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,210 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNBenchmarkTestCase.h"
+#import <mach/mach_time.h>
+
+
+#pragma mark Static
+
+/**
+ @brief  Number of samples which should be taken for each benchmark.
+ */
+static NSUInteger const kPNBenchmarkSamplesCount = 7;
+
+/**
+ @brief  Default allowed slowdown which is used if baseline and environment doesn't specify it.
+ */
+static double const kPNBenchmarkDefaultThreshold = 0.15f;
+
+
+#pragma mark - Private interface declaration
+
+@interface PNBenchmarkTestCase ()
+
+
+#pragma mark - Baseline
+
+/**
+ @brief  Retrieve content of baseline file which is bundled with benchmarks.
+
+ @return Dictionary with \c threshold and \c benchmarks (name / median time) keys.
+ */
++ (NSDictionary *)baseline;
+
+/**
+ @brief  Retrieve shared storage for results which has been gathered during current run.
+
+ @return Mutable dictionary with benchmark name / median time pairs.
+ */
++ (NSMutableDictionary<NSString *, NSNumber *> *)results;
+
+/**
+ @brief  Store results gathered during current run into file which is specified by \c PN_BENCHMARK_OUTPUT.
+ */
++ (void)writeResults;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Convert \c mach_absolute_time() ticks to seconds.
+
+ @param ticks Number of ticks which should be converted.
+
+ @return Time interval in seconds.
+ */
++ (NSTimeInterval)secondsFromTicks:(uint64_t)ticks;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNBenchmarkTestCase
+
+
+#pragma mark - Baseline
+
++ (NSDictionary *)baseline {
+
+    static NSDictionary *_baseline;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+
+        NSBundle *bundle = [NSBundle bundleForClass:[PNBenchmarkTestCase class]];
+        NSData *data = [NSData dataWithContentsOfFile:[bundle pathForResource:@"PNBenchmarkBaseline"
+                                                                       ofType:@"json"]];
+        _baseline = (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil);
+        if (![_baseline isKindOfClass:[NSDictionary class]]) { _baseline = @{}; }
+    });
+
+    return _baseline;
+}
+
++ (NSMutableDictionary<NSString *, NSNumber *> *)results {
+
+    static NSMutableDictionary<NSString *, NSNumber *> *_results;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+
+        _results = [NSMutableDictionary new];
+    });
+
+    return _results;
+}
+
++ (void)writeResults {
+
+    NSString *path = [NSProcessInfo processInfo].environment[@"PN_BENCHMARK_OUTPUT"];
+    if (!path.length) {
+
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"PNBenchmarkBaseline.json"];
+    }
+    NSMutableDictionary *baseline = [[self baseline] mutableCopy];
+    NSMutableDictionary *benchmarks = [(baseline[@"benchmarks"]?: @{}) mutableCopy];
+    [benchmarks addEntriesFromDictionary:[self results]];
+    baseline[@"benchmarks"] = benchmarks;
+    if (!baseline[@"threshold"]) { baseline[@"threshold"] = @(kPNBenchmarkDefaultThreshold); }
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:baseline options:NSJSONWritingPrettyPrinted
+                                                     error:nil];
+    [data writeToFile:path atomically:YES];
+    NSLog(@"<PubNub::Benchmark> Results stored at: %@", path);
+}
+
+
+#pragma mark - Measurement
+
+- (void)measureBenchmark:(NSString *)name iterations:(NSUInteger)iterations usingBlock:(dispatch_block_t)block {
+
+    iterations = MAX(iterations, (NSUInteger)1);
+    for (NSUInteger warmUpIdx = 0; warmUpIdx < MAX(iterations / 10, (NSUInteger)1); warmUpIdx++) {
+
+        @autoreleasepool { block(); }
+    }
+
+    NSTimeInterval samples[kPNBenchmarkSamplesCount];
+    for (NSUInteger sampleIdx = 0; sampleIdx < kPNBenchmarkSamplesCount; sampleIdx++) {
+
+        uint64_t start = mach_absolute_time();
+        for (NSUInteger iterationIdx = 0; iterationIdx < iterations; iterationIdx++) {
+
+            @autoreleasepool { block(); }
+        }
+        samples[sampleIdx] = ([[self class] secondsFromTicks:(mach_absolute_time() - start)] / iterations);
+    }
+
+    // Sort samples to get median value which is less sensitive to scheduler noise than average.
+    for (NSUInteger sampleIdx = 1; sampleIdx < kPNBenchmarkSamplesCount; sampleIdx++) {
+
+        NSTimeInterval sample = samples[sampleIdx];
+        NSInteger targetIdx = (NSInteger)sampleIdx - 1;
+        for (; targetIdx >= 0 && samples[targetIdx] > sample; targetIdx--) {
+
+            samples[targetIdx + 1] = samples[targetIdx];
+        }
+        samples[targetIdx + 1] = sample;
+    }
+    [self reportBenchmark:name value:samples[kPNBenchmarkSamplesCount / 2]];
+}
+
+- (void)reportBenchmark:(NSString *)name value:(NSTimeInterval)value {
+
+    NSDictionary<NSString *, NSString *> *environment = [NSProcessInfo processInfo].environment;
+    NSString *mode = (environment[@"PN_BENCHMARK_MODE"]?: @"report");
+    NSDictionary *baseline = [[self class] baseline];
+    NSNumber *baselineValue = baseline[@"benchmarks"][name];
+    double threshold = ((NSNumber *)baseline[@"threshold"]?: @(kPNBenchmarkDefaultThreshold)).doubleValue;
+    if (environment[@"PN_BENCHMARK_THRESHOLD"]) { threshold = environment[@"PN_BENCHMARK_THRESHOLD"].doubleValue; }
+
+    if ([baselineValue isKindOfClass:[NSNumber class]] && baselineValue.doubleValue > 0.f) {
+
+        double change = ((value - baselineValue.doubleValue) / baselineValue.doubleValue);
+        NSLog(@"<PubNub::Benchmark> %@: %.3f us (baseline: %.3f us, %+.1f%%)", name, (value * 1000000.f),
+              (baselineValue.doubleValue * 1000000.f), (change * 100.f));
+        if ([mode isEqualToString:@"compare"]) {
+
+            XCTAssertLessThanOrEqual(change, threshold, @"'%@' regressed by %.1f%% (allowed: %.1f%%)", name,
+                                     (change * 100.f), (threshold * 100.f));
+        }
+    }
+    else {
+
+        // Benchmark w/o recorded value can't be compared, so comparison skipped (it isn't a regression).
+        NSLog(@"<PubNub::Benchmark> %@: %.3f us (no baseline%@)", name, (value * 1000000.f),
+              ([mode isEqualToString:@"compare"] ? @", comparison skipped. Record baseline using 'record' mode"
+                                                 : @""));
+    }
+
+    if ([mode isEqualToString:@"record"]) {
+
+        [[self class] results][name] = @(value);
+        [[self class] writeResults];
+    }
+}
+
+
+#pragma mark - Misc
+
++ (NSTimeInterval)secondsFromTicks:(uint64_t)ticks {
+
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+
+        mach_timebase_info(&timebase);
+    });
+
+    return ((ticks * timebase.numer / timebase.denom) / 1000000000.f);
+}
+
+#pragma mark -
+
+
+@end
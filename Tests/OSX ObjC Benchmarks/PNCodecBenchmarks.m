@@ -0,0 +1,120 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNBenchmarkTestCase.h"
+#import "PNGZIP.h"
+#import "PNJSON.h"
+#import "PNAES.h"
+
+
+#pragma mark Private interface declaration
+
+/**
+ @brief  Encryption and compression helpers benchmarks.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNCodecBenchmarks : PNBenchmarkTestCase
+
+
+#pragma mark - Payloads
+
+/**
+ @brief  Construct JSON message data of specified size.
+
+ @param length Approximate size of message data in bytes.
+
+ @return UTF-8 encoded JSON string data.
+ */
+- (NSData *)messageDataWithLength:(NSUInteger)length;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNCodecBenchmarks
+
+
+#pragma mark - AES
+
+- (void)testAESEncrypt1KB {
+
+    NSData *data = [self messageDataWithLength:1024];
+    [self measureBenchmark:@"aes-encrypt-1kb" iterations:1000 usingBlock:^{
+
+        [PNAES encrypt:data withKey:@"enigma"];
+    }];
+}
+
+- (void)testAESDecrypt1KB {
+
+    NSString *encryptedMessage = [PNAES encrypt:[self messageDataWithLength:1024] withKey:@"enigma"];
+    XCTAssertNotNil([PNAES decrypt:encryptedMessage withKey:@"enigma"]);
+    [self measureBenchmark:@"aes-decrypt-1kb" iterations:1000 usingBlock:^{
+
+        [PNAES decrypt:encryptedMessage withKey:@"enigma"];
+    }];
+}
+
+
+#pragma mark - GZIP
+
+- (void)testGZIPDeflate1KB {
+
+    NSData *data = [self messageDataWithLength:1024];
+    [self measureBenchmark:@"gzip-deflate-1kb" iterations:1000 usingBlock:^{
+
+        [PNGZIP GZIPDeflatedData:data];
+    }];
+}
+
+- (void)testGZIPDeflate32KB {
+
+    NSData *data = [self messageDataWithLength:(32 * 1024)];
+    [self measureBenchmark:@"gzip-deflate-32kb" iterations:100 usingBlock:^{
+
+        [PNGZIP GZIPDeflatedData:data];
+    }];
+}
+
+- (void)testGZIPInflate32KB {
+
+    NSData *data = [self messageDataWithLength:(32 * 1024)];
+    NSData *compressedData = [PNGZIP GZIPDeflatedData:data];
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressedData], data);
+    [self measureBenchmark:@"gzip-inflate-32kb" iterations:100 usingBlock:^{
+
+        [PNGZIP GZIPInflatedData:compressedData];
+    }];
+}
+
+
+#pragma mark - Payloads
+
+- (NSData *)messageDataWithLength:(NSUInteger)length {
+
+    NSMutableArray *entries = [NSMutableArray new];
+    NSUInteger approximateLength = 0;
+    while (approximateLength < length) {
+
+        NSDictionary *entry = @{@"index": @(entries.count), @"text": @"Hello from PubNub benchmarks",
+                                @"coordinates": @[@(37.7749f + entries.count), @(-122.4194f)]};
+        [entries addObject:entry];
+        approximateLength += 80;
+    }
+
+    return [[PNJSON JSONStringFrom:entries withError:nil] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark -
+
+
+@end
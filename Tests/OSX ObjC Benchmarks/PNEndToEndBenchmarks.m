@@ -0,0 +1,330 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNBenchmarkTestCase.h"
+#import <PubNub/PubNub.h>
+#import "PNMockOrigin.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Key which is used to encrypt messages in encrypted benchmarks.
+ */
+static NSString * const kPNBenchmarkCipherKey = @"enigma";
+
+/**
+ @brief  Number of messages which is published by client during publish-to-listener benchmarks.
+ */
+static NSUInteger const kPNBenchmarkPublishedMessagesCount = 1000;
+
+/**
+ @brief  Rate with which client publish messages during publish-to-listener benchmarks.
+ */
+static NSUInteger const kPNBenchmarkPublishRate = 200;
+
+/**
+ @brief  For how long mock should generate synthetic traffic.
+ */
+static NSTimeInterval const kPNBenchmarkTrafficDuration = 5.f;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+/**
+ @brief      End-to-end benchmarks for whole client stack.
+ @discussion Client configured to use loopback \c PNMockOrigin and measure time between moment when message
+             has been published (or generated by mock) and moment when it has been delivered to listener.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNEndToEndBenchmarks : PNBenchmarkTestCase <PNObjectEventListener>
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on running mock service.
+ */
+@property (nonatomic, strong) PNMockOrigin *origin;
+
+/**
+ @brief  Stores reference on client which is used for benchmark.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on queue on which client deliver events (accessed only from it).
+ */
+@property (nonatomic, strong) dispatch_queue_t callbackQueue;
+
+/**
+ @brief  Stores reference on list of message delivery latencies (in seconds).
+ */
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *latencies;
+
+/**
+ @brief  Stores number of presence events which has been delivered to listener.
+ */
+@property (nonatomic, assign) NSUInteger presenceEventsCount;
+
+/**
+ @brief  Stores date when last message has been delivered to listener.
+ */
+@property (nonatomic, assign) CFAbsoluteTime lastMessageTime;
+
+/**
+ @brief  Stores number of messages after which \c receiveExpectation should be fulfilled.
+ */
+@property (nonatomic, assign) NSUInteger expectedMessagesCount;
+
+/**
+ @brief  Stores reference on expectation which is fulfilled when client connect.
+ */
+@property (nonatomic, nullable, strong) XCTestExpectation *connectExpectation;
+
+/**
+ @brief  Stores reference on expectation which is fulfilled when all expected messages delivered.
+ */
+@property (nonatomic, nullable, strong) XCTestExpectation *receiveExpectation;
+
+
+#pragma mark - Benchmarks
+
+/**
+ @brief  Publish messages with fixed rate and measure time which is required to deliver them to listener.
+
+ @param cipherKey Key which should be used by client to encrypt / decrypt messages.
+ @param name      Prefix for reported benchmark names.
+ */
+- (void)measurePublishToListenerWithCipherKey:(nullable NSString *)cipherKey name:(NSString *)name;
+
+/**
+ @brief  Subscribe to channels with synthetic traffic and measure throughput and delivery latency.
+
+ @param cipherKey Key which should be used by mock to encrypt messages (and by client to decrypt them).
+ @param name      Prefix for reported benchmark names.
+ */
+- (void)measureSyntheticTrafficWithCipherKey:(nullable NSString *)cipherKey name:(NSString *)name;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Create client which use mock and wait for subscription completion.
+
+ @param cipherKey Key which should be used by client to encrypt / decrypt messages.
+ @param channels  List of channels to which client should subscribe.
+ */
+- (void)connectWithCipherKey:(nullable NSString *)cipherKey toChannels:(NSArray<NSString *> *)channels;
+
+/**
+ @brief  Log throughput and report latency percentiles.
+
+ @param name      Prefix for reported benchmark names.
+ @param startTime Date when first message has been published or generated.
+ */
+- (void)reportLatenciesWithName:(NSString *)name sinceTime:(CFAbsoluteTime)startTime;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation PNEndToEndBenchmarks
+
+
+#pragma mark - Configuration
+
+- (void)setUp {
+
+    [super setUp];
+
+    self.origin = [PNMockOrigin origin];
+    self.callbackQueue = dispatch_queue_create("com.pubnub.benchmarks.callbacks", DISPATCH_QUEUE_SERIAL);
+    self.latencies = [NSMutableArray new];
+    XCTAssertNotNil(self.origin);
+}
+
+- (void)tearDown {
+
+    [self.client removeListener:self];
+    [self.client unsubscribeFromAll];
+    self.client = nil;
+    [self.origin stop];
+    self.origin = nil;
+
+    [super tearDown];
+}
+
+
+#pragma mark - Publish to listener
+
+- (void)testPublishToListenerLatency {
+
+    [self measurePublishToListenerWithCipherKey:nil name:@"e2e-publish"];
+}
+
+- (void)testEncryptedPublishToListenerLatency {
+
+    [self measurePublishToListenerWithCipherKey:kPNBenchmarkCipherKey name:@"e2e-publish-encrypted"];
+}
+
+
+#pragma mark - Synthetic traffic
+
+- (void)testSyntheticTrafficThroughput {
+
+    [self measureSyntheticTrafficWithCipherKey:nil name:@"e2e-traffic"];
+}
+
+- (void)testEncryptedSyntheticTrafficThroughput {
+
+    [self measureSyntheticTrafficWithCipherKey:kPNBenchmarkCipherKey name:@"e2e-traffic-encrypted"];
+}
+
+
+#pragma mark - Benchmarks
+
+- (void)measurePublishToListenerWithCipherKey:(NSString *)cipherKey name:(NSString *)name {
+
+    NSString *channel = @"e2e-latency";
+    [self connectWithCipherKey:cipherKey toChannels:@[channel]];
+
+    self.expectedMessagesCount = kPNBenchmarkPublishedMessagesCount;
+    self.receiveExpectation = [self expectationWithDescription:@"Messages delivery"];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    PubNub *client = self.client;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+
+        for (NSUInteger messageIdx = 0; messageIdx < kPNBenchmarkPublishedMessagesCount; messageIdx++) {
+
+            [client publish:@{@"sent": @(CFAbsoluteTimeGetCurrent()), @"seq": @(messageIdx)} toChannel:channel
+             withCompletion:nil];
+            usleep((useconds_t)(1000000 / kPNBenchmarkPublishRate));
+        }
+    });
+    [self waitForExpectationsWithTimeout:(kPNBenchmarkPublishedMessagesCount / kPNBenchmarkPublishRate + 30.f)
+                                 handler:nil];
+    [self reportLatenciesWithName:name sinceTime:startTime];
+}
+
+- (void)measureSyntheticTrafficWithCipherKey:(NSString *)cipherKey name:(NSString *)name {
+
+    NSMutableArray<NSString *> *channels = [NSMutableArray new];
+    for (NSUInteger channelIdx = 0; channelIdx < 10; channelIdx++) {
+
+        [channels addObject:[NSString stringWithFormat:@"e2e-traffic-%@", @(channelIdx)]];
+    }
+    self.origin.trafficChannels = channels;
+    self.origin.trafficMessagesPerSecond = 2000;
+    self.origin.trafficPayloadSize = 256;
+    self.origin.trafficCipherKey = cipherKey;
+    self.origin.trafficPresenceEventsPerSecond = 20;
+    [self connectWithCipherKey:cipherKey toChannels:channels];
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [self.origin startTraffic];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:kPNBenchmarkTrafficDuration]];
+    [self.origin stopTraffic];
+
+    // Wait for client to catch up with generated traffic.
+    NSUInteger generatedMessagesCount = self.origin.publishedMessagesCount;
+    __block NSUInteger receivedMessagesCount = 0;
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.f];
+    while (receivedMessagesCount < generatedMessagesCount && [timeoutDate timeIntervalSinceNow] > 0.f) {
+
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1f]];
+        dispatch_sync(self.callbackQueue, ^{ receivedMessagesCount = self.latencies.count; });
+    }
+    XCTAssertEqual(receivedMessagesCount, generatedMessagesCount);
+    [self reportLatenciesWithName:name sinceTime:startTime];
+}
+
+
+#pragma mark - Listener
+
+- (void)client:(PubNub *)client didReceiveMessage:(PNMessageResult *)message {
+
+    NSDictionary *payload = message.data.message;
+    if (![payload isKindOfClass:[NSDictionary class]] || !payload[@"sent"]) { return; }
+
+    self.lastMessageTime = CFAbsoluteTimeGetCurrent();
+    [self.latencies addObject:@(self.lastMessageTime - ((NSNumber *)payload[@"sent"]).doubleValue)];
+    if (self.receiveExpectation && self.latencies.count == self.expectedMessagesCount) {
+
+        [self.receiveExpectation fulfill];
+        self.receiveExpectation = nil;
+    }
+}
+
+- (void)client:(PubNub *)client didReceivePresenceEvent:(PNPresenceEventResult *)event {
+
+    self.presenceEventsCount++;
+}
+
+- (void)client:(PubNub *)client didReceiveStatus:(PNStatus *)status {
+
+    if (status.category == PNConnectedCategory && self.connectExpectation) {
+
+        [self.connectExpectation fulfill];
+        self.connectExpectation = nil;
+    }
+}
+
+
+#pragma mark - Misc
+
+- (void)connectWithCipherKey:(NSString *)cipherKey toChannels:(NSArray<NSString *> *)channels {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"mock" subscribeKey:@"mock"];
+    configuration.origin = self.origin.origin;
+    configuration.TLSEnabled = NO;
+    configuration.cipherKey = cipherKey;
+    self.client = [PubNub clientWithConfiguration:configuration callbackQueue:self.callbackQueue];
+    [self.client addListener:self];
+
+    self.connectExpectation = [self expectationWithDescription:@"Subscribe"];
+    [self.client subscribeToChannels:channels withPresence:YES];
+    [self waitForExpectationsWithTimeout:10.f handler:nil];
+}
+
+- (void)reportLatenciesWithName:(NSString *)name sinceTime:(CFAbsoluteTime)startTime {
+
+    __block NSArray<NSNumber *> *latencies = nil;
+    __block CFAbsoluteTime lastMessageTime = 0.f;
+    __block NSUInteger presenceEventsCount = 0;
+    dispatch_sync(self.callbackQueue, ^{
+
+        latencies = [self.latencies sortedArrayUsingSelector:@selector(compare:)];
+        lastMessageTime = self.lastMessageTime;
+        presenceEventsCount = self.presenceEventsCount;
+    });
+    if (!latencies.count) { return; }
+
+    NSLog(@"<PubNub::Benchmark> %@: %@ messages (%.1f msg/s), %@ presence events", name, @(latencies.count),
+          (latencies.count / MAX(lastMessageTime - startTime, 0.001f)), @(presenceEventsCount));
+    for (NSNumber *percentile in @[@50, @90, @99]) {
+
+        NSUInteger latencyIdx = MIN((NSUInteger)(percentile.doubleValue / 100.f * latencies.count),
+                                    (latencies.count - 1));
+        [self reportBenchmark:[NSString stringWithFormat:@"%@-latency-p%@", name, percentile]
+                        value:latencies[latencyIdx].doubleValue];
+    }
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,128 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Loopback \b PubNub service mock.
+ @discussion Minimal HTTP/1.1 server which is bound to \c 127.0.0.1 and can be used by client with
+             \c PNConfiguration.origin set to \c origin value (\c TLSEnabled should be set to \c NO).
+             Server implement:
+             - subscribe long-poll with real time tokens and regions;
+             - publish (message in path);
+             - history (with \c count, \c reverse, \c start, \c end and \c include_token support);
+             - channel and global here now, heartbeat and leave (with presence events);
+             - time.
+             Mock also can generate synthetic traffic: messages with \c trafficPayloadSize payload for
+             \c trafficChannels with \c trafficMessagesPerSecond rate (encrypted if \c trafficCipherKey is
+             set) and presence churn (join / leave of fake users) with \c trafficPresenceEventsPerSecond rate.
+             Synthetic message is dictionary with: \c sent - date when message has been generated (as
+             \c timeIntervalSinceReferenceDate), \c seq - message sequence number and \c data - filler string.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNMockOrigin : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on origin (host and port) which should be used by client to reach mock.
+ */
+@property (nonatomic, readonly, copy) NSString *origin;
+
+/**
+ @brief      Stores maximum time which subscribe long-poll request will wait for new events.
+ @discussion \b Default: 10 seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval subscribeTimeout;
+
+/**
+ @brief      Stores region which is reported with time tokens.
+ @discussion \b Default: 4.
+ */
+@property (nonatomic, assign) int32_t region;
+
+/**
+ @brief      Stores maximum number of events which can be returned with single subscribe response.
+ @discussion \b Default: 100.
+ */
+@property (nonatomic, assign) NSUInteger maximumEventsPerResponse;
+
+/**
+ @brief  Stores number of messages which has been published by clients and traffic generator.
+ */
+@property (nonatomic, readonly, assign) NSUInteger publishedMessagesCount;
+
+
+///------------------------------------------------
+/// @name Synthetic traffic
+///------------------------------------------------
+
+/**
+ @brief  Stores list of channels for which synthetic messages should be generated.
+ */
+@property (nonatomic, copy) NSArray<NSString *> *trafficChannels;
+
+/**
+ @brief  Stores how many messages per second should be generated (across all \c trafficChannels).
+ */
+@property (nonatomic, assign) NSUInteger trafficMessagesPerSecond;
+
+/**
+ @brief  Stores length of filler string which is added to each synthetic message.
+ */
+@property (nonatomic, assign) NSUInteger trafficPayloadSize;
+
+/**
+ @brief  Stores reference on key which should be used to encrypt synthetic messages (if set).
+ */
+@property (nonatomic, nullable, copy) NSString *trafficCipherKey;
+
+/**
+ @brief  Stores how many presence events per second should be generated (across all \c trafficChannels).
+ */
+@property (nonatomic, assign) NSUInteger trafficPresenceEventsPerSecond;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and start mock on random loopback port.
+
+ @return Running mock or \c nil in case if server socket can't be created.
+ */
++ (nullable instancetype)origin;
+
+/**
+ @brief  Stop server and close all connections.
+ */
+- (void)stop;
+
+
+///------------------------------------------------
+/// @name Synthetic traffic
+///------------------------------------------------
+
+/**
+ @brief  Start synthetic messages and presence events generation with current traffic configuration.
+ */
+- (void)startTraffic;
+
+/**
+ @brief  Stop synthetic messages and presence events generation.
+ */
+- (void)stopTraffic;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
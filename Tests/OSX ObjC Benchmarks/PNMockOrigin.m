@@ -0,0 +1,1016 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNMockOrigin.h"
+#import <netinet/tcp.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+#import <unistd.h>
+#import "PNAES.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Maximum number of events which is stored by mock (used by subscribe and history).
+ */
+static NSUInteger const kPNMockOriginMaximumStoredEvents = 50000;
+
+/**
+ @brief  Interval with which synthetic traffic generator check whether new events should be created.
+ */
+static NSTimeInterval const kPNMockOriginTrafficInterval = 0.01f;
+
+/**
+ @brief  Interval with which mock check whether pending subscribe requests should be completed by timeout.
+ */
+static NSTimeInterval const kPNMockOriginHousekeepingInterval = 0.1f;
+
+/**
+ @brief  Suffix which is used by \b PubNub service for presence channels.
+ */
+static NSString * const kPNMockOriginPresenceSuffix = @"-pnpres";
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Connection interface declaration
+
+@class PNMockOrigin;
+
+/**
+ @brief  Accepted client connection which is able to read HTTP requests and send responses.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNMockOriginConnection : NSObject
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores whether connection has been closed or not.
+ */
+@property (atomic, assign, getter = isClosed) BOOL closed;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Create connection and start reading requests from it.
+
+ @param socket Accepted client socket.
+ @param origin Reference on mock which should handle requests.
+
+ @return Configured and ready to use connection.
+ */
++ (instancetype)connectionWithSocket:(int)socket forOrigin:(PNMockOrigin *)origin;
+
+
+#pragma mark - Responses
+
+/**
+ @brief  Send HTTP response with JSON body.
+
+ @param statusCode HTTP status code which should be sent to the client.
+ @param object     Foundation object which should be serialized to JSON and sent as response body.
+ */
+- (void)sendResponseWithStatusCode:(NSInteger)statusCode object:(id)object;
+
+/**
+ @brief  Close connection.
+ */
+- (void)close;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Private interface declaration
+
+@interface PNMockOrigin ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *origin;
+@property (nonatomic, assign) NSUInteger publishedMessagesCount;
+
+/**
+ @brief  Stores reference on queue on which all mock state is accessed.
+ */
+@property (nonatomic, strong) dispatch_queue_t stateQueue;
+
+/**
+ @brief  Stores reference on listening socket.
+ */
+@property (nonatomic, assign) int serverSocket;
+
+/**
+ @brief  Stores reference on source which notify about new connections.
+ */
+@property (nonatomic, nullable, strong) dispatch_source_t acceptSource;
+
+/**
+ @brief  Stores reference on timer which complete expired subscribe requests.
+ */
+@property (nonatomic, nullable, strong) dispatch_source_t housekeepingTimer;
+
+/**
+ @brief  Stores reference on timer which generate synthetic traffic.
+ */
+@property (nonatomic, nullable, strong) dispatch_source_t trafficTimer;
+
+/**
+ @brief  Stores reference on list of active client connections.
+ */
+@property (nonatomic, strong) NSMutableSet<PNMockOriginConnection *> *connections;
+
+/**
+ @brief  Stores reference on list of events ordered by time token.
+ */
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *events;
+
+/**
+ @brief  Stores reference on list of subscribe requests which wait for new events.
+ */
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *pendingSubscribes;
+
+/**
+ @brief  Stores reference on channel name / list of unique user identifiers map.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableOrderedSet<NSString *> *> *occupancy;
+
+/**
+ @brief  Stores reference on last generated time token.
+ */
+@property (nonatomic, assign) uint64_t lastTimeToken;
+
+/**
+ @brief  Stores date when synthetic traffic generation has been started.
+ */
+@property (nonatomic, assign) CFAbsoluteTime trafficStartTime;
+
+/**
+ @brief  Stores number of synthetic messages which has been generated since traffic start.
+ */
+@property (nonatomic, assign) uint64_t trafficMessagesCount;
+
+/**
+ @brief  Stores number of synthetic presence events which has been generated since traffic start.
+ */
+@property (nonatomic, assign) uint64_t trafficPresenceEventsCount;
+
+
+#pragma mark - Server
+
+/**
+ @brief  Create listening socket and start accepting connections.
+
+ @return \c YES in case if server socket has been created.
+ */
+- (BOOL)startServer;
+
+/**
+ @brief  Accept pending connection on listening socket.
+ */
+- (void)acceptConnection;
+
+/**
+ @brief  Handle connection close.
+
+ @param connection Reference on connection which has been closed.
+ */
+- (void)connectionDidClose:(PNMockOriginConnection *)connection;
+
+
+#pragma mark - Requests handling
+
+/**
+ @brief  Route request to corresponding handler.
+
+ @param request    Dictionary with \c method, \c path (list of decoded components), \c query and \c body.
+ @param connection Reference on connection which should be used to send response.
+ */
+- (void)handleRequest:(NSDictionary *)request fromConnection:(PNMockOriginConnection *)connection;
+
+/**
+ @brief  Handle subscribe long-poll request.
+
+ @param channelsList Comma-separated list of channels.
+ @param query        Request query parameters.
+ @param connection   Reference on connection which should be used to send response.
+ */
+- (void)handleSubscribeToChannels:(NSString *)channelsList withQuery:(NSDictionary<NSString *, NSString *> *)query
+                       connection:(PNMockOriginConnection *)connection;
+
+/**
+ @brief  Handle presence API requests.
+
+ @param path  List of decoded path components.
+ @param query Request query parameters.
+
+ @return Service response object or \c nil in case if API not supported.
+ */
+- (nullable id)handlePresenceRequestWithPath:(NSArray<NSString *> *)path
+                                       query:(NSDictionary<NSString *, NSString *> *)query;
+
+/**
+ @brief  Store published message.
+
+ @param data    JSON representation of published message.
+ @param channel Name of channel to which message has been published.
+ @param uuid    Unique identifier of client which published message.
+
+ @return Service response object or \c nil in case if message can't be de-serialized.
+ */
+- (nullable NSArray *)publishMessageData:(NSData *)data toChannel:(NSString *)channel
+                              fromClient:(nullable NSString *)uuid;
+
+/**
+ @brief  Compose history response.
+
+ @param channel Name of channel for which history should be returned.
+ @param query   Request query parameters.
+
+ @return Service response object.
+ */
+- (NSArray *)historyForChannel:(NSString *)channel withQuery:(NSDictionary<NSString *, NSString *> *)query;
+
+
+#pragma mark - Events
+
+/**
+ @brief  Generate next unique time token.
+
+ @return Time token which is greater than any previously generated.
+ */
+- (uint64_t)nextTimeToken;
+
+/**
+ @brief  Store new event.
+
+ @param payload Event payload (message or presence event data).
+ @param channel Name of channel for which event should be stored.
+ @param uuid    Unique identifier of client which published message.
+
+ @return Time token which has been assigned to event.
+ */
+- (uint64_t)storeEventWithPayload:(id)payload forChannel:(NSString *)channel publisher:(nullable NSString *)uuid;
+
+/**
+ @brief  Update channels occupancy and store presence events for them.
+
+ @param join     Whether client joined channels or left them.
+ @param uuid     Unique identifier of client for which presence should be changed.
+ @param channels List of channels (presence channels ignored).
+ */
+- (void)updatePresence:(BOOL)join forClient:(nullable NSString *)uuid onChannels:(id<NSFastEnumeration>)channels;
+
+/**
+ @brief  Complete subscribe request if there is events for it.
+
+ @param subscribe Dictionary with pending subscribe request information.
+ @param force     Whether request should be completed even if there is no events.
+
+ @return \c YES in case if response has been sent.
+ */
+- (BOOL)completeSubscribe:(NSDictionary *)subscribe force:(BOOL)force;
+
+/**
+ @brief  Complete pending subscribe requests for which new events available.
+ */
+- (void)notifySubscribers;
+
+/**
+ @brief  Complete pending subscribe requests for which long-poll timeout expired.
+ */
+- (void)expireSubscribes;
+
+
+#pragma mark - Synthetic traffic
+
+/**
+ @brief  Generate messages and presence events which is due since traffic start.
+
+ @param filler String which should be used as synthetic message payload.
+ */
+- (void)generateTrafficWithFiller:(NSString *)filler;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Connection private interface declaration
+
+@interface PNMockOriginConnection ()
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on mock which handle requests.
+ */
+@property (nonatomic, weak) PNMockOrigin *origin;
+
+/**
+ @brief  Stores reference on client socket.
+ */
+@property (nonatomic, assign) int socket;
+
+/**
+ @brief  Stores reference on queue on which socket is read and written.
+ */
+@property (nonatomic, strong) dispatch_queue_t queue;
+
+/**
+ @brief  Stores reference on source which notify about new data.
+ */
+@property (nonatomic, strong) dispatch_source_t readSource;
+
+/**
+ @brief  Stores reference on data which has been read but not processed yet.
+ */
+@property (nonatomic, strong) NSMutableData *buffer;
+
+
+#pragma mark - Requests
+
+/**
+ @brief  Read available data from socket and pass complete requests to mock.
+ */
+- (void)readAvailableData;
+
+/**
+ @brief  Try to extract next complete HTTP request from buffer.
+
+ @return Request information or \c nil if more data required.
+ */
+- (nullable NSDictionary *)nextRequest;
+
+/**
+ @brief  Close connection (should be called on connection queue).
+ */
+- (void)closeConnection;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Connection implementation
+
+@implementation PNMockOriginConnection
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)connectionWithSocket:(int)socket forOrigin:(PNMockOrigin *)origin {
+
+    PNMockOriginConnection *connection = [self new];
+    connection.origin = origin;
+    connection.socket = socket;
+    connection.buffer = [NSMutableData new];
+    connection.queue = dispatch_queue_create("com.pubnub.mock-origin.connection", DISPATCH_QUEUE_SERIAL);
+    connection.readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)socket, 0,
+                                                   connection.queue);
+    __weak PNMockOriginConnection *weakConnection = connection;
+    dispatch_source_set_event_handler(connection.readSource, ^{ [weakConnection readAvailableData]; });
+    dispatch_source_set_cancel_handler(connection.readSource, ^{ close(socket); });
+    dispatch_resume(connection.readSource);
+
+    return connection;
+}
+
+
+#pragma mark - Requests
+
+- (void)readAvailableData {
+
+    uint8_t bytes[16384];
+    ssize_t length = read(self.socket, bytes, sizeof(bytes));
+    if (length <= 0) {
+
+        if (length < 0 && errno == EINTR) { return; }
+        [self closeConnection];
+        return;
+    }
+    [self.buffer appendBytes:bytes length:(NSUInteger)length];
+
+    NSDictionary *request = nil;
+    while (!self.isClosed && (request = [self nextRequest])) {
+
+        PNMockOrigin *origin = self.origin;
+        dispatch_async(origin.stateQueue, ^{ [origin handleRequest:request fromConnection:self]; });
+    }
+}
+
+- (NSDictionary *)nextRequest {
+
+    NSData *separator = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+    NSRange headRange = [self.buffer rangeOfData:separator options:0 range:NSMakeRange(0, self.buffer.length)];
+    if (headRange.location == NSNotFound) { return nil; }
+
+    NSData *headData = [self.buffer subdataWithRange:NSMakeRange(0, headRange.location)];
+    NSString *head = [[NSString alloc] initWithData:headData encoding:NSUTF8StringEncoding];
+    NSArray<NSString *> *lines = [head componentsSeparatedByString:@"\r\n"];
+    NSUInteger contentLength = 0;
+    for (NSString *line in lines) {
+
+        if ([line.lowercaseString hasPrefix:@"content-length:"]) {
+
+            contentLength = (NSUInteger)[line substringFromIndex:15].integerValue;
+        }
+    }
+    NSUInteger bodyOffset = NSMaxRange(headRange);
+    if (self.buffer.length < bodyOffset + contentLength) { return nil; }
+
+    NSData *body = [self.buffer subdataWithRange:NSMakeRange(bodyOffset, contentLength)];
+    [self.buffer replaceBytesInRange:NSMakeRange(0, bodyOffset + contentLength) withBytes:NULL length:0];
+    NSArray<NSString *> *requestLine = [lines.firstObject componentsSeparatedByString:@" "];
+    if (requestLine.count < 3) {
+
+        [self closeConnection];
+        return nil;
+    }
+
+    NSString *target = requestLine[1];
+    NSRange queryRange = [target rangeOfString:@"?"];
+    NSString *path = (queryRange.location != NSNotFound ? [target substringToIndex:queryRange.location] : target);
+    NSMutableDictionary<NSString *, NSString *> *query = [NSMutableDictionary new];
+    if (queryRange.location != NSNotFound) {
+
+        NSString *queryString = [target substringFromIndex:NSMaxRange(queryRange)];
+        for (NSString *pair in [queryString componentsSeparatedByString:@"&"]) {
+
+            NSRange valueRange = [pair rangeOfString:@"="];
+            if (valueRange.location == NSNotFound) {
+
+                if (pair.length) { query[pair] = @""; }
+                continue;
+            }
+            NSString *value = [[pair substringFromIndex:NSMaxRange(valueRange)] stringByRemovingPercentEncoding];
+            query[[pair substringToIndex:valueRange.location]] = (value?: @"");
+        }
+    }
+
+    // Path split before decoding, because components (like published message) may contain escaped '/'.
+    NSMutableArray<NSString *> *components = [NSMutableArray new];
+    for (NSString *component in [path componentsSeparatedByString:@"/"]) {
+
+        if (component.length) { [components addObject:([component stringByRemovingPercentEncoding]?: component)]; }
+    }
+
+    return @{@"method": requestLine[0], @"path": components, @"query": query, @"body": body};
+}
+
+
+#pragma mark - Responses
+
+- (void)sendResponseWithStatusCode:(NSInteger)statusCode object:(id)object {
+
+    NSData *body = [NSJSONSerialization dataWithJSONObject:object options:0 error:nil];
+    dispatch_async(self.queue, ^{
+
+        if (self.isClosed) { return; }
+        NSString *reason = (statusCode == 200 ? @"OK" : (statusCode == 400 ? @"Bad Request" : @"Not Found"));
+        NSString *head = [NSString stringWithFormat:@"HTTP/1.1 %ld %@\r\nContent-Type: text/javascript; "
+                          "charset=\"UTF-8\"\r\nContent-Length: %lu\r\nConnection: keep-alive\r\n"
+                          "Cache-Control: no-cache\r\n\r\n", (long)statusCode, reason, (unsigned long)body.length];
+        NSMutableData *data = [[head dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+        [data appendData:body];
+
+        const uint8_t *bytes = data.bytes;
+        NSUInteger written = 0;
+        while (written < data.length) {
+
+            ssize_t result = write(self.socket, (bytes + written), (data.length - written));
+            if (result < 0 && errno == EINTR) { continue; }
+            if (result <= 0) {
+
+                [self closeConnection];
+                break;
+            }
+            written += (NSUInteger)result;
+        }
+    });
+}
+
+- (void)close {
+
+    dispatch_async(self.queue, ^{ [self closeConnection]; });
+}
+
+- (void)closeConnection {
+
+    if (self.isClosed) { return; }
+    self.closed = YES;
+    dispatch_source_cancel(self.readSource);
+    [self.origin connectionDidClose:self];
+}
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNMockOrigin
+
+
+#pragma mark - Information
+
+- (NSUInteger)publishedMessagesCount {
+
+    __block NSUInteger count = 0;
+    dispatch_sync(self.stateQueue, ^{ count = self->_publishedMessagesCount; });
+
+    return count;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)origin {
+
+    PNMockOrigin *origin = [self new];
+
+    return ([origin startServer] ? origin : nil);
+}
+
+- (instancetype)init {
+
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+
+        _subscribeTimeout = 10.f;
+        _region = 4;
+        _maximumEventsPerResponse = 100;
+        _trafficChannels = @[];
+        _trafficPayloadSize = 64;
+        _serverSocket = -1;
+        _stateQueue = dispatch_queue_create("com.pubnub.mock-origin", DISPATCH_QUEUE_SERIAL);
+        _connections = [NSMutableSet new];
+        _events = [NSMutableArray new];
+        _pendingSubscribes = [NSMutableArray new];
+        _occupancy = [NSMutableDictionary new];
+    }
+
+    return self;
+}
+
+- (void)stop {
+
+    dispatch_sync(self.stateQueue, ^{
+
+        if (self.trafficTimer) { dispatch_source_cancel(self.trafficTimer); }
+        if (self.housekeepingTimer) { dispatch_source_cancel(self.housekeepingTimer); }
+        if (self.acceptSource) { dispatch_source_cancel(self.acceptSource); }
+        self.trafficTimer = nil;
+        self.housekeepingTimer = nil;
+        self.acceptSource = nil;
+        for (PNMockOriginConnection *connection in self.connections) { [connection close]; }
+        [self.connections removeAllObjects];
+        [self.pendingSubscribes removeAllObjects];
+    });
+}
+
+- (void)dealloc {
+
+    if (_trafficTimer) { dispatch_source_cancel(_trafficTimer); }
+    if (_housekeepingTimer) { dispatch_source_cancel(_housekeepingTimer); }
+    if (_acceptSource) { dispatch_source_cancel(_acceptSource); }
+    for (PNMockOriginConnection *connection in _connections) { [connection close]; }
+}
+
+
+#pragma mark - Server
+
+- (BOOL)startServer {
+
+    int serverSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (serverSocket < 0) { return NO; }
+
+    int reuseAddress = 1;
+    setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    if (bind(serverSocket, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(serverSocket, 64) != 0 ||
+        getsockname(serverSocket, (struct sockaddr *)&address, &addressLength) != 0) {
+
+        close(serverSocket);
+        return NO;
+    }
+    self.serverSocket = serverSocket;
+    self.origin = [NSString stringWithFormat:@"127.0.0.1:%d", ntohs(address.sin_port)];
+
+    __weak __typeof(self) weakSelf = self;
+    self.acceptSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)serverSocket, 0,
+                                               self.stateQueue);
+    dispatch_source_set_event_handler(self.acceptSource, ^{ [weakSelf acceptConnection]; });
+    dispatch_source_set_cancel_handler(self.acceptSource, ^{ close(serverSocket); });
+    dispatch_resume(self.acceptSource);
+
+    uint64_t interval = (uint64_t)(kPNMockOriginHousekeepingInterval * NSEC_PER_SEC);
+    self.housekeepingTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.stateQueue);
+    dispatch_source_set_timer(self.housekeepingTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval),
+                              interval, (interval / 10));
+    dispatch_source_set_event_handler(self.housekeepingTimer, ^{ [weakSelf expireSubscribes]; });
+    dispatch_resume(self.housekeepingTimer);
+
+    return YES;
+}
+
+- (void)acceptConnection {
+
+    int clientSocket = accept(self.serverSocket, NULL, NULL);
+    if (clientSocket < 0) { return; }
+
+    int enabled = 1;
+    setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+    setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    [self.connections addObject:[PNMockOriginConnection connectionWithSocket:clientSocket forOrigin:self]];
+}
+
+- (void)connectionDidClose:(PNMockOriginConnection *)connection {
+
+    dispatch_async(self.stateQueue, ^{
+
+        [self.connections removeObject:connection];
+        NSIndexSet *closed = [self.pendingSubscribes indexesOfObjectsPassingTest:^BOOL(NSDictionary *subscribe,
+                                                                                      __unused NSUInteger idx,
+                                                                                      __unused BOOL *stop) {
+            return (subscribe[@"connection"] == connection);
+        }];
+        [self.pendingSubscribes removeObjectsAtIndexes:closed];
+    });
+}
+
+
+#pragma mark - Requests handling
+
+- (void)handleRequest:(NSDictionary *)request fromConnection:(PNMockOriginConnection *)connection {
+
+    NSArray<NSString *> *path = request[@"path"];
+    NSDictionary<NSString *, NSString *> *query = request[@"query"];
+    NSInteger statusCode = 200;
+    id response = nil;
+
+    if (path.count == 2 && [path[0] isEqualToString:@"time"]) { response = @[@([self nextTimeToken])]; }
+    else if (path.count >= 6 && [path[0] isEqualToString:@"publish"]) {
+
+        NSData *messageData = (path.count > 6 ? [path[6] dataUsingEncoding:NSUTF8StringEncoding] : request[@"body"]);
+        response = [self publishMessageData:messageData toChannel:path[4] fromClient:query[@"uuid"]];
+        if (!response) {
+
+            statusCode = 400;
+            response = @[@0, @"Invalid JSON", @([self nextTimeToken]).stringValue];
+        }
+    }
+    else if (path.count == 5 && [path[1] isEqualToString:@"subscribe"]) {
+
+        [self handleSubscribeToChannels:path[3] withQuery:query connection:connection];
+        return;
+    }
+    else if (path.count == 6 && [path[1] isEqualToString:@"history"]) {
+
+        response = [self historyForChannel:path[5] withQuery:query];
+    }
+    else if (path.count >= 4 && [path[1] isEqualToString:@"presence"]) {
+
+        response = [self handlePresenceRequestWithPath:path query:query];
+    }
+
+    if (!response) {
+
+        statusCode = 404;
+        response = @{@"status": @404, @"error": @YES, @"message": @"Not Found", @"service": @"Mock"};
+    }
+    [connection sendResponseWithStatusCode:statusCode object:response];
+}
+
+- (void)handleSubscribeToChannels:(NSString *)channelsList withQuery:(NSDictionary<NSString *, NSString *> *)query
+                       connection:(PNMockOriginConnection *)connection {
+
+    NSMutableSet<NSString *> *channels = [NSMutableSet new];
+    for (NSString *channel in [channelsList componentsSeparatedByString:@","]) {
+
+        if (channel.length) { [channels addObject:channel]; }
+    }
+    uint64_t timeToken = strtoull((query[@"tt"].UTF8String?: "0"), NULL, 10);
+    if (timeToken == 0) {
+
+        // Initial subscribe receive current time token and only after that client join channels.
+        NSDictionary *response = @{@"t": @{@"t": @([self nextTimeToken]).stringValue, @"r": @(self.region)},
+                                   @"m": @[]};
+        [connection sendResponseWithStatusCode:200 object:response];
+        [self updatePresence:YES forClient:query[@"uuid"] onChannels:channels];
+        [self notifySubscribers];
+        return;
+    }
+
+    NSDictionary *subscribe = @{@"connection": connection, @"channels": channels, @"timetoken": @(timeToken),
+                                @"deadline": @(CFAbsoluteTimeGetCurrent() + self.subscribeTimeout)};
+    if (![self completeSubscribe:subscribe force:NO]) { [self.pendingSubscribes addObject:subscribe]; }
+}
+
+- (id)handlePresenceRequestWithPath:(NSArray<NSString *> *)path
+                              query:(NSDictionary<NSString *, NSString *> *)query {
+
+    NSDictionary *okResponse = @{@"status": @200, @"message": @"OK", @"service": @"Presence"};
+    if (path.count == 4) {
+
+        NSMutableDictionary *channels = [NSMutableDictionary new];
+        NSUInteger totalOccupancy = 0;
+        for (NSString *channel in self.occupancy) {
+
+            NSOrderedSet<NSString *> *uuids = self.occupancy[channel];
+            if (!uuids.count) { continue; }
+            channels[channel] = @{@"occupancy": @(uuids.count), @"uuids": uuids.array};
+            totalOccupancy += uuids.count;
+        }
+
+        return @{@"status": @200, @"message": @"OK", @"service": @"Presence",
+                 @"payload": @{@"channels": channels, @"total_channels": @(channels.count),
+                               @"total_occupancy": @(totalOccupancy)}};
+    }
+    if (path.count < 6 || ![path[4] isEqualToString:@"channel"]) { return nil; }
+
+    NSArray<NSString *> *channels = [path[5] componentsSeparatedByString:@","];
+    if (path.count == 6) {
+
+        NSOrderedSet<NSString *> *uuids = self.occupancy[path[5]];
+        NSMutableDictionary *response = [okResponse mutableCopy];
+        response[@"occupancy"] = @(uuids.count);
+        if (![query[@"disable_uuids"] isEqualToString:@"1"]) { response[@"uuids"] = (uuids.array?: @[]); }
+
+        return response;
+    }
+    if (path.count == 7 && [path[6] isEqualToString:@"leave"]) {
+
+        [self updatePresence:NO forClient:query[@"uuid"] onChannels:channels];
+        [self notifySubscribers];
+        NSMutableDictionary *response = [okResponse mutableCopy];
+        response[@"action"] = @"leave";
+
+        return response;
+    }
+    if (path.count == 7 && [path[6] isEqualToString:@"heartbeat"]) {
+
+        [self updatePresence:YES forClient:query[@"uuid"] onChannels:channels];
+        [self notifySubscribers];
+
+        return okResponse;
+    }
+
+    return nil;
+}
+
+- (NSArray *)publishMessageData:(NSData *)data toChannel:(NSString *)channel fromClient:(NSString *)uuid {
+
+    id message = (data.length ? [NSJSONSerialization JSONObjectWithData:data
+                                                                options:NSJSONReadingAllowFragments
+                                                                  error:nil] : nil);
+    if (!message) { return nil; }
+
+    uint64_t timeToken = [self storeEventWithPayload:message forChannel:channel publisher:uuid];
+    _publishedMessagesCount++;
+    [self notifySubscribers];
+
+    return @[@1, @"Sent", @(timeToken).stringValue];
+}
+
+- (NSArray *)historyForChannel:(NSString *)channel withQuery:(NSDictionary<NSString *, NSString *> *)query {
+
+    NSUInteger count = (query[@"count"] ? MIN((NSUInteger)query[@"count"].integerValue, (NSUInteger)100) : 100);
+    BOOL reverse = [query[@"reverse"] isEqualToString:@"true"];
+    BOOL includeToken = [query[@"include_token"] isEqualToString:@"true"];
+    uint64_t start = strtoull((query[@"start"].UTF8String?: "0"), NULL, 10);
+    uint64_t end = strtoull((query[@"end"].UTF8String?: "0"), NULL, 10);
+
+    NSMutableArray<NSDictionary *> *matches = [NSMutableArray new];
+    for (NSDictionary *event in self.events) {
+
+        uint64_t timeToken = ((NSNumber *)event[@"timetoken"]).unsignedLongLongValue;
+        if (![event[@"channel"] isEqualToString:channel] || (start && timeToken >= start) ||
+            (end && timeToken < end)) {
+
+            continue;
+        }
+        [matches addObject:event];
+    }
+    if (matches.count > count) {
+
+        NSRange range = NSMakeRange((reverse ? 0 : (matches.count - count)), count);
+        matches = [[matches subarrayWithRange:range] mutableCopy];
+    }
+
+    NSMutableArray *messages = [[NSMutableArray alloc] initWithCapacity:matches.count];
+    for (NSDictionary *event in matches) {
+
+        [messages addObject:(includeToken ? @{@"message": event[@"payload"], @"timetoken": event[@"timetoken"]} :
+                             event[@"payload"])];
+    }
+
+    return @[messages, (matches.firstObject[@"timetoken"]?: @0), (matches.lastObject[@"timetoken"]?: @0)];
+}
+
+
+#pragma mark - Events
+
+- (uint64_t)nextTimeToken {
+
+    uint64_t timeToken = (uint64_t)([NSDate date].timeIntervalSince1970 * 10000000);
+    self.lastTimeToken = MAX(timeToken, (self.lastTimeToken + 1));
+
+    return self.lastTimeToken;
+}
+
+- (uint64_t)storeEventWithPayload:(id)payload forChannel:(NSString *)channel publisher:(NSString *)uuid {
+
+    uint64_t timeToken = [self nextTimeToken];
+    NSMutableDictionary *envelope = [@{@"a": @"4", @"f": @0, @"k": @"mock", @"c": channel, @"d": payload,
+                                       @"p": @{@"t": @(timeToken).stringValue, @"r": @(self.region)}} mutableCopy];
+    if (uuid) { envelope[@"i"] = uuid; }
+    [self.events addObject:@{@"timetoken": @(timeToken), @"channel": channel, @"payload": payload,
+                             @"envelope": envelope}];
+    if (self.events.count > kPNMockOriginMaximumStoredEvents) {
+
+        [self.events removeObjectsInRange:NSMakeRange(0, (self.events.count - kPNMockOriginMaximumStoredEvents))];
+    }
+
+    return timeToken;
+}
+
+- (void)updatePresence:(BOOL)join forClient:(NSString *)uuid onChannels:(id<NSFastEnumeration>)channels {
+
+    if (!uuid.length) { return; }
+    for (NSString *channel in channels) {
+
+        if ([channel hasSuffix:kPNMockOriginPresenceSuffix]) { continue; }
+        NSMutableOrderedSet<NSString *> *uuids = self.occupancy[channel];
+        if (!uuids) {
+
+            uuids = [NSMutableOrderedSet new];
+            self.occupancy[channel] = uuids;
+        }
+        if (join == [uuids containsObject:uuid]) { continue; }
+
+        if (join) { [uuids addObject:uuid]; }
+        else { [uuids removeObject:uuid]; }
+        NSDictionary *event = @{@"action": (join ? @"join" : @"leave"), @"uuid": uuid,
+                                @"timestamp": @((uint64_t)[NSDate date].timeIntervalSince1970),
+                                @"occupancy": @(uuids.count)};
+        [self storeEventWithPayload:event forChannel:[channel stringByAppendingString:kPNMockOriginPresenceSuffix]
+                          publisher:nil];
+    }
+}
+
+- (BOOL)completeSubscribe:(NSDictionary *)subscribe force:(BOOL)force {
+
+    uint64_t timeToken = ((NSNumber *)subscribe[@"timetoken"]).unsignedLongLongValue;
+    NSSet<NSString *> *channels = subscribe[@"channels"];
+    uint64_t responseTimeToken = MAX(self.lastTimeToken, timeToken);
+    NSUInteger eventIdx = self.events.count;
+    while (eventIdx > 0 && ((NSNumber *)self.events[eventIdx - 1][@"timetoken"]).unsignedLongLongValue > timeToken) {
+
+        eventIdx--;
+    }
+
+    NSMutableArray<NSDictionary *> *envelopes = [NSMutableArray new];
+    for (; eventIdx < self.events.count; eventIdx++) {
+
+        NSDictionary *event = self.events[eventIdx];
+        if (![channels containsObject:event[@"channel"]]) { continue; }
+        [envelopes addObject:event[@"envelope"]];
+
+        // Rest of events will be delivered with next long-poll request.
+        if (envelopes.count == self.maximumEventsPerResponse) {
+
+            responseTimeToken = ((NSNumber *)event[@"timetoken"]).unsignedLongLongValue;
+            break;
+        }
+    }
+    if (!envelopes.count && !force) { return NO; }
+
+    NSDictionary *response = @{@"t": @{@"t": @(responseTimeToken).stringValue, @"r": @(self.region)},
+                               @"m": envelopes};
+    [(PNMockOriginConnection *)subscribe[@"connection"] sendResponseWithStatusCode:200 object:response];
+
+    return YES;
+}
+
+- (void)notifySubscribers {
+
+    NSIndexSet *completed = [self.pendingSubscribes indexesOfObjectsPassingTest:^BOOL(NSDictionary *subscribe,
+                                                                                     __unused NSUInteger idx,
+                                                                                     __unused BOOL *stop) {
+        return (((PNMockOriginConnection *)subscribe[@"connection"]).isClosed ||
+                [self completeSubscribe:subscribe force:NO]);
+    }];
+    [self.pendingSubscribes removeObjectsAtIndexes:completed];
+}
+
+- (void)expireSubscribes {
+
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSIndexSet *expired = [self.pendingSubscribes indexesOfObjectsPassingTest:^BOOL(NSDictionary *subscribe,
+                                                                                   __unused NSUInteger idx,
+                                                                                   __unused BOOL *stop) {
+        if (((PNMockOriginConnection *)subscribe[@"connection"]).isClosed) { return YES; }
+
+        return (((NSNumber *)subscribe[@"deadline"]).doubleValue <= now &&
+                [self completeSubscribe:subscribe force:YES]);
+    }];
+    [self.pendingSubscribes removeObjectsAtIndexes:expired];
+}
+
+
+#pragma mark - Synthetic traffic
+
+- (void)startTraffic {
+
+    dispatch_async(self.stateQueue, ^{
+
+        if (self.trafficTimer) { dispatch_source_cancel(self.trafficTimer); }
+        self.trafficStartTime = CFAbsoluteTimeGetCurrent();
+        self.trafficMessagesCount = 0;
+        self.trafficPresenceEventsCount = 0;
+        NSString *filler = [@"" stringByPaddingToLength:self.trafficPayloadSize withString:@"x" startingAtIndex:0];
+
+        __weak __typeof(self) weakSelf = self;
+        uint64_t interval = (uint64_t)(kPNMockOriginTrafficInterval * NSEC_PER_SEC);
+        self.trafficTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.stateQueue);
+        dispatch_source_set_timer(self.trafficTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval),
+                                  interval, (interval / 10));
+        dispatch_source_set_event_handler(self.trafficTimer, ^{ [weakSelf generateTrafficWithFiller:filler]; });
+        dispatch_resume(self.trafficTimer);
+    });
+}
+
+- (void)stopTraffic {
+
+    dispatch_sync(self.stateQueue, ^{
+
+        if (self.trafficTimer) { dispatch_source_cancel(self.trafficTimer); }
+        self.trafficTimer = nil;
+    });
+}
+
+- (void)generateTrafficWithFiller:(NSString *)filler {
+
+    NSUInteger channelsCount = self.trafficChannels.count;
+    if (!channelsCount) { return; }
+
+    NSTimeInterval elapsed = (CFAbsoluteTimeGetCurrent() - self.trafficStartTime);
+    uint64_t messagesDue = (uint64_t)(elapsed * self.trafficMessagesPerSecond);
+    uint64_t presenceEventsDue = (uint64_t)(elapsed * self.trafficPresenceEventsPerSecond);
+    BOOL generated = (self.trafficMessagesCount < messagesDue || self.trafficPresenceEventsCount < presenceEventsDue);
+
+    for (; self.trafficMessagesCount < messagesDue; self.trafficMessagesCount++) {
+
+        NSString *channel = self.trafficChannels[self.trafficMessagesCount % channelsCount];
+        id message = @{@"sent": @(CFAbsoluteTimeGetCurrent()), @"seq": @(self.trafficMessagesCount), @"data": filler};
+        if (self.trafficCipherKey.length) {
+
+            message = [PNAES encrypt:[NSJSONSerialization dataWithJSONObject:message options:0 error:nil]
+                             withKey:self.trafficCipherKey];
+        }
+        [self storeEventWithPayload:message forChannel:channel publisher:@"mock-publisher"];
+        _publishedMessagesCount++;
+    }
+
+    // Fake users alternately join and leave channels.
+    for (; self.trafficPresenceEventsCount < presenceEventsDue; self.trafficPresenceEventsCount++) {
+
+        NSString *channel = self.trafficChannels[self.trafficPresenceEventsCount % channelsCount];
+        NSUInteger userIdx = (NSUInteger)(self.trafficPresenceEventsCount / channelsCount % 100);
+        NSString *uuid = [NSString stringWithFormat:@"mock-user-%@", @(userIdx)];
+        [self updatePresence:![self.occupancy[channel] containsObject:uuid] forClient:uuid onChannels:@[channel]];
+    }
+
+    if (generated) { [self notifySubscribers]; }
+}
+
+#pragma mark -
+
+
+@end
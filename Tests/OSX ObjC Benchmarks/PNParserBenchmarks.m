@@ -0,0 +1,206 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNBenchmarkTestCase.h"
+#import "PNSubscribeParser.h"
+#import "PNHistoryParser.h"
+#import "PNJSON.h"
+#import "PNAES.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Key which is used to encrypt messages in synthetic payloads.
+ */
+static NSString * const kPNBenchmarkCipherKey = @"enigma";
+
+
+#pragma mark - Private interface declaration
+
+/**
+ @brief      Subscribe and history response parsers benchmarks.
+ @discussion Parsers fed with synthetic service responses (already de-serialized from JSON) with plain and
+             encrypted messages.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNParserBenchmarks : PNBenchmarkTestCase
+
+
+#pragma mark - Payloads
+
+/**
+ @brief  Construct message which is used as payload for synthetic events.
+
+ @param index Index of message in list.
+
+ @return Message payload (encrypted if \c encrypted is set to \c YES).
+ */
+- (id)messageWithIndex:(NSUInteger)index encrypted:(BOOL)encrypted;
+
+/**
+ @brief  Construct subscribe response with specified number of events.
+
+ @param count     Number of real-time events which should be stored in response.
+ @param encrypted Whether events payload should be encrypted or not.
+
+ @return De-serialized subscribe response.
+ */
+- (NSDictionary *)subscribeResponseWithEvents:(NSUInteger)count encrypted:(BOOL)encrypted;
+
+/**
+ @brief  Construct history response with specified number of messages.
+
+ @param count     Number of messages which should be stored in response.
+ @param encrypted Whether messages should be encrypted or not.
+
+ @return De-serialized history response.
+ */
+- (NSArray *)historyResponseWithMessages:(NSUInteger)count encrypted:(BOOL)encrypted;
+
+/**
+ @brief  Measure subscribe parser performance with specified number of events.
+
+ @param count     Number of real-time events which should be parsed.
+ @param encrypted Whether events payload should be decrypted by parser or not.
+ */
+- (void)measureSubscribeParserWithEvents:(NSUInteger)count encrypted:(BOOL)encrypted;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNParserBenchmarks
+
+
+#pragma mark - Subscribe
+
+- (void)testSubscribeParser1Event {
+
+    [self measureSubscribeParserWithEvents:1 encrypted:NO];
+}
+
+- (void)testSubscribeParser100Events {
+
+    [self measureSubscribeParserWithEvents:100 encrypted:NO];
+}
+
+- (void)testSubscribeParser1000Events {
+
+    [self measureSubscribeParserWithEvents:1000 encrypted:NO];
+}
+
+- (void)testSubscribeParser1EncryptedEvent {
+
+    [self measureSubscribeParserWithEvents:1 encrypted:YES];
+}
+
+- (void)testSubscribeParser100EncryptedEvents {
+
+    [self measureSubscribeParserWithEvents:100 encrypted:YES];
+}
+
+- (void)testSubscribeParser1000EncryptedEvents {
+
+    [self measureSubscribeParserWithEvents:1000 encrypted:YES];
+}
+
+
+#pragma mark - History
+
+- (void)testHistoryParser100Messages {
+
+    NSArray *response = [self historyResponseWithMessages:100 encrypted:NO];
+    [self measureBenchmark:@"history-parser-100" iterations:100 usingBlock:^{
+
+        [PNHistoryParser parsedServiceResponse:response withData:@{}];
+    }];
+}
+
+- (void)testHistoryParser100EncryptedMessages {
+
+    NSArray *response = [self historyResponseWithMessages:100 encrypted:YES];
+    NSDictionary *data = @{@"cipherKey": kPNBenchmarkCipherKey};
+    XCTAssertEqual(((NSArray *)[PNHistoryParser parsedServiceResponse:response withData:data][@"messages"]).count,
+                   (NSUInteger)100);
+    [self measureBenchmark:@"history-parser-100-encrypted" iterations:20 usingBlock:^{
+
+        [PNHistoryParser parsedServiceResponse:response withData:data];
+    }];
+}
+
+
+#pragma mark - Payloads
+
+- (id)messageWithIndex:(NSUInteger)index encrypted:(BOOL)encrypted {
+
+    NSDictionary *message = @{@"text": @"Hello from PubNub benchmarks with some payload text.",
+                              @"index": @(index), @"sender": @{@"name": @"bench", @"online": @YES},
+                              @"tags": @[@"alpha", @"beta", @"gamma"]};
+    if (encrypted) {
+
+        NSString *messageString = [PNJSON JSONStringFrom:message withError:nil];
+        return [PNAES encrypt:[messageString dataUsingEncoding:NSUTF8StringEncoding]
+                      withKey:kPNBenchmarkCipherKey];
+    }
+
+    return message;
+}
+
+- (NSDictionary *)subscribeResponseWithEvents:(NSUInteger)count encrypted:(BOOL)encrypted {
+
+    NSMutableArray *events = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger eventIdx = 0; eventIdx < count; eventIdx++) {
+
+        NSString *channel = [NSString stringWithFormat:@"channel-%@", @(eventIdx % 10)];
+        [events addObject:@{@"a": @"1", @"f": @0, @"k": @"demo", @"c": channel, @"b": channel,
+                            @"p": @{@"t": @(14637536741734954 + eventIdx).stringValue, @"r": @1},
+                            @"d": [self messageWithIndex:eventIdx encrypted:encrypted]}];
+    }
+
+    return @{@"t": @{@"t": @"14637536741734954", @"r": @1}, @"m": events};
+}
+
+- (NSArray *)historyResponseWithMessages:(NSUInteger)count encrypted:(BOOL)encrypted {
+
+    NSMutableArray *messages = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger messageIdx = 0; messageIdx < count; messageIdx++) {
+
+        [messages addObject:@{@"message": [self messageWithIndex:messageIdx encrypted:encrypted],
+                              @"timetoken": @(14637536741734954 + messageIdx)}];
+    }
+
+    return @[messages, @14637536741734954, @(14637536741734954 + count)];
+}
+
+
+#pragma mark - Misc
+
+- (void)measureSubscribeParserWithEvents:(NSUInteger)count encrypted:(BOOL)encrypted {
+
+    NSDictionary *response = [self subscribeResponseWithEvents:count encrypted:encrypted];
+    NSDictionary *data = (encrypted ? @{@"cipherKey": kPNBenchmarkCipherKey} : @{});
+    XCTAssertEqual(((NSArray *)[PNSubscribeParser parsedServiceResponse:response withData:data][@"events"]).count,
+                   count);
+    NSString *name = [NSString stringWithFormat:@"subscribe-parser-%@%@", @(count),
+                      (encrypted ? @"-encrypted" : @"")];
+    NSUInteger iterations = MAX((NSUInteger)(10000 / count / (encrypted ? 5 : 1)), (NSUInteger)5);
+    [self measureBenchmark:name iterations:iterations usingBlock:^{
+
+        [PNSubscribeParser parsedServiceResponse:response withData:data];
+    }];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,177 @@
+/**
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+#import "PNBenchmarkTestCase.h"
+#import "PNRequestParameters.h"
+#import <PubNub/PubNub.h>
+#import "PNClientState.h"
+#import "PNURLBuilder.h"
+#import "PNChannel.h"
+#import "PNString.h"
+
+
+#pragma mark Private interface declaration
+
+/**
+ @brief  Request URL composition benchmarks.
+
+ @author Sergey Mamontov
+ @since 4.5.0
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNRequestBenchmarks : PNBenchmarkTestCase
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Measure channels list composition for subscribe request.
+
+ @param count Number of channels which should be joined.
+ */
+- (void)measureChannelNamesWithCount:(NSUInteger)count;
+
+/**
+ @brief  Measure client state serialization for subscribe request after single object state change.
+
+ @param count Number of objects which has state in client state cache.
+ */
+- (void)measureClientStateWithCount:(NSUInteger)count;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation PNRequestBenchmarks
+
+
+#pragma mark - URL builder
+
+- (void)testURLBuilderPublish {
+
+    NSString *message = [PNString percentEscapedString:@"{\"text\":\"Hello from PubNub benchmarks\",\"index\":1}"];
+    [self measureBenchmark:@"url-builder-publish" iterations:5000 usingBlock:^{
+
+        PNRequestParameters *parameters = [PNRequestParameters new];
+        [parameters addPathComponents:@{@"{pub-key}": @"demo", @"{sub-key}": @"demo",
+                                        @"{channel}": @"benchmark-channel", @"{message}": message}];
+        [parameters addQueryParameters:@{@"uuid": @"4E1B5E1E-2A7A-4B4E-8C3E-4B1F3C2A1D0E",
+                                         @"pnsdk": @"PubNub-ObjC-iOS/4.5.0", @"seqn": @"1",
+                                         @"auth": @"benchmark-auth-key"}];
+        [PNURLBuilder URLForOperation:PNPublishOperation withParameters:parameters];
+    }];
+}
+
+- (void)testURLBuilderSubscribe {
+
+    NSString *channels = [PNChannel namesForRequest:@[@"channel-a", @"channel-b", @"channel-c"]];
+    [self measureBenchmark:@"url-builder-subscribe" iterations:5000 usingBlock:^{
+
+        PNRequestParameters *parameters = [PNRequestParameters new];
+        [parameters addPathComponents:@{@"{sub-key}": @"demo", @"{channels}": channels}];
+        [parameters addQueryParameters:@{@"tt": @"14637536741734954", @"tr": @"1", @"heartbeat": @"300",
+                                         @"uuid": @"4E1B5E1E-2A7A-4B4E-8C3E-4B1F3C2A1D0E"}];
+        [PNURLBuilder URLForOperation:PNSubscribeOperation withParameters:parameters];
+    }];
+}
+
+
+#pragma mark - Percent-escaping
+
+- (void)testPercentEscapedString {
+
+    NSString *string = (@"{\"text\":\"Hello from PubNub benchmarks! Привет, 世界 & friends\","
+                        "\"tags\":[\"a/b\",\"c?d\"]}");
+    [self measureBenchmark:@"percent-escaped-string" iterations:10000 usingBlock:^{
+
+        [PNString percentEscapedString:string];
+    }];
+}
+
+
+#pragma mark - Channel names
+
+- (void)testChannelNames10 {
+
+    [self measureChannelNamesWithCount:10];
+}
+
+- (void)testChannelNames100 {
+
+    [self measureChannelNamesWithCount:100];
+}
+
+- (void)testChannelNames1000 {
+
+    [self measureChannelNamesWithCount:1000];
+}
+
+- (void)testChannelNames5000 {
+
+    [self measureChannelNamesWithCount:5000];
+}
+
+
+#pragma mark - Client state
+
+- (void)testClientState100 {
+
+    [self measureClientStateWithCount:100];
+}
+
+- (void)testClientState1000 {
+
+    [self measureClientStateWithCount:1000];
+}
+
+
+#pragma mark - Misc
+
+- (void)measureChannelNamesWithCount:(NSUInteger)count {
+
+    NSMutableArray<NSString *> *channels = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger channelIdx = 0; channelIdx < count; channelIdx++) {
+
+        [channels addObject:[NSString stringWithFormat:@"benchmark-channel-%@", @(channelIdx)]];
+    }
+    NSString *name = [NSString stringWithFormat:@"channel-names-%@", @(count)];
+    [self measureBenchmark:name iterations:MAX((NSUInteger)(50000 / count), (NSUInteger)5) usingBlock:^{
+
+        [PNChannel namesForRequest:channels];
+    }];
+}
+
+- (void)measureClientStateWithCount:(NSUInteger)count {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo" subscribeKey:@"demo"];
+    PubNub *client = [PubNub clientWithConfiguration:configuration];
+    PNClientState *clientState = [PNClientState stateForClient:client];
+    NSMutableArray<NSString *> *channels = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableDictionary *state = [NSMutableDictionary new];
+    for (NSUInteger channelIdx = 0; channelIdx < count; channelIdx++) {
+
+        NSString *channel = [NSString stringWithFormat:@"benchmark-channel-%@", @(channelIdx)];
+        state[channel] = @{@"index": @(channelIdx), @"status": @"online"};
+        [channels addObject:channel];
+    }
+    [clientState JSONStateMergedWith:state forObjects:channels];
+
+    __block NSUInteger iteration = 0;
+    NSString *name = [NSString stringWithFormat:@"client-state-%@", @(count)];
+    [self measureBenchmark:name iterations:200 usingBlock:^{
+
+        NSString *channel = channels[iteration % count];
+        [clientState JSONStateMergedWith:@{channel: @{@"iteration": @(iteration++)}} forObjects:channels];
+    }];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,167 @@
+#import <XCTest/XCTest.h>
+#import "PNErrorCodes.h"
+#import "PNAES.h"
+
+
+/**
+ @brief      PNAES testing.
+ @discussion Verify Base64 decoding of encrypted payloads, reuse of per-thread cryptors when cipher key change
+             and batch decryption of messages list which contain valid and invalid payloads.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNAESTests : XCTestCase
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose UTF-8 encoded data from string.
+
+ @param string Reference on string which should be encoded.
+
+ @return Encoded string data.
+ */
+- (NSData *)dataFrom:(NSString *)string;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNAESTests
+
+- (void)testBase64DecodingIgnoresWhitespaceAndQuotes {
+
+    NSData *data = [self dataFrom:@"{\"message\":\"Hello world with long enough payload\"}"];
+    NSString *encrypted = [PNAES encrypt:data withKey:@"key"];
+    NSMutableString *formatted = [NSMutableString stringWithString:@"\""];
+    for (NSUInteger offset = 0; offset < encrypted.length; offset += 8) {
+
+        NSRange range = NSMakeRange(offset, MIN(8, encrypted.length - offset));
+        [formatted appendString:[encrypted substringWithRange:range]];
+        [formatted appendString:(offset % 16 ? @"\r\n" : @" \t")];
+    }
+    [formatted appendString:@"\""];
+
+    NSError *error = nil;
+    XCTAssertEqualObjects([PNAES decrypt:formatted withKey:@"key" andError:&error], data);
+    XCTAssertNil(error);
+}
+
+- (void)testBase64DecodingTailLengths {
+
+    // Encrypted data has 16, 32 and 48 bytes, so Base64 strings end with two, one and no padding symbols.
+    for (NSString *payload in @[@"\"a\"", @"\"twenty bytes long\"", @"\"forty bytes long message for last block\""]) {
+
+        NSData *data = [self dataFrom:payload];
+        NSString *encrypted = [PNAES encrypt:data withKey:@"key"];
+        XCTAssertEqualObjects([PNAES decrypt:encrypted withKey:@"key"], data, @"%@", payload);
+    }
+}
+
+- (void)testBase64DecodingMalformed {
+
+    // Data after padding, single symbol tail, too long padding and missing padding.
+    for (NSString *payload in @[@"QUJD=A", @"QUJDR", @"QQ===", @"QUJ", @"QUJDRA="]) {
+
+        NSError *error = nil;
+        NSData *decrypted = [PNAES decrypt:payload withKey:@"key" andError:&error];
+        XCTAssertEqual(error.code, kPNAESDecryptionError, @"%@", payload);
+        XCTAssertTrue([error.localizedDescription rangeOfString:@"Base64"].location != NSNotFound, @"%@", payload);
+
+        // Original data returned for payloads which can't be decoded.
+        XCTAssertEqualObjects(decrypted, [self dataFrom:payload], @"%@", payload);
+    }
+}
+
+- (void)testCryptorReusedAcrossKeys {
+
+    NSData *firstData = [self dataFrom:@"\"first message\""];
+    NSData *secondData = [self dataFrom:@"{\"second\":\"message\"}"];
+    NSString *firstEncrypted = [PNAES encrypt:firstData withKey:@"first-key"];
+    NSString *secondEncrypted = [PNAES encrypt:secondData withKey:@"second-key"];
+
+    // Same initialization vector used for each message, so cryptor state shouldn't leak between calls.
+    XCTAssertEqualObjects([PNAES encrypt:firstData withKey:@"first-key"], firstEncrypted);
+    XCTAssertNotEqualObjects([PNAES encrypt:firstData withKey:@"second-key"], firstEncrypted);
+    XCTAssertEqualObjects([PNAES encrypt:firstData withKey:@"first-key"], firstEncrypted);
+
+    XCTAssertEqualObjects([PNAES decrypt:firstEncrypted withKey:@"first-key"], firstData);
+    XCTAssertEqualObjects([PNAES decrypt:firstEncrypted withKey:@"first-key"], firstData);
+    XCTAssertEqualObjects([PNAES decrypt:secondEncrypted withKey:@"second-key"], secondData);
+    XCTAssertEqualObjects([PNAES decrypt:firstEncrypted withKey:@"first-key"], firstData);
+}
+
+- (void)testCryptorResetAfterFailedDecryption {
+
+    NSData *data = [self dataFrom:@"\"message\""];
+    NSString *encrypted = [PNAES encrypt:data withKey:@"key"];
+
+    // Decoded data isn't multiple of block size, so cryptor will fail to complete decryption.
+    NSError *error = nil;
+    [PNAES decrypt:@"YWJj" withKey:@"key" andError:&error];
+    XCTAssertNotNil(error);
+
+    XCTAssertEqualObjects([PNAES decrypt:encrypted withKey:@"key"], data);
+}
+
+- (void)testBatchDecryptMixedPayloads {
+
+    NSData *firstData = [self dataFrom:@"\"first\""];
+    NSData *secondData = [self dataFrom:@"{\"second\":2}"];
+    NSArray<NSString *> *messages = @[[PNAES encrypt:firstData withKey:@"key"], @"not base64 !!", @"",
+                                      @"YWJj", [PNAES encrypt:secondData withKey:@"key"]];
+    NSArray *decryptedMessages = [PNAES decryptMessages:messages withKey:@"key"];
+
+    XCTAssertEqual(decryptedMessages.count, messages.count);
+    XCTAssertEqualObjects(decryptedMessages[0], firstData);
+    XCTAssertTrue([decryptedMessages[1] isKindOfClass:[NSError class]]);
+    XCTAssertTrue([decryptedMessages[2] isKindOfClass:[NSError class]]);
+    XCTAssertTrue([decryptedMessages[3] isKindOfClass:[NSError class]]);
+    XCTAssertEqualObjects(decryptedMessages[4], secondData);
+}
+
+- (void)testBatchDecryptPreserveOrder {
+
+    NSMutableArray<NSString *> *messages = [NSMutableArray new];
+    NSMutableArray<NSData *> *expectedMessages = [NSMutableArray new];
+    for (NSUInteger messageIdx = 0; messageIdx < 200; messageIdx++) {
+
+        NSData *data = [self dataFrom:[NSString stringWithFormat:@"{\"idx\":%@}", @(messageIdx)]];
+        [messages addObject:(messageIdx % 10 ? [PNAES encrypt:data withKey:@"key"] : @"YWJj")];
+        [expectedMessages addObject:data];
+    }
+
+    // Batch requested from low priority queue should be processed in the same way.
+    __block NSArray *decryptedMessages = nil;
+    dispatch_sync(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+
+        decryptedMessages = [PNAES decryptMessages:messages withKey:@"key"];
+    });
+
+    XCTAssertEqual(decryptedMessages.count, messages.count);
+    for (NSUInteger messageIdx = 0; messageIdx < messages.count; messageIdx++) {
+
+        id decryptedMessage = decryptedMessages[messageIdx];
+        if (messageIdx % 10) { XCTAssertEqualObjects(decryptedMessage, expectedMessages[messageIdx]); }
+        else { XCTAssertTrue([decryptedMessage isKindOfClass:[NSError class]]); }
+    }
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)dataFrom:(NSString *)string {
+
+    return [string dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark -
+
+
+@end
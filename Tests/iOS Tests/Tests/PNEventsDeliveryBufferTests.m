@@ -0,0 +1,320 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNResult+Private.h"
+#import "PNStateListener.h"
+
+
+/**
+ @brief      Events delivery buffer testing.
+ @discussion Verify that when buffer overflown, buffered events handled according to configured policy and
+             overflow reported to state listeners.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNEventsDeliveryBufferTests : XCTestCase <PNObjectEventListener>
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which state listener created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested state listener.
+ */
+@property (nonatomic, strong) PNStateListener *listener;
+
+/**
+ @brief  Stores reference on list of messages which has been delivered to test case.
+ */
+@property (nonatomic, strong) NSMutableArray<PNMessageResult *> *messages;
+
+/**
+ @brief  Stores reference on list of presence events which has been delivered to test case.
+ */
+@property (nonatomic, strong) NSMutableArray<PNPresenceEventResult *> *events;
+
+/**
+ @brief  Stores reference on list of statuses which has been delivered to test case.
+ */
+@property (nonatomic, strong) NSMutableArray<PNStatus *> *statuses;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Create client and state listener with specified buffer configuration.
+
+ @param capacity Maximum number of events which can wait for delivery.
+ @param policy   Policy which should be used when buffer overflown.
+ */
+- (void)setUpListenerWithCapacity:(NSUInteger)capacity policy:(PNEventsDeliveryBufferPolicy)policy;
+
+/**
+ @brief  Compose message result.
+
+ @param message Reference on message payload.
+ @param channel Name of channel from which message has been received.
+
+ @return Configured message result.
+ */
+- (PNMessageResult *)message:(id)message forChannel:(NSString *)channel;
+
+/**
+ @brief  Compose presence event result.
+
+ @param type      Name of presence event (\c join, \c leave, \c interval and etc).
+ @param uuid      Unique identifier of user for which event has been generated (if any).
+ @param occupancy Number of users on channel after event.
+
+ @return Configured presence event result.
+ */
+- (PNPresenceEventResult *)event:(NSString *)type forUUID:(NSString *)uuid occupancy:(NSUInteger)occupancy;
+
+/**
+ @brief  Pass events to state listener in the same way as subscriber does.
+
+ @param events List of messages and presence events which should be passed one-by-one.
+ */
+- (void)notifyEvents:(NSArray<PNResult *> *)events;
+
+/**
+ @brief  Wait till buffered events and statuses will be delivered on callback queue.
+ */
+- (void)waitForDelivery;
+
+/**
+ @brief  Retrieve information about buffer overflow from delivered status.
+
+ @return Overflow status \c data (with \c dropped and \c overflows) or \c nil if overflow not reported.
+ */
+- (NSDictionary *)overflowData;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNEventsDeliveryBufferTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    self.messages = [NSMutableArray new];
+    self.events = [NSMutableArray new];
+    self.statuses = [NSMutableArray new];
+}
+
+- (void)testDropOldestPolicy {
+
+    [self setUpListenerWithCapacity:3 policy:PNDropOldestBufferPolicy];
+    [self notifyEvents:@[[self message:@0 forChannel:@"a"], [self message:@1 forChannel:@"a"],
+                         [self message:@2 forChannel:@"b"], [self message:@3 forChannel:@"a"],
+                         [self message:@4 forChannel:@"b"], [self message:@5 forChannel:@"a"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.messages valueForKeyPath:@"data.message"], (@[@3, @4, @5]));
+    XCTAssertEqualObjects([self overflowData], (@{@"dropped": @3, @"overflows": @3}));
+}
+
+- (void)testLatestPerChannelPolicy {
+
+    // Messages and presence events from same channel doesn't replace each other.
+    [self setUpListenerWithCapacity:3 policy:PNLatestPerChannelBufferPolicy];
+    [self notifyEvents:@[[self message:@"a1" forChannel:@"a"], [self message:@"b1" forChannel:@"b"],
+                         [self message:@"a2" forChannel:@"a"], [self event:@"join" forUUID:@"alice" occupancy:1],
+                         [self message:@"a3" forChannel:@"a"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.messages valueForKeyPath:@"data.message"], (@[@"b1", @"a3"]));
+    XCTAssertEqualObjects([self.events valueForKeyPath:@"data.presence.uuid"], (@[@"alice"]));
+    XCTAssertEqualObjects([self overflowData], (@{@"dropped": @2, @"overflows": @2}));
+}
+
+- (void)testLatestPerChannelPolicyDropOldestChannels {
+
+    [self setUpListenerWithCapacity:2 policy:PNLatestPerChannelBufferPolicy];
+    [self notifyEvents:@[[self message:@"a1" forChannel:@"a"], [self message:@"b1" forChannel:@"b"],
+                         [self message:@"c1" forChannel:@"c"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.messages valueForKeyPath:@"data.message"], (@[@"b1", @"c1"]));
+    XCTAssertEqualObjects([self overflowData][@"dropped"], @1);
+}
+
+- (void)testCoalescePresencePolicy {
+
+    // Only 'join' replaced by 'leave' for same user, messages kept as-is.
+    [self setUpListenerWithCapacity:3 policy:PNCoalescePresenceBufferPolicy];
+    [self notifyEvents:@[[self event:@"join" forUUID:@"alice" occupancy:1], [self message:@"m1" forChannel:@"a"],
+                         [self event:@"leave" forUUID:@"alice" occupancy:0], [self message:@"m2" forChannel:@"a"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.messages valueForKeyPath:@"data.message"], (@[@"m1", @"m2"]));
+    XCTAssertEqualObjects([self.events valueForKeyPath:@"data.presenceEvent"], (@[@"leave"]));
+    XCTAssertEqualObjects([self overflowData], (@{@"dropped": @1, @"overflows": @1}));
+}
+
+- (void)testCoalescePresencePolicyForEventsWithoutUUID {
+
+    [self setUpListenerWithCapacity:2 policy:PNCoalescePresenceBufferPolicy];
+    [self notifyEvents:@[[self event:@"interval" forUUID:nil occupancy:1],
+                         [self event:@"interval" forUUID:nil occupancy:2],
+                         [self event:@"interval" forUUID:nil occupancy:3]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.events valueForKeyPath:@"data.presence.occupancy"], (@[@3]));
+}
+
+- (void)testBlockSubscribeLoopPolicyKeepEvents {
+
+    [self setUpListenerWithCapacity:2 policy:PNBlockSubscribeLoopBufferPolicy];
+    [self notifyEvents:@[[self message:@0 forChannel:@"a"], [self message:@1 forChannel:@"a"],
+                         [self message:@2 forChannel:@"a"], [self message:@3 forChannel:@"a"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects([self.messages valueForKeyPath:@"data.message"], (@[@0, @1, @2, @3]));
+    XCTAssertEqualObjects([self overflowData], (@{@"dropped": @0, @"overflows": @2}));
+}
+
+- (void)testBlockSubscribeLoopPolicyDeferBlockTillDelivery {
+
+    [self setUpListenerWithCapacity:2 policy:PNBlockSubscribeLoopBufferPolicy];
+    [self notifyEvents:@[[self message:@0 forChannel:@"a"], [self message:@1 forChannel:@"a"],
+                         [self message:@2 forChannel:@"a"]]];
+    __block BOOL called = NO;
+    dispatch_queue_t queue = dispatch_queue_create("com.pubnub.test.buffer", DISPATCH_QUEUE_SERIAL);
+    [self.listener performWhenDeliveryBufferHasSpace:^{ called = YES; } onQueue:queue];
+
+    // Delivery scheduled on main queue, so buffer stays overflown while test is waiting.
+    [NSThread sleepForTimeInterval:0.1f];
+    dispatch_sync(queue, ^{});
+    XCTAssertFalse(called);
+
+    [self waitForDelivery];
+    dispatch_sync(queue, ^{});
+    XCTAssertTrue(called);
+}
+
+- (void)testUnlimitedBufferDoesNotDeferBlock {
+
+    [self setUpListenerWithCapacity:0 policy:PNBlockSubscribeLoopBufferPolicy];
+    [self notifyEvents:@[[self message:@0 forChannel:@"a"], [self message:@1 forChannel:@"a"]]];
+    __block BOOL called = NO;
+    dispatch_queue_t queue = dispatch_queue_create("com.pubnub.test.buffer", DISPATCH_QUEUE_SERIAL);
+    [self.listener performWhenDeliveryBufferHasSpace:^{ called = YES; } onQueue:queue];
+    dispatch_sync(queue, ^{});
+
+    XCTAssertTrue(called);
+}
+
+- (void)testUnlimitedBuffer {
+
+    [self setUpListenerWithCapacity:0 policy:PNDropOldestBufferPolicy];
+    [self notifyEvents:@[[self message:@0 forChannel:@"a"], [self message:@1 forChannel:@"a"],
+                         [self message:@2 forChannel:@"a"]]];
+    [self waitForDelivery];
+
+    XCTAssertEqual(self.messages.count, 3);
+    XCTAssertNil([self overflowData]);
+}
+
+
+#pragma mark - Listener
+
+- (void)client:(PubNub *)client didReceiveMessage:(PNMessageResult *)message {
+
+    [self.messages addObject:message];
+}
+
+- (void)client:(PubNub *)client didReceivePresenceEvent:(PNPresenceEventResult *)event {
+
+    [self.events addObject:event];
+}
+
+- (void)client:(PubNub *)client didReceiveStatus:(PNStatus *)status {
+
+    [self.statuses addObject:status];
+}
+
+
+#pragma mark - Misc
+
+- (void)setUpListenerWithCapacity:(NSUInteger)capacity policy:(PNEventsDeliveryBufferPolicy)policy {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.eventsDeliveryBufferCapacity = capacity;
+    configuration.eventsDeliveryBufferPolicy = policy;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.listener = [PNStateListener stateListenerForClient:self.client];
+    [self.listener addListener:self];
+}
+
+- (PNMessageResult *)message:(id)message forChannel:(NSString *)channel {
+
+    return [PNMessageResult objectForOperation:PNSubscribeOperation completedWithTask:nil
+                                 processedData:@{@"subscribedChannel": channel, @"message": message}
+                               processingError:nil];
+}
+
+- (PNPresenceEventResult *)event:(NSString *)type forUUID:(NSString *)uuid occupancy:(NSUInteger)occupancy {
+
+    NSMutableDictionary *presence = [@{@"occupancy": @(occupancy)} mutableCopy];
+    if (uuid) { presence[@"uuid"] = uuid; }
+    NSDictionary *data = @{@"subscribedChannel": @"a-pnpres", @"actualChannel": @"a",
+                           @"presenceEvent": type, @"presence": presence};
+
+    return [PNPresenceEventResult objectForOperation:PNSubscribeOperation completedWithTask:nil
+                                       processedData:data processingError:nil];
+}
+
+- (void)notifyEvents:(NSArray<PNResult *> *)events {
+
+    // Delivery scheduled on main queue, so it won't start till test will wait for it.
+    for (PNResult *event in events) {
+
+        [self.listener notifyWithBlock:^{
+
+            if ([event isKindOfClass:[PNPresenceEventResult class]]) {
+
+                [self.listener notifyPresenceEvent:(PNPresenceEventResult *)event];
+            }
+            else { [self.listener notifyMessage:(PNMessageResult *)event]; }
+        }];
+    }
+}
+
+- (void)waitForDelivery {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Events delivery"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3f * NSEC_PER_SEC)), dispatch_get_main_queue(),
+                   ^{ [expectation fulfill]; });
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+}
+
+- (NSDictionary *)overflowData {
+
+    NSDictionary *data = nil;
+    for (PNStatus *status in self.statuses) {
+
+        if (status.category == PNEventsDeliveryOverflowCategory) { data = ((PNErrorStatus *)status).errorData.data; }
+    }
+
+    return data;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,198 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNResult+Private.h"
+#import "PNStateListener.h"
+
+
+/**
+ @brief      Events delivery time slicing testing.
+ @discussion Verify that buffered events delivered in slices which doesn't exceed configured bounds and that
+             callback queue able to process other blocks between slices.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNEventsDeliverySliceTests : XCTestCase <PNObjectEventListener>
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which state listener created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested state listener.
+ */
+@property (nonatomic, strong) PNStateListener *listener;
+
+/**
+ @brief  Stores reference on list of numbers of messages which has been delivered during each slice.
+ */
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *sliceSizes;
+
+/**
+ @brief  Stores reference on list of received messages payloads.
+ */
+@property (nonatomic, strong) NSMutableArray *messages;
+
+/**
+ @brief      Stores whether messages delivered within slice which is tracked by last \c sliceSizes entry.
+ @discussion Flag reset by block scheduled on callback queue, so it will be called only between slices.
+ */
+@property (nonatomic, assign, getter = isSliceOpened) BOOL sliceOpened;
+
+/**
+ @brief  Stores for how long listener should process each batch of messages.
+ */
+@property (nonatomic, assign) NSTimeInterval batchProcessingDuration;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Create client and state listener with specified slice configuration.
+
+ @param duration     Maximum time which can be spent on single slice.
+ @param maximumCount Maximum number of events which can be delivered during single slice.
+ */
+- (void)setUpListenerWithSliceDuration:(NSTimeInterval)duration maximumCount:(NSUInteger)maximumCount;
+
+/**
+ @brief  Pass messages to state listener in the same way as subscriber does.
+
+ @param count Number of messages which should be passed.
+ */
+- (void)notifyMessagesCount:(NSUInteger)count;
+
+/**
+ @brief  Wait till buffered events will be delivered on callback queue.
+ */
+- (void)waitForDelivery;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNEventsDeliverySliceTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    self.sliceSizes = [NSMutableArray new];
+    self.messages = [NSMutableArray new];
+    self.sliceOpened = NO;
+    self.batchProcessingDuration = 0.f;
+}
+
+- (void)testNotSlicedByDefault {
+
+    [self setUpListenerWithSliceDuration:0.f maximumCount:0];
+    [self notifyMessagesCount:40];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects(self.sliceSizes, (@[@40]));
+}
+
+- (void)testSliceMaximumCount {
+
+    [self setUpListenerWithSliceDuration:0.f maximumCount:3];
+    [self notifyMessagesCount:10];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects(self.sliceSizes, (@[@3, @3, @3, @1]));
+}
+
+- (void)testSliceDuration {
+
+    // Budget exhausted by first chunk, so each slice has single chunk.
+    self.batchProcessingDuration = 0.005f;
+    [self setUpListenerWithSliceDuration:0.001f maximumCount:0];
+    [self notifyMessagesCount:40];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects(self.sliceSizes, (@[@16, @16, @8]));
+}
+
+- (void)testSliceEndsWithFirstReachedLimit {
+
+    [self setUpListenerWithSliceDuration:10.f maximumCount:5];
+    [self notifyMessagesCount:12];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects(self.sliceSizes, (@[@5, @5, @2]));
+}
+
+- (void)testSlicesDeliverMessagesInOrder {
+
+    [self setUpListenerWithSliceDuration:0.f maximumCount:4];
+    [self notifyMessagesCount:10];
+    [self waitForDelivery];
+
+    XCTAssertEqualObjects(self.messages, (@[@0, @1, @2, @3, @4, @5, @6, @7, @8, @9]));
+}
+
+
+#pragma mark - Listener
+
+- (void)client:(PubNub *)client didReceiveMessages:(NSArray<PNMessageResult *> *)messages {
+
+    if (!self.isSliceOpened) {
+
+        self.sliceOpened = YES;
+        [self.sliceSizes addObject:@0];
+        dispatch_async(dispatch_get_main_queue(), ^{ self.sliceOpened = NO; });
+    }
+    self.sliceSizes[self.sliceSizes.count - 1] = @(self.sliceSizes.lastObject.unsignedIntegerValue + messages.count);
+    [self.messages addObjectsFromArray:[messages valueForKeyPath:@"data.message"]];
+    if (self.batchProcessingDuration > 0.f) { [NSThread sleepForTimeInterval:self.batchProcessingDuration]; }
+}
+
+
+#pragma mark - Misc
+
+- (void)setUpListenerWithSliceDuration:(NSTimeInterval)duration maximumCount:(NSUInteger)maximumCount {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.eventsDeliverySliceDuration = duration;
+    configuration.eventsDeliverySliceMaximumCount = maximumCount;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.listener = [PNStateListener stateListenerForClient:self.client];
+    [self.listener addListener:self];
+}
+
+- (void)notifyMessagesCount:(NSUInteger)count {
+
+    // Delivery scheduled on main queue, so it won't start till test will wait for it.
+    for (NSUInteger messageIdx = 0; messageIdx < count; messageIdx++) {
+
+        PNMessageResult *message = [PNMessageResult objectForOperation:PNSubscribeOperation completedWithTask:nil
+                                                         processedData:@{@"subscribedChannel": @"a",
+                                                                         @"message": @(messageIdx)}
+                                                       processingError:nil];
+        [self.listener notifyWithBlock:^{ [self.listener notifyMessage:message]; }];
+    }
+}
+
+- (void)waitForDelivery {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Events delivery"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5f * NSEC_PER_SEC)), dispatch_get_main_queue(),
+                   ^{ [expectation fulfill]; });
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,326 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PubNub+CorePrivate.h"
+#import "PNStatus+Private.h"
+#import "PNResult+Private.h"
+#import "PNStateListener.h"
+#import "PNSubscriber.h"
+
+
+#pragma mark Private interfaces
+
+/**
+ @brief  State listener private interface which is used to wait for listeners list update.
+ */
+@interface PNStateListener (PNTest)
+
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+@end
+
+
+/**
+ @brief  Subscriber private interface which is used to pass received events for processing.
+ */
+@interface PNSubscriber (PNTest)
+
+- (void)handleLiveFeedEvents:(PNSubscribeStatus *)status;
+
+@end
+
+
+/**
+ @brief      Events processing workers testing.
+ @discussion Verify that events from same channel processed and delivered on same worker in order in which
+             they has been received, while events from different channels processed in parallel.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNEventsProcessingWorkersTests : XCTestCase <PNObjectEventListener>
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client which process events on workers.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on map of channel names to list of received events (message payloads and presence
+         event names).
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray *> *channelEvents;
+
+/**
+ @brief  Stores reference on map of channel names to set of queue labels on which events has been delivered.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *channelQueues;
+
+/**
+ @brief  Stores name of channel for which listener should wait on \c slowChannelSemaphore.
+ */
+@property (nonatomic, copy) NSString *slowChannel;
+
+/**
+ @brief  Stores reference on semaphore which is used to hold processing of \c slowChannel events.
+ */
+@property (nonatomic, strong) dispatch_semaphore_t slowChannelSemaphore;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Pass events to subscriber in the same way as it is done when subscribe response received.
+
+ @param events List of events in format which is used by subscribe parser.
+ */
+- (void)handleEvents:(NSArray<NSDictionary *> *)events;
+
+/**
+ @brief  Compose message event.
+
+ @param message Reference on message payload.
+ @param channel Name of channel from which message has been received.
+
+ @return Message event in format which is used by subscribe parser.
+ */
+- (NSDictionary *)message:(id)message forChannel:(NSString *)channel;
+
+/**
+ @brief  Compose presence event.
+
+ @param type    Name of presence event (\c join, \c leave and etc).
+ @param channel Name of channel (w/o presence suffix) for which event has been generated.
+
+ @return Presence event in format which is used by subscribe parser.
+ */
+- (NSDictionary *)event:(NSString *)type forChannel:(NSString *)channel;
+
+/**
+ @brief  Store information about delivered event.
+
+ @param event   Message payload or presence event name.
+ @param channel Name of channel from which event has been received.
+ */
+- (void)storeEvent:(id)event forChannel:(NSString *)channel;
+
+/**
+ @brief  Wait till listener will receive specified number of events.
+
+ @param count Number of events which should be received.
+
+ @return Whether all events has been received or not.
+ */
+- (BOOL)waitForEventsCount:(NSUInteger)count;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNEventsProcessingWorkersTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.eventsProcessingWorkersCount = 4;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.channelEvents = [NSMutableDictionary new];
+    self.channelQueues = [NSMutableDictionary new];
+    self.slowChannelSemaphore = dispatch_semaphore_create(0);
+    [self.client addListener:self];
+    dispatch_sync(self.client.listenersManager.resourceAccessQueue, ^{});
+}
+
+- (void)tearDown {
+
+    [self.client removeListener:self];
+    dispatch_semaphore_signal(self.slowChannelSemaphore);
+
+
+    // Forward method call to the super class.
+    [super tearDown];
+}
+
+- (void)testWorkerForChannel {
+
+    PNStateListener *listener = self.client.listenersManager;
+    XCTAssertEqual(listener.eventsProcessingWorkersCount, 4);
+    XCTAssertEqual([listener workerForChannel:@"a"], [listener workerForChannel:@"a"]);
+    for (NSUInteger channelIdx = 0; channelIdx < 100; channelIdx++) {
+
+        XCTAssertLessThan([listener workerForChannel:[NSString stringWithFormat:@"channel-%@", @(channelIdx)]], 4);
+    }
+}
+
+- (void)testPerChannelOrder {
+
+    // Each response has events from all channels, so each worker receive new block for each response.
+    NSUInteger channelsCount = 8;
+    NSUInteger responsesCount = 5;
+    NSUInteger messagesPerResponse = 4;
+    for (NSUInteger responseIdx = 0; responseIdx < responsesCount; responseIdx++) {
+
+        NSMutableArray *events = [NSMutableArray new];
+        for (NSUInteger messageIdx = 0; messageIdx < messagesPerResponse; messageIdx++) {
+
+            for (NSUInteger channelIdx = 0; channelIdx < channelsCount; channelIdx++) {
+
+                NSString *channel = [NSString stringWithFormat:@"channel-%@", @(channelIdx)];
+                [events addObject:[self message:@(responseIdx * messagesPerResponse + messageIdx) forChannel:channel]];
+            }
+        }
+        [self handleEvents:events];
+    }
+    XCTAssertTrue([self waitForEventsCount:(channelsCount * responsesCount * messagesPerResponse)]);
+
+    NSMutableArray *expectedMessages = [NSMutableArray new];
+    for (NSUInteger messageIdx = 0; messageIdx < responsesCount * messagesPerResponse; messageIdx++) {
+
+        [expectedMessages addObject:@(messageIdx)];
+    }
+    @synchronized (self) {
+
+        XCTAssertEqual(self.channelEvents.count, channelsCount);
+        [self.channelEvents enumerateKeysAndObjectsUsingBlock:^(NSString *channel, NSMutableArray *messages,
+                                                                __unused BOOL *stop) {
+
+            XCTAssertEqualObjects(messages, expectedMessages, @"Channel: %@", channel);
+            XCTAssertEqual(self.channelQueues[channel].count, 1, @"Channel: %@", channel);
+            XCTAssertTrue([self.channelQueues[channel].anyObject hasPrefix:@"com.pubnub.listener.worker."]);
+        }];
+    }
+}
+
+- (void)testPresenceEventsProcessedWithChannelMessages {
+
+    [self handleEvents:@[[self message:@0 forChannel:@"a"], [self event:@"join" forChannel:@"a"]]];
+    [self handleEvents:@[[self message:@1 forChannel:@"a"], [self event:@"leave" forChannel:@"a"]]];
+    XCTAssertTrue([self waitForEventsCount:4]);
+
+    @synchronized (self) {
+
+        XCTAssertEqualObjects(self.channelEvents[@"a"], (@[@0, @"join", @1, @"leave"]));
+        XCTAssertEqual(self.channelQueues[@"a"].count, 1);
+    }
+}
+
+- (void)testDifferentChannelsProcessedInParallel {
+
+    // Find channel which is processed by different worker.
+    PNStateListener *listener = self.client.listenersManager;
+    NSString *fastChannel = nil;
+    for (NSUInteger channelIdx = 0; !fastChannel; channelIdx++) {
+
+        NSString *channel = [NSString stringWithFormat:@"channel-%@", @(channelIdx)];
+        if ([listener workerForChannel:channel] != [listener workerForChannel:@"slow"]) { fastChannel = channel; }
+    }
+    self.slowChannel = @"slow";
+
+    [self handleEvents:@[[self message:@0 forChannel:@"slow"], [self message:@0 forChannel:fastChannel]]];
+    [self handleEvents:@[[self message:@1 forChannel:@"slow"], [self message:@1 forChannel:fastChannel]]];
+
+    // Events from 'slow' channel blocked, but shouldn't affect other channel.
+    XCTAssertTrue([self waitForEventsCount:2]);
+    @synchronized (self) {
+
+        XCTAssertEqualObjects(self.channelEvents[fastChannel], (@[@0, @1]));
+        XCTAssertNil(self.channelEvents[@"slow"]);
+    }
+
+    dispatch_semaphore_signal(self.slowChannelSemaphore);
+    dispatch_semaphore_signal(self.slowChannelSemaphore);
+    XCTAssertTrue([self waitForEventsCount:4]);
+    @synchronized (self) { XCTAssertEqualObjects(self.channelEvents[@"slow"], (@[@0, @1])); }
+}
+
+
+#pragma mark - Listener
+
+- (void)client:(PubNub *)client didReceiveMessage:(PNMessageResult *)message {
+
+    NSString *channel = (message.data.actualChannel?: message.data.subscribedChannel);
+    if ([channel isEqualToString:self.slowChannel]) {
+
+        dispatch_semaphore_wait(self.slowChannelSemaphore,
+                                dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.f * NSEC_PER_SEC)));
+    }
+    [self storeEvent:message.data.message forChannel:channel];
+}
+
+- (void)client:(PubNub *)client didReceivePresenceEvent:(PNPresenceEventResult *)event {
+
+    [self storeEvent:event.data.presenceEvent forChannel:(event.data.actualChannel?: event.data.subscribedChannel)];
+}
+
+
+#pragma mark - Misc
+
+- (void)handleEvents:(NSArray<NSDictionary *> *)events {
+
+    // Subscriber modify presence events, so they should be mutable.
+    NSMutableArray *mutableEvents = [NSMutableArray new];
+    for (NSDictionary *event in events) { [mutableEvents addObject:[event mutableCopy]]; }
+    PNSubscribeStatus *status = [PNSubscribeStatus statusForOperation:PNSubscribeOperation
+                                                             category:PNAcknowledgmentCategory
+                                                  withProcessingError:nil];
+    [status updateData:@{@"events": mutableEvents, @"timetoken": @1, @"region": @1}];
+    [self.client.subscriberManager handleLiveFeedEvents:status];
+}
+
+- (NSDictionary *)message:(id)message forChannel:(NSString *)channel {
+
+    return @{@"subscribedChannel": channel, @"message": message};
+}
+
+- (NSDictionary *)event:(NSString *)type forChannel:(NSString *)channel {
+
+    return @{@"subscribedChannel": [channel stringByAppendingString:@"-pnpres"], @"presenceEvent": type,
+             @"presence": @{@"uuid": @"alice", @"occupancy": @1}};
+}
+
+- (void)storeEvent:(id)event forChannel:(NSString *)channel {
+
+    NSString *queue = @(dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+    @synchronized (self) {
+
+        if (!self.channelEvents[channel]) { self.channelEvents[channel] = [NSMutableArray new]; }
+        if (!self.channelQueues[channel]) { self.channelQueues[channel] = [NSMutableSet new]; }
+        [self.channelEvents[channel] addObject:event];
+        [self.channelQueues[channel] addObject:queue];
+    }
+}
+
+- (BOOL)waitForEventsCount:(NSUInteger)count {
+
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.f];
+    BOOL received = NO;
+    while (!received && [timeoutDate timeIntervalSinceNow] > 0.f) {
+
+        NSUInteger receivedCount = 0;
+        @synchronized (self) {
+
+            for (NSArray *events in self.channelEvents.allValues) { receivedCount += events.count; }
+        }
+        received = (receivedCount >= count);
+        if (!received) { [NSThread sleepForTimeInterval:0.01f]; }
+    }
+
+    return received;
+}
+
+#pragma mark -
+
+
+@end
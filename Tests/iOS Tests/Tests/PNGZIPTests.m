@@ -0,0 +1,160 @@
+#import <XCTest/XCTest.h>
+#import "PNGZIP.h"
+
+
+/**
+ @brief      PNGZIP testing.
+ @discussion Verify that data compressed with any level and strategy can be uncompressed back and that
+             per-thread streams doesn't leak state between calls.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNGZIPTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on serialized message which is used for compression.
+ */
+@property (nonatomic, strong) NSData *message;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose data filled with pseudo-random bytes (which can't be compressed well).
+
+ @param length Length of data which should be composed.
+
+ @return Composed data.
+ */
+- (NSData *)randomDataWithLength:(NSUInteger)length;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNGZIPTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    NSMutableArray *entries = [NSMutableArray new];
+    for (NSUInteger entryIdx = 0; entryIdx < 200; entryIdx++) {
+
+        [entries addObject:@{@"idx": @(entryIdx), @"text": @"Hello real-time world!"}];
+    }
+    self.message = [NSJSONSerialization dataWithJSONObject:entries options:(NSJSONWritingOptions)0 error:nil];
+}
+
+- (void)testRoundTrip {
+
+    NSData *compressed = [PNGZIP GZIPDeflatedData:self.message];
+    const uint8_t *bytes = compressed.bytes;
+
+    XCTAssertNotNil(compressed);
+    XCTAssertLessThan(compressed.length, self.message.length);
+    XCTAssertEqual(bytes[0], 0x1f);
+    XCTAssertEqual(bytes[1], 0x8b);
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressed], self.message);
+}
+
+- (void)testRoundTripForEachLevelAndStrategy {
+
+    // Same thread stream reused with different parameters.
+    PNCompressionStrategy strategies[] = {PNDefaultCompressionStrategy, PNFilteredCompressionStrategy,
+                                          PNHuffmanOnlyCompressionStrategy, PNRLECompressionStrategy};
+    for (NSUInteger strategyIdx = 0; strategyIdx < sizeof(strategies) / sizeof(strategies[0]); strategyIdx++) {
+
+        for (NSInteger level = -1; level <= 9; level++) {
+
+            NSData *compressed = [PNGZIP GZIPDeflatedData:self.message withLevel:level
+                                                 strategy:strategies[strategyIdx]];
+            XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressed], self.message,
+                                  @"Level: %@, strategy: %@", @(level), @(strategies[strategyIdx]));
+        }
+    }
+}
+
+- (void)testRoundTripForIncompressibleData {
+
+    NSData *data = [self randomDataWithLength:64 * 1024];
+    NSData *compressed = [PNGZIP GZIPDeflatedData:data];
+
+    XCTAssertNotNil(compressed);
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressed], data);
+}
+
+- (void)testSequentialCallsDoesNotShareState {
+
+    NSData *data = [self randomDataWithLength:1024];
+    NSData *compressedMessage = [PNGZIP GZIPDeflatedData:self.message];
+    NSData *compressedData = [PNGZIP GZIPDeflatedData:data];
+
+    XCTAssertEqualObjects([PNGZIP GZIPDeflatedData:self.message], compressedMessage);
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressedData], data);
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressedMessage], self.message);
+}
+
+- (void)testRoundTripOnConcurrentThreads {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Concurrent compression"];
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_group_t group = dispatch_group_create();
+    __block BOOL allMatched = YES;
+    NSObject *lock = [NSObject new];
+    for (NSUInteger iterationIdx = 0; iterationIdx < 50; iterationIdx++) {
+
+        dispatch_group_async(group, queue, ^{
+
+            NSData *data = [self randomDataWithLength:(512 + iterationIdx * 64)];
+            NSData *message = ((iterationIdx % 2) ? self.message : data);
+            BOOL matched = [[PNGZIP GZIPInflatedData:[PNGZIP GZIPDeflatedData:message]] isEqualToData:message];
+            @synchronized (lock) { allMatched = (allMatched && matched); }
+        });
+    }
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{ [expectation fulfill]; });
+    [self waitForExpectationsWithTimeout:10.f handler:nil];
+
+    XCTAssertTrue(allMatched);
+}
+
+- (void)testMalformedData {
+
+    NSData *compressed = [PNGZIP GZIPDeflatedData:self.message];
+
+    XCTAssertNil([PNGZIP GZIPDeflatedData:[NSData data]]);
+    XCTAssertNil([PNGZIP GZIPInflatedData:[NSData data]]);
+    XCTAssertNil([PNGZIP GZIPInflatedData:[compressed subdataWithRange:NSMakeRange(0, compressed.length / 2)]]);
+    XCTAssertNil([PNGZIP GZIPInflatedData:self.message]);
+
+    // Stream should be usable after failure.
+    XCTAssertEqualObjects([PNGZIP GZIPInflatedData:compressed], self.message);
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)randomDataWithLength:(NSUInteger)length {
+
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger byteIdx = 0; byteIdx < length; byteIdx++) { bytes[byteIdx] = (uint8_t)arc4random_uniform(256); }
+
+    return data;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,126 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNMetrics+Private.h"
+#import "PubNub+CorePrivate.h"
+
+
+/**
+ @brief      PNMetrics testing.
+ @discussion Verify that metrics snapshot calculate averages and rates from client-wide counters.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNMetricsTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on counters which is used to build metrics snapshots.
+ */
+@property (nonatomic, assign) PNMetricsCounters *counters;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNMetricsTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    self.counters = calloc(1, sizeof(PNMetricsCounters));
+}
+
+- (void)tearDown {
+
+    free(self.counters);
+    self.counters = NULL;
+
+
+    // Forward method call to the super class.
+    [super tearDown];
+}
+
+- (void)testCountersCopiedToSnapshot {
+
+    PNMetricsAdd(self.counters, messagesReceived, 10);
+    PNMetricsAdd(self.counters, presenceEventsReceived, 3);
+    PNMetricsAdd(self.counters, bytesReceived, 2048);
+    PNMetricsIncrement(self.counters, publishesInFlight);
+    PNMetricsIncrement(self.counters, publishesInFlight);
+    PNMetricsDecrement(self.counters, publishesInFlight);
+    PNMetricsStore(self.counters, deliveryBacklog, 42);
+    PNMetrics *metrics = [PNMetrics metricsWithCounters:self.counters previousMetrics:nil startDate:[NSDate date]];
+
+    XCTAssertEqual(metrics.messagesReceived, 10);
+    XCTAssertEqual(metrics.presenceEventsReceived, 3);
+    XCTAssertEqual(metrics.bytesReceived, 2048);
+    XCTAssertEqual(metrics.publishesInFlight, 1);
+    XCTAssertEqual(metrics.deliveryBacklog, 42);
+}
+
+- (void)testAverages {
+
+    // Durations stored in microseconds.
+    PNMetricsAdd(self.counters, subscribeCycles, 4);
+    PNMetricsAdd(self.counters, subscribeCycleLatency, 2000000);
+    PNMetricsStore(self.counters, lastSubscribeCycleLatency, 250000);
+    PNMetricsAdd(self.counters, pollGaps, 2);
+    PNMetricsAdd(self.counters, pollGap, 3000);
+    PNMetricsAdd(self.counters, deliverySlices, 3);
+    PNMetricsAdd(self.counters, deliverySlicesEvents, 30);
+    PNMetrics *metrics = [PNMetrics metricsWithCounters:self.counters previousMetrics:nil startDate:[NSDate date]];
+
+    XCTAssertEqualWithAccuracy(metrics.averageSubscribeCycleLatency, 0.5, 0.0001);
+    XCTAssertEqualWithAccuracy(metrics.lastSubscribeCycleLatency, 0.25, 0.0001);
+    XCTAssertEqualWithAccuracy(metrics.averagePollGap, 0.0015, 0.0001);
+    XCTAssertEqualWithAccuracy(metrics.averageDeliverySliceSize, 10.0, 0.0001);
+    XCTAssertEqual(metrics.averagePublishQueueWait, 0.f);
+}
+
+- (void)testRatesCalculatedSincePreviousSnapshot {
+
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceNow:-2.f];
+    PNMetricsAdd(self.counters, messagesReceived, 100);
+    PNMetrics *metrics = [PNMetrics metricsWithCounters:self.counters previousMetrics:nil startDate:startDate];
+    XCTAssertEqualWithAccuracy(metrics.interval, 2.f, 0.1f);
+    XCTAssertEqualWithAccuracy(metrics.messagesPerSecond, 50.f, 3.f);
+
+    // Messages received before previous snapshot shouldn't affect rate.
+    [NSThread sleepForTimeInterval:0.5f];
+    PNMetricsAdd(self.counters, messagesReceived, 10);
+    PNMetrics *nextMetrics = [PNMetrics metricsWithCounters:self.counters previousMetrics:metrics
+                                                  startDate:startDate];
+    XCTAssertEqual(nextMetrics.messagesReceived, 110);
+    XCTAssertEqualWithAccuracy(nextMetrics.interval, 0.5f, 0.1f);
+    XCTAssertEqualWithAccuracy(nextMetrics.messagesPerSecond, 20.f, 4.f);
+}
+
+- (void)testClientSnapshot {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    PubNub *client = [PubNub clientWithConfiguration:configuration];
+    XCTAssertEqual([client metrics].messagesReceived, 0);
+
+    PNMetricsAdd(client.metricsCounters, messagesReceived, 5);
+    PNMetricsIncrement(client.metricsCounters, subscribeRetries);
+    PNMetrics *metrics = [client metrics];
+    XCTAssertEqual(metrics.messagesReceived, 5);
+    XCTAssertEqual(metrics.subscribeRetries, 1);
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,156 @@
+#import <XCTest/XCTest.h>
+#import "PNSubscribeStreamParser.h"
+#import "PNParsingExecutor.h"
+#import <libkern/OSAtomic.h>
+
+
+/**
+ @brief      PNParsingExecutor testing.
+ @discussion Verify that executor run passed blocks and that streamed subscribe responses processed on it.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNParsingExecutorTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on executor which is used by test case.
+ */
+@property (nonatomic, strong) PNParsingExecutor *executor;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose subscribe response body.
+
+ @param count Number of messages which should be placed into response.
+
+ @return Serialized subscribe response.
+ */
+- (NSData *)subscribeResponseWithMessagesCount:(NSUInteger)count;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNParsingExecutorTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    self.executor = [PNParsingExecutor executorWithIdentifier:@"com.pubnub.tests.parsing"
+                                             qualityOfService:PNUserInitiatedQualityOfService
+                                           maximumConcurrency:2];
+}
+
+- (void)testExecutedBlocksCounted {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Blocks execution"];
+    dispatch_group_t group = dispatch_group_create();
+    __block int32_t executedBlocksCount = 0;
+    for (NSUInteger blockIdx = 0; blockIdx < 10; blockIdx++) {
+
+        dispatch_group_enter(group);
+        [self.executor executeBlock:^{ OSAtomicIncrement32(&executedBlocksCount); }
+                     withCompletion:^(PNParsingTimings timings) {
+
+            XCTAssertGreaterThanOrEqual(timings.executionTime, 0.f);
+            dispatch_group_leave(group);
+        }];
+    }
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{ [expectation fulfill]; });
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+
+    XCTAssertEqual(executedBlocksCount, 10);
+    XCTAssertEqual(self.executor.statistics.executedBlocksCount, 10);
+}
+
+- (void)testStreamedSubscribeResponseProcessedOnExecutor {
+
+    NSData *response = [self subscribeResponseWithMessagesCount:40];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil
+                                                                               executor:self.executor];
+
+    // Feed response with small chunks to emulate data arrival from network.
+    for (NSUInteger offset = 0; offset < response.length; offset += 64) {
+
+        NSRange range = NSMakeRange(offset, MIN(64, response.length - offset));
+        XCTAssertTrue([parser appendData:[response subdataWithRange:range]]);
+    }
+    XCTAssertTrue(parser.isCompleted);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Response processing"];
+    __block NSDictionary *processedResponse = nil;
+    [parser processedResponseOnQueue:dispatch_get_main_queue() withCompletion:^(NSDictionary *data) {
+
+        processedResponse = data;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+
+    NSArray<NSDictionary *> *events = processedResponse[@"events"];
+    XCTAssertEqualObjects(processedResponse[@"timetoken"], @14630027081471920);
+    XCTAssertEqual(events.count, 40);
+    for (NSUInteger eventIdx = 0; eventIdx < events.count; eventIdx++) {
+
+        XCTAssertEqualObjects(events[eventIdx][@"message"], @{@"idx": @(eventIdx)});
+        XCTAssertEqualObjects(events[eventIdx][@"timetoken"], @14630027081471920);
+    }
+
+    // Events captured from response should be processed in two batches on executor.
+    XCTAssertEqual(self.executor.statistics.executedBlocksCount, 2);
+}
+
+- (void)testMalformedStreamedSubscribeEvent {
+
+    // Event object boundaries valid, so it will be captured and rejected only on executor.
+    NSData *response = [@"{\"t\":{\"t\":\"14630027081471920\",\"r\":1},\"m\":[{\"a\" 1}]}"
+                        dataUsingEncoding:NSUTF8StringEncoding];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil
+                                                                               executor:self.executor];
+    [parser appendData:response];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Response processing"];
+    __block NSDictionary *processedResponse = @{};
+    [parser processedResponseOnQueue:dispatch_get_main_queue() withCompletion:^(NSDictionary *data) {
+
+        processedResponse = data;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+
+    XCTAssertNil(processedResponse);
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)subscribeResponseWithMessagesCount:(NSUInteger)count {
+
+    NSMutableArray *events = [NSMutableArray new];
+    for (NSUInteger eventIdx = 0; eventIdx < count; eventIdx++) {
+
+        [events addObject:@{@"a": @"1", @"b": @"test-channel", @"c": @"test-channel", @"d": @{@"idx": @(eventIdx)},
+                            @"k": @"demo"}];
+    }
+    NSDictionary *response = @{@"t": @{@"t": @"14630027081471920", @"r": @1}, @"m": events};
+
+    return [NSJSONSerialization dataWithJSONObject:response options:(NSJSONWritingOptions)0 error:nil];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,300 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PubNub+CorePrivate.h"
+#import "PNPresenceIndex.h"
+#import "PNResult+Private.h"
+
+
+#pragma mark Private interfaces
+
+/**
+ @brief  Presence index private interface which is used by tests to prepare entries.
+ */
+@interface PNPresenceIndex (PNTest)
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *entries;
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+- (void)applyHereNowData:(PNPresenceChannelHereNowData *)data toEntry:(id)entry;
+
+@end
+
+
+/**
+ @brief      PNPresenceIndex testing.
+ @discussion Verify that presence events applied on top of here now information in order in which they has been
+             generated.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPresenceIndexTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which presence index created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested presence index.
+ */
+@property (nonatomic, strong) PNPresenceIndex *index;
+
+/**
+ @brief  Stores reference on presence information entry which has been created for \c test channel.
+ */
+@property (nonatomic, strong) id entry;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose presence event.
+
+ @param type      Presence event type (join, leave, timeout, state-change or interval).
+ @param uuid      Unique identifier of subscriber which triggered event.
+ @param occupancy Number of subscribers after event.
+ @param timetoken Time when event has been generated.
+ @param state     Subscriber's state which has been passed along with event.
+
+ @return Constructed presence event result.
+ */
+- (PNPresenceEventResult *)event:(NSString *)type forUUID:(NSString *)uuid occupancy:(NSUInteger)occupancy
+                       timetoken:(unsigned long long)timetoken state:(NSDictionary *)state;
+
+/**
+ @brief  Compose \c interval presence event with subscribers list changes.
+
+ @param changes   Dictionary with \c join, \c leave and \c timeout lists of unique identifiers.
+ @param occupancy Number of subscribers after event.
+ @param timetoken Time when event has been generated.
+
+ @return Constructed presence event result.
+ */
+- (PNPresenceEventResult *)intervalEventWithChanges:(NSDictionary<NSString *, NSArray *> *)changes
+                                          occupancy:(NSUInteger)occupancy timetoken:(unsigned long long)timetoken;
+
+/**
+ @brief  Seed \c test channel entry with here now information.
+
+ @param uuids     List of subscribers' here now information (dictionaries with \c uuid and \c state).
+ @param occupancy Number of subscribers.
+ */
+- (void)seedWithUUIDs:(NSArray<NSDictionary *> *)uuids occupancy:(NSUInteger)occupancy;
+
+/**
+ @brief  Retrieve list of subscribers' unique identifiers from local here now information.
+
+ @return Set of unique identifiers.
+ */
+- (NSSet<NSString *> *)localUUIDs;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNPresenceIndexTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.index = self.client.presenceIndex;
+    self.entry = [NSClassFromString(@"PNPresenceIndexEntry") new];
+    dispatch_barrier_sync(self.index.resourceAccessQueue, ^{ self.index.entries[@"test"] = self.entry; });
+}
+
+- (void)testNotSeededChannel {
+
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"bob" occupancy:1 timetoken:10 state:nil]];
+    XCTAssertNil([self.index hereNowForChannel:@"test"]);
+    XCTAssertNil([self.index hereNowForChannel:@"unknown"]);
+}
+
+- (void)testJoinEvent {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}] occupancy:1];
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"bob" occupancy:2 timetoken:10
+                                          state:@{@"mood": @"happy"}]];
+
+    NSDictionary *hereNow = [self.index hereNowForChannel:@"test"];
+    XCTAssertEqualObjects(hereNow[@"occupancy"], @2);
+    XCTAssertEqualObjects([self localUUIDs], ([NSSet setWithArray:@[@"alice", @"bob"]]));
+    XCTAssertTrue([hereNow[@"uuids"] containsObject:(@{@"uuid": @"bob", @"state": @{@"mood": @"happy"}})]);
+}
+
+- (void)testLeaveAndTimeoutEvents {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}, @{@"uuid": @"bob", @"state": @{@"mood": @"happy"}},
+                          @{@"uuid": @"carol"}] occupancy:3];
+    [self.index handlePresenceEvent:[self event:@"leave" forUUID:@"bob" occupancy:2 timetoken:10 state:nil]];
+    [self.index handlePresenceEvent:[self event:@"timeout" forUUID:@"carol" occupancy:1 timetoken:11
+                                          state:nil]];
+
+    XCTAssertEqualObjects([self.index hereNowForChannel:@"test"][@"occupancy"], @1);
+    XCTAssertEqualObjects([self localUUIDs], [NSSet setWithObject:@"alice"]);
+
+    // Re-joined subscriber shouldn't get state which it had before leave.
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"bob" occupancy:2 timetoken:12 state:nil]];
+    XCTAssertTrue([[self.index hereNowForChannel:@"test"][@"uuids"] containsObject:@{@"uuid": @"bob"}]);
+}
+
+- (void)testStateChangeEvent {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice", @"state": @{@"mood": @"sad"}}] occupancy:1];
+    [self.index handlePresenceEvent:[self event:@"state-change" forUUID:@"alice" occupancy:1 timetoken:10
+                                          state:@{@"mood": @"happy"}]];
+
+    NSDictionary *hereNow = [self.index hereNowForChannel:@"test"];
+    XCTAssertEqualObjects(hereNow[@"occupancy"], @1);
+    XCTAssertEqualObjects(hereNow[@"uuids"], (@[@{@"uuid": @"alice", @"state": @{@"mood": @"happy"}}]));
+}
+
+- (void)testIntervalEvent {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}] occupancy:1];
+    [self.index handlePresenceEvent:[self event:@"interval" forUUID:nil occupancy:25 timetoken:10 state:nil]];
+
+    NSDictionary *hereNow = [self.index hereNowForChannel:@"test"];
+    XCTAssertEqualObjects(hereNow[@"occupancy"], @25);
+    XCTAssertEqualObjects([self localUUIDs], [NSSet setWithObject:@"alice"]);
+}
+
+- (void)testIntervalEventWithChanges {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}, @{@"uuid": @"bob", @"state": @{@"mood": @"happy"}},
+                          @{@"uuid": @"carol"}] occupancy:3];
+    [self.index handlePresenceEvent:[self intervalEventWithChanges:@{@"join": @[@"dave", @"erin"],
+                                                                     @"leave": @[@"bob"], @"timeout": @[@"carol"]}
+                                                         occupancy:3 timetoken:10]];
+
+    XCTAssertEqualObjects([self.index hereNowForChannel:@"test"][@"occupancy"], @3);
+    XCTAssertEqualObjects([self localUUIDs], ([NSSet setWithArray:@[@"alice", @"dave", @"erin"]]));
+
+    // Re-joined subscriber shouldn't get state which it had before leave.
+    [self.index handlePresenceEvent:[self intervalEventWithChanges:@{@"join": @[@"bob"]} occupancy:4
+                                                         timetoken:11]];
+    XCTAssertTrue([[self.index hereNowForChannel:@"test"][@"uuids"] containsObject:@{@"uuid": @"bob"}]);
+}
+
+- (void)testSeedingDisabledByDefault {
+
+    [self.index seedChannels:@[@"other-pnpres"]];
+
+    __block id entry = nil;
+    dispatch_sync(self.index.resourceAccessQueue, ^{ entry = self.index.entries[@"other"]; });
+    XCTAssertFalse(self.client.currentConfiguration.shouldMaintainPresenceIndex);
+    XCTAssertNil(entry);
+}
+
+- (void)testStaleEventSkipped {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}] occupancy:1];
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"bob" occupancy:2 timetoken:20 state:nil]];
+    [self.index handlePresenceEvent:[self event:@"leave" forUUID:@"bob" occupancy:1 timetoken:10 state:nil]];
+
+    XCTAssertEqualObjects([self.index hereNowForChannel:@"test"][@"occupancy"], @2);
+    XCTAssertEqualObjects([self localUUIDs], ([NSSet setWithArray:@[@"alice", @"bob"]]));
+}
+
+- (void)testPendingEventsReplayedOverSeed {
+
+    // Events arrived while here now request still in progress.
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"bob" occupancy:2 timetoken:10 state:nil]];
+    [self.index handlePresenceEvent:[self event:@"leave" forUUID:@"alice" occupancy:1 timetoken:11 state:nil]];
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}] occupancy:1];
+
+    XCTAssertEqualObjects([self.index hereNowForChannel:@"test"][@"occupancy"], @1);
+    XCTAssertEqualObjects([self localUUIDs], [NSSet setWithObject:@"bob"]);
+
+    // Pending events should be applied only once.
+    [self.index handlePresenceEvent:[self event:@"join" forUUID:@"carol" occupancy:2 timetoken:12 state:nil]];
+    XCTAssertEqualObjects([self localUUIDs], ([NSSet setWithArray:@[@"bob", @"carol"]]));
+}
+
+- (void)testRemovedChannel {
+
+    [self seedWithUUIDs:@[@{@"uuid": @"alice"}] occupancy:1];
+    [self.index removeChannels:@[@"test"]];
+    XCTAssertNotNil([self.index hereNowForChannel:@"test"]);
+
+    [self.index removeChannels:@[@"test-pnpres"]];
+    XCTAssertNil([self.index hereNowForChannel:@"test"]);
+}
+
+- (void)testClientLocalHereNowAPI {
+
+    XCTAssertNil([self.client localHereNowForChannel:@"pubnub"]);
+    [self seedWithUUIDs:@[@{@"uuid": @"alice", @"state": @{@"mood": @"happy"}}] occupancy:1];
+
+    // Same usage as in -localHereNowForChannel: documentation.
+    PNPresenceChannelHereNowData *hereNow = [self.client localHereNowForChannel:@"test"];
+    XCTAssertEqualObjects(hereNow.occupancy, @1);
+    XCTAssertEqualObjects(hereNow.uuids, (@[@{@"uuid": @"alice", @"state": @{@"mood": @"happy"}}]));
+}
+
+
+#pragma mark - Misc
+
+- (PNPresenceEventResult *)event:(NSString *)type forUUID:(NSString *)uuid occupancy:(NSUInteger)occupancy
+                       timetoken:(unsigned long long)timetoken state:(NSDictionary *)state {
+
+    NSMutableDictionary *presence = [@{@"occupancy": @(occupancy), @"timetoken": @(timetoken)} mutableCopy];
+    if (uuid) { presence[@"uuid"] = uuid; }
+    if (state) { presence[@"state"] = state; }
+    NSDictionary *data = @{@"subscribedChannel": @"test-pnpres", @"presenceEvent": type,
+                           @"presence": presence};
+
+    return [PNPresenceEventResult objectForOperation:PNSubscribeOperation completedWithTask:nil
+                                       processedData:data processingError:nil];
+}
+
+- (PNPresenceEventResult *)intervalEventWithChanges:(NSDictionary<NSString *, NSArray *> *)changes
+                                          occupancy:(NSUInteger)occupancy timetoken:(unsigned long long)timetoken {
+
+    NSMutableDictionary *presence = [@{@"occupancy": @(occupancy), @"timetoken": @(timetoken)} mutableCopy];
+    [presence addEntriesFromDictionary:changes];
+    NSDictionary *data = @{@"subscribedChannel": @"test-pnpres", @"presenceEvent": @"interval",
+                           @"presence": presence};
+
+    return [PNPresenceEventResult objectForOperation:PNSubscribeOperation completedWithTask:nil
+                                       processedData:data processingError:nil];
+}
+
+- (void)seedWithUUIDs:(NSArray<NSDictionary *> *)uuids occupancy:(NSUInteger)occupancy {
+
+    PNPresenceChannelHereNowResult *result = [PNPresenceChannelHereNowResult
+                                              objectForOperation:PNHereNowForChannelOperation
+                                              completedWithTask:nil
+                                              processedData:@{@"occupancy": @(occupancy), @"uuids": uuids}
+                                              processingError:nil];
+    dispatch_barrier_sync(self.index.resourceAccessQueue, ^{
+
+        [self.index applyHereNowData:result.data toEntry:self.entry];
+    });
+}
+
+- (NSSet<NSString *> *)localUUIDs {
+
+    NSArray<NSDictionary *> *uuids = [self.index hereNowForChannel:@"test"][@"uuids"];
+
+    return [NSSet setWithArray:[uuids valueForKey:@"uuid"]];
+}
+
+#pragma mark -
+
+
+@end
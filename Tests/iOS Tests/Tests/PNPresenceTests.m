@@ -438,4 +438,15 @@
     }];
 }
 
+- (void)testLocalHereNowForNotSubscribedChannel {
+    XCTAssertNil([self.client localHereNowForChannel:self.channelName]);
+}
+
+- (void)testLocalHereNowForNilChannel {
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wnonnull"
+    XCTAssertNil([self.client localHereNowForChannel:nil]);
+    #pragma clang diagnostic pop
+}
+
 @end
\ No newline at end of file
@@ -0,0 +1,228 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNPublishQueue.h"
+
+
+/**
+ @brief      PNPublishQueue testing.
+ @discussion Verify that messages for same channel processed one-by-one in order in which they has been
+             scheduled and that number of in-flight messages limited by configuration.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNPublishQueueTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which publish queue created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested publish queue.
+ */
+@property (nonatomic, strong) PNPublishQueue *queue;
+
+/**
+ @brief  Stores reference on list of tasks completion blocks which wait for test to release them.
+ */
+@property (nonatomic, strong) NSMutableArray<dispatch_block_t> *heldCompletions;
+
+/**
+ @brief  Stores number of tasks which is processed at this moment.
+ */
+@property (nonatomic, assign) NSUInteger inFlightCount;
+
+/**
+ @brief  Stores maximum number of tasks which has been processed at the same time.
+ */
+@property (nonatomic, assign) NSUInteger maximumInFlightCount;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Schedule task which will be completed only when test will release it.
+
+ @param channel Name of channel for which task should be scheduled.
+ @param block   Reference on block which is called when task processing started.
+ */
+- (void)enqueueHeldTaskForChannel:(NSString *)channel startBlock:(dispatch_block_t)block;
+
+/**
+ @brief  Complete all tasks which has been started so far.
+ */
+- (void)releaseHeldTasks;
+
+/**
+ @brief  Wait till specified number of tasks will be started and hold.
+
+ @param count Number of tasks which should be started.
+ */
+- (void)waitForHeldTasksCount:(NSUInteger)count;
+
+/**
+ @brief  Wait for publish queue flush.
+
+ @param timeout For how long queue should wait for tasks completion.
+
+ @return Whether queue has been flushed or not.
+ */
+- (BOOL)flushWithTimeout:(NSTimeInterval)timeout;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNPublishQueueTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.publishMaximumInFlight = 2;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.queue = [PNPublishQueue publishQueueForClient:self.client];
+    self.heldCompletions = [NSMutableArray new];
+    self.inFlightCount = 0;
+    self.maximumInFlightCount = 0;
+}
+
+- (void)testPerChannelFIFO {
+
+    NSMutableArray<NSNumber *> *processedTasks = [NSMutableArray new];
+    for (NSUInteger taskIdx = 0; taskIdx < 5; taskIdx++) {
+
+        [self enqueueHeldTaskForChannel:@"a" startBlock:^{ [processedTasks addObject:@(taskIdx)]; }];
+    }
+
+    // Only one task for channel can be in-flight.
+    for (NSUInteger taskIdx = 0; taskIdx < 5; taskIdx++) {
+
+        [self waitForHeldTasksCount:1];
+        @synchronized (self) { XCTAssertEqual(self.inFlightCount, 1); }
+        [self releaseHeldTasks];
+    }
+
+    XCTAssertTrue([self flushWithTimeout:5.f]);
+    XCTAssertEqualObjects(processedTasks, (@[@0, @1, @2, @3, @4]));
+    XCTAssertEqual(self.maximumInFlightCount, 1);
+}
+
+- (void)testMaximumInFlight {
+
+    for (NSUInteger taskIdx = 0; taskIdx < 6; taskIdx++) {
+
+        [self enqueueHeldTaskForChannel:[NSString stringWithFormat:@"channel-%@", @(taskIdx)] startBlock:nil];
+    }
+
+    // Each time only two tasks should be started, rest should wait for free slot.
+    for (NSUInteger releaseIdx = 0; releaseIdx < 3; releaseIdx++) {
+
+        [self waitForHeldTasksCount:2];
+        [NSThread sleepForTimeInterval:0.1f];
+        @synchronized (self) { XCTAssertEqual(self.heldCompletions.count, 2); }
+        [self releaseHeldTasks];
+    }
+
+    XCTAssertTrue([self flushWithTimeout:5.f]);
+    XCTAssertEqual(self.maximumInFlightCount, 2);
+}
+
+- (void)testDifferentChannelsProcessedInParallel {
+
+    [self enqueueHeldTaskForChannel:@"a" startBlock:nil];
+    [self enqueueHeldTaskForChannel:@"a" startBlock:nil];
+    [self enqueueHeldTaskForChannel:@"b" startBlock:nil];
+
+    // Second task for 'a' wait for first one, so 'b' should use free slot.
+    [self waitForHeldTasksCount:2];
+    @synchronized (self) { XCTAssertEqual(self.inFlightCount, 2); }
+
+    [self releaseHeldTasks];
+    [self waitForHeldTasksCount:1];
+    [self releaseHeldTasks];
+    XCTAssertTrue([self flushWithTimeout:5.f]);
+}
+
+- (void)testFlushTimeout {
+
+    [self enqueueHeldTaskForChannel:@"a" startBlock:nil];
+    [self waitForHeldTasksCount:1];
+
+    XCTAssertFalse([self flushWithTimeout:0.2f]);
+    [self releaseHeldTasks];
+    XCTAssertTrue([self flushWithTimeout:5.f]);
+}
+
+
+#pragma mark - Misc
+
+- (void)enqueueHeldTaskForChannel:(NSString *)channel startBlock:(dispatch_block_t)block {
+
+    [self.queue enqueueForChannel:channel usingBlock:^(dispatch_block_t completion) {
+
+        @synchronized (self) {
+
+            self.inFlightCount++;
+            self.maximumInFlightCount = MAX(self.maximumInFlightCount, self.inFlightCount);
+            if (block) { block(); }
+            [self.heldCompletions addObject:completion];
+        }
+    }];
+}
+
+- (void)releaseHeldTasks {
+
+    NSArray<dispatch_block_t> *completions = nil;
+    @synchronized (self) {
+
+        completions = [self.heldCompletions copy];
+        [self.heldCompletions removeAllObjects];
+        self.inFlightCount -= completions.count;
+    }
+    for (dispatch_block_t completion in completions) { completion(); }
+}
+
+- (void)waitForHeldTasksCount:(NSUInteger)count {
+
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.f];
+    BOOL started = NO;
+    while (!started && [timeoutDate timeIntervalSinceNow] > 0.f) {
+
+        @synchronized (self) { started = (self.heldCompletions.count >= count); }
+        if (!started) { [NSThread sleepForTimeInterval:0.01f]; }
+    }
+    XCTAssertTrue(started);
+}
+
+- (BOOL)flushWithTimeout:(NSTimeInterval)timeout {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Publish queue flush"];
+    __block BOOL queueFlushed = NO;
+    [self.queue flushWithTimeout:timeout completion:^(BOOL flushed) {
+
+        queueFlushed = flushed;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:(timeout + 5.f) handler:nil];
+
+    return queueFlushed;
+}
+
+#pragma mark -
+
+
+@end
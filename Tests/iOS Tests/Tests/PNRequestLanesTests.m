@@ -0,0 +1,317 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNRequestParameters.h"
+#import "PNTransport.h"
+#import "PNNetwork.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores reference on list of tasks which has been created by test transport.
+ */
+static NSMutableArray *PNLanesTestTasks = nil;
+
+
+#pragma mark - Test transport
+
+/**
+ @brief  Transport task which doesn't perform any requests and complete only when test ask for it.
+ */
+@interface PNLanesTestTask : NSObject <PNTransportTask>
+
+
+#pragma mark - Information
+
+@property (nullable, copy) NSURLRequest *currentRequest;
+@property (nullable, copy) NSURLResponse *response;
+@property (nullable, copy) NSError *error;
+
+/**
+ @brief  Stores whether task processing has been started or not.
+ */
+@property (atomic, assign, getter = isResumed) BOOL resumed;
+
+/**
+ @brief  Stores whether task processing has been cancelled or not.
+ */
+@property (atomic, assign, getter = isCancelled) BOOL cancelled;
+
+/**
+ @brief  Stores reference on block which should be called at the end of task processing.
+ */
+@property (nonatomic, copy) PNTransportTaskCompletionBlock completion;
+
+
+#pragma mark - Processing
+
+/**
+ @brief  Complete task processing with error.
+
+ @param code One of \a NSURLError codes which should be reported.
+ */
+- (void)completeWithErrorCode:(NSInteger)code;
+
+#pragma mark -
+
+
+@end
+
+
+/**
+ @brief  Transport which create \b PNLanesTestTask tasks and store them for tests.
+ */
+@interface PNLanesTestTransport : NSObject <PNTransport>
+
+@property (nonatomic, nullable, copy) NSDictionary<NSString *, NSString *> *HTTPAdditionalHeaders;
+@property (nonatomic, assign) NSURLRequestCachePolicy requestCachePolicy;
+
+@end
+
+
+/**
+ @brief      Requests lanes testing.
+ @discussion Verify that non-subscribe requests queued when their lane budget exhausted and don't affect
+             requests from other lanes.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNRequestLanesTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which network manager created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested network manager.
+ */
+@property (nonatomic, strong) PNNetwork *network;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Send \c time request which should be scheduled using control lane.
+ */
+- (void)sendControlRequest;
+
+/**
+ @brief  Send \c history request which should be scheduled using bulk read lane.
+ */
+- (void)sendBulkReadRequest;
+
+/**
+ @brief  Wait till specified task processing will be started.
+
+ @param task Reference on task for which test should wait.
+ */
+- (void)waitForResumeOfTask:(PNLanesTestTask *)task;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test transport implementation
+
+@implementation PNLanesTestTask
+
+- (void)resume {
+
+    self.resumed = YES;
+}
+
+- (void)cancel {
+
+    self.cancelled = YES;
+    [self completeWithErrorCode:NSURLErrorCancelled];
+}
+
+- (void)completeWithErrorCode:(NSInteger)code {
+
+    PNTransportTaskCompletionBlock completion = self.completion;
+    self.completion = nil;
+    if (completion) {
+
+        completion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:code userInfo:nil]);
+    }
+}
+
+@end
+
+
+@implementation PNLanesTestTransport
+
++ (instancetype)transportWithIdentifier:(NSString *)identifier requestTimeout:(NSTimeInterval)timeout
+                     maximumConnections:(NSInteger)maximumConnections longPoll:(BOOL)longPollEnabled {
+
+    return [self new];
+}
+
+- (id <PNTransportTask>)taskWithRequest:(NSURLRequest *)request
+                             completion:(PNTransportTaskCompletionBlock)block {
+
+    PNLanesTestTask *task = [PNLanesTestTask new];
+    task.currentRequest = request;
+    task.completion = block;
+    @synchronized (PNLanesTestTasks) { [PNLanesTestTasks addObject:task]; }
+
+    return task;
+}
+
+- (void)cancelAllTasks {
+}
+
+- (void)invalidate {
+}
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNRequestLanesTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNLanesTestTasks = [NSMutableArray new];
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.controlRequestsMaximumConnections = 1;
+    configuration.bulkReadRequestsMaximumConnections = 1;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.network = [PNNetwork networkForClient:self.client requestTimeout:10.f maximumConnections:2
+                                      longPoll:NO transport:[PNLanesTestTransport class]];
+}
+
+- (void)tearDown {
+
+    [self.network invalidate];
+    self.network = nil;
+
+
+    // Forward method call to the super class.
+    [super tearDown];
+}
+
+- (void)testRequestsQueuedInExhaustedLane {
+
+    [self sendControlRequest];
+    [self sendControlRequest];
+    [self sendControlRequest];
+    NSArray<PNLanesTestTask *> *tasks = [PNLanesTestTasks copy];
+
+    XCTAssertEqual(tasks.count, 3);
+    XCTAssertTrue(tasks[0].isResumed);
+    XCTAssertFalse(tasks[1].isResumed);
+    XCTAssertFalse(tasks[2].isResumed);
+    XCTAssertEqual([self.network activeRequestsCountInLane:PNControlRequestLane], 1);
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNControlRequestLane], 2);
+}
+
+- (void)testExhaustedLaneDoesNotBlockOtherLanes {
+
+    [self sendControlRequest];
+    [self sendControlRequest];
+    [self sendBulkReadRequest];
+    NSArray<PNLanesTestTask *> *tasks = [PNLanesTestTasks copy];
+
+    XCTAssertFalse(tasks[1].isResumed);
+    XCTAssertTrue(tasks[2].isResumed);
+    XCTAssertEqual([self.network activeRequestsCountInLane:PNBulkReadRequestLane], 1);
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNBulkReadRequestLane], 0);
+}
+
+- (void)testPendingRequestsResumedInOrder {
+
+    [self sendControlRequest];
+    [self sendControlRequest];
+    [self sendControlRequest];
+    NSArray<PNLanesTestTask *> *tasks = [PNLanesTestTasks copy];
+
+    [tasks[0] completeWithErrorCode:NSURLErrorTimedOut];
+    [self waitForResumeOfTask:tasks[1]];
+    XCTAssertFalse(tasks[2].isResumed);
+    XCTAssertEqual([self.network activeRequestsCountInLane:PNControlRequestLane], 1);
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNControlRequestLane], 1);
+
+    [tasks[1] completeWithErrorCode:NSURLErrorTimedOut];
+    [self waitForResumeOfTask:tasks[2]];
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNControlRequestLane], 0);
+}
+
+- (void)testCancelledPendingRequestDoesNotReleaseConnection {
+
+    [self sendControlRequest];
+    [self sendControlRequest];
+    [self sendControlRequest];
+    NSArray<PNLanesTestTask *> *tasks = [PNLanesTestTasks copy];
+
+    [tasks[1] cancel];
+    PNNetwork *network = self.network;
+    [self expectationForPredicate:[NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+
+        return ([network pendingRequestsCountInLane:PNControlRequestLane] == 1);
+    }] evaluatedWithObject:self handler:nil];
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+    XCTAssertFalse(tasks[2].isResumed);
+    XCTAssertEqual([self.network activeRequestsCountInLane:PNControlRequestLane], 1);
+
+    [tasks[0] completeWithErrorCode:NSURLErrorTimedOut];
+    [self waitForResumeOfTask:tasks[2]];
+    XCTAssertFalse(tasks[1].isResumed);
+    XCTAssertEqual([self.network activeRequestsCountInLane:PNControlRequestLane], 1);
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNControlRequestLane], 0);
+}
+
+- (void)testInvalidateCancelsPendingRequests {
+
+    [self sendControlRequest];
+    [self sendControlRequest];
+    NSArray<PNLanesTestTask *> *tasks = [PNLanesTestTasks copy];
+
+    [self.network invalidate];
+    XCTAssertFalse(tasks[0].isCancelled);
+    XCTAssertTrue(tasks[1].isCancelled);
+    XCTAssertFalse(tasks[1].isResumed);
+    XCTAssertEqual([self.network pendingRequestsCountInLane:PNControlRequestLane], 0);
+}
+
+
+#pragma mark - Misc
+
+- (void)sendControlRequest {
+
+    [self.network processOperation:PNTimeOperation withParameters:[PNRequestParameters new] data:nil
+                   completionBlock:nil];
+}
+
+- (void)sendBulkReadRequest {
+
+    PNRequestParameters *parameters = [PNRequestParameters new];
+    [parameters addPathComponent:@"test" forPlaceholder:@"{channel}"];
+    [self.network processOperation:PNHistoryOperation withParameters:parameters data:nil completionBlock:nil];
+}
+
+- (void)waitForResumeOfTask:(PNLanesTestTask *)task {
+
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"resumed == YES"] evaluatedWithObject:task
+                          handler:nil];
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+}
+
+#pragma mark -
+
+
+@end
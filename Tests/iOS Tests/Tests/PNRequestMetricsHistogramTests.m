@@ -0,0 +1,148 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNRequestMetricsHistogram+Private.h"
+#import "PNRequestMetrics+Private.h"
+#import "PubNub+CorePrivate.h"
+
+
+/**
+ @brief      PNRequestMetricsHistogram testing.
+ @discussion Verify that requests durations placed into proper buckets and that client collect histograms
+             only when asked.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNRequestMetricsHistogramTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on tested histogram.
+ */
+@property (nonatomic, strong) PNRequestMetricsHistogram *histogram;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose metrics for completed request.
+
+ @param operation Type of operation for which request has been sent.
+ @param duration  Time which has been spent from request creation till completion block call.
+
+ @return Configured metrics instance.
+ */
+- (PNRequestMetrics *)metricsForOperation:(PNOperationType)operation withDuration:(NSTimeInterval)duration;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNRequestMetricsHistogramTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    self.histogram = [PNRequestMetricsHistogram histogramForOperation:PNPublishOperation];
+}
+
+- (void)testEmptyHistogram {
+
+    XCTAssertEqual(self.histogram.operation, PNPublishOperation);
+    XCTAssertEqual(self.histogram.count, 0);
+    XCTAssertEqual(self.histogram.averageDuration, 0.f);
+    XCTAssertEqual(self.histogram.bucketCounts.count, self.histogram.bucketBounds.count + 1);
+    XCTAssertEqualObjects([self.histogram.bucketCounts valueForKeyPath:@"@sum.self"], @0);
+}
+
+- (void)testDurationsPlacedIntoBuckets {
+
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.005]];
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.03]];
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.04]];
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:20.0]];
+    NSArray<NSNumber *> *counts = self.histogram.bucketCounts;
+
+    XCTAssertEqual(self.histogram.count, 4);
+    XCTAssertEqualWithAccuracy(self.histogram.minimumDuration, 0.005, 0.0001);
+    XCTAssertEqualWithAccuracy(self.histogram.maximumDuration, 20.0, 0.0001);
+    XCTAssertEqualWithAccuracy(self.histogram.averageDuration, 5.01875, 0.0001);
+    XCTAssertEqualObjects(counts[0], @1);
+    XCTAssertEqualObjects(counts[1], @0);
+    XCTAssertEqualObjects(counts[2], @2);
+    XCTAssertEqualObjects(counts.lastObject, @1);
+    XCTAssertEqualObjects([counts valueForKeyPath:@"@sum.self"], @4);
+}
+
+- (void)testCopyIsSnapshot {
+
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.2]];
+    PNRequestMetricsHistogram *snapshot = [self.histogram copy];
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.3]];
+
+    XCTAssertEqual(snapshot.count, 1);
+    XCTAssertEqualWithAccuracy(snapshot.maximumDuration, 0.2, 0.0001);
+    XCTAssertEqual(self.histogram.count, 2);
+}
+
+- (void)testReset {
+
+    [self.histogram recordMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.2]];
+    [self.histogram reset];
+
+    XCTAssertEqual(self.histogram.count, 0);
+    XCTAssertEqual(self.histogram.minimumDuration, 0.f);
+    XCTAssertEqual(self.histogram.maximumDuration, 0.f);
+    XCTAssertEqualObjects([self.histogram.bucketCounts valueForKeyPath:@"@sum.self"], @0);
+}
+
+- (void)testClientCollectHistogramsPerOperation {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.collectRequestMetricsHistogram = YES;
+    PubNub *client = [PubNub clientWithConfiguration:configuration];
+    [client storeRequestMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.2]];
+    [client storeRequestMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.3]];
+    [client storeRequestMetrics:[self metricsForOperation:PNHistoryOperation withDuration:1.5]];
+
+    XCTAssertEqual([client requestMetricsHistogramForOperation:PNPublishOperation].count, 2);
+    XCTAssertEqual([client requestMetricsHistogramForOperation:PNHistoryOperation].count, 1);
+    XCTAssertEqual([client requestMetricsHistogramForOperation:PNTimeOperation].count, 0);
+}
+
+- (void)testClientDoesNotCollectHistogramsByDefault {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    PubNub *client = [PubNub clientWithConfiguration:configuration];
+    [client storeRequestMetrics:[self metricsForOperation:PNPublishOperation withDuration:0.2]];
+
+    XCTAssertNil([client requestMetricsHistogramForOperation:PNPublishOperation]);
+}
+
+
+#pragma mark - Misc
+
+- (PNRequestMetrics *)metricsForOperation:(PNOperationType)operation withDuration:(NSTimeInterval)duration {
+
+    PNRequestMetrics *metrics = [PNRequestMetrics metricsForOperation:operation];
+    metrics.callbackDispatchDate = [metrics.requestCreationDate dateByAddingTimeInterval:duration];
+
+    return metrics;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,229 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PNStatus+Private.h"
+#import "PNSubscriber.h"
+
+
+#pragma mark Private interfaces
+
+/**
+ @brief  Subscriber private interface which is used by coalesced changes to send requests.
+ */
+@interface PNSubscriber (PNTest)
+
+- (void)subscribe:(BOOL)initialSubscribe usingTimeToken:(NSNumber *)timeToken
+        withState:(NSDictionary<NSString *, id> *)state completion:(PNSubscriberCompletionBlock)block;
+- (void)unsubscribeFromChannels:(NSArray<NSString *> *)channels groups:(NSArray<NSString *> *)groups
+                     completion:(void(^)(PNStatus *status, BOOL leaveSent))block;
+
+@end
+
+
+/**
+ @brief  Subscriber which record requests composed from coalesced changes instead of sending them.
+ */
+@interface PNCoalescingTestSubscriber : PNSubscriber
+
+
+#pragma mark - Information
+
+/**
+ @brief  Stores reference on list of subscribe requests (dictionaries with \c timeToken and \c state).
+ */
+@property (atomic, strong) NSMutableArray<NSDictionary *> *subscribeRequests;
+
+/**
+ @brief  Stores reference on list of leave requests (dictionaries with \c channels and \c groups).
+ */
+@property (atomic, strong) NSMutableArray<NSDictionary *> *leaveRequests;
+
+#pragma mark -
+
+
+@end
+
+
+/**
+ @brief      Subscription changes coalescing testing.
+ @discussion Verify that subscribe and unsubscribe calls done during coalescing window merged into single
+             change set.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSubscribeCoalescingTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client for which subscriber created.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on tested subscriber.
+ */
+@property (nonatomic, strong) PNCoalescingTestSubscriber *subscriber;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Wait till coalescing window will be closed and changes applied.
+ */
+- (void)waitForCoalescingWindow;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test subscriber implementation
+
+@implementation PNCoalescingTestSubscriber
+
+- (void)subscribe:(BOOL)initialSubscribe usingTimeToken:(NSNumber *)timeToken
+        withState:(NSDictionary<NSString *, id> *)state completion:(PNSubscriberCompletionBlock)block {
+
+    [self.subscribeRequests addObject:@{@"timeToken": (timeToken?: [NSNull null]),
+                                        @"state": (state?: [NSNull null])}];
+    if (block) { dispatch_async(dispatch_get_main_queue(), ^{ block(nil); }); }
+}
+
+- (void)unsubscribeFromChannels:(NSArray<NSString *> *)channels groups:(NSArray<NSString *> *)groups
+                     completion:(void(^)(PNStatus *status, BOOL leaveSent))block {
+
+    [self.leaveRequests addObject:@{@"channels": [NSSet setWithArray:channels],
+                                    @"groups": [NSSet setWithArray:groups]}];
+    block([PNStatus statusForOperation:PNUnsubscribeOperation category:PNAcknowledgmentCategory
+                   withProcessingError:nil], (channels.count || groups.count));
+}
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNSubscribeCoalescingTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.subscribeCoalescingInterval = 0.1f;
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.subscriber = [PNCoalescingTestSubscriber subscriberForClient:self.client];
+    self.subscriber.subscribeRequests = [NSMutableArray new];
+    self.subscriber.leaveRequests = [NSMutableArray new];
+}
+
+- (void)testSubscribeCallsMerged {
+
+    __block NSUInteger calledBlocksCount = 0;
+    [self.subscriber addChannels:@[@"a", @"b"]];
+    [self.subscriber subscribeUsingTimeToken:@1 withState:@{@"a": @{@"x": @1}}
+                                  completion:^(PNSubscribeStatus *status) { calledBlocksCount++; }];
+    [self.subscriber addChannels:@[@"c"]];
+    [self.subscriber subscribeUsingTimeToken:@2 withState:@{@"c": @{@"y": @2}}
+                                  completion:^(PNSubscribeStatus *status) { calledBlocksCount++; }];
+    [self waitForCoalescingWindow];
+
+    XCTAssertEqual(self.subscriber.leaveRequests.count, 0);
+    XCTAssertEqual(self.subscriber.subscribeRequests.count, 1);
+    XCTAssertEqualObjects(self.subscriber.subscribeRequests[0][@"timeToken"], @2);
+    XCTAssertEqualObjects(self.subscriber.subscribeRequests[0][@"state"],
+                          (@{@"a": @{@"x": @1}, @"c": @{@"y": @2}}));
+    XCTAssertEqual(calledBlocksCount, 2);
+}
+
+- (void)testUnsubscribeCallsMergedIntoSingleLeave {
+
+    __block NSUInteger calledBlocksCount = 0;
+    [self.subscriber addChannels:@[@"a", @"b"]];
+    [self.subscriber addChannelGroups:@[@"g"]];
+    [self.subscriber removeChannels:@[@"a"]];
+    [self.subscriber unsubscribeFrom:YES objects:@[@"a"]
+                          completion:^(PNSubscribeStatus *status) { calledBlocksCount++; }];
+    [self.subscriber removeChannelGroups:@[@"g"]];
+    [self.subscriber unsubscribeFrom:NO objects:@[@"g"]
+                          completion:^(PNSubscribeStatus *status) { calledBlocksCount++; }];
+    [self waitForCoalescingWindow];
+
+    XCTAssertEqual(self.subscriber.leaveRequests.count, 1);
+    XCTAssertEqualObjects(self.subscriber.leaveRequests[0][@"channels"], [NSSet setWithObject:@"a"]);
+    XCTAssertEqualObjects(self.subscriber.leaveRequests[0][@"groups"], [NSSet setWithObject:@"g"]);
+
+    // Subscription on rest of channels restored after 'leave'.
+    XCTAssertEqual(self.subscriber.subscribeRequests.count, 1);
+    XCTAssertEqual(calledBlocksCount, 2);
+}
+
+- (void)testLeaveNotSentForObjectsChangedWithinWindow {
+
+    [self.subscriber addChannels:@[@"a", @"b"]];
+    [self.subscriber subscribeUsingTimeToken:nil withState:nil completion:nil];
+    [self waitForCoalescingWindow];
+    [self.subscriber.subscribeRequests removeAllObjects];
+
+    // 'b' removed and added back, 'd' added and removed during window.
+    [self.subscriber removeChannels:@[@"b"]];
+    [self.subscriber unsubscribeFrom:YES objects:@[@"b"] completion:nil];
+    [self.subscriber addChannels:@[@"b", @"d"]];
+    [self.subscriber subscribeUsingTimeToken:nil withState:nil completion:nil];
+    [self.subscriber removeChannels:@[@"d"]];
+    [self.subscriber unsubscribeFrom:YES objects:@[@"d"] completion:nil];
+    [self waitForCoalescingWindow];
+
+    XCTAssertEqual(self.subscriber.leaveRequests.count, 1);
+    XCTAssertEqual(((NSSet *)self.subscriber.leaveRequests[0][@"channels"]).count, 0);
+    XCTAssertEqual(((NSSet *)self.subscriber.leaveRequests[0][@"groups"]).count, 0);
+    XCTAssertEqual(self.subscriber.subscribeRequests.count, 1);
+}
+
+- (void)testChangesAppliedSynchronouslyByDefault {
+
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    XCTAssertEqual(configuration.subscribeCoalescingInterval, 0.f);
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.subscriber = [PNCoalescingTestSubscriber subscriberForClient:self.client];
+    self.subscriber.subscribeRequests = [NSMutableArray new];
+    self.subscriber.leaveRequests = [NSMutableArray new];
+
+    [self.subscriber addChannels:@[@"a", @"b"]];
+    [self.subscriber subscribeUsingTimeToken:nil withState:nil completion:nil];
+    XCTAssertEqual(self.subscriber.subscribeRequests.count, 1);
+
+    [self.subscriber addChannels:@[@"c"]];
+    [self.subscriber subscribeUsingTimeToken:nil withState:nil completion:nil];
+    XCTAssertEqual(self.subscriber.subscribeRequests.count, 2);
+
+    [self.subscriber removeChannels:@[@"a"]];
+    [self.subscriber unsubscribeFrom:YES objects:@[@"a"] completion:nil];
+    XCTAssertEqual(self.subscriber.leaveRequests.count, 1);
+    XCTAssertEqualObjects(self.subscriber.leaveRequests[0][@"channels"], [NSSet setWithObject:@"a"]);
+}
+
+
+#pragma mark - Misc
+
+- (void)waitForCoalescingWindow {
+
+    // Window closed after 0.1 second, additional time allow to make sure what nothing else has been sent.
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Coalescing window"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5f * NSEC_PER_SEC)), dispatch_get_main_queue(),
+                   ^{ [expectation fulfill]; });
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,133 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PubNub+CorePrivate.h"
+#import "PNSubscriber.h"
+
+
+#pragma mark Private interfaces
+
+/**
+ @brief  Subscriber private interface which is used by tests to pass responses for handling.
+ */
+@interface PNSubscriber (PNTest)
+
+@property (nonatomic, strong) dispatch_queue_t responsesHandlingQueue;
+
+- (void)handleResponse:(int64_t)identifier withBlock:(dispatch_block_t)block;
+
+@end
+
+
+/**
+ @brief      Subscribe responses ordering testing.
+ @discussion Verify that responses handled in order in which requests has been sent and late responses
+             dropped.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSubscribeResponsesOrderTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client which own tested subscriber.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+/**
+ @brief  Stores reference on list of identifiers of responses which has been handled.
+ */
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *handledResponses;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Pass response to subscriber for handling.
+
+ @param identifier Identifier which has been assigned to subscribe request.
+ */
+- (void)handleResponse:(int64_t)identifier;
+
+/**
+ @brief  Wait till subscriber will complete handling of passed responses.
+ */
+- (void)waitForHandling;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNSubscribeResponsesOrderTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    self.client = [PubNub clientWithConfiguration:configuration];
+    self.handledResponses = [NSMutableArray new];
+}
+
+- (void)testResponsesHandledInRequestsOrder {
+
+    [self handleResponse:3];
+    [self handleResponse:2];
+    [self waitForHandling];
+    XCTAssertEqual(self.handledResponses.count, 0);
+
+    [self handleResponse:1];
+    [self waitForHandling];
+    XCTAssertEqualObjects(self.handledResponses, (@[@1, @2, @3]));
+}
+
+- (void)testLateResponseDropped {
+
+    [self handleResponse:1];
+    [self handleResponse:2];
+    [self handleResponse:1];
+    [self waitForHandling];
+
+    XCTAssertEqualObjects(self.handledResponses, (@[@1, @2]));
+}
+
+- (void)testDuplicatePendingResponseDropped {
+
+    [self handleResponse:2];
+    [self handleResponse:2];
+    [self handleResponse:1];
+    [self waitForHandling];
+
+    XCTAssertEqualObjects(self.handledResponses, (@[@1, @2]));
+}
+
+
+#pragma mark - Misc
+
+- (void)handleResponse:(int64_t)identifier {
+
+    [self.client.subscriberManager handleResponse:identifier withBlock:^{
+
+        [self.handledResponses addObject:@(identifier)];
+    }];
+}
+
+- (void)waitForHandling {
+
+    dispatch_sync(self.client.subscriberManager.responsesHandlingQueue, ^{});
+}
+
+#pragma mark -
+
+
+@end
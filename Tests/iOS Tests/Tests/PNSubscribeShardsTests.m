@@ -0,0 +1,166 @@
+#import <XCTest/XCTest.h>
+#import <PubNub/PubNub.h>
+#import "PubNub+CorePrivate.h"
+#import "PNSubscriber.h"
+
+
+#pragma mark Private interfaces
+
+/**
+ @brief  Subscriber private interface which is used by tests to verify objects distribution.
+ */
+@interface PNSubscriber (PNTest)
+
+- (NSUInteger)shardsCountForObjectsCount:(NSUInteger)objectsCount;
+- (NSArray<NSArray<NSString *> *> *)distributeObjects:(NSArray<NSString *> *)objects
+                                        betweenShards:(NSUInteger)shardsCount;
+
+@end
+
+
+/**
+ @brief      Subscribe shards testing.
+ @discussion Verify that large subscription sets split between limited number of shards and that each object
+             handled by single shard.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSubscribeShardsTests : XCTestCase
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on client which own tested subscriber.
+ */
+@property (nonatomic, strong) PubNub *client;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose list of channel names.
+
+ @param count Number of channel names which should be composed.
+
+ @return List of channel names.
+ */
+- (NSArray<NSString *> *)channelsWithCount:(NSUInteger)count;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNSubscribeShardsTests
+
+- (void)setUp {
+
+    // Forward method call to the super class.
+    [super setUp];
+
+
+    // Prepare 'fixtures'
+    PNConfiguration *configuration = [PNConfiguration configurationWithPublishKey:@"demo-36"
+                                                                     subscribeKey:@"demo-36"];
+    configuration.subscribeShardsMaximumCount = 3;
+    configuration.subscribeShardObjectsThreshold = 10;
+    self.client = [PubNub clientWithConfiguration:configuration];
+}
+
+- (void)testShardsCount {
+
+    PNSubscriber *subscriber = self.client.subscriberManager;
+    XCTAssertEqual([subscriber shardsCountForObjectsCount:0], 1);
+    XCTAssertEqual([subscriber shardsCountForObjectsCount:10], 1);
+    XCTAssertEqual([subscriber shardsCountForObjectsCount:11], 2);
+    XCTAssertEqual([subscriber shardsCountForObjectsCount:30], 3);
+    XCTAssertEqual([subscriber shardsCountForObjectsCount:1000], 3);
+}
+
+- (void)testSingleShardKeepAllObjects {
+
+    NSArray<NSString *> *channels = [self channelsWithCount:10];
+    NSArray<NSArray<NSString *> *> *shards = [self.client.subscriberManager distributeObjects:channels
+                                                                                betweenShards:1];
+
+    XCTAssertEqual(shards.count, 1);
+    XCTAssertEqualObjects(shards[0], channels);
+}
+
+- (void)testEachObjectAssignedToSingleShard {
+
+    NSArray<NSString *> *channels = [self channelsWithCount:100];
+    NSArray<NSArray<NSString *> *> *shards = [self.client.subscriberManager distributeObjects:channels
+                                                                                betweenShards:3];
+    NSMutableArray<NSString *> *assignedChannels = [NSMutableArray new];
+    for (NSArray<NSString *> *shardChannels in shards) {
+
+        XCTAssertGreaterThan(shardChannels.count, 0);
+        [assignedChannels addObjectsFromArray:shardChannels];
+    }
+
+    XCTAssertEqual(shards.count, 3);
+    XCTAssertEqual(assignedChannels.count, channels.count);
+    XCTAssertEqualObjects([NSSet setWithArray:assignedChannels], [NSSet setWithArray:channels]);
+}
+
+- (void)testAssignmentStableBetweenSubscriptionChanges {
+
+    PNSubscriber *subscriber = self.client.subscriberManager;
+    NSArray<NSString *> *channels = [self channelsWithCount:30];
+    NSArray<NSArray<NSString *> *> *shards = [subscriber distributeObjects:channels betweenShards:3];
+    NSArray<NSString *> *updatedChannels = [[channels subarrayWithRange:NSMakeRange(0, 20)]
+                                            arrayByAddingObject:@"test-channel-new"];
+    NSArray<NSArray<NSString *> *> *updatedShards = [subscriber distributeObjects:updatedChannels
+                                                                    betweenShards:3];
+
+    // Channels which still in subscription set shouldn't move to another long-poll loop.
+    for (NSUInteger shardIdx = 0; shardIdx < shards.count; shardIdx++) {
+
+        NSMutableSet *keptChannels = [NSMutableSet setWithArray:shards[shardIdx]];
+        [keptChannels intersectSet:[NSSet setWithArray:updatedChannels]];
+        XCTAssertTrue([keptChannels isSubsetOfSet:[NSSet setWithArray:updatedShards[shardIdx]]]);
+    }
+}
+
+- (void)testPresenceChannelAssignedWithChannel {
+
+    NSArray<NSString *> *channels = [self channelsWithCount:30];
+    NSMutableArray<NSString *> *objects = [channels mutableCopy];
+    for (NSString *channel in channels) { [objects addObject:[channel stringByAppendingString:@"-pnpres"]]; }
+    NSArray<NSArray<NSString *> *> *shards = [self.client.subscriberManager distributeObjects:objects
+                                                                                betweenShards:3];
+
+    for (NSArray<NSString *> *shardObjects in shards) {
+
+        for (NSString *object in shardObjects) {
+
+            if ([object hasSuffix:@"-pnpres"]) { continue; }
+            XCTAssertTrue([shardObjects containsObject:[object stringByAppendingString:@"-pnpres"]]);
+        }
+    }
+}
+
+
+#pragma mark - Misc
+
+- (NSArray<NSString *> *)channelsWithCount:(NSUInteger)count {
+
+    NSMutableArray<NSString *> *channels = [NSMutableArray new];
+    for (NSUInteger channelIdx = 0; channelIdx < count; channelIdx++) {
+
+        [channels addObject:[NSString stringWithFormat:@"test-channel-%@", @(channelIdx)]];
+    }
+
+    return channels;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,234 @@
+#import <XCTest/XCTest.h>
+#import "PNSubscribeStreamParser.h"
+#import "PNParsingExecutor.h"
+
+
+/**
+ @brief      PNSubscribeStreamParser testing.
+ @discussion Verify that envelope scanner handle response body split at any byte, escaped characters, any kind
+             of event payload and malformed or truncated responses, and that events processed in batches
+             delivered in order in which they has been received.
+
+ @author Sergey Mamontov
+ @copyright © 2009-2016 PubNub, Inc.
+ */
+@interface PNSubscribeStreamParserTests : XCTestCase
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Compose subscribe response body.
+
+ @param payloads List of objects which should be used as events' payloads (\c d field).
+
+ @return Serialized subscribe response.
+ */
+- (NSData *)subscribeResponseWithPayloads:(NSArray *)payloads;
+
+/**
+ @brief  Pass response body to parser in chunks of specified size.
+
+ @param data   Reference on response body.
+ @param size   Maximum length of single chunk.
+ @param parser Reference on parser which should be fed with response body.
+
+ @return Whether all chunks has been accepted by parser or not.
+ */
+- (BOOL)feedData:(NSData *)data withChunkSize:(NSUInteger)size toParser:(PNSubscribeStreamParser *)parser;
+
+/**
+ @brief  Wait for parser to complete events processing.
+
+ @param parser Reference on parser which has been fed with response body.
+
+ @return Processed response or \c nil in case if parser wasn't able to process response.
+ */
+- (NSDictionary *)processedResponseFromParser:(PNSubscribeStreamParser *)parser;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Test case implementation
+
+@implementation PNSubscribeStreamParserTests
+
+- (void)testResponseSplitIntoSingleByteChunks {
+
+    // Single byte chunks split escape sequences and multi-byte UTF-8 characters.
+    NSArray *payloads = @[@"café ✓ \U0001F600", @"\"quoted\" back\\slash /path",
+                          @{@"nested": @[@1, @{@"key": @"}]{[\""}]}];
+    NSData *response = [self subscribeResponseWithPayloads:payloads];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+
+    XCTAssertTrue([self feedData:response withChunkSize:1 toParser:parser]);
+    XCTAssertTrue(parser.isCompleted);
+    NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+    XCTAssertEqualObjects([processedResponse[@"events"] valueForKey:@"message"], payloads);
+    XCTAssertEqualObjects(processedResponse[@"timetoken"], @14630027081471920);
+    XCTAssertEqualObjects(processedResponse[@"region"], @1);
+}
+
+- (void)testResponseSplitAtEveryOffset {
+
+    NSArray *payloads = @[@"café \\\"", @{@"a": @"✓"}];
+    NSData *response = [self subscribeResponseWithPayloads:payloads];
+    for (NSUInteger offset = 1; offset < response.length; offset++) {
+
+        PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+        XCTAssertTrue([parser appendData:[response subdataWithRange:NSMakeRange(0, offset)]]);
+        XCTAssertTrue([parser appendData:[response subdataWithRange:NSMakeRange(offset, response.length - offset)]]);
+
+        NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+        XCTAssertEqualObjects([processedResponse[@"events"] valueForKey:@"message"], payloads,
+                              @"Split offset: %@", @(offset));
+    }
+}
+
+- (void)testEscapedQuotesAndBackslashes {
+
+    // Escaped quotes and backslashes in envelope key, envelope value and events shouldn't end strings.
+    NSData *response = [(@"{\"t\":{\"t\":\"15\",\"r\":2},\"x\\\"y\":\"}\\\\\",\"m\":["
+                         "{\"b\":\"a\",\"c\":\"a\",\"d\":\"\\\"}\\\\\",\"k\":\"demo\"},"
+                         "{\"b\":\"a\",\"c\":\"a\",\"d\":\"caf\\u00e9 \\\\\\\"\",\"k\":\"demo\"}]}")
+                        dataUsingEncoding:NSUTF8StringEncoding];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+
+    XCTAssertTrue([self feedData:response withChunkSize:1 toParser:parser]);
+    XCTAssertTrue(parser.isCompleted);
+    NSDictionary *envelope = [NSJSONSerialization JSONObjectWithData:[parser envelopeData] options:0 error:nil];
+    XCTAssertEqualObjects(envelope, (@{@"t": @{@"t": @"15", @"r": @2}, @"x\"y": @"}\\"}));
+    NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+    XCTAssertEqualObjects([processedResponse[@"events"] valueForKey:@"message"],
+                          (@[@"\"}\\", @"café \\\""]));
+    XCTAssertEqualObjects(processedResponse[@"timetoken"], @15);
+}
+
+- (void)testScalarAndNestedPayloads {
+
+    NSArray *payloads = @[@42, @YES, [NSNull null], @"string", @[@1, @[@2, @[@3]]],
+                          @{@"a": @[@1, @{@"b": @"]}"}], @"c": @{}}];
+    NSData *response = [self subscribeResponseWithPayloads:payloads];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+
+    XCTAssertTrue([self feedData:response withChunkSize:5 toParser:parser]);
+    NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+    XCTAssertEqualObjects([processedResponse[@"events"] valueForKey:@"message"], payloads);
+}
+
+- (void)testScalarEnvelopeFields {
+
+    // Scalar value end detected by next character, including envelope closing brace.
+    NSData *response = [@"{\"x\":123 ,\"t\":{\"t\":\"15\",\"r\":2},\"m\":[],\"y\":true}"
+                        dataUsingEncoding:NSUTF8StringEncoding];
+    PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+
+    XCTAssertTrue([self feedData:response withChunkSize:1 toParser:parser]);
+    XCTAssertTrue(parser.isCompleted);
+    NSDictionary *envelope = [NSJSONSerialization JSONObjectWithData:[parser envelopeData] options:0 error:nil];
+    XCTAssertEqualObjects(envelope, (@{@"x": @123, @"t": @{@"t": @"15", @"r": @2}, @"y": @YES}));
+    NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+    XCTAssertEqualObjects(processedResponse[@"events"], @[]);
+    XCTAssertEqualObjects(processedResponse[@"timetoken"], @15);
+}
+
+- (void)testMalformedResponse {
+
+    NSArray<NSString *> *responses = @[@"[]", @"{\"t\" 1}", @"{\"m\":[1]}", @"{\"m\":[]} x", @"{,\"m\":[]]"];
+    for (NSString *response in responses) {
+
+        PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+        XCTAssertFalse([parser appendData:[response dataUsingEncoding:NSUTF8StringEncoding]], @"%@", response);
+        XCTAssertFalse(parser.isCompleted, @"%@", response);
+        XCTAssertNil([self processedResponseFromParser:parser], @"%@", response);
+
+        // Parser shouldn't accept data after malformed response has been detected.
+        XCTAssertFalse([parser appendData:[@"{}" dataUsingEncoding:NSUTF8StringEncoding]], @"%@", response);
+    }
+}
+
+- (void)testTruncatedResponse {
+
+    NSData *response = [self subscribeResponseWithPayloads:@[@"first", @{@"second": @"✓"}]];
+    for (NSUInteger length = 1; length < response.length; length++) {
+
+        PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil executor:nil];
+        XCTAssertTrue([parser appendData:[response subdataWithRange:NSMakeRange(0, length)]]);
+        XCTAssertFalse(parser.isCompleted, @"Length: %@", @(length));
+        XCTAssertNil([self processedResponseFromParser:parser], @"Length: %@", @(length));
+    }
+}
+
+- (void)testBatchesOrderAcrossBatchSizeLimit {
+
+    // Batches processed concurrently, so they may complete in any order.
+    PNParsingExecutor *executor = [PNParsingExecutor executorWithIdentifier:@"com.pubnub.tests.stream-parser"
+                                                           qualityOfService:PNUserInitiatedQualityOfService
+                                                         maximumConcurrency:4];
+    for (NSNumber *count in @[@31, @32, @33, @64, @100]) {
+
+        NSMutableArray *payloads = [NSMutableArray new];
+        for (NSUInteger eventIdx = 0; eventIdx < count.unsignedIntegerValue; eventIdx++) {
+
+            [payloads addObject:@{@"idx": @(eventIdx)}];
+        }
+        NSData *response = [self subscribeResponseWithPayloads:payloads];
+        PNSubscribeStreamParser *parser = [PNSubscribeStreamParser parserWithAdditionalData:nil
+                                                                                   executor:executor];
+
+        XCTAssertTrue([self feedData:response withChunkSize:7 toParser:parser]);
+        NSDictionary *processedResponse = [self processedResponseFromParser:parser];
+        XCTAssertEqualObjects([processedResponse[@"events"] valueForKey:@"message"], payloads,
+                              @"Events count: %@", count);
+    }
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)subscribeResponseWithPayloads:(NSArray *)payloads {
+
+    NSMutableArray *events = [NSMutableArray new];
+    for (id payload in payloads) {
+
+        [events addObject:@{@"a": @"1", @"b": @"test-channel", @"c": @"test-channel", @"d": payload,
+                            @"k": @"demo"}];
+    }
+    NSDictionary *response = @{@"t": @{@"t": @"14630027081471920", @"r": @1}, @"m": events};
+
+    return [NSJSONSerialization dataWithJSONObject:response options:(NSJSONWritingOptions)0 error:nil];
+}
+
+- (BOOL)feedData:(NSData *)data withChunkSize:(NSUInteger)size toParser:(PNSubscribeStreamParser *)parser {
+
+    BOOL accepted = YES;
+    for (NSUInteger offset = 0; offset < data.length && accepted; offset += size) {
+
+        NSRange range = NSMakeRange(offset, MIN(size, data.length - offset));
+        accepted = [parser appendData:[data subdataWithRange:range]];
+    }
+
+    return accepted;
+}
+
+- (NSDictionary *)processedResponseFromParser:(PNSubscribeStreamParser *)parser {
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Response processing"];
+    __block NSDictionary *processedResponse = nil;
+    [parser processedResponseOnQueue:dispatch_get_main_queue() withCompletion:^(NSDictionary *data) {
+
+        processedResponse = data;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.f handler:nil];
+
+    return processedResponse;
+}
+
+#pragma mark -
+
+
+@end